@@ -5,6 +5,7 @@ ENABLE_COMP?=1
 ENABLE_STATIC?=0
 ENABLE_DECODER?=1
 ENABLE_UNITTESTS?=1
+ENABLE_BENCHMARKS?=0
 ENABLE_LIBREF?=1
 
 BIN?=bin
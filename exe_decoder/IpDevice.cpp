@@ -62,7 +62,9 @@ AL_TAllocator* createDmaAllocator(const char* deviceName)
 
 extern "C"
 {
-AL_TIDecChannel* AL_DecChannelMcu_Create();
+#include "lib_decode/DecChannelMcu.h"
+#include "lib_decode/DecChannelSim.h"
+#include "lib_fpga/DmaAllocSim.h"
 }
 
 static unique_ptr<CIpDevice> createMcuIpDevice()
@@ -82,8 +84,25 @@ static unique_ptr<CIpDevice> createMcuIpDevice()
   return device;
 }
 
+static unique_ptr<CIpDevice> createSimIpDevice(AL_TSimDeviceSettings const& tSimSettings)
+{
+  auto device = make_unique<CIpDevice>();
 
-shared_ptr<CIpDevice> CreateIpDevice(int* iUseBoard, int iSchedulerType, AL_EDecUnit eDecUnit, function<AL_TIpCtrl* (AL_TIpCtrl*)> wrapIpCtrl, bool trackDma, int uNumCore, int hangers)
+  device->m_pAllocator.reset(DmaAllocSim_Create(), &AL_Allocator_Destroy);
+
+  if(!device->m_pAllocator)
+    throw runtime_error("Can't create the simulated DMA allocator");
+
+  device->m_pDecChannel = AL_DecChannelSim_Create(device->m_pAllocator.get(), &tSimSettings);
+
+  if(!device->m_pDecChannel)
+    throw runtime_error("Failed to create the simulated MCU");
+
+  return device;
+}
+
+
+shared_ptr<CIpDevice> CreateIpDevice(int* iUseBoard, int iSchedulerType, AL_EDecUnit eDecUnit, function<AL_TIpCtrl* (AL_TIpCtrl*)> wrapIpCtrl, bool trackDma, int uNumCore, int hangers, AL_TSimDeviceSettings tSimSettings)
 {
   (void)iUseBoard, (void)eDecUnit, (void)wrapIpCtrl, (void)uNumCore, (void)trackDma, (void)hangers;
 
@@ -92,6 +111,9 @@ shared_ptr<CIpDevice> CreateIpDevice(int* iUseBoard, int iSchedulerType, AL_EDec
   if(iSchedulerType == SCHEDULER_TYPE_MCU)
     return createMcuIpDevice();
 
+  if(iSchedulerType == SCHEDULER_TYPE_SIM)
+    return createSimIpDevice(tSimSettings);
+
   throw runtime_error("No support for this scheduling type");
 }
 
@@ -42,6 +42,11 @@
 #include "lib_app/utils.h"
 #include "lib_common_dec/DecChanParam.h"
 
+extern "C"
+{
+#include "lib_common/SimDevice.h"
+}
+
 typedef struct AL_t_Allocator AL_TAllocator;
 typedef struct AL_t_IDecChannel AL_TIDecChannel;
 typedef struct AL_t_IpCtrl AL_TIpCtrl;
@@ -53,5 +58,5 @@ struct CIpDevice
   std::shared_ptr<AL_TAllocator> m_pAllocator;
 };
 
-std::shared_ptr<CIpDevice> CreateIpDevice(int* iUseBoard, int iSchedulerType, AL_EDecUnit eDecUnit, std::function<AL_TIpCtrl* (AL_TIpCtrl*)> wrapIpCtrl, bool trackDma = false, int uNumCore = 0, int hangers = 0);
+std::shared_ptr<CIpDevice> CreateIpDevice(int* iUseBoard, int iSchedulerType, AL_EDecUnit eDecUnit, std::function<AL_TIpCtrl* (AL_TIpCtrl*)> wrapIpCtrl, bool trackDma = false, int uNumCore = 0, int hangers = 0, AL_TSimDeviceSettings tSimSettings = {});
 
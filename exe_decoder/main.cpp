@@ -53,6 +53,7 @@ extern "C"
 #include "lib_app/BufPool.h"
 #include "lib_common/BufferSrcMeta.h"
 #include "lib_decode/lib_decode.h"
+#include "lib_decode/DecChannelMcu.h"
 #include "lib_common_dec/DecBuffers.h"
 #include "lib_common/FourCC.h"
 #include "lib_common/StreamBuffer.h"
@@ -61,9 +62,13 @@ extern "C"
 
 #include "lib_app/console.h"
 #include "lib_app/convert.h"
+#include "lib_app/convert_planner.h"
+#include "lib_app/convert_scheduler.h"
 #include "lib_app/timing.h"
 #include "lib_app/utils.h"
 #include "lib_app/CommandLineParser.h"
+#include "lib_app/StageReport.h"
+#include "lib_app/TraceExport.h"
 
 #include "Conversion.h"
 #include "al_resource.h"
@@ -141,14 +146,19 @@ struct Config
   AL_TDecSettings tDecSettings = getDefaultDecSettings();
   int iUseBoard = 1; // board
   SCHEDULER_TYPE iSchedulerType = SCHEDULER_TYPE_MCU;
+  AL_TSimDeviceSettings tSimSettings = {};
   int iNumTrace = -1;
   int iNumberTrace = 0;
   bool bConceal = false;
   bool bEnableYUVOutput = true;
   unsigned int uInputBufferNum = 2;
   size_t zInputBufferSize = zDefaultInputBufferSize;
+  bool bZeroCopyInput = false;
+  int iPoolMagazineSize = 0;
+  bool bPoolStats = false;
   IpCtrlMode ipCtrlMode = IPCTRL_MODE_STANDARD;
   string logsFile = "";
+  string sBenchJson = "";
   bool trackDma = false;
   int hangers = 0;
   int iLoop = 1;
@@ -247,6 +257,9 @@ static Config ParseCommandLine(int argc, char* argv[])
   opt.addString("-out,-o", &Config.sOut, "Output YUV");
   opt.addInt("-nbuf", &Config.uInputBufferNum, "Specify the number of input feeder buffer");
   opt.addInt("-nsize", &Config.zInputBufferSize, "Specify the size (in bytes) of input feeder buffer");
+  opt.addFlag("--zero-copy-input", &Config.bZeroCopyInput, "Read the bitstream directly in the decoder stream buffer when possible");
+  opt.addInt("--pool-magazine", &Config.iPoolMagazineSize, "Number of free input buffers each thread keeps at hand (0: disabled)");
+  opt.addFlag("--pool-stats", &Config.bPoolStats, "Print the input buffer pool and start code search statistics at the end of the decoding");
   opt.addInt("-num", &Config.iNumberTrace, "Number of frames to trace");
   opt.addFlag("--quiet,-q", &quiet, "quiet mode");
   opt.addInt("-core", &Config.tDecSettings.uNumCore, "number of hevc_decoder cores");
@@ -285,6 +298,25 @@ static Config ParseCommandLine(int argc, char* argv[])
               "Specify decoder DPB Low ref (stream musn't have B-frame & reference must be at best 1",
               AL_DPB_LOW_REF);
 
+  opt.addFlag("--sim-mcu", &Config.iSchedulerType,
+              "Complete the decoding jobs on a software stand-in for the MCU: the pictures are not decoded",
+              SCHEDULER_TYPE_SIM);
+  opt.addInt("--sim-latency", &Config.tSimSettings.uLatency, "Latency of the simulated MCU jobs, in microseconds");
+  opt.addInt("--sim-rate", &Config.tSimSettings.uJobsPerSecond, "Number of pictures the simulated MCU decodes per second (0: no limit)");
+
+  opt.addInt("--sim-msg-cost", &Config.tSimSettings.uMessageCost, "Host time spent sending each message to the simulated MCU, in microseconds");
+
+  opt.addFlag("-slicelat", &Config.tDecSettings.eDecUnit,
+              "Specify decoder latency (default: Frame Latency)",
+              AL_VCL_NAL_UNIT);
+  opt.addInt("--slice-batch", &Config.tDecSettings.uSliceBatchCount, "With -slicelat, number of slices sent to the MCU in one message (0: no count threshold)");
+  opt.addInt("--slice-batch-bytes", &Config.tDecSettings.uSliceBatchBytes, "With -slicelat, stream size from which the pending slices are sent to the MCU (0: no size threshold)");
+  opt.addInt("--lookahead", &Config.tDecSettings.iLookahead, "In frame latency, number of access units parsed ahead of the ones the IP is decoding");
+
+  opt.addFlag("--sw-scd", &Config.tDecSettings.eScdMode,
+              "Search the start codes on the CPU instead of the IP",
+              AL_SCD_SOFTWARE);
+
   opt.addFlag("-avc", &Config.tDecSettings.bIsAvc,
               "Specify the input bitstream codec (default: HEVC)",
               true);
@@ -299,12 +331,17 @@ static Config ParseCommandLine(int argc, char* argv[])
 
   opt.addInt("-loop", &Config.iLoop, "Number of Decoding loop (optional)");
 
-  opt.addString("--log", &Config.logsFile, "A file where logged events will be dumped");
+  opt.addString("--log", &Config.logsFile, "A file where the trace of the decoding events will be dumped (chrome trace json)");
+  opt.addString("--bench-json", &Config.sBenchJson, "A file where the host cpu time and latency of each decoding stage will be dumped (json)");
 
 
   string preAllocArgs = "";
   opt.addInt("--timeout", &Config.iTimeOutInSeconds, "Specify timeout in seconds");
   opt.addString("--prealloc-args", &preAllocArgs, "Specify the stream dimension: 1920x1080:422:10:profile-idc:level");
+  opt.addOption("--conv-threads", [&]()
+  {
+    SetConversionThreads(opt.popInt());
+  }, "Number of threads used by the output YUV conversion (0: one per cpu, default: 1)");
 
   opt.parse(argc, argv);
 
@@ -435,118 +472,55 @@ static TFourCC GetInternalFourCC(AL_EChromaMode eChromaMode, uint8_t uBitDepth,
   return FOURCC(I420);
 }
 
-AL_TO_IP Get8BitsConversionFunction(int iPicFmt)
+/* fourcc of the raster frame buffers written by the ip */
+static TFourCC GetRasterFourCC(AL_EChromaMode eChromaMode, int iBitDepth)
 {
-  auto const CHROMA_MONO_8bitTo8bit = 0x00080800;
-  auto const CHROMA_MONO_8bitTo10bit = 0x000A0800;
-
-  auto const CHROMA_420_8bitTo8bit = 0x00080801;
-  auto const CHROMA_420_8bitTo10bit = 0x000A0801;
-
-  auto const CHROMA_422_8bitTo8bit = 0x00080802;
-  auto const CHROMA_422_8bitTo10bit = 0x000A0802;
-  switch(iPicFmt)
+  if(iBitDepth == 8)
   {
-  case CHROMA_420_8bitTo8bit:
-    return NV12_To_I420;
-  case CHROMA_420_8bitTo10bit:
-    return NV12_To_I0AL;
-  case CHROMA_422_8bitTo8bit:
-    return NV16_To_I422;
-  case CHROMA_422_8bitTo10bit:
-    return NV16_To_I2AL;
-  case CHROMA_MONO_8bitTo8bit:
-    return Y800_To_Y800;
-  case CHROMA_MONO_8bitTo10bit:
-    return Y800_To_Y010;
-  default:
-    assert(0);
-    return nullptr;
+    switch(eChromaMode)
+    {
+    case CHROMA_4_2_0: return FOURCC(NV12);
+    case CHROMA_4_2_2: return FOURCC(NV16);
+    case CHROMA_MONO: return FOURCC(Y800);
+    default: assert(0);
+    }
   }
-}
-
-AL_TO_IP Get10BitsConversionFunction(int iPicFmt)
-{
-  auto const CHROMA_MONO_10bitTo10bit = 0x000A0A00;
-  auto const CHROMA_MONO_10bitTo8bit = 0x00080A00;
-
-  auto const CHROMA_420_10bitTo10bit = 0x000A0A01;
-  auto const CHROMA_420_10bitTo8bit = 0x00080A01;
-
-  auto const CHROMA_422_10bitTo10bit = 0x000A0A02;
-  auto const CHROMA_422_10bitTo8bit = 0x00080A02;
-
-  bool bPlanar = false;
-  switch(iPicFmt)
+  else
   {
-  case CHROMA_420_10bitTo10bit:
-    return bPlanar ? P010_To_I0AL : RX0A_To_I0AL;
-  case CHROMA_420_10bitTo8bit:
-    return bPlanar ? P010_To_I420 : RX0A_To_I420;
-  case CHROMA_422_10bitTo10bit:
-    return bPlanar ? P210_To_I2AL : RX2A_To_I2AL;
-  case CHROMA_422_10bitTo8bit:
-    return bPlanar ? P210_To_I422 : RX2A_To_I422;
-  case CHROMA_MONO_10bitTo10bit:
-    return bPlanar ? P010_To_Y010 : RX0A_To_Y010;
-  case CHROMA_MONO_10bitTo8bit:
-    return bPlanar ? P010_To_Y800 : RX0A_To_Y800;
-  default:
-    assert(0);
-    return nullptr;
+    switch(eChromaMode)
+    {
+    case CHROMA_4_2_0: return FOURCC(RX0A);
+    case CHROMA_4_2_2: return FOURCC(RX2A);
+    case CHROMA_MONO: return FOURCC(RX0A);
+    default: assert(0);
+    }
   }
+  return FOURCC(NV12);
 }
 
-AL_TO_IP GetTileConversionFunction(int iPicFmt)
+static TFourCC GetOutputFourCC(AL_EChromaMode eChromaMode, int iBitDepth)
 {
-  auto const CHROMA_MONO_8bitTo8bit = 0x00080800;
-  auto const CHROMA_MONO_8bitTo10bit = 0x000A0800;
-
-  auto const CHROMA_420_8bitTo8bit = 0x00080801;
-  auto const CHROMA_420_8bitTo10bit = 0x000A0801;
-
-  auto const CHROMA_422_8bitTo8bit = 0x00080802;
-  auto const CHROMA_422_8bitTo10bit = 0x000A0802;
-
-  auto const CHROMA_MONO_10bitTo10bit = 0x000A0A00;
-  auto const CHROMA_MONO_10bitTo8bit = 0x00080A00;
-
-  auto const CHROMA_420_10bitTo10bit = 0x000A0A01;
-  auto const CHROMA_420_10bitTo8bit = 0x00080A01;
-
-  auto const CHROMA_422_10bitTo10bit = 0x000A0A02;
-  auto const CHROMA_422_10bitTo8bit = 0x00080A02;
-  switch(iPicFmt)
+  if(iBitDepth == 8)
   {
-  case CHROMA_420_8bitTo8bit:
-    return T608_To_I420;
-  case CHROMA_420_8bitTo10bit:
-    return T608_To_I0AL;
-  case CHROMA_422_8bitTo8bit:
-    return T628_To_I422;
-  case CHROMA_422_8bitTo10bit:
-    return T628_To_I2AL;
-  case CHROMA_MONO_8bitTo8bit:
-    return T608_To_Y800;
-  case CHROMA_MONO_8bitTo10bit:
-    return T608_To_Y010;
-
-  case CHROMA_420_10bitTo10bit:
-    return T60A_To_I0AL;
-  case CHROMA_420_10bitTo8bit:
-    return T60A_To_I420;
-  case CHROMA_422_10bitTo10bit:
-    return T62A_To_I2AL;
-  case CHROMA_422_10bitTo8bit:
-    return T62A_To_I422;
-  case CHROMA_MONO_10bitTo10bit:
-    return T60A_To_Y010;
-  case CHROMA_MONO_10bitTo8bit:
-    return T60A_To_Y800;
-  default:
-    assert(0);
-    return nullptr;
+    switch(eChromaMode)
+    {
+    case CHROMA_4_2_0: return FOURCC(I420);
+    case CHROMA_4_2_2: return FOURCC(I422);
+    case CHROMA_MONO: return FOURCC(Y800);
+    default: assert(0);
+    }
   }
+  else
+  {
+    switch(eChromaMode)
+    {
+    case CHROMA_4_2_0: return FOURCC(I0AL);
+    case CHROMA_4_2_2: return FOURCC(I2AL);
+    case CHROMA_MONO: return FOURCC(Y010);
+    default: assert(0);
+    }
+  }
+  return FOURCC(I420);
 }
 
 AL_TO_IP GetConversionFunction(TFourCC input, int iBdOut)
@@ -554,16 +528,12 @@ AL_TO_IP GetConversionFunction(TFourCC input, int iBdOut)
   auto const eChromaMode = AL_GetChromaMode(input);
   auto const iBdIn = AL_GetBitDepth(input);
 
-#define GetConvFormat(ChromaMode, iBdIn, iBdOut) ((ChromaMode) | ((iBdIn) << 8) | ((iBdOut) << 16))
+  auto const tSrcFourCC = AL_IsTiled(input) ? input : GetRasterFourCC(eChromaMode, iBdIn);
+  auto const tDstFourCC = GetOutputFourCC(eChromaMode, iBdOut);
 
-  int iPicFmt = GetConvFormat(eChromaMode, iBdIn, iBdOut);
-
-  if(AL_IsTiled(input))
-    return GetTileConversionFunction(iPicFmt);
-  else if(iBdIn == 8)
-    return Get8BitsConversionFunction(iPicFmt);
-  else
-    return Get10BitsConversionFunction(iPicFmt);
+  auto Convert = GetConversion(tSrcFourCC, tDstFourCC);
+  assert(Convert);
+  return Convert;
 }
 
 static void FillInternalOffsets(AL_TSrcMetaData* pMeta, AL_EFbStorageMode eFBStorageMode)
@@ -597,9 +567,8 @@ static void ConvertFrameBuffer(AL_TBuffer& input, int iBdIn, AL_TBuffer& output,
   pYuvMeta->tDim.iHeight = pRecMeta->tDim.iHeight;
   pYuvMeta->tPitches.iLuma = iSizePix * pRecMeta->tDim.iWidth;
   pYuvMeta->tPitches.iChroma = iSizePix * ((eChromaMode == CHROMA_4_4_4) ? pRecMeta->tDim.iWidth : pRecMeta->tDim.iWidth >> 1);
-  pYuvMeta->tOffsetYC.iLuma = pYuvMeta->tPitches.iLuma / iSizePix * pYuvMeta->tDim.iHeight;
-  int iCScale = eChromaMode == CHROMA_4_2_2 ? 2 : eChromaMode == CHROMA_4_2_0 ? 4 : 1;
-  pYuvMeta->tOffsetYC.iChroma = pYuvMeta->tOffsetYC.iLuma + pYuvMeta->tOffsetYC.iLuma / iCScale;
+  pYuvMeta->tOffsetYC.iLuma = 0;
+  pYuvMeta->tOffsetYC.iChroma = pYuvMeta->tPitches.iLuma * pYuvMeta->tDim.iHeight;
 
   auto AllegroConvert = GetConversionFunction(pRecMeta->tFourCC, iBdOut);
   AllegroConvert(&input, &output);
@@ -626,10 +595,13 @@ static void ProcessFrame(AL_TBuffer& tRecBuf, AL_TBuffer& tYuvBuf, AL_TInfoDecod
 
     auto const iSizePix = (iBdOut + 7) >> 3;
 
-    ConvertFrameBuffer(tRecBuf, iBdIn, tYuvBuf, iBdOut, info.eFbStorageMode);
+    {
+      StageScope conversion(AL_STAGE_CONVERSION);
+      ConvertFrameBuffer(tRecBuf, iBdIn, tYuvBuf, iBdOut, info.eFbStorageMode);
 
-    if(info.tCrop.bCropping)
-      CropFrame(&tYuvBuf, iSizePix, info.tCrop.uCropOffsetLeft, info.tCrop.uCropOffsetRight, info.tCrop.uCropOffsetTop, info.tCrop.uCropOffsetBottom);
+      if(info.tCrop.bCropping)
+        CropFrame(&tYuvBuf, iSizePix, info.tCrop.uCropOffsetLeft, info.tCrop.uCropOffsetRight, info.tCrop.uCropOffsetTop, info.tCrop.uCropOffsetBottom);
+    }
 
     if(ofCertCrcFile.is_open())
     {
@@ -654,6 +626,7 @@ static void ProcessFrame(AL_TBuffer& tRecBuf, AL_TBuffer& tYuvBuf, AL_TInfoDecod
 
     if(ofYuvFile.is_open())
     {
+      StageScope writeOut(AL_STAGE_WRITE_OUT);
       auto uSize = GetPictureSizeInSamples(pYuvMeta) * iSizePix;
       ofYuvFile.write((const char*)AL_Buffer_GetData(&tYuvBuf), uSize);
     }
@@ -796,7 +769,7 @@ static void sResolutionFound(int BufferNumber, int BufferSize, AL_TStreamSetting
     throw codec_error(AL_ERR_RESOLUTION_CHANGE);
 
   const int buffersHeldByNextComponent = 1; /* We need at least 1 buffer to copy the output on a file */
-  AL_TBufPoolConfig BufPoolConfig;
+  AL_TBufPoolConfig BufPoolConfig {};
   BufPoolConfig.zBufSize = BufferSize;
   BufPoolConfig.uNumBuf = BufferNumber + buffersHeldByNextComponent;
   BufPoolConfig.debugName = "yuv";
@@ -820,9 +793,28 @@ static void sResolutionFound(int BufferNumber, int BufferSize, AL_TStreamSetting
   }
 }
 
+/******************************************************************************/
+static void PrintPoolStats(char const* sName, AL_TBufPool* pPool)
+{
+  AL_TBufPoolStats tStats;
+  AL_BufPool_GetStats(pPool, &tStats);
+  Message(CC_DEFAULT, "%s pool: %d hits, %d misses, %d waits, %d buffers used at most\n",
+          sName, tStats.iHits, tStats.iMisses, tStats.iWaits, tStats.iHighWater);
+}
+
+/******************************************************************************/
+static void PrintScSearchStats(AL_TIDecChannel* pDecChannel)
+{
+  AL_TScSearchStats tStats;
+  AL_DecChannelMcu_GetScStats(pDecChannel, &tStats);
+  Message(CC_DEFAULT, "start code searches: %d posted, %d in flight at most, %d without a pooled handle\n",
+          tStats.iNumSearches, tStats.iMaxInFlight, tStats.iNumExhausted);
+}
+
 /******************************************************************************/
 static uint32_t ReadStream(istream& ifFileStream, AL_TBuffer* pBufStream)
 {
+  StageScope fileRead(AL_STAGE_FILE_READ);
   uint8_t* pBuf = AL_Buffer_GetData(pBufStream);
   auto zSize = pBufStream->zSize;
 
@@ -836,6 +828,7 @@ static void AddBuffer(AL_HDecoder hDec, AL_TBuffer* pBufStream, size_t zAvailSiz
   assert(pBufStream);
   assert(hDec);
 
+  StageScope process(AL_STAGE_PROCESS);
   auto bRet = AL_Decoder_PushBuffer(hDec, pBufStream, zAvailSize, AL_BUF_MODE_BLOCK);
 
   if(!bRet)
@@ -893,7 +886,7 @@ void SafeMain(int argc, char** argv)
     break;
   }
 
-  auto pIpDevice = CreateIpDevice(&iUseBoard, Config.iSchedulerType, Config.tDecSettings.eDecUnit, wrapIpCtrl, Config.trackDma, Config.tDecSettings.uNumCore, Config.hangers);
+  auto pIpDevice = CreateIpDevice(&iUseBoard, Config.iSchedulerType, Config.tDecSettings.eDecUnit, wrapIpCtrl, Config.trackDma, Config.tDecSettings.uNumCore, Config.hangers, Config.tSimSettings);
 
   auto pAllocator = pIpDevice->m_pAllocator.get();
   auto pDecChannel = pIpDevice->m_pDecChannel;
@@ -922,6 +915,7 @@ void SafeMain(int argc, char** argv)
     BufPoolConfig.uNumBuf = Config.uInputBufferNum;
     BufPoolConfig.pMetaData = nullptr;
     BufPoolConfig.debugName = "stream";
+    BufPoolConfig.uMagazineSize = Config.iPoolMagazineSize;
 
     auto ret = AL_BufPool_Init(&bufPool, AL_GetDefaultAllocator(), &BufPoolConfig);
 
@@ -975,6 +969,9 @@ void SafeMain(int argc, char** argv)
         throw codec_error(eErr);
   }
 
+  AL_StageStats_Enable(!Config.sBenchJson.empty());
+  AL_Trace_Enable(!Config.logsFile.empty());
+
   // Initial stream buffer filling
   auto const uBegin = GetPerfTime();
   int iLoop = 0;
@@ -984,8 +981,10 @@ void SafeMain(int argc, char** argv)
   {
     for(;;)
     {
+      // fall back on a feeder buffer (copied by the decoder) when no chunk is available
+      AL_TBuffer* pChunk = Config.bZeroCopyInput ? AL_Decoder_GetStreamChunk(hDec, Config.zInputBufferSize) : nullptr;
       auto pBufStream = shared_ptr<AL_TBuffer>(
-        AL_BufPool_GetBuffer(&bufPool, AL_BUF_MODE_BLOCK),
+        pChunk ? pChunk : AL_BufPool_GetBuffer(&bufPool, AL_BUF_MODE_BLOCK),
         &AL_Buffer_Unref);
 
       auto uAvailSize = ReadStream(ifFileStream, pBufStream.get());
@@ -1058,6 +1057,20 @@ void SafeMain(int argc, char** argv)
           duration,
           tDecodeParam.decodedFrames / duration,
           iNumFrameConceal);
+
+  if(!Config.sBenchJson.empty())
+    WriteStageReport(Config.sBenchJson, "decoder", tDecodeParam.decodedFrames, duration);
+
+  if(!Config.logsFile.empty())
+    WriteChromeTrace(Config.logsFile);
+
+  if(Config.bPoolStats)
+  {
+    PrintPoolStats("stream", &bufPool);
+
+    if(Config.iSchedulerType == SCHEDULER_TYPE_MCU)
+      PrintScSearchStats(pDecChannel);
+  }
 }
 
 /******************************************************************************/
@@ -1067,6 +1080,7 @@ int main(int argc, char** argv)
   try
   {
     SafeMain(argc, argv);
+    AL_Trace_Deinit();
     return 0;
   }
   catch(codec_error const& error)
@@ -543,3 +543,46 @@ int WriteStream(std::ofstream& HEVCFile, AL_TBuffer* pStream)
   return iNumFrame;
 }
 
+/*****************************************************************************/
+static void AddChunk(std::vector<TStreamChunk>& Chunks, uint8_t* pData, size_t zSize)
+{
+  if(!Chunks.empty() && Chunks.back().pData + Chunks.back().zSize == pData)
+  {
+    Chunks.back().zSize += zSize;
+    return;
+  }
+
+  Chunks.push_back({ pData, zSize });
+}
+
+/*****************************************************************************/
+int GatherStream(AL_TBuffer* pStream, std::vector<TStreamChunk>& Chunks)
+{
+  AL_TStreamMetaData* pStreamMeta = (AL_TStreamMetaData*)AL_Buffer_GetMetaData(pStream, AL_META_TYPE_STREAM);
+  uint8_t* pData = AL_Buffer_GetData(pStream);
+  int iNumFrame = 0;
+
+  for(int i = 0; i < pStreamMeta->uNumSection; ++i)
+  {
+    AL_TStreamSection* pCurSection = &pStreamMeta->pSections[i];
+
+    if(pCurSection->uFlags & SECTION_END_FRAME_FLAG)
+      ++iNumFrame;
+
+    if(!pCurSection->uLength)
+      continue;
+
+    uint32_t uRemSize = pStream->zSize - pCurSection->uOffset;
+
+    if(uRemSize < pCurSection->uLength)
+    {
+      AddChunk(Chunks, pData + pCurSection->uOffset, uRemSize);
+      AddChunk(Chunks, pData, pCurSection->uLength - uRemSize);
+    }
+    else
+      AddChunk(Chunks, pData + pCurSection->uOffset, pCurSection->uLength);
+  }
+
+  return iNumFrame;
+}
+
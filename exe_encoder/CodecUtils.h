@@ -40,6 +40,7 @@
 #include <fstream>
 #include <string>
 #include <stdexcept>
+#include <vector>
 #include "lib_app/console.h"
 #include "lib_app/InputFiles.h"
 
@@ -80,6 +81,19 @@ void WriteOneSection(std::ofstream& File, AL_TBuffer* pStream, int iSection);
 /*****************************************************************************/
 int WriteStream(std::ofstream& HEVCFile, AL_TBuffer* pStream);
 
+/*****************************************************************************/
+struct TStreamChunk
+{
+  uint8_t* pData;
+  size_t zSize;
+};
+
+/*****************************************************************************/
+/* Appends the bytes of the sections of pStream to Chunks, in the order
+ * WriteStream writes them: a wrapped section gives two chunks, contiguous
+ * sections are merged. Returns the number of frames ended in pStream */
+int GatherStream(AL_TBuffer* pStream, std::vector<TStreamChunk>& Chunks);
+
 /*****************************************************************************/
 void DisplayFrameStatus(int iFrameNum);
 
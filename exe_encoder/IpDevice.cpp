@@ -50,6 +50,13 @@ extern "C"
 
 using namespace std;
 
+CIpDevice::~CIpDevice()
+{
+  /* the scheduler uses the driver and the allocator */
+  if(m_pScheduler)
+    AL_ISchedulerEnc_Destroy(m_pScheduler);
+}
+
 AL_TAllocator* createDmaAllocator(const char* deviceName)
 {
   auto h = DmaAlloc_Create(deviceName);
@@ -64,6 +71,8 @@ extern "C"
 {
 #include "lib_encode/SchedulerMcu.h"
 #include "lib_encode/hardwareDriver.h"
+#include "lib_encode/simulatedDriver.h"
+#include "lib_fpga/DmaAllocSim.h"
 }
 
 static unique_ptr<CIpDevice> createMcuIpDevice()
@@ -83,8 +92,30 @@ static unique_ptr<CIpDevice> createMcuIpDevice()
   return device;
 }
 
+static unique_ptr<CIpDevice> createSimIpDevice(AL_TSimDeviceSettings const& tSimSettings)
+{
+  auto device = make_unique<CIpDevice>();
+
+  device->m_pAllocator.reset(DmaAllocSim_Create(), &AL_Allocator_Destroy);
+
+  if(!device->m_pAllocator)
+    throw runtime_error("Can't create the simulated DMA allocator");
+
+  device->m_pDriver.reset(AL_SimulatedDriver_Create(device->m_pAllocator.get(), &tSimSettings), &AL_SimulatedDriver_Destroy);
+
+  if(!device->m_pDriver)
+    throw runtime_error("Failed to create the simulated MCU");
 
-shared_ptr<CIpDevice> CreateIpDevice(bool bUseRefSoftware, int iSchedulerType, AL_TEncSettings& Settings, function<AL_TIpCtrl* (AL_TIpCtrl*)> wrapIpCtrl, bool trackDma, int eVqDescr)
+  device->m_pScheduler = AL_SchedulerMcu_Create(device->m_pDriver.get(), device->m_pAllocator.get());
+
+  if(!device->m_pScheduler)
+    throw std::runtime_error("Failed to create MCU scheduler");
+
+  return device;
+}
+
+
+shared_ptr<CIpDevice> CreateIpDevice(bool bUseRefSoftware, int iSchedulerType, AL_TEncSettings& Settings, function<AL_TIpCtrl* (AL_TIpCtrl*)> wrapIpCtrl, bool trackDma, int eVqDescr, AL_TSimDeviceSettings tSimSettings)
 {
   (void)bUseRefSoftware, (void)Settings, (void)wrapIpCtrl, (void)eVqDescr, (void)trackDma;
 
@@ -93,6 +124,9 @@ shared_ptr<CIpDevice> CreateIpDevice(bool bUseRefSoftware, int iSchedulerType, A
   if(iSchedulerType == SCHEDULER_TYPE_MCU)
     return createMcuIpDevice();
 
+  if(iSchedulerType == SCHEDULER_TYPE_SIM)
+    return createSimIpDevice(tSimSettings);
+
   throw runtime_error("No support for this scheduling type");
 }
 
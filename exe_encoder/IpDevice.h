@@ -45,17 +45,22 @@ extern "C"
 {
 #include "lib_common_enc/Settings.h"
 #include "lib_encode/lib_encoder.h"
+#include "lib_common/SimDevice.h"
 }
 
 typedef struct AL_t_Allocator AL_TAllocator;
 typedef struct AL_t_IpCtrl AL_TIpCtrl;
+typedef struct t_driver Driver;
 
 /*****************************************************************************/
 struct CIpDevice
 {
+  ~CIpDevice();
+
   TScheduler* m_pScheduler = nullptr;
   std::shared_ptr<AL_TAllocator> m_pAllocator;
+  std::shared_ptr<Driver> m_pDriver; // only set for the simulated MCU
 };
 
-std::shared_ptr<CIpDevice> CreateIpDevice(bool bUseRefSoftware, int iSchedulerType, AL_TEncSettings& Settings, std::function<AL_TIpCtrl* (AL_TIpCtrl*)> wrapIpCtrl, bool trackDma = false, int iVqDescr = 0);
+std::shared_ptr<CIpDevice> CreateIpDevice(bool bUseRefSoftware, int iSchedulerType, AL_TEncSettings& Settings, std::function<AL_TIpCtrl* (AL_TIpCtrl*)> wrapIpCtrl, bool trackDma = false, int iVqDescr = 0, AL_TSimDeviceSettings tSimSettings = {});
 
@@ -54,6 +54,10 @@
 
 #include "lib_app/console.h"
 #include "lib_app/utils.h"
+#include "lib_app/convert_scheduler.h"
+#include "lib_app/StageReport.h"
+#include "lib_app/TraceExport.h"
+#include "lib_app/timing.h"
 
 #include "CodecUtils.h"
 #include "sink.h"
@@ -79,12 +83,20 @@ extern "C"
 
 #include "sink_encoder.h"
 #include "sink_bitstream_writer.h"
+#include "sink_async_bitstream_writer.h"
 #include "sink_frame_writer.h"
 #include "sink_md5.h"
 #include "sink_repeater.h"
 #include "QPGenerator.h"
+#include "lib_app/read_ahead.h"
 
 int g_numFrameToRepeat;
+int g_poolMagazineSize;
+bool g_poolStats;
+AL_TSimDeviceSettings g_simSettings;
+string g_benchJson;
+bool g_asyncOutput;
+int g_readAhead;
 
 using namespace std;
 
@@ -234,10 +246,22 @@ void ParseCommandLine(int argc, char** argv, ConfigFile& cfg)
   opt.addInt("--max-picture", &cfg.RunInfo.iMaxPict, "Maximum number of pictures encoded (1,2 .. -1 for ALL)");
   opt.addInt("--num-slices", &cfg.Settings.tChParam.uNumSlices, "Specify the number of slices to use");
   opt.addInt("--num-core", &cfg.Settings.tChParam.uNumCore, "Specify the number of cores to use (resolution needs to be sufficient)");
-  opt.addString("--log", &cfg.RunInfo.logsFile, "A file where log event will be dumped");
+  opt.addString("--log", &cfg.RunInfo.logsFile, "A file where the trace of the encoding events will be dumped (chrome trace json)");
   opt.addFlag("--loop", &cfg.RunInfo.bLoop, "loop at the end of the yuv file");
 
   opt.addInt("--prefetch", &g_numFrameToRepeat, "prefetch n frames and loop between these frames for max picture count");
+  opt.addInt("--pool-magazine", &g_poolMagazineSize, "Number of free source buffers each thread keeps at hand (0: disabled)");
+  opt.addInt("--read-ahead", &g_readAhead, "Read and convert the input n frames ahead of the encoder, on a dedicated thread (0: disabled)");
+  opt.addFlag("--pool-stats", &g_poolStats, "Print the source buffer pool statistics at the end of the encoding");
+  opt.addFlag("--sim-mcu", &cfg.RunInfo.iSchedulerType, "Complete the encoding jobs on a software stand-in for the MCU: the frames are not encoded", SCHEDULER_TYPE_SIM);
+  opt.addInt("--sim-latency", &g_simSettings.uLatency, "Latency of the simulated MCU jobs, in microseconds");
+  opt.addInt("--sim-rate", &g_simSettings.uJobsPerSecond, "Number of frames the simulated MCU encodes per second (0: no limit)");
+  opt.addFlag("--async-output", &g_asyncOutput, "Write the bitstream from a dedicated thread, with one gather write per stream buffer");
+  opt.addString("--bench-json", &g_benchJson, "A file where the host cpu time and latency of each encoding stage will be dumped (json)");
+  opt.addOption("--conv-threads", [&]()
+  {
+    SetConversionThreads(opt.popInt());
+  }, "Number of threads used by the input YUV conversion (0: one per cpu, default: 1)");
   opt.parse(argc, argv);
 
   if(help)
@@ -364,11 +388,18 @@ shared_ptr<AL_TBuffer> ReadSourceFrame(AL_TBufPool* pBufPool, AL_TBuffer* conver
   shared_ptr<AL_TBuffer> sourceBuffer(AL_BufPool_GetBuffer(pBufPool, AL_BUF_MODE_BLOCK), &AL_Buffer_Unref);
   assert(sourceBuffer);
 
-  if(!ReadOneFrameYuv(YuvFile, hConv ? conversionBuffer : sourceBuffer.get(), cfg.RunInfo.bLoop))
-    return nullptr;
+  {
+    StageScope fileRead(AL_STAGE_FILE_READ);
+
+    if(!ReadOneFrameYuv(YuvFile, hConv ? conversionBuffer : sourceBuffer.get(), cfg.RunInfo.bLoop))
+      return nullptr;
+  }
 
   if(hConv)
+  {
+    StageScope conversion(AL_STAGE_CONVERSION);
     hConv->ConvertSrcBuf(AL_GET_BITDEPTH(cfg.Settings.tChParam.ePicFormat), conversionBuffer, sourceBuffer.get());
+  }
 
   return sourceBuffer;
 }
@@ -384,6 +415,16 @@ bool isLastPict(int iPictCount, int iMaxPict)
   return (iPictCount >= iMaxPict) && (iMaxPict != -1);
 }
 
+/******************************************************************************/
+static void PrintPoolStats(char const* sName, AL_TBufPool* pPool)
+{
+  AL_TBufPoolStats tStats;
+  AL_BufPool_GetStats(pPool, &tStats);
+  Message(CC_DEFAULT, "%s pool: %d hits, %d misses, %d waits, %d buffers used at most\n",
+          sName, tStats.iHits, tStats.iMisses, tStats.iWaits, tStats.iHighWater);
+}
+
+/******************************************************************************/
 int sendInputFileTo(string YUVFileName, BufPool& SrcBufPool, AL_TBuffer* Yuv, ConfigFile const& cfg, IConvSrc* pSrcConv, IFrameSink* sink)
 {
   ifstream YuvFile;
@@ -391,21 +432,35 @@ int sendInputFileTo(string YUVFileName, BufPool& SrcBufPool, AL_TBuffer* Yuv, Co
 
   GotoFirstPicture(cfg.FileInfo, YuvFile, cfg.RunInfo.iFirstPict);
 
-  int iPictCount = 0;
+  int iReadPictCount = 0;
   int iReadCount = 0;
 
-  while(true)
-  {
-    shared_ptr<AL_TBuffer> frame;
+  auto readFrame = [&]() -> shared_ptr<AL_TBuffer>
+                   {
+                     if(isLastPict(iReadPictCount, cfg.RunInfo.iMaxPict))
+                       return nullptr;
 
-    if(!isLastPict(iPictCount, cfg.RunInfo.iMaxPict))
-    {
-      if(cfg.FileInfo.FrameRate != cfg.Settings.tChParam.tRCParam.uFrameRate)
-        iReadCount += GotoNextPicture(cfg.FileInfo, YuvFile, cfg.Settings.tChParam.tRCParam.uFrameRate, iPictCount, iReadCount);
+                     if(cfg.FileInfo.FrameRate != cfg.Settings.tChParam.tRCParam.uFrameRate)
+                       iReadCount += GotoNextPicture(cfg.FileInfo, YuvFile, cfg.Settings.tChParam.tRCParam.uFrameRate, iReadPictCount, iReadCount);
 
-      frame = ReadSourceFrame(&SrcBufPool, Yuv, YuvFile, cfg, pSrcConv);
-      iReadCount++;
-    }
+                     auto frame = ReadSourceFrame(&SrcBufPool, Yuv, YuvFile, cfg, pSrcConv);
+                     iReadCount++;
+
+                     if(frame)
+                       iReadPictCount++;
+                     return frame;
+                   };
+
+  unique_ptr<ReadAhead> readAhead;
+
+  if(g_readAhead > 0)
+    readAhead.reset(new ReadAhead(readFrame, g_readAhead));
+
+  int iPictCount = 0;
+
+  while(true)
+  {
+    auto frame = readAhead ? readAhead->Next() : readFrame();
 
     sink->ProcessFrame(frame.get());
 
@@ -462,7 +517,7 @@ void SafeMain(int argc, char** argv)
     break;
   }
 
-  auto pIpDevice = CreateIpDevice(!RunInfo.bUseBoard, RunInfo.iSchedulerType, Settings, wrapIpCtrl, RunInfo.trackDma, RunInfo.eVQDescr);
+  auto pIpDevice = CreateIpDevice(!RunInfo.bUseBoard, RunInfo.iSchedulerType, Settings, wrapIpCtrl, RunInfo.trackDma, RunInfo.eVQDescr, g_simSettings);
 
   if(!pIpDevice)
     throw runtime_error("Can't create IpDevice");
@@ -477,7 +532,7 @@ void SafeMain(int argc, char** argv)
   auto pAllocator = pIpDevice->m_pAllocator.get();
   auto pScheduler = pIpDevice->m_pScheduler;
 
-  AL_TBufPoolConfig StreamBufPoolConfig;
+  AL_TBufPoolConfig StreamBufPoolConfig {};
 
   auto numStreams = 2 + 2 + Settings.tChParam.tGopParam.uNumB;
   AL_TDimension dim = { FileInfo.PictWidth, FileInfo.PictHeight };
@@ -518,7 +573,17 @@ void SafeMain(int argc, char** argv)
 
   enc.reset(new EncoderSink(cfg, pScheduler, pAllocator, QpBufPool));
 
-  enc->BitstreamOutput = createBitstreamWriter(StreamFileName, cfg);
+  if(g_asyncOutput)
+  {
+    auto pEnc = enc.get();
+    enc->BitstreamOutput = createAsyncBitstreamWriter(StreamFileName, cfg, [pEnc](AL_TBuffer* pStream) {
+      pEnc->ReleaseStream(pStream);
+    });
+    enc->BitstreamOutputReleasesStream = true;
+  }
+  else
+    enc->BitstreamOutput = createBitstreamWriter(StreamFileName, cfg);
+
   enc->m_done = ([&]() {
     Rtos_SetEvent(hFinished);
   });
@@ -595,11 +660,13 @@ void SafeMain(int argc, char** argv)
 
   AL_TBufPoolConfig poolConfig {};
 
-  poolConfig.uNumBuf = frameBuffersCount;
+  /* the frames read ahead wait in the source pool buffers */
+  poolConfig.uNumBuf = frameBuffersCount + max(g_readAhead, 0);
   poolConfig.zBufSize = pSrcConv->GetConvBufSize();
 
   poolConfig.pMetaData = (AL_TMetaData*)AL_SrcMetaData_Create({ FrameInfo.iWidth, FrameInfo.iHeight }, p, tOffsetYC, FourCC);
   poolConfig.debugName = "src";
+  poolConfig.uMagazineSize = g_poolMagazineSize;
 
   bool ret = AL_BufPool_Init(&SrcBufPool, pAllocator, &poolConfig);
   assert(ret);
@@ -607,10 +674,23 @@ void SafeMain(int argc, char** argv)
   if(!shouldConvert)
     pSrcConv.reset(nullptr);
 
-  sendInputFileTo(cfg.YUVFileName, SrcBufPool, SrcYuv.get(), cfg, pSrcConv.get(), firstSink);
+  AL_StageStats_Enable(!g_benchJson.empty());
+  AL_Trace_Enable(!RunInfo.logsFile.empty());
+  auto const uBegin = GetPerfTime();
+
+  int iNumFrames = sendInputFileTo(cfg.YUVFileName, SrcBufPool, SrcYuv.get(), cfg, pSrcConv.get(), firstSink);
 
   Rtos_WaitEvent(hFinished, AL_WAIT_FOREVER);
 
+  if(!g_benchJson.empty())
+    WriteStageReport(g_benchJson, "encoder", iNumFrames, (GetPerfTime() - uBegin) / 1000.0);
+
+  if(!RunInfo.logsFile.empty())
+    WriteChromeTrace(RunInfo.logsFile);
+
+  if(g_poolStats)
+    PrintPoolStats("src", &SrcBufPool);
+
   if(auto err = GetEncoderLastError())
     throw codec_error(EncoderErrorToString(err), err);
 }
@@ -622,6 +702,7 @@ int main(int argc, char** argv)
   try
   {
     SafeMain(argc, argv);
+    AL_Trace_Deinit();
     return 0;
   }
   catch(codec_error const& error)
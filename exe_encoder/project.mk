@@ -5,6 +5,7 @@ EXE_ENCODER_SRCS:=\
   $(THIS_EXE_ENCODER)/IpDevice.cpp\
   $(THIS_EXE_ENCODER)/main.cpp\
   $(THIS_EXE_ENCODER)/sink_bitstream_writer.cpp\
+  $(THIS_EXE_ENCODER)/sink_async_bitstream_writer.cpp\
   $(THIS_EXE_ENCODER)/sink_frame_writer.cpp\
   $(THIS_EXE_ENCODER)/sink_md5.cpp\
   $(THIS_EXE_ENCODER)/MD5.cpp\
@@ -0,0 +1,516 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include "sink_async_bitstream_writer.h"
+#include "lib_cfg/lib_cfg.h"
+#include "lib_app/utils.h" // OpenOutput
+#include "lib_app/StageReport.h"
+#include "CodecUtils.h" // GatherStream
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <linux/io_uring.h>
+#endif
+
+using namespace std;
+
+/****************************************************************************/
+struct TWriteBatch
+{
+  AL_TBuffer* pStream;
+  vector<TStreamChunk> chunks;
+  size_t zSize;
+  uint64_t uOffset; // position of the batch in the file
+};
+
+/****************************************************************************/
+/* Writes batches at their position in the file, returns once all of them are written */
+struct IGatherWriter
+{
+  virtual ~IGatherWriter() {}
+  virtual int MaxBatches() = 0;
+  virtual void Write(vector<TWriteBatch*> const& batches) = 0;
+};
+
+#ifdef __linux__
+/****************************************************************************/
+static void WriteAt(int fd, TWriteBatch const& batch, size_t zDone)
+{
+  uint64_t uOffset = batch.uOffset;
+
+  for(auto& chunk : batch.chunks)
+  {
+    size_t zSkip = min(zDone, chunk.zSize);
+    zDone -= zSkip;
+    uOffset += zSkip;
+
+    while(zSkip < chunk.zSize)
+    {
+      ssize_t zWritten = pwrite(fd, chunk.pData + zSkip, chunk.zSize - zSkip, uOffset);
+
+      if(zWritten < 0 && errno == EINTR)
+        continue;
+
+      if(zWritten <= 0)
+        throw runtime_error(string("Can't write the bitstream: ") + strerror(errno));
+
+      zSkip += zWritten;
+      uOffset += zWritten;
+    }
+  }
+}
+
+/****************************************************************************/
+static vector<iovec> ToIovec(TWriteBatch const& batch)
+{
+  vector<iovec> iovecs;
+
+  for(auto& chunk : batch.chunks)
+    iovecs.push_back({ chunk.pData, chunk.zSize });
+
+  return iovecs;
+}
+
+/****************************************************************************/
+class WritevWriter : public IGatherWriter
+{
+public:
+  explicit WritevWriter(int fd) : m_fd(fd) {}
+
+  int MaxBatches() override { return 16; }
+
+  void Write(vector<TWriteBatch*> const& batches) override
+  {
+    for(auto pBatch : batches)
+    {
+      auto iovecs = ToIovec(*pBatch);
+      ssize_t zWritten = -1;
+
+      if(iovecs.size() <= IOV_MAX)
+      {
+        do
+        {
+          zWritten = pwritev(m_fd, iovecs.data(), iovecs.size(), pBatch->uOffset);
+        }
+        while(zWritten < 0 && errno == EINTR);
+      }
+
+      /* short writes and huge batches are completed chunk by chunk */
+      if(zWritten < (ssize_t)pBatch->zSize)
+        WriteAt(m_fd, *pBatch, max<ssize_t>(zWritten, 0));
+    }
+  }
+
+private:
+  int const m_fd;
+};
+
+/****************************************************************************/
+class UringWriter : public IGatherWriter
+{
+public:
+  static UringWriter* Create(int fd)
+  {
+    auto pWriter = new UringWriter(fd);
+
+    if(!pWriter->Setup())
+    {
+      delete pWriter;
+      return nullptr;
+    }
+    return pWriter;
+  }
+
+  ~UringWriter()
+  {
+    if(m_pSqes)
+      munmap(m_pSqes, m_zSqesSize);
+
+    if(m_pCqRing && m_pCqRing != m_pSqRing)
+      munmap(m_pCqRing, m_zCqRingSize);
+
+    if(m_pSqRing)
+      munmap(m_pSqRing, m_zSqRingSize);
+
+    if(m_iRing >= 0)
+      close(m_iRing);
+  }
+
+  int MaxBatches() override { return m_uNumEntries; }
+
+  void Write(vector<TWriteBatch*> const& batches) override
+  {
+    vector<vector<iovec>> iovecs(batches.size());
+    unsigned uTail = *m_pSqTail;
+    int iNumSubmitted = 0;
+
+    for(size_t i = 0; i < batches.size(); ++i)
+    {
+      iovecs[i] = ToIovec(*batches[i]);
+
+      if(iovecs[i].size() > IOV_MAX)
+        continue;
+
+      unsigned uIndex = uTail & *m_pSqMask;
+      io_uring_sqe* pSqe = &m_pSqes[uIndex];
+      memset(pSqe, 0, sizeof(*pSqe));
+      pSqe->opcode = IORING_OP_WRITEV;
+      pSqe->fd = m_fd;
+      pSqe->addr = (uintptr_t)iovecs[i].data();
+      pSqe->len = iovecs[i].size();
+      pSqe->off = batches[i]->uOffset;
+      pSqe->user_data = i;
+      m_pSqArray[uIndex] = uIndex;
+      ++uTail;
+      ++iNumSubmitted;
+    }
+
+    __atomic_store_n(m_pSqTail, uTail, __ATOMIC_RELEASE);
+
+    vector<ssize_t> results(batches.size(), 0);
+    int iNumToSubmit = iNumSubmitted;
+    int iNumCompleted = 0;
+
+    while(iNumCompleted < iNumSubmitted)
+    {
+      int iRet = syscall(__NR_io_uring_enter, m_iRing, iNumToSubmit, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+
+      if(iRet < 0)
+      {
+        if(errno == EINTR)
+          continue;
+        throw runtime_error(string("io_uring_enter failed: ") + strerror(errno));
+      }
+
+      iNumToSubmit -= iRet;
+
+      unsigned uHead = *m_pCqHead;
+
+      while(uHead != __atomic_load_n(m_pCqTail, __ATOMIC_ACQUIRE))
+      {
+        io_uring_cqe* pCqe = &m_pCqes[uHead & *m_pCqMask];
+        results[pCqe->user_data] = pCqe->res;
+        ++uHead;
+        ++iNumCompleted;
+      }
+
+      __atomic_store_n(m_pCqHead, uHead, __ATOMIC_RELEASE);
+    }
+
+    /* short writes, errors and huge batches are completed chunk by chunk */
+    for(size_t i = 0; i < batches.size(); ++i)
+    {
+      if(results[i] < (ssize_t)batches[i]->zSize)
+        WriteAt(m_fd, *batches[i], max<ssize_t>(results[i], 0));
+    }
+  }
+
+private:
+  explicit UringWriter(int fd) : m_fd(fd) {}
+
+  bool Setup()
+  {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    m_iRing = syscall(__NR_io_uring_setup, 16, &params);
+
+    if(m_iRing < 0)
+      return false;
+
+    m_uNumEntries = params.sq_entries;
+    m_zSqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    m_zCqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+    bool const bSingleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+
+    if(bSingleMmap)
+      m_zSqRingSize = m_zCqRingSize = max(m_zSqRingSize, m_zCqRingSize);
+
+    m_pSqRing = Map(m_zSqRingSize, IORING_OFF_SQ_RING);
+    m_pCqRing = bSingleMmap ? m_pSqRing : Map(m_zCqRingSize, IORING_OFF_CQ_RING);
+    m_zSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    m_pSqes = (io_uring_sqe*)Map(m_zSqesSize, IORING_OFF_SQES);
+
+    if(!m_pSqRing || !m_pCqRing || !m_pSqes)
+      return false;
+
+    m_pSqTail = (unsigned*)(m_pSqRing + params.sq_off.tail);
+    m_pSqMask = (unsigned*)(m_pSqRing + params.sq_off.ring_mask);
+    m_pSqArray = (unsigned*)(m_pSqRing + params.sq_off.array);
+    m_pCqHead = (unsigned*)(m_pCqRing + params.cq_off.head);
+    m_pCqTail = (unsigned*)(m_pCqRing + params.cq_off.tail);
+    m_pCqMask = (unsigned*)(m_pCqRing + params.cq_off.ring_mask);
+    m_pCqes = (io_uring_cqe*)(m_pCqRing + params.cq_off.cqes);
+
+    return true;
+  }
+
+  uint8_t* Map(size_t zSize, off_t offset)
+  {
+    void* p = mmap(NULL, zSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_iRing, offset);
+    return p == MAP_FAILED ? nullptr : (uint8_t*)p;
+  }
+
+  int const m_fd;
+  int m_iRing = -1;
+  int m_uNumEntries = 0;
+
+  uint8_t* m_pSqRing = nullptr;
+  uint8_t* m_pCqRing = nullptr;
+  io_uring_sqe* m_pSqes = nullptr;
+  size_t m_zSqRingSize = 0;
+  size_t m_zCqRingSize = 0;
+  size_t m_zSqesSize = 0;
+
+  unsigned* m_pSqTail = nullptr;
+  unsigned* m_pSqMask = nullptr;
+  unsigned* m_pSqArray = nullptr;
+  unsigned* m_pCqHead = nullptr;
+  unsigned* m_pCqTail = nullptr;
+  unsigned* m_pCqMask = nullptr;
+  io_uring_cqe* m_pCqes = nullptr;
+};
+#else
+/****************************************************************************/
+class StreamWriter : public IGatherWriter
+{
+public:
+  explicit StreamWriter(string path)
+  {
+    OpenOutput(m_file, path);
+  }
+
+  int MaxBatches() override { return 16; }
+
+  /* the batches are given in file order */
+  void Write(vector<TWriteBatch*> const& batches) override
+  {
+    for(auto pBatch : batches)
+    {
+      for(auto& chunk : pBatch->chunks)
+        m_file.write((char*)chunk.pData, chunk.zSize);
+    }
+  }
+
+private:
+  ofstream m_file;
+};
+#endif
+
+/****************************************************************************/
+struct AsyncBitstreamWriter : IFrameSink
+{
+  AsyncBitstreamWriter(string path, ConfigFile const& cfg_, function<void(AL_TBuffer*)> releaseStream) : cfg(cfg_), m_releaseStream(releaseStream)
+  {
+#ifdef __linux__
+    m_fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if(m_fd < 0)
+      throw runtime_error("Can't open file for writing: '" + path + "'");
+
+    m_writer.reset(UringWriter::Create(m_fd));
+
+    if(!m_writer)
+      m_writer.reset(new WritevWriter(m_fd));
+#else
+    m_writer.reset(new StreamWriter(path));
+#endif
+
+    m_thread = thread(&AsyncBitstreamWriter::WriterLoop, this);
+  }
+
+  ~AsyncBitstreamWriter()
+  {
+    {
+      lock_guard<mutex> lock(m_mutex);
+      m_bExit = true;
+    }
+    m_batchReady.notify_all();
+    m_thread.join();
+
+    m_writer.reset();
+#ifdef __linux__
+    close(m_fd);
+#endif
+  }
+
+  void ProcessFrame(AL_TBuffer* pStream) override
+  {
+    if(pStream == EndOfStream)
+    {
+      unique_lock<mutex> lock(m_mutex);
+      m_allWritten.wait(lock, [&]() { return m_batches.empty() && !m_iNumWriting; });
+      CheckError();
+      printBitrate();
+      return;
+    }
+
+    {
+      lock_guard<mutex> lock(m_mutex);
+      CheckError();
+    }
+
+    auto pBatch = new TWriteBatch;
+    pBatch->pStream = pStream;
+    m_frameCount += GatherStream(pStream, pBatch->chunks);
+    pBatch->zSize = 0;
+
+    for(auto& chunk : pBatch->chunks)
+      pBatch->zSize += chunk.zSize;
+
+    pBatch->uOffset = m_uFileSize;
+    m_uFileSize += pBatch->zSize;
+
+    /* the encoder releases its reference once the callback returns */
+    AL_Buffer_Ref(pStream);
+
+    {
+      lock_guard<mutex> lock(m_mutex);
+      m_batches.push_back(pBatch);
+    }
+    m_batchReady.notify_one();
+  }
+
+  void printBitrate()
+  {
+    auto const outputSizeInBits = m_uFileSize * 8;
+    auto const frameRate = (float)cfg.Settings.tChParam.tRCParam.uFrameRate / cfg.Settings.tChParam.tRCParam.uClkRatio;
+    auto const durationInSeconds = m_frameCount / frameRate;
+    auto bitrate = outputSizeInBits / durationInSeconds;
+    Message(CC_DEFAULT, "\nAchieved bitrate = %.4f Kbps\n", (float)bitrate);
+  }
+
+private:
+  /* m_mutex must be held */
+  void CheckError()
+  {
+    if(m_error)
+      rethrow_exception(m_error);
+  }
+
+  void WriterLoop()
+  {
+    unique_lock<mutex> lock(m_mutex);
+
+    while(true)
+    {
+      m_batchReady.wait(lock, [&]() { return m_bExit || !m_batches.empty(); });
+
+      if(m_batches.empty())
+        return;
+
+      vector<TWriteBatch*> batches;
+
+      while(!m_batches.empty() && (int)batches.size() < m_writer->MaxBatches())
+      {
+        batches.push_back(m_batches.front());
+        m_batches.pop_front();
+      }
+
+      m_iNumWriting = batches.size();
+      lock.unlock();
+
+      exception_ptr error;
+
+      try
+      {
+        StageScope writeOut(AL_STAGE_WRITE_OUT);
+        m_writer->Write(batches);
+      }
+      catch(...)
+      {
+        error = current_exception();
+      }
+
+      for(auto pBatch : batches)
+      {
+        m_releaseStream(pBatch->pStream);
+        AL_Buffer_Unref(pBatch->pStream);
+        delete pBatch;
+      }
+
+      lock.lock();
+
+      if(!m_error)
+        m_error = error;
+
+      m_iNumWriting = 0;
+      m_allWritten.notify_all();
+    }
+  }
+
+  ConfigFile const cfg;
+  function<void(AL_TBuffer*)> const m_releaseStream;
+  int m_frameCount = 0;
+  uint64_t m_uFileSize = 0;
+
+#ifdef __linux__
+  int m_fd = -1;
+#endif
+  unique_ptr<IGatherWriter> m_writer;
+
+  mutex m_mutex;
+  condition_variable m_batchReady;
+  condition_variable m_allWritten;
+  deque<TWriteBatch*> m_batches;
+  int m_iNumWriting = 0;
+  bool m_bExit = false;
+  exception_ptr m_error;
+  thread m_thread;
+};
+
+unique_ptr<IFrameSink> createAsyncBitstreamWriter(string path, ConfigFile const& cfg, function<void(AL_TBuffer*)> releaseStream)
+{
+  return unique_ptr<IFrameSink>(new AsyncBitstreamWriter(path, cfg, releaseStream));
+}
+
@@ -39,6 +39,7 @@
 #include "lib_cfg/lib_cfg.h"
 #include "lib_app/utils.h" // OpenOutput
 #include "lib_app/InputFiles.h"
+#include "lib_app/StageReport.h"
 #include "CodecUtils.h" // WriteStream
 #include <fstream>
 
@@ -65,6 +66,7 @@ struct BitstreamWriter : IFrameSink
       return;
     }
 
+    StageScope writeOut(AL_STAGE_WRITE_OUT);
     m_frameCount += WriteStream(m_file, pStream);
   }
 
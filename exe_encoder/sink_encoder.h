@@ -38,6 +38,7 @@
 #pragma once
 
 #include "lib_app/timing.h"
+#include "lib_app/StageReport.h"
 #include "QPGenerator.h"
 
 static bool PreprocessQP(uint8_t* pQPs, const AL_TEncSettings& Settings, int iFrameCountSent)
@@ -246,6 +247,8 @@ struct EncoderSink : IFrameSink
     Message(CC_DEFAULT, "\n\n%d pictures encoded. Average FrameRate = %.4f Fps\n",
             m_picCount, (m_picCount * 1000.0) / (m_EndTime - m_StartTime));
 
+    /* an asynchronous output gives its stream buffers back before the encoder goes away */
+    BitstreamOutput.reset();
     AL_Encoder_Destroy(hEnc);
   }
 
@@ -271,8 +274,12 @@ struct EncoderSink : IFrameSink
       QpBuf = qpBuffers.getBuffer(m_picCount);
     }
 
-    if(!AL_Encoder_Process(hEnc, Src, QpBuf))
-      throw runtime_error("Failed");
+    {
+      StageScope process(AL_STAGE_PROCESS);
+
+      if(!AL_Encoder_Process(hEnc, Src, QpBuf))
+        throw runtime_error("Failed");
+    }
 
     qpBuffers.releaseBuffer(QpBuf);
 
@@ -284,6 +291,15 @@ struct EncoderSink : IFrameSink
   unique_ptr<IFrameSink> BitstreamOutput;
   AL_HEncoder hEnc;
 
+  /* set when BitstreamOutput gives the stream buffers back itself, with ReleaseStream */
+  bool BitstreamOutputReleasesStream = false;
+
+  void ReleaseStream(AL_TBuffer* pStream)
+  {
+    auto bRet = AL_Encoder_PutStreamBuffer(hEnc, pStream);
+    assert(bRet);
+  }
+
 private:
   int m_picCount = 0;
   uint64_t m_StartTime = 0;
@@ -319,11 +335,8 @@ private:
 
     BitstreamOutput->ProcessFrame(pStream);
 
-    if(pStream)
-    {
-      auto bRet = AL_Encoder_PutStreamBuffer(hEnc, pStream);
-      assert(bRet);
-    }
+    if(pStream && !BitstreamOutputReleasesStream)
+      ReleaseStream(pStream);
 
     TRecPic RecPic;
 
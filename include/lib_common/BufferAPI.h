@@ -86,6 +86,30 @@ AL_TBuffer* AL_Buffer_WrapData(uint8_t* pData, size_t zSize, PFN_RefCount_CallBa
 *****************************************************************************/
 void AL_Buffer_Destroy(AL_TBuffer* pBuf);
 
+/*************************************************************************//*!
+   \brief Number of objects of one type currently allocated
+*****************************************************************************/
+typedef struct
+{
+  int32_t iNumLive; /*!< objects created and not destroyed yet */
+  int32_t iNumPeak; /*!< maximum of iNumLive since the start of the process */
+}AL_TObjectCounter;
+
+typedef struct
+{
+  AL_TObjectCounter tBuffers;
+  AL_TObjectCounter tSrcMetaData;
+  AL_TObjectCounter tCircMetaData;
+  AL_TObjectCounter tStreamMetaData;
+}AL_TBufferObjectCounters;
+
+/*************************************************************************//*!
+   \brief AL_Buffer_GetObjectCounters: Get the number of live buffers and metadata.
+   A count that keeps growing while the stream is processed shows a leak.
+   \param[out] pCounters Filled with the counters of each object type
+*****************************************************************************/
+void AL_Buffer_GetObjectCounters(AL_TBufferObjectCounters* pCounters);
+
 /*************************************************************************//*!
    \brief AL_Buffer_Ref: Tell that we are using this buffer
    \param[in] pBuf Pointer to an AL_TBuffer
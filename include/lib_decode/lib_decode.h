@@ -72,6 +72,10 @@ typedef struct
 /*************************************************************************//*!
    \brief Display callback definition.
    a null frame indicates the end of the stream
+   With the MCU decoder channel, this callback and the decoded callback can be
+   called from a thread shared by all the channels of the process: they must
+   return quickly and not wait for another channel. Writing or converting the
+   frame belongs to a thread of the application.
 *****************************************************************************/
 typedef struct
 {
@@ -97,9 +101,20 @@ typedef struct
 *****************************************************************************/
 typedef AL_HANDLE AL_HDecoder;
 
+/*************************************************************************//*!
+   \brief Start code detection backend
+*****************************************************************************/
+typedef enum AL_e_ScdMode
+{
+  AL_SCD_IP,       // !< Start codes are searched by the IP through the decoder channel
+  AL_SCD_SOFTWARE, // !< Start codes are searched by the CPU in the stream buffer
+  AL_SCD_MAX_ENUM,
+}AL_EScdMode;
+
 typedef struct
 {
   int iStackSize;        // !< Size of the command stack handled by the decoder
+  int iLookahead;        // !< Number of access units parsed ahead of the command stack, in access unit latency mode
   int iBitDepth;         // !< Output BitDepth
   uint8_t uNumCore;           // !< Number of hevc decoder core used for the decoding
   uint32_t uFrameRate;        // !< User Frame Rate value which is used if syntax element isn't present
@@ -114,6 +129,9 @@ typedef struct
   AL_EFbStorageMode eFBStorageMode;
   AL_EDecUnit eDecUnit;     // !< SubFrame latency control activation flag
   AL_EDpbMode eDpbMode;     // !< Low ref mode control activation flag
+  AL_EScdMode eScdMode;     // !< Start code detection backend
+  uint16_t uSliceBatchCount; // !< In slice latency mode, number of slices sent to the IP in one message (0: no count threshold)
+  uint32_t uSliceBatchBytes; // !< In slice latency mode, stream size from which the pending slices are sent to the IP (0: no size threshold)
   AL_TStreamSettings tStream; // !< Stream's settings
 }AL_TDecSettings;
 
@@ -156,6 +174,19 @@ void AL_Decoder_SetParam(AL_HDecoder hDec, bool bConceal, bool bUseBoard, int iN
 *****************************************************************************/
 bool AL_Decoder_PushBuffer(AL_HDecoder hDec, AL_TBuffer* pBuf, size_t uSize, AL_EBufMode eMode);
 
+/*************************************************************************//*!
+   \brief Lends a window of the decoder stream buffer so the bitstream can be written in place.
+   Once filled, the chunk is given back with AL_Decoder_PushBuffer and its data is
+   decoded without being copied. The chunk is released with AL_Buffer_Unref when not needed
+   anymore. Buffers pushed while a chunk is lent are only copied once the chunk is pushed or released.
+   The area is reused by the decoder once AL_Decoder_GetStrOffset has passed it.
+   \param[in] hDec Handle to an decoder object.
+   \param[in] zMaxSize Maximum size in bytes of the chunk
+   \return return NULL if no chunk is available (previously pushed buffers are still waiting to be copied,
+   a chunk is already lent or the stream buffer is full). Plain buffers can be pushed instead.
+*****************************************************************************/
+AL_TBuffer* AL_Decoder_GetStreamChunk(AL_HDecoder hDec, size_t zMaxSize);
+
 /*************************************************************************//*!
    \brief The AL_Decoder_Flush function allows to flush the decoding request stack when the stream parsing is finished.
    \param[in]  hDec Handle to an decoder object.
@@ -66,6 +66,9 @@ typedef AL_HANDLE AL_HEncoder;
    - eos reached ((pStream == NULL) && (pSrc == NULL))
    - release stream buffer ((pStream != NULL) && (pSrc == NULL))
    - release source buffer ((pStream == NULL) && (pSrc != NULL))
+   With the MCU scheduler, the callback is called from a thread shared by all
+   the channels of the process: it must return quickly and not wait for another
+   channel. Long processing of the stream belongs to a thread of the application.
    \param[out] pUserParam User parameter
    \param[out] pStream The stream buffer if any
    \param[out] pSrc The source buffer associated to the stream if any
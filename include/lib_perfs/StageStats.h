@@ -0,0 +1,83 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#pragma once
+
+#include "lib_rtos/types.h"
+
+/*************************************************************************//*!
+   \brief Host side stages of the control software whose cost is measured.
+*****************************************************************************/
+typedef enum
+{
+  AL_STAGE_FILE_READ, /*!< input file (stream or yuv) reading */
+  AL_STAGE_CONVERSION, /*!< yuv format conversion */
+  AL_STAGE_PROCESS, /*!< AL_Encoder_Process / AL_Decoder_PushBuffer */
+  AL_STAGE_SCD, /*!< start code detection */
+  AL_STAGE_SLICE_HEADER, /*!< slice header parsing */
+  AL_STAGE_SUBMIT, /*!< command submission to the scheduler */
+  AL_STAGE_CALLBACK, /*!< end of frame callback dispatch */
+  AL_STAGE_WRITE_OUT, /*!< output file writing */
+  AL_STAGE_MAX_ENUM,
+}AL_EStage;
+
+typedef struct
+{
+  AL_64U uWall; /*!< monotonic time, in nanoseconds */
+  AL_64U uCpu; /*!< calling thread processor time, in nanoseconds */
+}AL_TStageClock;
+
+typedef struct
+{
+  AL_64U uCount;
+  AL_64U uWallTotal;
+  AL_64U uCpuTotal;
+  AL_64U uWallMax;
+  AL_64U uWall[3]; /*!< p50, p99 and p999 wall latencies */
+  AL_64U uCpu[3]; /*!< p50, p99 and p999 processor times */
+}AL_TStageReport;
+
+/* stages are only measured once the statistics are enabled */
+void AL_StageStats_Enable(bool bEnable);
+bool AL_StageStats_IsEnabled(void);
+void AL_StageStats_Reset(void);
+
+AL_TStageClock AL_StageStats_Begin(void);
+void AL_StageStats_End(AL_EStage eStage, AL_TStageClock tBegin);
+
+char const* AL_StageStats_GetName(AL_EStage eStage);
+void AL_StageStats_GetReport(AL_EStage eStage, AL_TStageReport* pReport);
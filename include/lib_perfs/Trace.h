@@ -0,0 +1,110 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#pragma once
+
+#include "lib_rtos/types.h"
+
+/*************************************************************************//*!
+   \brief Per-thread trace of the control software hot path.
+
+   Each thread records its events in its own ring, without any lock: when a
+   ring is full, the oldest events are overwritten. The ring of an exited
+   thread is kept, with its events, and handed to the next new thread. The
+   names must be string literals, only their address is recorded. When the
+   tracing is disabled, recording an event costs one atomic load.
+*****************************************************************************/
+typedef enum
+{
+  AL_TRACE_BEGIN = 'B', /*!< start of a span on the recording thread */
+  AL_TRACE_END = 'E', /*!< end of the last span begun on the recording thread */
+  AL_TRACE_INSTANT = 'i',
+  AL_TRACE_ASYNC_BEGIN = 'b', /*!< start of a span which may end on another thread */
+  AL_TRACE_ASYNC_END = 'e',
+}AL_ETracePhase;
+
+typedef struct
+{
+  AL_64U uTimestamp; /*!< monotonic time, in nanoseconds */
+  AL_64U uId; /*!< identifies the span of the asynchronous events */
+  char const* sName;
+  int32_t iPhase; /*!< AL_ETracePhase */
+}AL_TTraceEvent;
+
+/* identifies a picture of a channel in the asynchronous events */
+#define AL_TRACE_ID(pCtx, uPicID) ((((AL_64U)(uintptr_t)(pCtx)) << 8) | (uint8_t)(uPicID))
+
+void AL_Trace_Enable(bool bEnable);
+bool AL_Trace_IsEnabled(void);
+
+void AL_Trace_Record(AL_ETracePhase ePhase, char const* sName, AL_64U uId);
+
+static inline void AL_Trace_Begin(char const* sName)
+{
+  AL_Trace_Record(AL_TRACE_BEGIN, sName, 0);
+}
+
+static inline void AL_Trace_End(char const* sName)
+{
+  AL_Trace_Record(AL_TRACE_END, sName, 0);
+}
+
+static inline void AL_Trace_Instant(char const* sName)
+{
+  AL_Trace_Record(AL_TRACE_INSTANT, sName, 0);
+}
+
+static inline void AL_Trace_AsyncBegin(char const* sName, AL_64U uId)
+{
+  AL_Trace_Record(AL_TRACE_ASYNC_BEGIN, sName, uId);
+}
+
+static inline void AL_Trace_AsyncEnd(char const* sName, AL_64U uId)
+{
+  AL_Trace_Record(AL_TRACE_ASYNC_END, sName, uId);
+}
+
+typedef void (* AL_FN_TraceVisitor)(void* pParam, int iThread, AL_TTraceEvent const* pEvent);
+
+/* the recorded events are only consistent once the traced threads are idle */
+void AL_Trace_Visit(AL_FN_TraceVisitor pfnVisit, void* pParam);
+/* number of events overwritten or not recorded */
+AL_64U AL_Trace_GetNumLost(void);
+/* only call it with the tracing disabled and no thread recording: the ring heads are owned by the recording threads */
+void AL_Trace_Reset(void);
+/* disables the tracing and frees the rings, once the traced threads are idle */
+void AL_Trace_Deinit(void);
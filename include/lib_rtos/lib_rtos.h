@@ -51,6 +51,7 @@ typedef void* AL_MUTEX;
 typedef void* AL_SEMAPHORE;
 typedef void* AL_EVENT;
 typedef void* AL_THREAD;
+typedef void* AL_TLS;
 
 /****************************************************************************/
 #define AL_NO_WAIT 0
@@ -73,7 +74,16 @@ int Rtos_Memcmp(void const* pBuf1, void const* pBuf2, size_t zSize);
 /*  Clock */
 /****************************************************************************/
 AL_64U Rtos_GetTime();
+/* monotonic clock, in microseconds */
+AL_64U Rtos_GetTimeUs();
+/* monotonic clock, in nanoseconds */
+AL_64U Rtos_GetTimeNs();
+/* processor time consumed by the calling thread, in nanoseconds */
+AL_64U Rtos_GetThreadCpuTimeNs();
 void Rtos_Sleep(uint32_t uMillisecond);
+void Rtos_SleepUs(uint32_t uMicrosecond);
+/* give the processor to another ready thread, if any */
+void Rtos_Yield();
 
 /****************************************************************************/
 /*  Mutex */
@@ -106,6 +116,16 @@ AL_THREAD Rtos_CreateThread(void* (*pFunc)(void* pParam), void* pParam);
 bool Rtos_JoinThread(AL_THREAD Thread);
 void Rtos_DeleteThread(AL_THREAD Thread);
 
+/****************************************************************************/
+/*  Thread local storage */
+/****************************************************************************/
+/* pfnDestructor, if any, is called with the non NULL value of each thread when
+ * it exits. Deleting the storage doesn't call it */
+AL_TLS Rtos_CreateTls(void (* pfnDestructor)(void* pValue));
+void Rtos_DeleteTls(AL_TLS Tls);
+void* Rtos_GetTls(AL_TLS Tls);
+bool Rtos_SetTls(AL_TLS Tls, void* pValue);
+
 /****************************************************************************/
 /*  Driver */
 /****************************************************************************/
@@ -118,6 +138,17 @@ int Rtos_DriverIoctl(void* drv, int req, void* data);
 /****************************************************************************/
 int32_t Rtos_AtomicIncrement(int32_t* iVal);
 int32_t Rtos_AtomicDecrement(int32_t* iVal);
+/* returns the new value */
+int32_t Rtos_AtomicAdd(int32_t* iVal, int32_t iAdd);
+int64_t Rtos_AtomicAdd64(int64_t* iVal, int64_t iAdd);
+/* stores iNew if *iVal still holds iOld. returns true if the store happened */
+bool Rtos_AtomicCompareAndSwap(int32_t* iVal, int32_t iOld, int32_t iNew);
+int32_t Rtos_AtomicLoad(int32_t* iVal);
+void Rtos_AtomicStore(int32_t* iVal, int32_t iNew);
+int64_t Rtos_AtomicLoad64(int64_t* iVal);
+void Rtos_AtomicStore64(int64_t* iVal, int64_t iNew);
+/* the memory reads before the fence are not reordered with the accesses after it */
+void Rtos_AcquireFence();
 
 /****************************************************************************/
 
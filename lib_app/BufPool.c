@@ -41,19 +41,155 @@
 #include "BufPool.h"
 #include "BufferMetaFactory.h"
 #include "lib_common/Allocator.h"
+#include "lib_common/Utils.h"
 
-/* lockless, one producer, one consumer */
+#ifdef _MSC_VER
+#define AL_THREAD_LOCAL __declspec(thread)
+#else
+#define AL_THREAD_LOCAL __thread
+#endif
 
-static bool Fifo_Init(App_Fifo* pFifo, size_t zMaxElem);
-static void Fifo_Deinit(App_Fifo* pFifo);
-static bool Fifo_Queue(App_Fifo* pFifo, void* pElem, uint32_t uWait);
-static void* Fifo_Dequeue(App_Fifo* pFifo, uint32_t uWait);
+static int32_t s_iNumThreads = 0;
+static AL_THREAD_LOCAL int32_t s_iThreadId = 0;
+
+/****************************************************************************/
+static AL_TBufMagazine* GetThreadMagazine(AL_TBufPool* pBufPool)
+{
+  if(!s_iThreadId)
+    s_iThreadId = Rtos_AtomicIncrement(&s_iNumThreads);
+
+  return &pBufPool->magazines[s_iThreadId % AL_BUFPOOL_MAX_MAGAZINES];
+}
+
+/****************************************************************************/
+static bool TryLockMagazine(AL_TBufMagazine* pMagazine)
+{
+  return Rtos_AtomicCompareAndSwap(&pMagazine->iLock, 0, 1);
+}
+
+/****************************************************************************/
+static void LockMagazine(AL_TBufMagazine* pMagazine)
+{
+  while(!TryLockMagazine(pMagazine))
+    Rtos_Yield();
+}
+
+/****************************************************************************/
+static void UnlockMagazine(AL_TBufMagazine* pMagazine)
+{
+  Rtos_AtomicStore(&pMagazine->iLock, 0);
+}
+
+/****************************************************************************/
+static bool IsStarving(AL_TBufPool* pBufPool)
+{
+  /* full barrier: also orders the previous magazine update before the read */
+  return Rtos_AtomicAdd(&pBufPool->iNumStarving, 0) > 0;
+}
+
+/****************************************************************************/
+static void ReturnToFifo(AL_TBufPool* pBufPool, AL_TBufMagazine* pMagazine, int32_t iNumKept)
+{
+  /* the fifo can hold every buffer of the pool: this never blocks */
+  while(pMagazine->iNumBuf > iNumKept)
+    AL_Fifo_Queue(&pBufPool->fifo, pMagazine->pBuf[--pMagazine->iNumBuf], AL_WAIT_FOREVER);
+}
+
+/****************************************************************************/
+static bool PutInMagazine(AL_TBufPool* pBufPool, AL_TBuffer* pBuf)
+{
+  if(IsStarving(pBufPool))
+    return false;
+
+  AL_TBufMagazine* pMagazine = GetThreadMagazine(pBufPool);
+
+  if(!TryLockMagazine(pMagazine))
+    return false;
+
+  /* full magazine: give half of it back in one go */
+  if(pMagazine->iNumBuf == (int32_t)pBufPool->config.uMagazineSize)
+    ReturnToFifo(pBufPool, pMagazine, pMagazine->iNumBuf / 2);
+
+  pMagazine->pBuf[pMagazine->iNumBuf++] = pBuf;
+  UnlockMagazine(pMagazine);
+
+  /* a thread may have started to wait after our first check and missed this buffer */
+  if(IsStarving(pBufPool))
+  {
+    LockMagazine(pMagazine);
+    ReturnToFifo(pBufPool, pMagazine, 0);
+    UnlockMagazine(pMagazine);
+  }
+
+  return true;
+}
+
+/****************************************************************************/
+static AL_TBuffer* GetFromMagazine(AL_TBufPool* pBufPool, bool* pHit)
+{
+  AL_TBufMagazine* pMagazine = GetThreadMagazine(pBufPool);
+
+  if(!TryLockMagazine(pMagazine))
+    return NULL;
+
+  *pHit = pMagazine->iNumBuf != 0;
+
+  /* empty magazine: refill half of it in one go */
+  if(pMagazine->iNumBuf == 0 && !IsStarving(pBufPool))
+  {
+    int32_t iNumRefill = (pBufPool->config.uMagazineSize + 1) / 2;
+
+    while(pMagazine->iNumBuf < iNumRefill)
+    {
+      AL_TBuffer* pBuf = AL_Fifo_Dequeue(&pBufPool->fifo, AL_NO_WAIT);
+
+      if(!pBuf)
+        break;
+      pMagazine->pBuf[pMagazine->iNumBuf++] = pBuf;
+    }
+  }
+
+  AL_TBuffer* pBuf = NULL;
+
+  if(pMagazine->iNumBuf)
+    pBuf = pMagazine->pBuf[--pMagazine->iNumBuf];
+
+  UnlockMagazine(pMagazine);
+  return pBuf;
+}
+
+/****************************************************************************/
+static AL_TBuffer* StealFromMagazines(AL_TBufPool* pBufPool)
+{
+  for(int i = 0; i < AL_BUFPOOL_MAX_MAGAZINES; ++i)
+  {
+    AL_TBufMagazine* pMagazine = &pBufPool->magazines[i];
+    AL_TBuffer* pBuf = NULL;
+
+    LockMagazine(pMagazine);
+
+    if(pMagazine->iNumBuf)
+      pBuf = pMagazine->pBuf[--pMagazine->iNumBuf];
+    UnlockMagazine(pMagazine);
+
+    if(pBuf)
+      return pBuf;
+  }
+
+  return NULL;
+}
 
 /****************************************************************************/
 static void FreeBufInPool(AL_TBuffer* pBuf)
 {
   AL_TBufPool* pBufPool = AL_Buffer_GetUserData(pBuf);
-  Fifo_Queue(&pBufPool->fifo, pBuf, AL_WAIT_FOREVER);
+
+  Rtos_AtomicDecrement(&pBufPool->iNumUsed);
+
+  if(pBufPool->config.uMagazineSize && PutInMagazine(pBufPool, pBuf))
+    return;
+
+  AL_Fifo_Queue(&pBufPool->fifo, pBuf, AL_WAIT_FOREVER);
 }
 
 /****************************************************************************/
@@ -83,7 +219,7 @@ static bool AL_sBufPool_AllocBuf(AL_TBufPool* pBufPool)
 
   pBufPool->pPool[pBufPool->uNumBuf++] = pBuf;
 
-  Fifo_Queue(&pBufPool->fifo, pBuf, AL_WAIT_FOREVER);
+  AL_Fifo_Queue(&pBufPool->fifo, pBuf, AL_WAIT_FOREVER);
 
   return true;
 
@@ -107,11 +243,16 @@ bool AL_BufPool_Init(AL_TBufPool* pBufPool, AL_TAllocator* pAllocator, AL_TBufPo
 
   pBufPool->pAllocator = pAllocator;
 
-  if(!Fifo_Init(&pBufPool->fifo, pConfig->uNumBuf))
+  if(!AL_Fifo_InitWithMode(&pBufPool->fifo, pConfig->uNumBuf, AL_FIFO_MPMC))
     goto fail_init;
 
   pBufPool->config = *pConfig;
+  pBufPool->config.uMagazineSize = UnsignedMin(pConfig->uMagazineSize, AL_BUFPOOL_MAX_MAGAZINE_SIZE);
   pBufPool->uNumBuf = 0;
+  Rtos_Memset(pBufPool->magazines, 0, sizeof(pBufPool->magazines));
+  pBufPool->iNumStarving = 0;
+  pBufPool->iNumUsed = 0;
+  Rtos_Memset(&pBufPool->stats, 0, sizeof(pBufPool->stats));
 
   size_t zMemPoolSize = pConfig->uNumBuf * sizeof(AL_TBuffer*);
 
@@ -146,96 +287,80 @@ void AL_BufPool_Deinit(AL_TBufPool* pBufPool)
 
   if(pBufPool->config.pMetaData)
     pBufPool->config.pMetaData->MetaDestroy(pBufPool->config.pMetaData);
-  Fifo_Deinit(&pBufPool->fifo);
+  AL_Fifo_Deinit(&pBufPool->fifo);
   Rtos_Free(pBufPool->pPool);
   Rtos_Memset(pBufPool, 0, sizeof(*pBufPool));
 }
 
 /****************************************************************************/
-AL_TBuffer* AL_BufPool_GetBuffer(AL_TBufPool* pBufPool, AL_EBufMode eMode)
+static AL_TBuffer* WaitBuffer(AL_TBufPool* pBufPool, uint32_t Wait)
 {
-  uint32_t Wait = AL_GetWaitMode(eMode);
+  if(!pBufPool->config.uMagazineSize)
+    return AL_Fifo_Dequeue(&pBufPool->fifo, Wait);
+
+  /* from now on, released buffers go to the fifo */
+  Rtos_AtomicIncrement(&pBufPool->iNumStarving);
 
-  AL_TBuffer* pBuf = Fifo_Dequeue(&pBufPool->fifo, Wait);
+  AL_TBuffer* pBuf = StealFromMagazines(pBufPool);
 
   if(!pBuf)
-    return NULL;
+    pBuf = AL_Fifo_Dequeue(&pBufPool->fifo, Wait);
 
-  AL_Buffer_Ref(pBuf);
+  Rtos_AtomicDecrement(&pBufPool->iNumStarving);
   return pBuf;
 }
 
-static bool Fifo_Init(App_Fifo* pFifo, size_t zMaxElem)
+/****************************************************************************/
+static void UpdateHighWater(AL_TBufPool* pBufPool)
 {
-  pFifo->m_zMaxElem = zMaxElem + 1;
-  pFifo->m_zTail = 0;
-  pFifo->m_zHead = 0;
-
-  size_t zElemSize = pFifo->m_zMaxElem * sizeof(void*);
-  pFifo->m_ElemBuffer = Rtos_Malloc(zElemSize);
-
-  if(!pFifo->m_ElemBuffer)
-    return false;
-  Rtos_Memset(pFifo->m_ElemBuffer, 0xCD, zElemSize);
+  int32_t iNumUsed = Rtos_AtomicIncrement(&pBufPool->iNumUsed);
+  int32_t iHighWater = Rtos_AtomicLoad(&pBufPool->stats.iHighWater);
 
-  pFifo->hCountSem = Rtos_CreateSemaphore(0);
+  while(iNumUsed > iHighWater && !Rtos_AtomicCompareAndSwap(&pBufPool->stats.iHighWater, iHighWater, iNumUsed))
+    iHighWater = Rtos_AtomicLoad(&pBufPool->stats.iHighWater);
+}
 
-  if(!pFifo->hCountSem)
-  {
-    Rtos_Free(pFifo->m_ElemBuffer);
-    return false;
-  }
+/****************************************************************************/
+AL_TBuffer* AL_BufPool_GetBuffer(AL_TBufPool* pBufPool, AL_EBufMode eMode)
+{
+  uint32_t Wait = AL_GetWaitMode(eMode);
+  AL_TBuffer* pBuf = NULL;
+  bool bHit = false;
 
-  pFifo->hSpaceSem = Rtos_CreateSemaphore(zMaxElem);
-  pFifo->hMutex = Rtos_CreateMutex();
+  if(pBufPool->config.uMagazineSize)
+    pBuf = GetFromMagazine(pBufPool, &bHit);
 
-  if(!pFifo->hSpaceSem)
+  if(pBuf)
+    Rtos_AtomicIncrement(bHit ? &pBufPool->stats.iHits : &pBufPool->stats.iMisses);
+  else
   {
-    Rtos_DeleteSemaphore(pFifo->hCountSem);
-    Rtos_Free(pFifo->m_ElemBuffer);
-    return false;
-  }
-
-  return true;
-}
+    pBuf = AL_Fifo_Dequeue(&pBufPool->fifo, AL_NO_WAIT);
 
-static void Fifo_Deinit(App_Fifo* pFifo)
-{
-  Rtos_Free(pFifo->m_ElemBuffer);
-  Rtos_DeleteSemaphore(pFifo->hCountSem);
-  Rtos_DeleteSemaphore(pFifo->hSpaceSem);
-  Rtos_DeleteMutex(pFifo->hMutex);
-}
+    if(!pBuf && Wait != AL_NO_WAIT)
+    {
+      Rtos_AtomicIncrement(&pBufPool->stats.iWaits);
+      pBuf = WaitBuffer(pBufPool, Wait);
+    }
+    else if(!pBuf && pBufPool->config.uMagazineSize)
+      pBuf = StealFromMagazines(pBufPool);
 
-static bool Fifo_Queue(App_Fifo* pFifo, void* pElem, uint32_t uWait)
-{
-  if(!Rtos_GetSemaphore(pFifo->hSpaceSem, uWait))
-    return false;
+    if(!pBuf)
+      return NULL;
 
-  Rtos_GetMutex(pFifo->hMutex);
-  pFifo->m_ElemBuffer[pFifo->m_zTail] = pElem;
-  pFifo->m_zTail = (pFifo->m_zTail + 1) % pFifo->m_zMaxElem;
-  Rtos_ReleaseMutex(pFifo->hMutex);
-
-  Rtos_ReleaseSemaphore(pFifo->hCountSem);
+    Rtos_AtomicIncrement(&pBufPool->stats.iMisses);
+  }
 
-  /* new item was added in the queue */
-  return true;
+  UpdateHighWater(pBufPool);
+  AL_Buffer_Ref(pBuf);
+  return pBuf;
 }
 
-static void* Fifo_Dequeue(App_Fifo* pFifo, uint32_t uWait)
+/****************************************************************************/
+void AL_BufPool_GetStats(AL_TBufPool* pBufPool, AL_TBufPoolStats* pStats)
 {
-  /* wait if no items */
-  if(!Rtos_GetSemaphore(pFifo->hCountSem, uWait))
-    return NULL;
-
-  Rtos_GetMutex(pFifo->hMutex);
-  void* pElem = pFifo->m_ElemBuffer[pFifo->m_zHead];
-  pFifo->m_zHead = (pFifo->m_zHead + 1) % pFifo->m_zMaxElem;
-  Rtos_ReleaseMutex(pFifo->hMutex);
-
-  /* new empty space available */
-  Rtos_ReleaseSemaphore(pFifo->hSpaceSem);
-  return pElem;
+  pStats->iHits = Rtos_AtomicLoad(&pBufPool->stats.iHits);
+  pStats->iMisses = Rtos_AtomicLoad(&pBufPool->stats.iMisses);
+  pStats->iWaits = Rtos_AtomicLoad(&pBufPool->stats.iWaits);
+  pStats->iHighWater = Rtos_AtomicLoad(&pBufPool->stats.iHighWater);
 }
 
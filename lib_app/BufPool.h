@@ -51,6 +51,7 @@
 #include "lib_common/BufferAPI.h"
 #include "lib_common/BufferMeta.h"
 #include "lib_common/BufferAccess.h"
+#include "lib_common/Fifo.h"
 
 /*************************************************************************//*!
    \brief AL_TBufPoolConfig: Used to configure the AL_TBufPool
@@ -61,18 +62,32 @@ typedef struct al_t_BufPoolConfig
   size_t zBufSize;/*!< Size of the buffers that will fill the pool */
   char const* debugName;
   AL_TMetaData* pMetaData;/*!< Metadata of the buffer that will fill the pool */
+  uint32_t uMagazineSize; /*!< Number of free buffers each thread keeps at hand (0: disabled, at most AL_BUFPOOL_MAX_MAGAZINE_SIZE) */
 }AL_TBufPoolConfig;
 
+#define AL_BUFPOOL_MAX_MAGAZINES 8
+#define AL_BUFPOOL_MAX_MAGAZINE_SIZE 8
+
+/*************************************************************************//*!
+   \brief AL_TBufMagazine: Free buffers stashed by the threads sharing a slot
+*****************************************************************************/
+typedef struct
+{
+  int32_t iLock;
+  int32_t iNumBuf;
+  AL_TBuffer* pBuf[AL_BUFPOOL_MAX_MAGAZINE_SIZE];
+}AL_TBufMagazine;
+
+/*************************************************************************//*!
+   \brief AL_TBufPoolStats: Usage statistics of an AL_TBufPool
+*****************************************************************************/
 typedef struct
 {
-  size_t m_zMaxElem;
-  size_t m_zTail;
-  size_t m_zHead;
-  void** m_ElemBuffer;
-  AL_MUTEX hMutex;
-  AL_SEMAPHORE hCountSem;
-  AL_SEMAPHORE hSpaceSem;
-}App_Fifo;
+  int32_t iHits; /*!< Buffers taken from the magazine of the calling thread */
+  int32_t iMisses; /*!< Buffers taken from the shared fifo or from another magazine */
+  int32_t iWaits; /*!< Gets that had to wait for a buffer to be released */
+  int32_t iHighWater; /*!< Maximum number of buffers used at the same time */
+}AL_TBufPoolStats;
 
 /*************************************************************************//*!
    \brief AL_TBufPool: Pool of buffer
@@ -86,7 +101,13 @@ typedef struct
 
   AL_TBufPoolConfig config;
 
-  App_Fifo fifo;
+  AL_TFifo fifo; /*! free buffers, released from any thread */
+
+  AL_TBufMagazine magazines[AL_BUFPOOL_MAX_MAGAZINES]; /*! per thread stashes of free buffers */
+  int32_t iNumStarving; /*! threads waiting for a buffer: magazines are bypassed meanwhile */
+
+  int32_t iNumUsed;
+  AL_TBufPoolStats stats;
 }AL_TBufPool;
 
 /*************************************************************************//*!
@@ -111,6 +132,13 @@ void AL_BufPool_Deinit(AL_TBufPool* pBufPool);
 *****************************************************************************/
 AL_TBuffer* AL_BufPool_GetBuffer(AL_TBufPool* pBufPool, AL_EBufMode eMode);
 
+/*************************************************************************//*!
+   \brief AL_BufPool_GetStats Get the usage statistics of the pool
+   \param[in] pBufPool Pointer to an AL_TBufPool
+   \param[out] pStats Pointer to the statistics to fill
+*****************************************************************************/
+void AL_BufPool_GetStats(AL_TBufPool* pBufPool, AL_TBufPoolStats* pStats);
+
 /*****************************************************************************/
 
 /*@}*/
@@ -0,0 +1,80 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include <fstream>
+#include "StageReport.h"
+#include "utils.h"
+
+using namespace std;
+
+/*****************************************************************************/
+static void WriteTimes(ofstream& fp, char const* sName, AL_64U uTotal, AL_64U const uPercentiles[3])
+{
+  fp << "\"" << sName << "\": { \"total\": " << uTotal
+     << ", \"p50\": " << uPercentiles[0]
+     << ", \"p99\": " << uPercentiles[1]
+     << ", \"p999\": " << uPercentiles[2] << " }";
+}
+
+/*****************************************************************************/
+void WriteStageReport(string const& sFilename, string const& sTool, int iFrames, double fDurationInSeconds)
+{
+  ofstream fp;
+  OpenOutput(fp, sFilename, false);
+
+  fp << "{\n";
+  fp << "  \"tool\": \"" << sTool << "\",\n";
+  fp << "  \"frames\": " << iFrames << ",\n";
+  fp << "  \"duration_s\": " << fDurationInSeconds << ",\n";
+  fp << "  \"unit\": \"ns\",\n";
+  fp << "  \"stages\": {\n";
+
+  for(int i = 0; i < AL_STAGE_MAX_ENUM; ++i)
+  {
+    AL_TStageReport tReport;
+    AL_StageStats_GetReport((AL_EStage)i, &tReport);
+
+    fp << "    \"" << AL_StageStats_GetName((AL_EStage)i) << "\": { \"count\": " << tReport.uCount << ", ";
+    WriteTimes(fp, "wall", tReport.uWallTotal, tReport.uWall);
+    fp << ", \"wall_max\": " << tReport.uWallMax << ", ";
+    WriteTimes(fp, "cpu", tReport.uCpuTotal, tReport.uCpu);
+    fp << " }" << (i + 1 < AL_STAGE_MAX_ENUM ? "," : "") << "\n";
+  }
+
+  fp << "  }\n";
+  fp << "}\n";
+}
@@ -0,0 +1,101 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include <fstream>
+#include <iomanip>
+#include <vector>
+#include "TraceExport.h"
+#include "utils.h"
+
+using namespace std;
+
+struct TracedEvent
+{
+  int iThread;
+  AL_TTraceEvent tEvent;
+};
+
+/*****************************************************************************/
+static void CollectEvent(void* pParam, int iThread, AL_TTraceEvent const* pEvent)
+{
+  auto pEvents = static_cast<vector<TracedEvent>*>(pParam);
+  pEvents->push_back({ iThread, *pEvent });
+}
+
+/*****************************************************************************/
+void WriteChromeTrace(string const& sFilename)
+{
+  vector<TracedEvent> events;
+  AL_Trace_Visit(&CollectEvent, &events);
+
+  AL_64U uOrigin = UINT64_MAX;
+
+  for(auto& e : events)
+    uOrigin = min(uOrigin, e.tEvent.uTimestamp);
+
+  ofstream fp;
+  OpenOutput(fp, sFilename, false);
+
+  fp << "{\"displayTimeUnit\": \"ns\", \"otherData\": { \"lost_events\": " << AL_Trace_GetNumLost() << " },\n";
+  fp << "\"traceEvents\": [\n";
+  fp << fixed << setprecision(3);
+
+  bool bFirst = true;
+
+  for(auto& e : events)
+  {
+    auto& tEvent = e.tEvent;
+    auto const ePhase = (AL_ETracePhase)tEvent.iPhase;
+
+    fp << (bFirst ? "" : ",\n");
+    bFirst = false;
+
+    /* timestamps are in microseconds */
+    fp << "{\"name\": \"" << tEvent.sName << "\", \"ph\": \"" << (char)ePhase << "\", \"ts\": " << (tEvent.uTimestamp - uOrigin) / 1000.0
+       << ", \"pid\": 1, \"tid\": " << e.iThread;
+
+    if(ePhase == AL_TRACE_ASYNC_BEGIN || ePhase == AL_TRACE_ASYNC_END)
+      fp << ", \"cat\": \"pipeline\", \"id\": \"0x" << hex << tEvent.uId << dec << "\"";
+
+    if(ePhase == AL_TRACE_INSTANT)
+      fp << ", \"s\": \"t\"";
+
+    fp << "}";
+  }
+
+  fp << "\n]}\n";
+}
@@ -54,9 +54,47 @@ extern "C" {
 }
 
 #include "convert.h"
+#include "convert_kernels.h"
+#include "convert_scheduler.h"
 
 #define RND_10B_TO_8B(val) (((val) >= 0x3FC) ? 0xFF : (((val) + 2) >> 2))
 
+/****************************************************************************/
+/* The last tile row is always written in full and may spill over the rows that
+ * follow the plane: convert it once the other stripes are done */
+template<typename Function>
+static void ConvertTileStripes(int iNumRows, int iTileH, Function const& ConvertRows)
+{
+  int iNumFullRows = iNumRows - iNumRows % iTileH;
+
+  ConvertStripes(iNumFullRows, iTileH, ConvertRows);
+
+  if(iNumFullRows < iNumRows)
+    ConvertRows(iNumFullRows, iNumRows);
+}
+
+/****************************************************************************/
+/* Runs Convert(iOffset, iNum) over iNum contiguous samples, in stripes of whole rows of iRowSize samples */
+template<typename Function>
+static void ConvertLinear(int iNum, int iRowSize, Function const& Convert)
+{
+  if(iRowSize <= 0)
+  {
+    Convert(0, iNum);
+    return;
+  }
+
+  ConvertStripes(iNum / iRowSize, 1, [&](int iBeginRow, int iEndRow)
+  {
+    Convert(iBeginRow * iRowSize, (iEndRow - iBeginRow) * iRowSize);
+  });
+
+  int iDone = iNum / iRowSize * iRowSize;
+
+  if(iNum > iDone)
+    Convert(iDone, iNum - iDone);
+}
+
 static void SetFourCC(AL_TSrcMetaData* pMetaData, TFourCC tFourCC420, TFourCC tFourCC422, int iScale)
 {
   switch(iScale)
@@ -117,15 +155,14 @@ void I420_To_Y800(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   pDstMeta->tDim.iHeight = pSrcMeta->tDim.iHeight;
 
   // Luma
-  AL_VADDR pSrcY = AL_Buffer_GetData(pSrc);
-  AL_VADDR pDstY = AL_Buffer_GetData(pDst);
+  AL_VADDR pSrcData = AL_Buffer_GetData(pSrc);
+  AL_VADDR pDstData = AL_Buffer_GetData(pDst);
 
-  for(int iH = 0; iH < pSrcMeta->tDim.iHeight; ++iH)
+  ConvertStripes(pSrcMeta->tDim.iHeight, 1, [&](int iBeginRow, int iEndRow)
   {
-    Rtos_Memcpy(pDstY, pSrcY, pSrcMeta->tDim.iWidth);
-    pDstY += pDstMeta->tPitches.iLuma;
-    pSrcY += pSrcMeta->tDim.iWidth;
-  }
+    for(int iH = iBeginRow; iH < iEndRow; ++iH)
+      Rtos_Memcpy(pDstData + iH * pDstMeta->tPitches.iLuma, pSrcData + iH * pSrcMeta->tDim.iWidth, pSrcMeta->tDim.iWidth);
+  });
 
   pDstMeta->tFourCC = FOURCC(Y800);
 }
@@ -135,7 +172,6 @@ void I420_To_Y010(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
 {
   AL_TSrcMetaData* pSrcMeta = (AL_TSrcMetaData*)AL_Buffer_GetMetaData(pSrc, AL_META_TYPE_SOURCE);
   AL_TSrcMetaData* pDstMeta = (AL_TSrcMetaData*)AL_Buffer_GetMetaData(pDst, AL_META_TYPE_SOURCE);
-  const int iLumaSize = pSrcMeta->tDim.iWidth * pSrcMeta->tDim.iHeight;
 
   pDstMeta->tDim.iWidth = pSrcMeta->tDim.iWidth;
   pDstMeta->tDim.iHeight = pSrcMeta->tDim.iHeight;
@@ -144,10 +180,12 @@ void I420_To_Y010(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   // Luma
   uint8_t* pBufIn = AL_Buffer_GetData(pSrc);
   uint16_t* pBufOut = (uint16_t*)(AL_Buffer_GetData(pDst));
-  int iSize = iLumaSize;
+  int iWidth = pSrcMeta->tDim.iWidth;
 
-  while(iSize--)
-    *pBufOut++ = ((uint16_t)*pBufIn++) << 2;
+  ConvertStripes(pSrcMeta->tDim.iHeight, 1, [&](int iBeginRow, int iEndRow)
+  {
+    GetConvKernels()->Widen8To10(pBufIn + iBeginRow * iWidth, pBufOut + iBeginRow * iWidth, (iEndRow - iBeginRow) * iWidth);
+  });
 }
 
 /****************************************************************************/
@@ -170,10 +208,7 @@ void I420_To_I0AL(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
     uint8_t* pBufIn = pSrcData;
     uint16_t* pBufOut = (uint16_t*)(pDstData);
 
-    int iSize = iLumaSize;
-
-    while(iSize--)
-      *pBufOut++ = ((uint16_t)*pBufIn++) << 2;
+    GetConvKernels()->Widen8To10(pBufIn, pBufOut, iLumaSize);
   }
 
   // Chroma
@@ -181,10 +216,7 @@ void I420_To_I0AL(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
     uint8_t* pBufIn = pSrcData + iLumaSize;
     uint16_t* pBufOut = ((uint16_t*)(pDstData)) + iLumaSize;
 
-    int iSize = iChromaSize;
-
-    while(iSize--)
-      *pBufOut++ = ((uint16_t)*pBufIn++) << 2;
+    GetConvKernels()->Widen8To10(pBufIn, pBufOut, iChromaSize);
   }
 }
 
@@ -267,13 +299,7 @@ void YV12_To_NV12(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
     uint8_t* pBufInU = pSrcData + iLumaSize + iChromaSize;
     uint8_t* pBufOut = pDstData + iLumaSize;
 
-    int iSize = iChromaSize;
-
-    while(iSize--)
-    {
-      *pBufOut++ = *pBufInU++;
-      *pBufOut++ = *pBufInV++;
-    }
+    GetConvKernels()->Interleave8(pBufInU, pBufInV, pBufOut, iChromaSize);
   }
 }
 
@@ -312,10 +338,8 @@ void YV12_To_P010(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   {
     uint8_t* pBufIn = pSrcData;
     uint16_t* pBufOut = (uint16_t*)(pDstData);
-    int iSize = iLumaSize;
 
-    while(iSize--)
-      *pBufOut++ = ((uint16_t)*pBufIn++) << 2;
+    GetConvKernels()->Widen8To10(pBufIn, pBufOut, iLumaSize);
   }
 
   // Chroma
@@ -323,13 +347,8 @@ void YV12_To_P010(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
     uint8_t* pBufInV = pSrcData + iLumaSize;
     uint8_t* pBufInU = pSrcData + iLumaSize + iChromaSize;
     uint16_t* pBufOut = ((uint16_t*)(pDstData)) + iLumaSize;
-    int iSize = iChromaSize;
 
-    while(iSize--)
-    {
-      *pBufOut++ = ((uint16_t)*pBufInU++) << 2;
-      *pBufOut++ = ((uint16_t)*pBufInV++) << 2;
-    }
+    GetConvKernels()->Interleave8To10(pBufInU, pBufInV, pBufOut, iChromaSize);
   }
 }
 
@@ -412,10 +431,8 @@ void YV12_To_I0AL(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   {
     uint8_t* pBufIn = pSrcData;
     uint16_t* pBufOut = (uint16_t*)(pDstData);
-    int iSize = iLumaSize;
 
-    while(iSize--)
-      *pBufOut++ = ((uint16_t)*pBufIn++) << 2;
+    GetConvKernels()->Widen8To10(pBufIn, pBufOut, iLumaSize);
   }
 
   // Chroma
@@ -424,13 +441,8 @@ void YV12_To_I0AL(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
     uint8_t* pBufInU = pSrcData + iLumaSize + iChromaSize;
     uint16_t* pBufOutU = ((uint16_t*)(pDstData)) + iLumaSize;
     uint16_t* pBufOutV = ((uint16_t*)(pDstData)) + iLumaSize + iChromaSize;
-    int iSize = iChromaSize;
-
-    while(iSize--)
-    {
-      *pBufOutU++ = ((uint16_t)*pBufInU++) << 2;
-      *pBufOutV++ = ((uint16_t)*pBufInV++) << 2;
-    }
+    GetConvKernels()->Widen8To10(pBufInU, pBufOutU, iChromaSize);
+    GetConvKernels()->Widen8To10(pBufInV, pBufOutV, iChromaSize);
   }
 }
 
@@ -549,10 +561,8 @@ void Y800_To_P010(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   {
     uint8_t* pBufIn = AL_Buffer_GetData(pSrc);
     uint16_t* pBufOut = (uint16_t*)(pDstData);
-    int iSize = iLumaSize;
 
-    while(iSize--)
-      *pBufOut++ = ((uint16_t)*pBufIn++) << 2;
+    GetConvKernels()->Widen8To10(pBufIn, pBufOut, iLumaSize);
   }
   // Chroma
   {
@@ -585,31 +595,30 @@ void Y800_To_RX0A(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int h = 0; h < pSrcMeta->tDim.iHeight; h++)
+  ConvertStripes(pSrcMeta->tDim.iHeight, 1, [&](int iBeginRow, int iEndRow)
   {
-    uint32_t* pDst32 = (uint32_t*)(pDstData + h * pDstMeta->tPitches.iLuma);
-    uint8_t* pSrcY = (uint8_t*)(pSrcData + h * pSrcMeta->tPitches.iLuma);
+    for(int h = iBeginRow; h < iEndRow; h++)
+    {
+      uint32_t* pDst32 = (uint32_t*)(pDstData + h * pDstMeta->tPitches.iLuma);
+      uint8_t* pSrcY = (uint8_t*)(pSrcData + h * pSrcMeta->tPitches.iLuma);
 
-    int w = pSrcMeta->tDim.iWidth / 3;
+      int w = pSrcMeta->tDim.iWidth / 3;
 
-    while(w--)
-    {
-      *pDst32 = ((uint32_t)*pSrcY++) << 2;
-      *pDst32 |= ((uint32_t)*pSrcY++) << 12;
-      *pDst32 |= ((uint32_t)*pSrcY++) << 22;
-      ++pDst32;
-    }
+      GetConvKernels()->Pack8To10(pSrcY, pDst32, w);
+      pSrcY += 3 * w;
+      pDst32 += w;
 
-    if(pSrcMeta->tDim.iWidth % 3 > 1)
-    {
-      *pDst32 = ((uint32_t)*pSrcY++) << 2;
-      *pDst32 |= ((uint32_t)*pSrcY++) << 12;
-    }
-    else if(pSrcMeta->tDim.iWidth % 3 > 0)
-    {
-      *pDst32 = ((uint32_t)*pSrcY++) << 2;
+      if(pSrcMeta->tDim.iWidth % 3 > 1)
+      {
+        *pDst32 = ((uint32_t)*pSrcY++) << 2;
+        *pDst32 |= ((uint32_t)*pSrcY++) << 12;
+      }
+      else if(pSrcMeta->tDim.iWidth % 3 > 0)
+      {
+        *pDst32 = ((uint32_t)*pSrcY++) << 2;
+      }
     }
-  }
+  });
 
   pDstMeta->tFourCC = FOURCC(RX0A);
 }
@@ -628,14 +637,11 @@ void Y800_To_Y010(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   uint16_t* pBufOut = (uint16_t*)(AL_Buffer_GetData(pDst));
   int iDstPitchLuma = pDstMeta->tPitches.iLuma / sizeof(uint16_t);
 
-  for(int iH = 0; iH < pDstMeta->tDim.iHeight; ++iH)
+  ConvertStripes(pDstMeta->tDim.iHeight, 1, [&](int iBeginRow, int iEndRow)
   {
-    for(int iW = 0; iW < pDstMeta->tDim.iWidth; ++iW)
-      pBufOut[iW] = ((uint16_t)pBufIn[iW]) << 2;
-
-    pBufIn += pSrcMeta->tPitches.iLuma;
-    pBufOut += iDstPitchLuma;
-  }
+    for(int iH = iBeginRow; iH < iEndRow; ++iH)
+      GetConvKernels()->Widen8To10(pBufIn + iH * pSrcMeta->tPitches.iLuma, pBufOut + iH * iDstPitchLuma, pDstMeta->tDim.iWidth);
+  });
 }
 
 /****************************************************************************/
@@ -650,29 +656,28 @@ void Y010_To_RX0A(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int h = 0; h < pSrcMeta->tDim.iHeight; h++)
+  ConvertStripes(pSrcMeta->tDim.iHeight, 1, [&](int iBeginRow, int iEndRow)
   {
-    uint32_t* pDst32 = (uint32_t*)(pDstData + h * pDstMeta->tPitches.iLuma);
-    uint16_t* pSrcY = (uint16_t*)(pSrcData + h * pSrcMeta->tPitches.iLuma);
+    for(int h = iBeginRow; h < iEndRow; h++)
+    {
+      uint32_t* pDst32 = (uint32_t*)(pDstData + h * pDstMeta->tPitches.iLuma);
+      uint16_t* pSrcY = (uint16_t*)(pSrcData + h * pSrcMeta->tPitches.iLuma);
 
-    int w = pSrcMeta->tDim.iWidth / 3;
+      int w = pSrcMeta->tDim.iWidth / 3;
 
-    while(w--)
-    {
-      *pDst32 = ((uint32_t)*pSrcY++);
-      *pDst32 |= ((uint32_t)*pSrcY++) << 10;
-      *pDst32 |= ((uint32_t)*pSrcY++) << 20;
-      ++pDst32;
-    }
+      GetConvKernels()->Pack10(pSrcY, pDst32, w, 0xFFFF);
+      pSrcY += 3 * w;
+      pDst32 += w;
 
-    if(pSrcMeta->tDim.iWidth % 3 > 1)
-    {
-      *pDst32 = ((uint32_t)*pSrcY++);
-      *pDst32 |= ((uint32_t)*pSrcY++) << 10;
+      if(pSrcMeta->tDim.iWidth % 3 > 1)
+      {
+        *pDst32 = ((uint32_t)*pSrcY++);
+        *pDst32 |= ((uint32_t)*pSrcY++) << 10;
+      }
+      else if(pSrcMeta->tDim.iWidth % 3 > 0)
+        *pDst32 = ((uint32_t)*pSrcY++);
     }
-    else if(pSrcMeta->tDim.iWidth % 3 > 0)
-      *pDst32 = ((uint32_t)*pSrcY++);
-  }
+  });
 
   pDstMeta->tFourCC = FOURCC(RX0A);
 }
@@ -696,31 +701,30 @@ void Y800_To_RXmA(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int h = 0; h < pSrcMeta->tDim.iHeight; h++)
+  ConvertStripes(pSrcMeta->tDim.iHeight, 1, [&](int iBeginRow, int iEndRow)
   {
-    uint32_t* pDst32 = (uint32_t*)(pDstData + h * pDstMeta->tPitches.iLuma);
-    uint8_t* pSrcY = (uint8_t*)(pSrcData + h * pSrcMeta->tPitches.iLuma);
+    for(int h = iBeginRow; h < iEndRow; h++)
+    {
+      uint32_t* pDst32 = (uint32_t*)(pDstData + h * pDstMeta->tPitches.iLuma);
+      uint8_t* pSrcY = (uint8_t*)(pSrcData + h * pSrcMeta->tPitches.iLuma);
 
-    int w = pSrcMeta->tDim.iWidth / 3;
+      int w = pSrcMeta->tDim.iWidth / 3;
 
-    while(w--)
-    {
-      *pDst32 = toTen(*pSrcY++);
-      *pDst32 |= toTen(*pSrcY++) << 10;
-      *pDst32 |= toTen(*pSrcY++) << 20;
-      ++pDst32;
-    }
+      GetConvKernels()->Pack8To10(pSrcY, pDst32, w);
+      pSrcY += 3 * w;
+      pDst32 += w;
 
-    if(pSrcMeta->tDim.iWidth % 3 > 1)
-    {
-      *pDst32 = toTen(*pSrcY++);
-      *pDst32 |= toTen(*pSrcY++) << 10;
-    }
-    else if(pSrcMeta->tDim.iWidth % 3 > 0)
-    {
-      *pDst32 = toTen(*pSrcY++);
+      if(pSrcMeta->tDim.iWidth % 3 > 1)
+      {
+        *pDst32 = toTen(*pSrcY++);
+        *pDst32 |= toTen(*pSrcY++) << 10;
+      }
+      else if(pSrcMeta->tDim.iWidth % 3 > 0)
+      {
+        *pDst32 = toTen(*pSrcY++);
+      }
     }
-  }
+  });
 
   pDstMeta->tFourCC = FOURCC(RXmA);
 }
@@ -737,31 +741,30 @@ void Y010_To_RXmA(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int h = 0; h < pSrcMeta->tDim.iHeight; h++)
+  ConvertStripes(pSrcMeta->tDim.iHeight, 1, [&](int iBeginRow, int iEndRow)
   {
-    uint32_t* pDst32 = (uint32_t*)(pDstData + h * pDstMeta->tPitches.iLuma);
-    uint16_t* pSrcY = (uint16_t*)(pSrcData + h * pSrcMeta->tPitches.iLuma);
+    for(int h = iBeginRow; h < iEndRow; h++)
+    {
+      uint32_t* pDst32 = (uint32_t*)(pDstData + h * pDstMeta->tPitches.iLuma);
+      uint16_t* pSrcY = (uint16_t*)(pSrcData + h * pSrcMeta->tPitches.iLuma);
 
-    int w = pSrcMeta->tDim.iWidth / 3;
+      int w = pSrcMeta->tDim.iWidth / 3;
 
-    while(w--)
-    {
-      *pDst32 = ((uint32_t)(*pSrcY++) & 0x3FF);
-      *pDst32 |= ((uint32_t)(*pSrcY++) & 0x3FF) << 10;
-      *pDst32 |= ((uint32_t)(*pSrcY++) & 0x3FF) << 20;
-      ++pDst32;
-    }
+      GetConvKernels()->Pack10(pSrcY, pDst32, w, 0x3FF);
+      pSrcY += 3 * w;
+      pDst32 += w;
 
-    if(pSrcMeta->tDim.iWidth % 3 > 1)
-    {
-      *pDst32 = ((uint32_t)(*pSrcY++) & 0x3FF);
-      *pDst32 |= ((uint32_t)(*pSrcY++) & 0x3FF) << 10;
-    }
-    else if(pSrcMeta->tDim.iWidth % 3 > 0)
-    {
-      *pDst32 = ((uint32_t)(*pSrcY++) & 0x3FF);
+      if(pSrcMeta->tDim.iWidth % 3 > 1)
+      {
+        *pDst32 = ((uint32_t)(*pSrcY++) & 0x3FF);
+        *pDst32 |= ((uint32_t)(*pSrcY++) & 0x3FF) << 10;
+      }
+      else if(pSrcMeta->tDim.iWidth % 3 > 0)
+      {
+        *pDst32 = ((uint32_t)(*pSrcY++) & 0x3FF);
+      }
     }
-  }
+  });
 
   pDstMeta->tFourCC = FOURCC(RXmA);
 }
@@ -786,8 +789,7 @@ static void PX10_To_I42X(AL_TBuffer const* pSrc, AL_TBuffer* pDst, uint8_t uHrzC
 
     for(int iH = 0; iH < pDstMeta->tDim.iHeight; ++iH)
     {
-      for(int iW = 0; iW < pDstMeta->tDim.iWidth; ++iW)
-        pBufOut[iW] = (uint8_t)((2 + pBufIn[iW]) >> 2);
+      GetConvKernels()->Narrow10To8(pBufIn, pBufOut, pDstMeta->tDim.iWidth);
 
       pBufIn += uSrcPitchLuma;
       pBufOut += pDstMeta->tPitches.iLuma;
@@ -805,11 +807,7 @@ static void PX10_To_I42X(AL_TBuffer const* pSrc, AL_TBuffer* pDst, uint8_t uHrzC
 
     for(int iH = 0; iH < iHeight; ++iH)
     {
-      for(int iW = 0; iW < iWidth; ++iW)
-      {
-        pBufOutU[iW] = (uint8_t)((2 + pBufInC[(iW << 1)]) >> 2);
-        pBufOutV[iW] = (uint8_t)((2 + pBufInC[(iW << 1) + 1]) >> 2);
-      }
+      GetConvKernels()->Deinterleave10To8(pBufInC, pBufOutU, pBufOutV, iWidth);
 
       pBufInC += uSrcPitchChroma;
       pBufOutU += pDstMeta->tPitches.iChroma;
@@ -865,11 +863,7 @@ static void PX10_To_IXAL(AL_TBuffer const* pSrc, AL_TBuffer* pDst, uint8_t uHrzC
 
   for(int iH = 0; iH < iHeight; ++iH)
   {
-    for(int iW = 0; iW < iWidth; ++iW)
-    {
-      pBufOutU[iW] = pBufIn[(iW << 1)];
-      pBufOutV[iW] = pBufIn[(iW << 1) + 1];
-    }
+    GetConvKernels()->Deinterleave16(pBufIn, pBufOutU, pBufOutV, iWidth);
 
     pBufIn += uSrcPitchChroma;
     pBufOutU += uDstPitchChroma;
@@ -914,7 +908,10 @@ void P010_To_YV12(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
     int iSize = iLumaSize;
 
     while(iSize--)
-      *pBufOut++ = (uint8_t)((2 + *pBufIn++) >> 2);
+    {
+      *pBufOut++ = (uint8_t)RND_10B_TO_8B(*pBufIn);
+      ++pBufIn;
+    }
   }
 
   // Chroma
@@ -926,8 +923,9 @@ void P010_To_YV12(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
 
     while(iSize--)
     {
-      *pBufOutU++ = (uint8_t)((2 + *pBufIn++) >> 2);
-      *pBufOutV++ = (uint8_t)((2 + *pBufIn++) >> 2);
+      *pBufOutU++ = (uint8_t)RND_10B_TO_8B(pBufIn[0]);
+      *pBufOutV++ = (uint8_t)RND_10B_TO_8B(pBufIn[1]);
+      pBufIn += 2;
     }
   }
 }
@@ -951,19 +949,21 @@ void P010_To_NV12(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   {
     uint16_t* pBufIn = (uint16_t*)pSrcData;
     uint8_t* pBufOut = pDstData;
-    int iSize = iLumaSize;
 
-    while(iSize--)
-      *pBufOut++ = (uint8_t)((2 + *pBufIn++) >> 2);
+    ConvertLinear(iLumaSize, pSrcMeta->tDim.iWidth, [&](int iOffset, int iNum)
+    {
+      GetConvKernels()->Narrow10To8(pBufIn + iOffset, pBufOut + iOffset, iNum);
+    });
   }
   // Chroma
   {
     uint16_t* pBufIn = ((uint16_t*)pSrcData) + iLumaSize;
     uint8_t* pBufOut = pDstData + iLumaSize;
-    int iSize = iChromaSize >> 1;
 
-    while(iSize--)
-      *pBufOut++ = (uint8_t)((2 + *pBufIn++) >> 2);
+    ConvertLinear(iChromaSize >> 1, pSrcMeta->tDim.iWidth, [&](int iOffset, int iNum)
+    {
+      GetConvKernels()->Narrow10To8(pBufIn + iOffset, pBufOut + iOffset, iNum);
+    });
   }
 }
 
@@ -998,31 +998,30 @@ void P010_To_RX0A(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   int iSrcSizeY = pSrcMeta->tDim.iHeight * pSrcMeta->tPitches.iLuma;
   int iDstSizeY = pDstMeta->tDim.iHeight * pDstMeta->tPitches.iLuma;
 
-  for(int h = 0; h < iHeightC; h++)
+  ConvertStripes(iHeightC, 1, [&](int iBeginRow, int iEndRow)
   {
-    uint32_t* pDst32 = (uint32_t*)(pDstData + iDstSizeY + h * pDstMeta->tPitches.iChroma);
-    uint16_t* pSrcC = (uint16_t*)(pSrcData + iSrcSizeY + h * pSrcMeta->tPitches.iChroma);
+    for(int h = iBeginRow; h < iEndRow; h++)
+    {
+      uint32_t* pDst32 = (uint32_t*)(pDstData + iDstSizeY + h * pDstMeta->tPitches.iChroma);
+      uint16_t* pSrcC = (uint16_t*)(pSrcData + iSrcSizeY + h * pSrcMeta->tPitches.iChroma);
 
-    int w = pSrcMeta->tDim.iWidth / 3;
+      int w = pSrcMeta->tDim.iWidth / 3;
 
-    while(w--)
-    {
-      *pDst32 = ((uint32_t)*pSrcC++);
-      *pDst32 |= ((uint32_t)*pSrcC++) << 10;
-      *pDst32 |= ((uint32_t)*pSrcC++) << 20;
-      ++pDst32;
-    }
+      GetConvKernels()->Pack10(pSrcC, pDst32, w, 0xFFFF);
+      pSrcC += 3 * w;
+      pDst32 += w;
 
-    if(pSrcMeta->tDim.iWidth % 3 > 1)
-    {
-      *pDst32 = ((uint32_t)*pSrcC++);
-      *pDst32 |= ((uint32_t)*pSrcC++) << 10;
-    }
-    else if(pSrcMeta->tDim.iWidth % 3 > 0)
-    {
-      *pDst32 = ((uint32_t)*pSrcC++);
+      if(pSrcMeta->tDim.iWidth % 3 > 1)
+      {
+        *pDst32 = ((uint32_t)*pSrcC++);
+        *pDst32 |= ((uint32_t)*pSrcC++) << 10;
+      }
+      else if(pSrcMeta->tDim.iWidth % 3 > 0)
+      {
+        *pDst32 = ((uint32_t)*pSrcC++);
+      }
     }
-  }
+  });
 
   pDstMeta->tFourCC = FOURCC(RX0A);
 }
@@ -1048,13 +1047,10 @@ void I0AL_To_I420(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
 
   while(iH--)
   {
-    int iW = pSrcMeta->tDim.iWidth >> 1;
+    GetConvKernels()->Narrow10To8(pBufIn, pBufOut, pSrcMeta->tDim.iWidth >> 1);
 
-    while(iW--)
-      *pBufOut++ = (uint8_t)((2 + *pBufIn++) >> 2);
-
-    pBufOut += pDstMeta->tPitches.iChroma - (pSrcMeta->tDim.iWidth >> 1);
-    pBufIn += uSrcPitchChroma - (pSrcMeta->tDim.iWidth >> 1);
+    pBufOut += pDstMeta->tPitches.iChroma;
+    pBufIn += uSrcPitchChroma;
   }
 
   pDstMeta->tFourCC = FOURCC(I420);
@@ -1093,26 +1089,20 @@ void I0AL_To_YV12(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
 
   while(iH--)
   {
-    int iW = pSrcMeta->tDim.iWidth >> 1;
+    GetConvKernels()->Narrow10To8(pBufIn, pBufOut, pSrcMeta->tDim.iWidth >> 1);
 
-    while(iW--)
-      *pBufOut++ = (uint8_t)((2 + *pBufIn++) >> 2);
-
-    pBufOut += pDstMeta->tPitches.iChroma - (pSrcMeta->tDim.iWidth >> 1);
-    pBufIn += uSrcPitchChroma - (pSrcMeta->tDim.iWidth >> 1);
+    pBufOut += pDstMeta->tPitches.iChroma;
+    pBufIn += uSrcPitchChroma;
   }
 
   pBufIn = (uint16_t*)(pSrcData + pSrcMeta->tPitches.iLuma * pSrcMeta->tDim.iHeight);
 
   while(iH--)
   {
-    int iW = pSrcMeta->tDim.iWidth >> 1;
-
-    while(iW--)
-      *pBufOut++ = (uint8_t)((2 + *pBufIn++) >> 2);
+    GetConvKernels()->Narrow10To8(pBufIn, pBufOut, pSrcMeta->tDim.iWidth >> 1);
 
-    pBufOut += pDstMeta->tPitches.iChroma - (pSrcMeta->tDim.iWidth >> 1);
-    pBufIn += uSrcPitchChroma - (pSrcMeta->tDim.iWidth >> 1);
+    pBufOut += pDstMeta->tPitches.iChroma;
+    pBufIn += uSrcPitchChroma;
   }
 
   pDstMeta->tFourCC = FOURCC(YV12);
@@ -1132,18 +1122,11 @@ void I0AL_To_Y800(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   uint8_t* pBufOut = AL_Buffer_GetData(pDst);
   uint32_t uSrcPitchLuma = pSrcMeta->tPitches.iLuma / sizeof(uint16_t);
 
-  int iH = pSrcMeta->tDim.iHeight;
-
-  while(iH--)
+  ConvertStripes(pSrcMeta->tDim.iHeight, 1, [&](int iBeginRow, int iEndRow)
   {
-    int iW = pSrcMeta->tDim.iWidth;
-
-    while(iW--)
-      *pBufOut++ = (uint8_t)((2 + *pBufIn++) >> 2);
-
-    pBufOut += uSrcPitchLuma - pSrcMeta->tDim.iWidth;
-    pBufIn += uSrcPitchLuma - pSrcMeta->tDim.iWidth;
-  }
+    for(int iH = iBeginRow; iH < iEndRow; ++iH)
+      GetConvKernels()->Narrow10To8(pBufIn + iH * uSrcPitchLuma, pBufOut + iH * uSrcPitchLuma, pSrcMeta->tDim.iWidth);
+  });
 
   pDstMeta->tFourCC = FOURCC(Y800);
 }
@@ -1163,14 +1146,11 @@ void I0AL_To_Y010(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   uint32_t uSrcPitchLuma = pSrcMeta->tPitches.iLuma / sizeof(uint16_t);
   uint32_t uDstPitchLuma = pDstMeta->tPitches.iLuma / sizeof(uint16_t);
 
-  int iH = pSrcMeta->tDim.iHeight;
-
-  while(iH--)
+  ConvertStripes(pSrcMeta->tDim.iHeight, 1, [&](int iBeginRow, int iEndRow)
   {
-    memcpy(pBufOut, pBufIn, pSrcMeta->tDim.iWidth * sizeof(uint16_t));
-    pBufOut += uDstPitchLuma;
-    pBufIn += uSrcPitchLuma;
-  }
+    for(int iH = iBeginRow; iH < iEndRow; ++iH)
+      memcpy(pBufOut + iH * uDstPitchLuma, pBufIn + iH * uSrcPitchLuma, pSrcMeta->tDim.iWidth * sizeof(uint16_t));
+  });
 
   pDstMeta->tFourCC = FOURCC(Y010);
 }
@@ -1191,15 +1171,11 @@ static void I42X_To_NV1X(AL_TBuffer const* pSrc, AL_TBuffer* pDst, uint8_t uHrzC
   pDstMeta->tDim.iHeight = pSrcMeta->tDim.iHeight;
 
   // Luma
-  AL_VADDR pSrcY = pSrcData;
-  AL_VADDR pDstY = pDstData;
-
-  for(int iH = 0; iH < pSrcMeta->tDim.iHeight; ++iH)
+  ConvertStripes(pSrcMeta->tDim.iHeight, 1, [&](int iBeginRow, int iEndRow)
   {
-    Rtos_Memcpy(pDstY, pSrcY, pSrcMeta->tDim.iWidth);
-    pDstY += pDstMeta->tPitches.iLuma;
-    pSrcY += pSrcMeta->tDim.iWidth;
-  }
+    for(int iH = iBeginRow; iH < iEndRow; ++iH)
+      Rtos_Memcpy(pDstData + iH * pDstMeta->tPitches.iLuma, pSrcData + iH * pSrcMeta->tDim.iWidth, pSrcMeta->tDim.iWidth);
+  });
 
   // Chroma
   AL_VADDR pBufInU = pSrcData + iSize;
@@ -1209,18 +1185,11 @@ static void I42X_To_NV1X(AL_TBuffer const* pSrc, AL_TBuffer* pDst, uint8_t uHrzC
   int iHeightC = pSrcMeta->tDim.iHeight / uVrtCScale;
   int iWidthC = pSrcMeta->tDim.iWidth / uHrzCScale;
 
-  for(int iH = 0; iH < iHeightC; ++iH)
+  ConvertStripes(iHeightC, 1, [&](int iBeginRow, int iEndRow)
   {
-    for(int iW = 0; iW < iWidthC; ++iW)
-    {
-      pBufOut[iW * 2] = pBufInU[iW];
-      pBufOut[iW * 2 + 1] = pBufInV[iW];
-    }
-
-    pBufOut += pDstMeta->tPitches.iChroma;
-    pBufInU += iWidthC;
-    pBufInV += iWidthC;
-  }
+    for(int iH = iBeginRow; iH < iEndRow; ++iH)
+      GetConvKernels()->Interleave8(pBufInU + iH * iWidthC, pBufInV + iH * iWidthC, pBufOut + iH * pDstMeta->tPitches.iChroma, iWidthC);
+  });
 
   SetFourCC(pDstMeta, FOURCC(NV12), FOURCC(NV16), iCScale);
 }
@@ -1261,13 +1230,11 @@ static void I42X_To_PX10(AL_TBuffer const* pSrc, AL_TBuffer* pDst, uint8_t uHrzC
   uint8_t* pBufInU = pSrcData + iLumaSize;
   uint8_t* pBufInV = pSrcData + iLumaSize + iChromaSize;
   uint16_t* pBufOut = ((uint16_t*)(AL_Buffer_GetData(pDst))) + iLumaSize;
-  int iSize = iChromaSize;
 
-  while(iSize--)
+  ConvertLinear(iChromaSize, pSrcMeta->tDim.iWidth / uHrzCScale, [&](int iOffset, int iNum)
   {
-    *pBufOut++ = ((uint16_t)*pBufInU++) << 2;
-    *pBufOut++ = ((uint16_t)*pBufInV++) << 2;
-  }
+    GetConvKernels()->Interleave8To10(pBufInU + iOffset, pBufInV + iOffset, pBufOut + 2 * iOffset, iNum);
+  });
 
   SetFourCC(pDstMeta, FOURCC(P010), FOURCC(P210), iCScale);
 }
@@ -1311,40 +1278,43 @@ static void I42X_To_RXXA(AL_TBuffer const* pSrc, AL_TBuffer* pDst, uint8_t uHrzC
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int h = 0; h < iHeightC; h++)
+  ConvertStripes(iHeightC, 1, [&](int iBeginRow, int iEndRow)
   {
-    uint32_t* pDst32 = (uint32_t*)(pDstData + iDstSizeY + h * pDstMeta->tPitches.iChroma);
-    uint8_t* pSrcU = (uint8_t*)(pSrcData + iSrcSizeY + h * pSrcMeta->tPitches.iChroma);
-    uint8_t* pSrcV = pSrcU + iSrcSizeC;
+    for(int h = iBeginRow; h < iEndRow; h++)
+    {
+      uint32_t* pDst32 = (uint32_t*)(pDstData + iDstSizeY + h * pDstMeta->tPitches.iChroma);
+      uint8_t* pSrcU = (uint8_t*)(pSrcData + iSrcSizeY + h * pSrcMeta->tPitches.iChroma);
+      uint8_t* pSrcV = pSrcU + iSrcSizeC;
 
-    int w = pSrcMeta->tDim.iWidth / 6;
+      int w = pSrcMeta->tDim.iWidth / 6;
 
-    while(w--)
-    {
-      *pDst32 = ((uint32_t)*pSrcU++) << 2;
-      *pDst32 |= ((uint32_t)*pSrcV++) << 12;
-      *pDst32 |= ((uint32_t)*pSrcU++) << 22;
-      ++pDst32;
-      *pDst32 = ((uint32_t)*pSrcV++) << 2;
-      *pDst32 |= ((uint32_t)*pSrcU++) << 12;
-      *pDst32 |= ((uint32_t)*pSrcV++) << 22;
-      ++pDst32;
-    }
+      while(w--)
+      {
+        *pDst32 = ((uint32_t)*pSrcU++) << 2;
+        *pDst32 |= ((uint32_t)*pSrcV++) << 12;
+        *pDst32 |= ((uint32_t)*pSrcU++) << 22;
+        ++pDst32;
+        *pDst32 = ((uint32_t)*pSrcV++) << 2;
+        *pDst32 |= ((uint32_t)*pSrcU++) << 12;
+        *pDst32 |= ((uint32_t)*pSrcV++) << 22;
+        ++pDst32;
+      }
 
-    if(pSrcMeta->tDim.iWidth % 6 > 2)
-    {
-      *pDst32 = ((uint32_t)*pSrcU++) << 2;
-      *pDst32 |= ((uint32_t)*pSrcV++) << 12;
-      *pDst32 |= ((uint32_t)*pSrcU++) << 22;
-      ++pDst32;
-      *pDst32 = ((uint32_t)*pSrcV++) << 2;
-    }
-    else if(pSrcMeta->tDim.iWidth % 6 > 0)
-    {
-      *pDst32 = ((uint32_t)*pSrcU++) << 2;
-      *pDst32 |= ((uint32_t)*pSrcV++) << 12;
+      if(pSrcMeta->tDim.iWidth % 6 > 2)
+      {
+        *pDst32 = ((uint32_t)*pSrcU++) << 2;
+        *pDst32 |= ((uint32_t)*pSrcV++) << 12;
+        *pDst32 |= ((uint32_t)*pSrcU++) << 22;
+        ++pDst32;
+        *pDst32 = ((uint32_t)*pSrcV++) << 2;
+      }
+      else if(pSrcMeta->tDim.iWidth % 6 > 0)
+      {
+        *pDst32 = ((uint32_t)*pSrcU++) << 2;
+        *pDst32 |= ((uint32_t)*pSrcV++) << 12;
+      }
     }
-  }
+  });
 
   SetFourCC(pDstMeta, FOURCC(RX0A), FOURCC(RX2A), uHrzCScale * uVrtCScale);
 }
@@ -1384,19 +1354,13 @@ static void IXAL_To_NV1X(AL_TBuffer const* pSrc, AL_TBuffer* pDst, uint8_t uHrzC
   uint16_t* pBufInU = (uint16_t*)(AL_Buffer_GetData(pSrc) + pSrcMeta->tOffsetYC.iChroma);
   uint16_t* pBufInV = pBufInU + uSrcPitchChroma * iHeightC;
   uint8_t* pBufOut = AL_Buffer_GetData(pDst) + pDstMeta->tPitches.iLuma * pDstMeta->tDim.iHeight;
+  int iDstStrideChroma = pDstMeta->tPitches.iChroma - pDstMeta->tDim.iWidth + 2 * iWidthC;
 
-  for(int iH = 0; iH < iHeightC; ++iH)
+  ConvertStripes(iHeightC, 1, [&](int iBeginRow, int iEndRow)
   {
-    for(int iW = 0; iW < iWidthC; ++iW)
-    {
-      *pBufOut++ = (uint8_t)((2 + *pBufInU++) >> 2);
-      *pBufOut++ = (uint8_t)((2 + *pBufInV++) >> 2);
-    }
-
-    pBufOut += pDstMeta->tPitches.iChroma - pDstMeta->tDim.iWidth;
-    pBufInU += uSrcPitchChroma - iWidthC;
-    pBufInV += uSrcPitchChroma - iWidthC;
-  }
+    for(int iH = iBeginRow; iH < iEndRow; ++iH)
+      GetConvKernels()->Interleave10To8(pBufInU + iH * uSrcPitchChroma, pBufInV + iH * uSrcPitchChroma, pBufOut + iH * iDstStrideChroma, iWidthC);
+  });
 
   SetFourCC(pDstMeta, FOURCC(NV12), FOURCC(NV16), uHrzCScale * uVrtCScale);
 }
@@ -1435,18 +1399,11 @@ static void IXAL_To_PX10(AL_TBuffer const* pSrc, AL_TBuffer* pDst, uint8_t uHrzC
   uint16_t* pBufInU = (uint16_t*)(AL_Buffer_GetData(pSrc) + pSrcMeta->tOffsetYC.iChroma);
   uint16_t* pBufInV = pBufInU + uSrcPitchChroma * iHeightC;
 
-  for(int iH = 0; iH < iHeightC; ++iH)
+  ConvertStripes(iHeightC, 1, [&](int iBeginRow, int iEndRow)
   {
-    for(int iW = 0; iW < iWidthC; ++iW)
-    {
-      pBufOut[2 * iW] = pBufInU[iW];
-      pBufOut[2 * iW + 1] = pBufInV[iW];
-    }
-
-    pBufInU += uSrcPitchChroma;
-    pBufInV += uSrcPitchChroma;
-    pBufOut += uDstPitchChroma;
-  }
+    for(int iH = iBeginRow; iH < iEndRow; ++iH)
+      GetConvKernels()->Interleave16(pBufInU + iH * uSrcPitchChroma, pBufInV + iH * uSrcPitchChroma, pBufOut + iH * uDstPitchChroma, iWidthC);
+  });
 
   SetFourCC(pDstMeta, FOURCC(P010), FOURCC(P210), uHrzCScale * uVrtCScale);
 }
@@ -1483,40 +1440,43 @@ static void IXAL_To_RXXA(AL_TBuffer const* pSrc, AL_TBuffer* pDst, uint8_t uHrzC
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int h = 0; h < iHeightC; h++)
+  ConvertStripes(iHeightC, 1, [&](int iBeginRow, int iEndRow)
   {
-    uint32_t* pDst32 = (uint32_t*)(pDstData + iDstSizeY + h * pDstMeta->tPitches.iChroma);
-    uint16_t* pSrcU = (uint16_t*)(pSrcData + pSrcMeta->tOffsetYC.iChroma + h * pSrcMeta->tPitches.iChroma);
-    uint16_t* pSrcV = pSrcU + uSrcPitchChroma * iHeightC;
+    for(int h = iBeginRow; h < iEndRow; h++)
+    {
+      uint32_t* pDst32 = (uint32_t*)(pDstData + iDstSizeY + h * pDstMeta->tPitches.iChroma);
+      uint16_t* pSrcU = (uint16_t*)(pSrcData + pSrcMeta->tOffsetYC.iChroma + h * pSrcMeta->tPitches.iChroma);
+      uint16_t* pSrcV = pSrcU + uSrcPitchChroma * iHeightC;
 
-    int w = pSrcMeta->tDim.iWidth / 6;
+      int w = pSrcMeta->tDim.iWidth / 6;
 
-    while(w--)
-    {
-      *pDst32 = ((uint32_t)(*pSrcU++) & 0x3FF);
-      *pDst32 |= ((uint32_t)(*pSrcV++) & 0x3FF) << 10;
-      *pDst32 |= ((uint32_t)(*pSrcU++) & 0x3FF) << 20;
-      ++pDst32;
-      *pDst32 = ((uint32_t)(*pSrcV++) & 0x3FF);
-      *pDst32 |= ((uint32_t)(*pSrcU++) & 0x3FF) << 10;
-      *pDst32 |= ((uint32_t)(*pSrcV++) & 0x3FF) << 20;
-      ++pDst32;
-    }
+      while(w--)
+      {
+        *pDst32 = ((uint32_t)(*pSrcU++) & 0x3FF);
+        *pDst32 |= ((uint32_t)(*pSrcV++) & 0x3FF) << 10;
+        *pDst32 |= ((uint32_t)(*pSrcU++) & 0x3FF) << 20;
+        ++pDst32;
+        *pDst32 = ((uint32_t)(*pSrcV++) & 0x3FF);
+        *pDst32 |= ((uint32_t)(*pSrcU++) & 0x3FF) << 10;
+        *pDst32 |= ((uint32_t)(*pSrcV++) & 0x3FF) << 20;
+        ++pDst32;
+      }
 
-    if(pSrcMeta->tDim.iWidth % 6 > 2)
-    {
-      *pDst32 = ((uint32_t)(*pSrcU++) & 0x3FF);
-      *pDst32 |= ((uint32_t)(*pSrcV++) & 0x3FF) << 10;
-      *pDst32 |= ((uint32_t)(*pSrcU++) & 0x3FF) << 20;
-      ++pDst32;
-      *pDst32 = ((uint32_t)(*pSrcV++) & 0x3FF);
-    }
-    else if(pSrcMeta->tDim.iWidth % 6 > 0)
-    {
-      *pDst32 = ((uint32_t)(*pSrcU++) & 0x3FF);
-      *pDst32 |= ((uint32_t)(*pSrcV++) & 0x3FF) << 10;
+      if(pSrcMeta->tDim.iWidth % 6 > 2)
+      {
+        *pDst32 = ((uint32_t)(*pSrcU++) & 0x3FF);
+        *pDst32 |= ((uint32_t)(*pSrcV++) & 0x3FF) << 10;
+        *pDst32 |= ((uint32_t)(*pSrcU++) & 0x3FF) << 20;
+        ++pDst32;
+        *pDst32 = ((uint32_t)(*pSrcV++) & 0x3FF);
+      }
+      else if(pSrcMeta->tDim.iWidth % 6 > 0)
+      {
+        *pDst32 = ((uint32_t)(*pSrcU++) & 0x3FF);
+        *pDst32 |= ((uint32_t)(*pSrcV++) & 0x3FF) << 10;
+      }
     }
-  }
+  });
 
   SetFourCC(pDstMeta, FOURCC(RX0A), FOURCC(RX2A), uHrzCScale * uVrtCScale);
 }
@@ -1547,60 +1507,63 @@ void ALX8_To_I42X(AL_TBuffer const* pSrc, AL_TBuffer* pDst, int iHeightC)
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int H = 0; H < iHeightC; H += iTileH)
+  ConvertTileStripes(iHeightC, iTileH, [&](int iBeginRow, int iEndRow)
   {
-    uint8_t* pInC = pSrcData + pSrcMeta->tOffsetYC.iChroma + (H / iTileH) * pSrcMeta->tPitches.iChroma;
+    for(int H = iBeginRow; H < iEndRow; H += iTileH)
+    {
+      uint8_t* pInC = pSrcData + pSrcMeta->tOffsetYC.iChroma + (H / iTileH) * pSrcMeta->tPitches.iChroma;
 
-    int iCropH = (H + iTileH) - iHeightC;
+      int iCropH = (H + iTileH) - iHeightC;
 
-    if(iCropH < 0)
-      iCropH = 0;
+      if(iCropH < 0)
+        iCropH = 0;
 
-    for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
-    {
-      int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
+      for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
+      {
+        int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
 
-      if(iCropW < 0)
-        iCropW = 0;
+        if(iCropW < 0)
+          iCropW = 0;
 
-      for(int h = 0; h < iTileH - iCropH; h += 4)
-      {
-        for(int w = 0; w < iTileW - iCropW; w += 4)
+        for(int h = 0; h < iTileH - iCropH; h += 4)
         {
-          uint8_t* pOutU = pDstData + iOffsetU + (H + h) * pDstMeta->tPitches.iChroma + (W + w) / 2;
-          uint8_t* pOutV = pDstData + iOffsetV + (H + h) * pDstMeta->tPitches.iChroma + (W + w) / 2;
-
-          pOutU[0] = pInC[0];
-          pOutV[0] = pInC[1];
-          pOutU[1] = pInC[2];
-          pOutV[1] = pInC[3];
-          pOutU += pDstMeta->tPitches.iChroma;
-          pOutV += pDstMeta->tPitches.iChroma;
-          pOutU[0] = pInC[4];
-          pOutV[0] = pInC[5];
-          pOutU[1] = pInC[6];
-          pOutV[1] = pInC[7];
-          pOutU += pDstMeta->tPitches.iChroma;
-          pOutV += pDstMeta->tPitches.iChroma;
-          pOutU[0] = pInC[8];
-          pOutV[0] = pInC[9];
-          pOutU[1] = pInC[10];
-          pOutV[1] = pInC[11];
-          pOutU += pDstMeta->tPitches.iChroma;
-          pOutV += pDstMeta->tPitches.iChroma;
-          pOutU[0] = pInC[12];
-          pOutV[0] = pInC[13];
-          pOutU[1] = pInC[14];
-          pOutV[1] = pInC[15];
-          pInC += 16;
+          for(int w = 0; w < iTileW - iCropW; w += 4)
+          {
+            uint8_t* pOutU = pDstData + iOffsetU + (H + h) * pDstMeta->tPitches.iChroma + (W + w) / 2;
+            uint8_t* pOutV = pDstData + iOffsetV + (H + h) * pDstMeta->tPitches.iChroma + (W + w) / 2;
+
+            pOutU[0] = pInC[0];
+            pOutV[0] = pInC[1];
+            pOutU[1] = pInC[2];
+            pOutV[1] = pInC[3];
+            pOutU += pDstMeta->tPitches.iChroma;
+            pOutV += pDstMeta->tPitches.iChroma;
+            pOutU[0] = pInC[4];
+            pOutV[0] = pInC[5];
+            pOutU[1] = pInC[6];
+            pOutV[1] = pInC[7];
+            pOutU += pDstMeta->tPitches.iChroma;
+            pOutV += pDstMeta->tPitches.iChroma;
+            pOutU[0] = pInC[8];
+            pOutV[0] = pInC[9];
+            pOutU[1] = pInC[10];
+            pOutV[1] = pInC[11];
+            pOutU += pDstMeta->tPitches.iChroma;
+            pOutV += pDstMeta->tPitches.iChroma;
+            pOutU[0] = pInC[12];
+            pOutV[0] = pInC[13];
+            pOutU[1] = pInC[14];
+            pOutV[1] = pInC[15];
+            pInC += 16;
+          }
+
+          pInC += 4 * iCropW;
         }
 
-        pInC += 4 * iCropW;
+        pInC += iCropH * iTileW;
       }
-
-      pInC += iCropH * iTileW;
     }
-  }
+  });
 }
 
 /****************************************************************************/
@@ -1647,60 +1610,63 @@ void T608_To_YV12(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int H = 0; H < iHeightC; H += iTileH)
+  ConvertTileStripes(iHeightC, iTileH, [&](int iBeginRow, int iEndRow)
   {
-    uint8_t* pInC = pSrcData + iSrcLumaSize + (H / iTileH) * pSrcMeta->tPitches.iChroma;
+    for(int H = iBeginRow; H < iEndRow; H += iTileH)
+    {
+      uint8_t* pInC = pSrcData + iSrcLumaSize + (H / iTileH) * pSrcMeta->tPitches.iChroma;
 
-    int iCropH = (H + iTileH) - iHeightC;
+      int iCropH = (H + iTileH) - iHeightC;
 
-    if(iCropH < 0)
-      iCropH = 0;
+      if(iCropH < 0)
+        iCropH = 0;
 
-    for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
-    {
-      int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
+      for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
+      {
+        int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
 
-      if(iCropW < 0)
-        iCropW = 0;
+        if(iCropW < 0)
+          iCropW = 0;
 
-      for(int h = 0; h < iTileH - iCropH; h += 4)
-      {
-        for(int w = 0; w < iTileW - iCropW; w += 4)
+        for(int h = 0; h < iTileH - iCropH; h += 4)
         {
-          uint8_t* pOutU = pDstData + iOffsetU + (H + h) * pDstMeta->tPitches.iChroma + (W + w) / 2;
-          uint8_t* pOutV = pDstData + iOffsetV + (H + h) * pDstMeta->tPitches.iChroma + (W + w) / 2;
-
-          pOutU[0] = pInC[0];
-          pOutV[0] = pInC[1];
-          pOutU[1] = pInC[2];
-          pOutV[1] = pInC[3];
-          pOutU += pDstMeta->tPitches.iChroma;
-          pOutV += pDstMeta->tPitches.iChroma;
-          pOutU[0] = pInC[4];
-          pOutV[0] = pInC[5];
-          pOutU[1] = pInC[6];
-          pOutV[1] = pInC[7];
-          pOutU += pDstMeta->tPitches.iChroma;
-          pOutV += pDstMeta->tPitches.iChroma;
-          pOutU[0] = pInC[8];
-          pOutV[0] = pInC[9];
-          pOutU[1] = pInC[10];
-          pOutV[1] = pInC[11];
-          pOutU += pDstMeta->tPitches.iChroma;
-          pOutV += pDstMeta->tPitches.iChroma;
-          pOutU[0] = pInC[12];
-          pOutV[0] = pInC[13];
-          pOutU[1] = pInC[14];
-          pOutV[1] = pInC[15];
-          pInC += 16;
+          for(int w = 0; w < iTileW - iCropW; w += 4)
+          {
+            uint8_t* pOutU = pDstData + iOffsetU + (H + h) * pDstMeta->tPitches.iChroma + (W + w) / 2;
+            uint8_t* pOutV = pDstData + iOffsetV + (H + h) * pDstMeta->tPitches.iChroma + (W + w) / 2;
+
+            pOutU[0] = pInC[0];
+            pOutV[0] = pInC[1];
+            pOutU[1] = pInC[2];
+            pOutV[1] = pInC[3];
+            pOutU += pDstMeta->tPitches.iChroma;
+            pOutV += pDstMeta->tPitches.iChroma;
+            pOutU[0] = pInC[4];
+            pOutV[0] = pInC[5];
+            pOutU[1] = pInC[6];
+            pOutV[1] = pInC[7];
+            pOutU += pDstMeta->tPitches.iChroma;
+            pOutV += pDstMeta->tPitches.iChroma;
+            pOutU[0] = pInC[8];
+            pOutV[0] = pInC[9];
+            pOutU[1] = pInC[10];
+            pOutV[1] = pInC[11];
+            pOutU += pDstMeta->tPitches.iChroma;
+            pOutV += pDstMeta->tPitches.iChroma;
+            pOutU[0] = pInC[12];
+            pOutV[0] = pInC[13];
+            pOutU[1] = pInC[14];
+            pOutV[1] = pInC[15];
+            pInC += 16;
+          }
+
+          pInC += 4 * iCropW;
         }
 
-        pInC += 4 * iCropW;
+        pInC += iCropH * iTileW;
       }
-
-      pInC += iCropH * iTileW;
     }
-  }
+  });
 
   pDstMeta->tFourCC = FOURCC(YV12);
 }
@@ -1725,56 +1691,39 @@ void T608_To_NV12(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int H = 0; H < iHeightC; H += iTileH)
+  ConvertTileStripes(iHeightC, iTileH, [&](int iBeginRow, int iEndRow)
   {
-    uint8_t* pInC = pSrcData + iSrcLumaSize + (H / iTileH) * pSrcMeta->tPitches.iChroma;
+    for(int H = iBeginRow; H < iEndRow; H += iTileH)
+    {
+      uint8_t* pInC = pSrcData + iSrcLumaSize + (H / iTileH) * pSrcMeta->tPitches.iChroma;
 
-    int iCropH = (H + iTileH) - iHeightC;
+      int iCropH = (H + iTileH) - iHeightC;
 
-    if(iCropH < 0)
-      iCropH = 0;
+      if(iCropH < 0)
+        iCropH = 0;
 
-    for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
-    {
-      int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
+      for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
+      {
+        int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
 
-      if(iCropW < 0)
-        iCropW = 0;
+        if(iCropW < 0)
+          iCropW = 0;
 
-      for(int h = 0; h < iTileH - iCropH; h += 4)
-      {
-        for(int w = 0; w < iTileW - iCropW; w += 4)
+        for(int h = 0; h < iTileH - iCropH; h += 4)
         {
-          uint8_t* pOutC = pDstData + iOffsetC + (H + h) * pDstMeta->tPitches.iChroma + (W + w);
-
-          pOutC[0] = pInC[0];
-          pOutC[1] = pInC[1];
-          pOutC[2] = pInC[2];
-          pOutC[3] = pInC[3];
-          pOutC += pDstMeta->tPitches.iChroma;
-          pOutC[0] = pInC[4];
-          pOutC[1] = pInC[5];
-          pOutC[2] = pInC[6];
-          pOutC[3] = pInC[7];
-          pOutC += pDstMeta->tPitches.iChroma;
-          pOutC[0] = pInC[8];
-          pOutC[1] = pInC[9];
-          pOutC[2] = pInC[10];
-          pOutC[3] = pInC[11];
-          pOutC += pDstMeta->tPitches.iChroma;
-          pOutC[0] = pInC[12];
-          pOutC[1] = pInC[13];
-          pOutC[2] = pInC[14];
-          pOutC[3] = pInC[15];
-          pInC += 16;
+          int iNumBlocks = (iTileW - iCropW + 3) / 4;
+          uint8_t* pOutC = pDstData + iOffsetC + (H + h) * pDstMeta->tPitches.iChroma + W;
+
+          GetConvKernels()->Untile8(pInC, pOutC, pDstMeta->tPitches.iChroma, iNumBlocks);
+          pInC += 16 * iNumBlocks;
+
+          pInC += 4 * iCropW;
         }
 
-        pInC += 4 * iCropW;
+        pInC += iCropH * iTileW;
       }
-
-      pInC += iCropH * iTileW;
     }
-  }
+  });
 
   pDstMeta->tFourCC = FOURCC(NV12);
 }
@@ -1792,56 +1741,39 @@ void T608_To_Y800(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int H = 0; H < pDstMeta->tDim.iHeight; H += iTileH)
+  ConvertTileStripes(pDstMeta->tDim.iHeight, iTileH, [&](int iBeginRow, int iEndRow)
   {
-    uint8_t* pInY = pSrcData + (H / iTileH) * pSrcMeta->tPitches.iLuma;
+    for(int H = iBeginRow; H < iEndRow; H += iTileH)
+    {
+      uint8_t* pInY = pSrcData + (H / iTileH) * pSrcMeta->tPitches.iLuma;
 
-    int iCropH = (H + iTileH) - pDstMeta->tDim.iHeight;
+      int iCropH = (H + iTileH) - pDstMeta->tDim.iHeight;
 
-    if(iCropH < 0)
-      iCropH = 0;
+      if(iCropH < 0)
+        iCropH = 0;
 
-    for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
-    {
-      int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
+      for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
+      {
+        int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
 
-      if(iCropW < 0)
-        iCropW = 0;
+        if(iCropW < 0)
+          iCropW = 0;
 
-      for(int h = 0; h < iTileH - iCropH; h += 4)
-      {
-        for(int w = 0; w < iTileW - iCropW; w += 4)
+        for(int h = 0; h < iTileH - iCropH; h += 4)
         {
-          uint8_t* pOutY = pDstData + (H + h) * pDstMeta->tPitches.iLuma + (W + w);
-
-          pOutY[0] = pInY[0];
-          pOutY[1] = pInY[1];
-          pOutY[2] = pInY[2];
-          pOutY[3] = pInY[3];
-          pOutY += pDstMeta->tPitches.iLuma;
-          pOutY[0] = pInY[4];
-          pOutY[1] = pInY[5];
-          pOutY[2] = pInY[6];
-          pOutY[3] = pInY[7];
-          pOutY += pDstMeta->tPitches.iLuma;
-          pOutY[0] = pInY[8];
-          pOutY[1] = pInY[9];
-          pOutY[2] = pInY[10];
-          pOutY[3] = pInY[11];
-          pOutY += pDstMeta->tPitches.iLuma;
-          pOutY[0] = pInY[12];
-          pOutY[1] = pInY[13];
-          pOutY[2] = pInY[14];
-          pOutY[3] = pInY[15];
-          pInY += 16;
+          int iNumBlocks = (iTileW - iCropW + 3) / 4;
+          uint8_t* pOutY = pDstData + (H + h) * pDstMeta->tPitches.iLuma + W;
+
+          GetConvKernels()->Untile8(pInY, pOutY, pDstMeta->tPitches.iLuma, iNumBlocks);
+          pInY += 16 * iNumBlocks;
+
+          pInY += 4 * iCropW;
         }
 
-        pInY += 4 * iCropW;
+        pInY += iCropH * iTileW;
       }
-
-      pInY += iCropH * iTileW;
     }
-  }
+  });
 
   pDstMeta->tFourCC = FOURCC(Y800);
 }
@@ -1861,56 +1793,59 @@ void T608_To_Y010(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int H = 0; H < pDstMeta->tDim.iHeight; H += iTileH)
+  ConvertTileStripes(pDstMeta->tDim.iHeight, iTileH, [&](int iBeginRow, int iEndRow)
   {
-    uint8_t* pInY = pSrcData + (H / iTileH) * pSrcMeta->tPitches.iLuma;
+    for(int H = iBeginRow; H < iEndRow; H += iTileH)
+    {
+      uint8_t* pInY = pSrcData + (H / iTileH) * pSrcMeta->tPitches.iLuma;
 
-    int iCropH = (H + iTileH) - pDstMeta->tDim.iHeight;
+      int iCropH = (H + iTileH) - pDstMeta->tDim.iHeight;
 
-    if(iCropH < 0)
-      iCropH = 0;
+      if(iCropH < 0)
+        iCropH = 0;
 
-    for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
-    {
-      int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
+      for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
+      {
+        int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
 
-      if(iCropW < 0)
-        iCropW = 0;
+        if(iCropW < 0)
+          iCropW = 0;
 
-      for(int h = 0; h < iTileH - iCropH; h += 4)
-      {
-        for(int w = 0; w < iTileW - iCropW; w += 4)
+        for(int h = 0; h < iTileH - iCropH; h += 4)
         {
-          uint16_t* pOutY = ((uint16_t*)pDstData) + (H + h) * iDstPitchLuma + (W + w);
-
-          pOutY[0] = ((uint16_t)pInY[0]) << 2;
-          pOutY[1] = ((uint16_t)pInY[1]) << 2;
-          pOutY[2] = ((uint16_t)pInY[2]) << 2;
-          pOutY[3] = ((uint16_t)pInY[3]) << 2;
-          pOutY += iDstPitchLuma;
-          pOutY[0] = ((uint16_t)pInY[4]) << 2;
-          pOutY[1] = ((uint16_t)pInY[5]) << 2;
-          pOutY[2] = ((uint16_t)pInY[6]) << 2;
-          pOutY[3] = ((uint16_t)pInY[7]) << 2;
-          pOutY += iDstPitchLuma;
-          pOutY[0] = ((uint16_t)pInY[8]) << 2;
-          pOutY[1] = ((uint16_t)pInY[9]) << 2;
-          pOutY[2] = ((uint16_t)pInY[10]) << 2;
-          pOutY[3] = ((uint16_t)pInY[11]) << 2;
-          pOutY += iDstPitchLuma;
-          pOutY[0] = ((uint16_t)pInY[12]) << 2;
-          pOutY[1] = ((uint16_t)pInY[13]) << 2;
-          pOutY[2] = ((uint16_t)pInY[14]) << 2;
-          pOutY[3] = ((uint16_t)pInY[15]) << 2;
-          pInY += 16;
+          for(int w = 0; w < iTileW - iCropW; w += 4)
+          {
+            uint16_t* pOutY = ((uint16_t*)pDstData) + (H + h) * iDstPitchLuma + (W + w);
+
+            pOutY[0] = ((uint16_t)pInY[0]) << 2;
+            pOutY[1] = ((uint16_t)pInY[1]) << 2;
+            pOutY[2] = ((uint16_t)pInY[2]) << 2;
+            pOutY[3] = ((uint16_t)pInY[3]) << 2;
+            pOutY += iDstPitchLuma;
+            pOutY[0] = ((uint16_t)pInY[4]) << 2;
+            pOutY[1] = ((uint16_t)pInY[5]) << 2;
+            pOutY[2] = ((uint16_t)pInY[6]) << 2;
+            pOutY[3] = ((uint16_t)pInY[7]) << 2;
+            pOutY += iDstPitchLuma;
+            pOutY[0] = ((uint16_t)pInY[8]) << 2;
+            pOutY[1] = ((uint16_t)pInY[9]) << 2;
+            pOutY[2] = ((uint16_t)pInY[10]) << 2;
+            pOutY[3] = ((uint16_t)pInY[11]) << 2;
+            pOutY += iDstPitchLuma;
+            pOutY[0] = ((uint16_t)pInY[12]) << 2;
+            pOutY[1] = ((uint16_t)pInY[13]) << 2;
+            pOutY[2] = ((uint16_t)pInY[14]) << 2;
+            pOutY[3] = ((uint16_t)pInY[15]) << 2;
+            pInY += 16;
+          }
+
+          pInY += 4 * iCropW;
         }
 
-        pInY += 4 * iCropW;
+        pInY += iCropH * iTileW;
       }
-
-      pInY += iCropH * iTileW;
     }
-  }
+  });
 }
 
 /****************************************************************************/
@@ -1934,56 +1869,59 @@ void T608_To_P010(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int H = 0; H < iHeightC; H += iTileH)
+  ConvertTileStripes(iHeightC, iTileH, [&](int iBeginRow, int iEndRow)
   {
-    uint8_t* pInC = pSrcData + iSrcLumaSize + (H / iTileH) * pSrcMeta->tPitches.iChroma;
+    for(int H = iBeginRow; H < iEndRow; H += iTileH)
+    {
+      uint8_t* pInC = pSrcData + iSrcLumaSize + (H / iTileH) * pSrcMeta->tPitches.iChroma;
 
-    int iCropH = (H + iTileH) - iHeightC;
+      int iCropH = (H + iTileH) - iHeightC;
 
-    if(iCropH < 0)
-      iCropH = 0;
+      if(iCropH < 0)
+        iCropH = 0;
 
-    for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
-    {
-      int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
+      for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
+      {
+        int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
 
-      if(iCropW < 0)
-        iCropW = 0;
+        if(iCropW < 0)
+          iCropW = 0;
 
-      for(int h = 0; h < iTileH - iCropH; h += 4)
-      {
-        for(int w = 0; w < iTileW - iCropW; w += 4)
+        for(int h = 0; h < iTileH - iCropH; h += 4)
         {
-          uint16_t* pOutC = ((uint16_t*)(pDstData + iOffsetC)) + (H + h) * iDstPitchChroma + (W + w);
-
-          pOutC[0] = ((uint16_t)pInC[0]) << 2;
-          pOutC[1] = ((uint16_t)pInC[1]) << 2;
-          pOutC[2] = ((uint16_t)pInC[2]) << 2;
-          pOutC[3] = ((uint16_t)pInC[3]) << 2;
-          pOutC += iDstPitchChroma;
-          pOutC[0] = ((uint16_t)pInC[4]) << 2;
-          pOutC[1] = ((uint16_t)pInC[5]) << 2;
-          pOutC[2] = ((uint16_t)pInC[6]) << 2;
-          pOutC[3] = ((uint16_t)pInC[7]) << 2;
-          pOutC += iDstPitchChroma;
-          pOutC[0] = ((uint16_t)pInC[8]) << 2;
-          pOutC[1] = ((uint16_t)pInC[9]) << 2;
-          pOutC[2] = ((uint16_t)pInC[10]) << 2;
-          pOutC[3] = ((uint16_t)pInC[11]) << 2;
-          pOutC += iDstPitchChroma;
-          pOutC[0] = ((uint16_t)pInC[12]) << 2;
-          pOutC[1] = ((uint16_t)pInC[13]) << 2;
-          pOutC[2] = ((uint16_t)pInC[14]) << 2;
-          pOutC[3] = ((uint16_t)pInC[15]) << 2;
-          pInC += 16;
+          for(int w = 0; w < iTileW - iCropW; w += 4)
+          {
+            uint16_t* pOutC = ((uint16_t*)(pDstData + iOffsetC)) + (H + h) * iDstPitchChroma + (W + w);
+
+            pOutC[0] = ((uint16_t)pInC[0]) << 2;
+            pOutC[1] = ((uint16_t)pInC[1]) << 2;
+            pOutC[2] = ((uint16_t)pInC[2]) << 2;
+            pOutC[3] = ((uint16_t)pInC[3]) << 2;
+            pOutC += iDstPitchChroma;
+            pOutC[0] = ((uint16_t)pInC[4]) << 2;
+            pOutC[1] = ((uint16_t)pInC[5]) << 2;
+            pOutC[2] = ((uint16_t)pInC[6]) << 2;
+            pOutC[3] = ((uint16_t)pInC[7]) << 2;
+            pOutC += iDstPitchChroma;
+            pOutC[0] = ((uint16_t)pInC[8]) << 2;
+            pOutC[1] = ((uint16_t)pInC[9]) << 2;
+            pOutC[2] = ((uint16_t)pInC[10]) << 2;
+            pOutC[3] = ((uint16_t)pInC[11]) << 2;
+            pOutC += iDstPitchChroma;
+            pOutC[0] = ((uint16_t)pInC[12]) << 2;
+            pOutC[1] = ((uint16_t)pInC[13]) << 2;
+            pOutC[2] = ((uint16_t)pInC[14]) << 2;
+            pOutC[3] = ((uint16_t)pInC[15]) << 2;
+            pInC += 16;
+          }
+
+          pInC += 4 * iCropW;
         }
 
-        pInC += 4 * iCropW;
+        pInC += iCropH * iTileW;
       }
-
-      pInC += iCropH * iTileW;
     }
-  }
+  });
 
   pDstMeta->tFourCC = FOURCC(P010);
 }
@@ -2010,60 +1948,63 @@ void T608_To_I0AL(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int H = 0; H < iHeightC; H += iTileH)
+  ConvertTileStripes(iHeightC, iTileH, [&](int iBeginRow, int iEndRow)
   {
-    uint8_t* pInC = pSrcData + iSrcLumaSize + (H / iTileH) * pSrcMeta->tPitches.iChroma;
+    for(int H = iBeginRow; H < iEndRow; H += iTileH)
+    {
+      uint8_t* pInC = pSrcData + iSrcLumaSize + (H / iTileH) * pSrcMeta->tPitches.iChroma;
 
-    int iCropH = (H + iTileH) - iHeightC;
+      int iCropH = (H + iTileH) - iHeightC;
 
-    if(iCropH < 0)
-      iCropH = 0;
+      if(iCropH < 0)
+        iCropH = 0;
 
-    for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
-    {
-      int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
+      for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
+      {
+        int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
 
-      if(iCropW < 0)
-        iCropW = 0;
+        if(iCropW < 0)
+          iCropW = 0;
 
-      for(int h = 0; h < iTileH - iCropH; h += 4)
-      {
-        for(int w = 0; w < iTileW - iCropW; w += 4)
+        for(int h = 0; h < iTileH - iCropH; h += 4)
         {
-          uint16_t* pOutU = (uint16_t*)(pDstData + iOffsetU) + (H + h) * iDstPichChroma + (W + w) / 2;
-          uint16_t* pOutV = (uint16_t*)(pDstData + iOffsetV) + (H + h) * iDstPichChroma + (W + w) / 2;
-
-          pOutU[0] = ((uint16_t)pInC[0]) << 2;
-          pOutV[0] = ((uint16_t)pInC[1]) << 2;
-          pOutU[1] = ((uint16_t)pInC[2]) << 2;
-          pOutV[1] = ((uint16_t)pInC[3]) << 2;
-          pOutU += iDstPichChroma;
-          pOutV += iDstPichChroma;
-          pOutU[0] = ((uint16_t)pInC[4]) << 2;
-          pOutV[0] = ((uint16_t)pInC[5]) << 2;
-          pOutU[1] = ((uint16_t)pInC[6]) << 2;
-          pOutV[1] = ((uint16_t)pInC[7]) << 2;
-          pOutU += iDstPichChroma;
-          pOutV += iDstPichChroma;
-          pOutU[0] = ((uint16_t)pInC[8]) << 2;
-          pOutV[0] = ((uint16_t)pInC[9]) << 2;
-          pOutU[1] = ((uint16_t)pInC[10]) << 2;
-          pOutV[1] = ((uint16_t)pInC[11]) << 2;
-          pOutU += iDstPichChroma;
-          pOutV += iDstPichChroma;
-          pOutU[0] = ((uint16_t)pInC[12]) << 2;
-          pOutV[0] = ((uint16_t)pInC[13]) << 2;
-          pOutU[1] = ((uint16_t)pInC[14]) << 2;
-          pOutV[1] = ((uint16_t)pInC[15]) << 2;
-          pInC += 16;
+          for(int w = 0; w < iTileW - iCropW; w += 4)
+          {
+            uint16_t* pOutU = (uint16_t*)(pDstData + iOffsetU) + (H + h) * iDstPichChroma + (W + w) / 2;
+            uint16_t* pOutV = (uint16_t*)(pDstData + iOffsetV) + (H + h) * iDstPichChroma + (W + w) / 2;
+
+            pOutU[0] = ((uint16_t)pInC[0]) << 2;
+            pOutV[0] = ((uint16_t)pInC[1]) << 2;
+            pOutU[1] = ((uint16_t)pInC[2]) << 2;
+            pOutV[1] = ((uint16_t)pInC[3]) << 2;
+            pOutU += iDstPichChroma;
+            pOutV += iDstPichChroma;
+            pOutU[0] = ((uint16_t)pInC[4]) << 2;
+            pOutV[0] = ((uint16_t)pInC[5]) << 2;
+            pOutU[1] = ((uint16_t)pInC[6]) << 2;
+            pOutV[1] = ((uint16_t)pInC[7]) << 2;
+            pOutU += iDstPichChroma;
+            pOutV += iDstPichChroma;
+            pOutU[0] = ((uint16_t)pInC[8]) << 2;
+            pOutV[0] = ((uint16_t)pInC[9]) << 2;
+            pOutU[1] = ((uint16_t)pInC[10]) << 2;
+            pOutV[1] = ((uint16_t)pInC[11]) << 2;
+            pOutU += iDstPichChroma;
+            pOutV += iDstPichChroma;
+            pOutU[0] = ((uint16_t)pInC[12]) << 2;
+            pOutV[0] = ((uint16_t)pInC[13]) << 2;
+            pOutU[1] = ((uint16_t)pInC[14]) << 2;
+            pOutV[1] = ((uint16_t)pInC[15]) << 2;
+            pInC += 16;
+          }
+
+          pInC += 4 * iCropW;
         }
 
-        pInC += 4 * iCropW;
+        pInC += iCropH * iTileW;
       }
-
-      pInC += iCropH * iTileW;
     }
-  }
+  });
 
   pDstMeta->tFourCC = FOURCC(I0AL);
 }
@@ -2302,60 +2243,63 @@ void T60A_To_I420(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int H = 0; H < iHeightC; H += iTileH)
+  ConvertTileStripes(iHeightC, iTileH, [&](int iBeginRow, int iEndRow)
   {
-    uint16_t* pInC = (uint16_t*)(pSrcData + iSrcLumaSize + (H / iTileH) * pSrcMeta->tPitches.iChroma);
+    for(int H = iBeginRow; H < iEndRow; H += iTileH)
+    {
+      uint16_t* pInC = (uint16_t*)(pSrcData + iSrcLumaSize + (H / iTileH) * pSrcMeta->tPitches.iChroma);
 
-    int iCropH = (H + iTileH) - iHeightC;
+      int iCropH = (H + iTileH) - iHeightC;
 
-    if(iCropH < 0)
-      iCropH = 0;
+      if(iCropH < 0)
+        iCropH = 0;
 
-    for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
-    {
-      int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
+      for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
+      {
+        int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
 
-      if(iCropW < 0)
-        iCropW = 0;
+        if(iCropW < 0)
+          iCropW = 0;
 
-      for(int h = 0; h < iTileH - iCropH; h += 4)
-      {
-        for(int w = 0; w < iTileW - iCropW; w += 4)
+        for(int h = 0; h < iTileH - iCropH; h += 4)
         {
-          uint8_t* pOutU = pDstData + iOffsetU + (H + h) * pDstMeta->tPitches.iChroma + (W + w) / 2;
-          uint8_t* pOutV = pDstData + iOffsetV + (H + h) * pDstMeta->tPitches.iChroma + (W + w) / 2;
-
-          pOutU[0] = (uint8_t)RND_10B_TO_8B(pInC[0] & 0x3FF);
-          pOutV[0] = (uint8_t)RND_10B_TO_8B(((pInC[0] >> 10) | (pInC[1] << 6)) & 0x3FF);
-          pOutU[1] = (uint8_t)RND_10B_TO_8B((pInC[1] >> 4) & 0x3FF);
-          pOutV[1] = (uint8_t)RND_10B_TO_8B(((pInC[1] >> 14) | (pInC[2] << 2)) & 0x3FF);
-          pOutU += pDstMeta->tPitches.iChroma;
-          pOutV += pDstMeta->tPitches.iChroma;
-          pOutU[0] = (uint8_t)RND_10B_TO_8B(((pInC[2] >> 8) | (pInC[3] << 8)) & 0x3FF);
-          pOutV[0] = (uint8_t)RND_10B_TO_8B((pInC[3] >> 2) & 0x3FF);
-          pOutU[1] = (uint8_t)RND_10B_TO_8B(((pInC[3] >> 12) | (pInC[4] << 4)) & 0x3FF);
-          pOutV[1] = (uint8_t)RND_10B_TO_8B(pInC[4] >> 6);
-          pOutU += pDstMeta->tPitches.iChroma;
-          pOutV += pDstMeta->tPitches.iChroma;
-          pOutU[0] = (uint8_t)RND_10B_TO_8B(pInC[5] & 0x3FF);
-          pOutV[0] = (uint8_t)RND_10B_TO_8B(((pInC[5] >> 10) | (pInC[6] << 6)) & 0x3FF);
-          pOutU[1] = (uint8_t)RND_10B_TO_8B((pInC[6] >> 4) & 0x3FF);
-          pOutV[1] = (uint8_t)RND_10B_TO_8B(((pInC[6] >> 14) | (pInC[7] << 2)) & 0x3FF);
-          pOutU += pDstMeta->tPitches.iChroma;
-          pOutV += pDstMeta->tPitches.iChroma;
-          pOutU[0] = (uint8_t)RND_10B_TO_8B(((pInC[7] >> 8) | (pInC[8] << 8)) & 0x3FF);
-          pOutV[0] = (uint8_t)RND_10B_TO_8B((pInC[8] >> 2) & 0x3FF);
-          pOutU[1] = (uint8_t)RND_10B_TO_8B(((pInC[8] >> 12) | (pInC[9] << 4)) & 0x3FF);
-          pOutV[1] = (uint8_t)RND_10B_TO_8B(pInC[9] >> 6);
-          pInC += 10;
+          for(int w = 0; w < iTileW - iCropW; w += 4)
+          {
+            uint8_t* pOutU = pDstData + iOffsetU + (H + h) * pDstMeta->tPitches.iChroma + (W + w) / 2;
+            uint8_t* pOutV = pDstData + iOffsetV + (H + h) * pDstMeta->tPitches.iChroma + (W + w) / 2;
+
+            pOutU[0] = (uint8_t)RND_10B_TO_8B(pInC[0] & 0x3FF);
+            pOutV[0] = (uint8_t)RND_10B_TO_8B(((pInC[0] >> 10) | (pInC[1] << 6)) & 0x3FF);
+            pOutU[1] = (uint8_t)RND_10B_TO_8B((pInC[1] >> 4) & 0x3FF);
+            pOutV[1] = (uint8_t)RND_10B_TO_8B(((pInC[1] >> 14) | (pInC[2] << 2)) & 0x3FF);
+            pOutU += pDstMeta->tPitches.iChroma;
+            pOutV += pDstMeta->tPitches.iChroma;
+            pOutU[0] = (uint8_t)RND_10B_TO_8B(((pInC[2] >> 8) | (pInC[3] << 8)) & 0x3FF);
+            pOutV[0] = (uint8_t)RND_10B_TO_8B((pInC[3] >> 2) & 0x3FF);
+            pOutU[1] = (uint8_t)RND_10B_TO_8B(((pInC[3] >> 12) | (pInC[4] << 4)) & 0x3FF);
+            pOutV[1] = (uint8_t)RND_10B_TO_8B(pInC[4] >> 6);
+            pOutU += pDstMeta->tPitches.iChroma;
+            pOutV += pDstMeta->tPitches.iChroma;
+            pOutU[0] = (uint8_t)RND_10B_TO_8B(pInC[5] & 0x3FF);
+            pOutV[0] = (uint8_t)RND_10B_TO_8B(((pInC[5] >> 10) | (pInC[6] << 6)) & 0x3FF);
+            pOutU[1] = (uint8_t)RND_10B_TO_8B((pInC[6] >> 4) & 0x3FF);
+            pOutV[1] = (uint8_t)RND_10B_TO_8B(((pInC[6] >> 14) | (pInC[7] << 2)) & 0x3FF);
+            pOutU += pDstMeta->tPitches.iChroma;
+            pOutV += pDstMeta->tPitches.iChroma;
+            pOutU[0] = (uint8_t)RND_10B_TO_8B(((pInC[7] >> 8) | (pInC[8] << 8)) & 0x3FF);
+            pOutV[0] = (uint8_t)RND_10B_TO_8B((pInC[8] >> 2) & 0x3FF);
+            pOutU[1] = (uint8_t)RND_10B_TO_8B(((pInC[8] >> 12) | (pInC[9] << 4)) & 0x3FF);
+            pOutV[1] = (uint8_t)RND_10B_TO_8B(pInC[9] >> 6);
+            pInC += 10;
+          }
+
+          pInC += 5 * iCropW / sizeof(uint16_t);
         }
 
-        pInC += 5 * iCropW / sizeof(uint16_t);
+        pInC += iCropH * iTileW * 5 / 4 / sizeof(uint16_t);
       }
-
-      pInC += iCropH * iTileW * 5 / 4 / sizeof(uint16_t);
     }
-  }
+  });
 
   pDstMeta->tFourCC = FOURCC(I420);
 }
@@ -2390,60 +2334,63 @@ void T60A_To_YV12(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int H = 0; H < iHeightC; H += iTileH)
+  ConvertTileStripes(iHeightC, iTileH, [&](int iBeginRow, int iEndRow)
   {
-    uint16_t* pInC = (uint16_t*)(pSrcData + iSrcLumaSize + (H / iTileH) * pSrcMeta->tPitches.iChroma);
+    for(int H = iBeginRow; H < iEndRow; H += iTileH)
+    {
+      uint16_t* pInC = (uint16_t*)(pSrcData + iSrcLumaSize + (H / iTileH) * pSrcMeta->tPitches.iChroma);
 
-    int iCropH = (H + iTileH) - iHeightC;
+      int iCropH = (H + iTileH) - iHeightC;
 
-    if(iCropH < 0)
-      iCropH = 0;
+      if(iCropH < 0)
+        iCropH = 0;
 
-    for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
-    {
-      int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
+      for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
+      {
+        int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
 
-      if(iCropW < 0)
-        iCropW = 0;
+        if(iCropW < 0)
+          iCropW = 0;
 
-      for(int h = 0; h < iTileH - iCropH; h += 4)
-      {
-        for(int w = 0; w < iTileW - iCropW; w += 4)
+        for(int h = 0; h < iTileH - iCropH; h += 4)
         {
-          uint8_t* pOutU = pDstData + iOffsetU + (H + h) * pDstMeta->tPitches.iChroma + (W + w) / 2;
-          uint8_t* pOutV = pDstData + iOffsetV + (H + h) * pDstMeta->tPitches.iChroma + (W + w) / 2;
-
-          pOutU[0] = (uint8_t)RND_10B_TO_8B(pInC[0] & 0x3FF);
-          pOutV[0] = (uint8_t)RND_10B_TO_8B(((pInC[0] >> 10) | (pInC[1] << 6)) & 0x3FF);
-          pOutU[1] = (uint8_t)RND_10B_TO_8B((pInC[1] >> 4) & 0x3FF);
-          pOutV[1] = (uint8_t)RND_10B_TO_8B(((pInC[1] >> 14) | (pInC[2] << 2)) & 0x3FF);
-          pOutU += pDstMeta->tPitches.iChroma;
-          pOutV += pDstMeta->tPitches.iChroma;
-          pOutU[0] = (uint8_t)RND_10B_TO_8B(((pInC[2] >> 8) | (pInC[3] << 8)) & 0x3FF);
-          pOutV[0] = (uint8_t)RND_10B_TO_8B((pInC[3] >> 2) & 0x3FF);
-          pOutU[1] = (uint8_t)RND_10B_TO_8B(((pInC[3] >> 12) | (pInC[4] << 4)) & 0x3FF);
-          pOutV[1] = (uint8_t)RND_10B_TO_8B(pInC[4] >> 6);
-          pOutU += pDstMeta->tPitches.iChroma;
-          pOutV += pDstMeta->tPitches.iChroma;
-          pOutU[0] = (uint8_t)RND_10B_TO_8B(pInC[5] & 0x3FF);
-          pOutV[0] = (uint8_t)RND_10B_TO_8B(((pInC[5] >> 10) | (pInC[6] << 6)) & 0x3FF);
-          pOutU[1] = (uint8_t)RND_10B_TO_8B((pInC[6] >> 4) & 0x3FF);
-          pOutV[1] = (uint8_t)RND_10B_TO_8B(((pInC[6] >> 14) | (pInC[7] << 2)) & 0x3FF);
-          pOutU += pDstMeta->tPitches.iChroma;
-          pOutV += pDstMeta->tPitches.iChroma;
-          pOutU[0] = (uint8_t)RND_10B_TO_8B(((pInC[7] >> 8) | (pInC[8] << 8)) & 0x3FF);
-          pOutV[0] = (uint8_t)RND_10B_TO_8B((pInC[8] >> 2) & 0x3FF);
-          pOutU[1] = (uint8_t)RND_10B_TO_8B(((pInC[8] >> 12) | (pInC[9] << 4)) & 0x3FF);
-          pOutV[1] = (uint8_t)RND_10B_TO_8B(pInC[9] >> 6);
-          pInC += 10;
+          for(int w = 0; w < iTileW - iCropW; w += 4)
+          {
+            uint8_t* pOutU = pDstData + iOffsetU + (H + h) * pDstMeta->tPitches.iChroma + (W + w) / 2;
+            uint8_t* pOutV = pDstData + iOffsetV + (H + h) * pDstMeta->tPitches.iChroma + (W + w) / 2;
+
+            pOutU[0] = (uint8_t)RND_10B_TO_8B(pInC[0] & 0x3FF);
+            pOutV[0] = (uint8_t)RND_10B_TO_8B(((pInC[0] >> 10) | (pInC[1] << 6)) & 0x3FF);
+            pOutU[1] = (uint8_t)RND_10B_TO_8B((pInC[1] >> 4) & 0x3FF);
+            pOutV[1] = (uint8_t)RND_10B_TO_8B(((pInC[1] >> 14) | (pInC[2] << 2)) & 0x3FF);
+            pOutU += pDstMeta->tPitches.iChroma;
+            pOutV += pDstMeta->tPitches.iChroma;
+            pOutU[0] = (uint8_t)RND_10B_TO_8B(((pInC[2] >> 8) | (pInC[3] << 8)) & 0x3FF);
+            pOutV[0] = (uint8_t)RND_10B_TO_8B((pInC[3] >> 2) & 0x3FF);
+            pOutU[1] = (uint8_t)RND_10B_TO_8B(((pInC[3] >> 12) | (pInC[4] << 4)) & 0x3FF);
+            pOutV[1] = (uint8_t)RND_10B_TO_8B(pInC[4] >> 6);
+            pOutU += pDstMeta->tPitches.iChroma;
+            pOutV += pDstMeta->tPitches.iChroma;
+            pOutU[0] = (uint8_t)RND_10B_TO_8B(pInC[5] & 0x3FF);
+            pOutV[0] = (uint8_t)RND_10B_TO_8B(((pInC[5] >> 10) | (pInC[6] << 6)) & 0x3FF);
+            pOutU[1] = (uint8_t)RND_10B_TO_8B((pInC[6] >> 4) & 0x3FF);
+            pOutV[1] = (uint8_t)RND_10B_TO_8B(((pInC[6] >> 14) | (pInC[7] << 2)) & 0x3FF);
+            pOutU += pDstMeta->tPitches.iChroma;
+            pOutV += pDstMeta->tPitches.iChroma;
+            pOutU[0] = (uint8_t)RND_10B_TO_8B(((pInC[7] >> 8) | (pInC[8] << 8)) & 0x3FF);
+            pOutV[0] = (uint8_t)RND_10B_TO_8B((pInC[8] >> 2) & 0x3FF);
+            pOutU[1] = (uint8_t)RND_10B_TO_8B(((pInC[8] >> 12) | (pInC[9] << 4)) & 0x3FF);
+            pOutV[1] = (uint8_t)RND_10B_TO_8B(pInC[9] >> 6);
+            pInC += 10;
+          }
+
+          pInC += 5 * iCropW / sizeof(uint16_t);
         }
 
-        pInC += 5 * iCropW / sizeof(uint16_t);
+        pInC += iCropH * iTileW * 5 / 4 / sizeof(uint16_t);
       }
-
-      pInC += iCropH * iTileW * 5 / 4 / sizeof(uint16_t);
     }
-  }
+  });
 
   pDstMeta->tFourCC = FOURCC(YV12);
 }
@@ -2468,56 +2415,59 @@ void T60A_To_NV12(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int H = 0; H < iHeightC; H += iTileH)
+  ConvertTileStripes(iHeightC, iTileH, [&](int iBeginRow, int iEndRow)
   {
-    uint16_t* pInC = (uint16_t*)(pSrcData + iSrcLumaSize + (H / iTileH) * pSrcMeta->tPitches.iChroma);
+    for(int H = iBeginRow; H < iEndRow; H += iTileH)
+    {
+      uint16_t* pInC = (uint16_t*)(pSrcData + iSrcLumaSize + (H / iTileH) * pSrcMeta->tPitches.iChroma);
 
-    int iCropH = (H + iTileH) - iHeightC;
+      int iCropH = (H + iTileH) - iHeightC;
 
-    if(iCropH < 0)
-      iCropH = 0;
+      if(iCropH < 0)
+        iCropH = 0;
 
-    for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
-    {
-      int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
+      for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
+      {
+        int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
 
-      if(iCropW < 0)
-        iCropW = 0;
+        if(iCropW < 0)
+          iCropW = 0;
 
-      for(int h = 0; h < iTileH - iCropH; h += 4)
-      {
-        for(int w = 0; w < iTileW - iCropW; w += 4)
+        for(int h = 0; h < iTileH - iCropH; h += 4)
         {
-          uint8_t* pOutC = pDstData + iOffsetC + (H + h) * pDstMeta->tPitches.iChroma + (W + w);
-
-          pOutC[0] = (uint8_t)RND_10B_TO_8B(pInC[0] & 0x3FF);
-          pOutC[1] = (uint8_t)RND_10B_TO_8B(((pInC[0] >> 10) | (pInC[1] << 6)) & 0x3FF);
-          pOutC[2] = (uint8_t)RND_10B_TO_8B((pInC[1] >> 4) & 0x3FF);
-          pOutC[3] = (uint8_t)RND_10B_TO_8B(((pInC[1] >> 14) | (pInC[2] << 2)) & 0x3FF);
-          pOutC += pDstMeta->tPitches.iChroma;
-          pOutC[0] = (uint8_t)RND_10B_TO_8B(((pInC[2] >> 8) | (pInC[3] << 8)) & 0x3FF);
-          pOutC[1] = (uint8_t)RND_10B_TO_8B((pInC[3] >> 2) & 0x3FF);
-          pOutC[2] = (uint8_t)RND_10B_TO_8B(((pInC[3] >> 12) | (pInC[4] << 4)) & 0x3FF);
-          pOutC[3] = (uint8_t)RND_10B_TO_8B(pInC[4] >> 6);
-          pOutC += pDstMeta->tPitches.iChroma;
-          pOutC[0] = (uint8_t)RND_10B_TO_8B(pInC[5] & 0x3FF);
-          pOutC[1] = (uint8_t)RND_10B_TO_8B(((pInC[5] >> 10) | (pInC[6] << 6)) & 0x3FF);
-          pOutC[2] = (uint8_t)RND_10B_TO_8B((pInC[6] >> 4) & 0x3FF);
-          pOutC[3] = (uint8_t)RND_10B_TO_8B(((pInC[6] >> 14) | (pInC[7] << 2)) & 0x3FF);
-          pOutC += pDstMeta->tPitches.iChroma;
-          pOutC[0] = (uint8_t)RND_10B_TO_8B(((pInC[7] >> 8) | (pInC[8] << 8)) & 0x3FF);
-          pOutC[1] = (uint8_t)RND_10B_TO_8B((pInC[8] >> 2) & 0x3FF);
-          pOutC[2] = (uint8_t)RND_10B_TO_8B(((pInC[8] >> 12) | (pInC[9] << 4)) & 0x3FF);
-          pOutC[3] = (uint8_t)RND_10B_TO_8B(pInC[9] >> 6);
-          pInC += 10;
+          for(int w = 0; w < iTileW - iCropW; w += 4)
+          {
+            uint8_t* pOutC = pDstData + iOffsetC + (H + h) * pDstMeta->tPitches.iChroma + (W + w);
+
+            pOutC[0] = (uint8_t)RND_10B_TO_8B(pInC[0] & 0x3FF);
+            pOutC[1] = (uint8_t)RND_10B_TO_8B(((pInC[0] >> 10) | (pInC[1] << 6)) & 0x3FF);
+            pOutC[2] = (uint8_t)RND_10B_TO_8B((pInC[1] >> 4) & 0x3FF);
+            pOutC[3] = (uint8_t)RND_10B_TO_8B(((pInC[1] >> 14) | (pInC[2] << 2)) & 0x3FF);
+            pOutC += pDstMeta->tPitches.iChroma;
+            pOutC[0] = (uint8_t)RND_10B_TO_8B(((pInC[2] >> 8) | (pInC[3] << 8)) & 0x3FF);
+            pOutC[1] = (uint8_t)RND_10B_TO_8B((pInC[3] >> 2) & 0x3FF);
+            pOutC[2] = (uint8_t)RND_10B_TO_8B(((pInC[3] >> 12) | (pInC[4] << 4)) & 0x3FF);
+            pOutC[3] = (uint8_t)RND_10B_TO_8B(pInC[4] >> 6);
+            pOutC += pDstMeta->tPitches.iChroma;
+            pOutC[0] = (uint8_t)RND_10B_TO_8B(pInC[5] & 0x3FF);
+            pOutC[1] = (uint8_t)RND_10B_TO_8B(((pInC[5] >> 10) | (pInC[6] << 6)) & 0x3FF);
+            pOutC[2] = (uint8_t)RND_10B_TO_8B((pInC[6] >> 4) & 0x3FF);
+            pOutC[3] = (uint8_t)RND_10B_TO_8B(((pInC[6] >> 14) | (pInC[7] << 2)) & 0x3FF);
+            pOutC += pDstMeta->tPitches.iChroma;
+            pOutC[0] = (uint8_t)RND_10B_TO_8B(((pInC[7] >> 8) | (pInC[8] << 8)) & 0x3FF);
+            pOutC[1] = (uint8_t)RND_10B_TO_8B((pInC[8] >> 2) & 0x3FF);
+            pOutC[2] = (uint8_t)RND_10B_TO_8B(((pInC[8] >> 12) | (pInC[9] << 4)) & 0x3FF);
+            pOutC[3] = (uint8_t)RND_10B_TO_8B(pInC[9] >> 6);
+            pInC += 10;
+          }
+
+          pInC += 5 * iCropW / sizeof(uint16_t);
         }
 
-        pInC += 5 * iCropW / sizeof(uint16_t);
+        pInC += iCropH * iTileW * 5 / 4 / sizeof(uint16_t);
       }
-
-      pInC += iCropH * iTileW * 5 / 4 / sizeof(uint16_t);
     }
-  }
+  });
 
   pDstMeta->tFourCC = FOURCC(NV12);
 }
@@ -2535,56 +2485,59 @@ void T60A_To_Y800(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int H = 0; H < pDstMeta->tDim.iHeight; H += iTileH)
+  ConvertTileStripes(pDstMeta->tDim.iHeight, iTileH, [&](int iBeginRow, int iEndRow)
   {
-    uint16_t* pInY = (uint16_t*)(pSrcData + (H / iTileH) * pSrcMeta->tPitches.iLuma);
+    for(int H = iBeginRow; H < iEndRow; H += iTileH)
+    {
+      uint16_t* pInY = (uint16_t*)(pSrcData + (H / iTileH) * pSrcMeta->tPitches.iLuma);
 
-    int iCropH = (H + iTileH) - pDstMeta->tDim.iHeight;
+      int iCropH = (H + iTileH) - pDstMeta->tDim.iHeight;
 
-    if(iCropH < 0)
-      iCropH = 0;
+      if(iCropH < 0)
+        iCropH = 0;
 
-    for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
-    {
-      int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
+      for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
+      {
+        int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
 
-      if(iCropW < 0)
-        iCropW = 0;
+        if(iCropW < 0)
+          iCropW = 0;
 
-      for(int h = 0; h < iTileH - iCropH; h += 4)
-      {
-        for(int w = 0; w < iTileW - iCropW; w += 4)
+        for(int h = 0; h < iTileH - iCropH; h += 4)
         {
-          uint8_t* pOutY = pDstData + (H + h) * pDstMeta->tPitches.iLuma + (W + w);
-
-          pOutY[0] = (uint8_t)RND_10B_TO_8B(pInY[0] & 0x3FF);
-          pOutY[1] = (uint8_t)RND_10B_TO_8B(((pInY[0] >> 10) | (pInY[1] << 6)) & 0x3FF);
-          pOutY[2] = (uint8_t)RND_10B_TO_8B((pInY[1] >> 4) & 0x3FF);
-          pOutY[3] = (uint8_t)RND_10B_TO_8B(((pInY[1] >> 14) | (pInY[2] << 2)) & 0x3FF);
-          pOutY += pDstMeta->tPitches.iLuma;
-          pOutY[0] = (uint8_t)RND_10B_TO_8B(((pInY[2] >> 8) | (pInY[3] << 8)) & 0x3FF);
-          pOutY[1] = (uint8_t)RND_10B_TO_8B((pInY[3] >> 2) & 0x3FF);
-          pOutY[2] = (uint8_t)RND_10B_TO_8B(((pInY[3] >> 12) | (pInY[4] << 4)) & 0x3FF);
-          pOutY[3] = (uint8_t)RND_10B_TO_8B(pInY[4] >> 6);
-          pOutY += pDstMeta->tPitches.iLuma;
-          pOutY[0] = (uint8_t)RND_10B_TO_8B(pInY[5] & 0x3FF);
-          pOutY[1] = (uint8_t)RND_10B_TO_8B(((pInY[5] >> 10) | (pInY[6] << 6)) & 0x3FF);
-          pOutY[2] = (uint8_t)RND_10B_TO_8B((pInY[6] >> 4) & 0x3FF);
-          pOutY[3] = (uint8_t)RND_10B_TO_8B(((pInY[6] >> 14) | (pInY[7] << 2)) & 0x3FF);
-          pOutY += pDstMeta->tPitches.iLuma;
-          pOutY[0] = (uint8_t)RND_10B_TO_8B(((pInY[7] >> 8) | (pInY[8] << 8)) & 0x3FF);
-          pOutY[1] = (uint8_t)RND_10B_TO_8B((pInY[8] >> 2) & 0x3FF);
-          pOutY[2] = (uint8_t)RND_10B_TO_8B(((pInY[8] >> 12) | (pInY[9] << 4)) & 0x3FF);
-          pOutY[3] = (uint8_t)RND_10B_TO_8B(pInY[9] >> 6);
-          pInY += 10;
+          for(int w = 0; w < iTileW - iCropW; w += 4)
+          {
+            uint8_t* pOutY = pDstData + (H + h) * pDstMeta->tPitches.iLuma + (W + w);
+
+            pOutY[0] = (uint8_t)RND_10B_TO_8B(pInY[0] & 0x3FF);
+            pOutY[1] = (uint8_t)RND_10B_TO_8B(((pInY[0] >> 10) | (pInY[1] << 6)) & 0x3FF);
+            pOutY[2] = (uint8_t)RND_10B_TO_8B((pInY[1] >> 4) & 0x3FF);
+            pOutY[3] = (uint8_t)RND_10B_TO_8B(((pInY[1] >> 14) | (pInY[2] << 2)) & 0x3FF);
+            pOutY += pDstMeta->tPitches.iLuma;
+            pOutY[0] = (uint8_t)RND_10B_TO_8B(((pInY[2] >> 8) | (pInY[3] << 8)) & 0x3FF);
+            pOutY[1] = (uint8_t)RND_10B_TO_8B((pInY[3] >> 2) & 0x3FF);
+            pOutY[2] = (uint8_t)RND_10B_TO_8B(((pInY[3] >> 12) | (pInY[4] << 4)) & 0x3FF);
+            pOutY[3] = (uint8_t)RND_10B_TO_8B(pInY[4] >> 6);
+            pOutY += pDstMeta->tPitches.iLuma;
+            pOutY[0] = (uint8_t)RND_10B_TO_8B(pInY[5] & 0x3FF);
+            pOutY[1] = (uint8_t)RND_10B_TO_8B(((pInY[5] >> 10) | (pInY[6] << 6)) & 0x3FF);
+            pOutY[2] = (uint8_t)RND_10B_TO_8B((pInY[6] >> 4) & 0x3FF);
+            pOutY[3] = (uint8_t)RND_10B_TO_8B(((pInY[6] >> 14) | (pInY[7] << 2)) & 0x3FF);
+            pOutY += pDstMeta->tPitches.iLuma;
+            pOutY[0] = (uint8_t)RND_10B_TO_8B(((pInY[7] >> 8) | (pInY[8] << 8)) & 0x3FF);
+            pOutY[1] = (uint8_t)RND_10B_TO_8B((pInY[8] >> 2) & 0x3FF);
+            pOutY[2] = (uint8_t)RND_10B_TO_8B(((pInY[8] >> 12) | (pInY[9] << 4)) & 0x3FF);
+            pOutY[3] = (uint8_t)RND_10B_TO_8B(pInY[9] >> 6);
+            pInY += 10;
+          }
+
+          pInY += 5 * iCropW / sizeof(uint16_t);
         }
 
-        pInY += 5 * iCropW / sizeof(uint16_t);
+        pInY += iCropH * iTileW * 5 / 4 / sizeof(uint16_t);
       }
-
-      pInY += iCropH * iTileW * 5 / 4 / sizeof(uint16_t);
     }
-  }
+  });
 
   pDstMeta->tFourCC = FOURCC(Y800);
 }
@@ -2603,56 +2556,39 @@ void T60A_To_Y010(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int H = 0; H < pDstMeta->tDim.iHeight; H += iTileH)
+  ConvertTileStripes(pDstMeta->tDim.iHeight, iTileH, [&](int iBeginRow, int iEndRow)
   {
-    uint16_t* pInY = (uint16_t*)(pSrcData + (H / iTileH) * pSrcMeta->tPitches.iLuma);
+    for(int H = iBeginRow; H < iEndRow; H += iTileH)
+    {
+      uint16_t* pInY = (uint16_t*)(pSrcData + (H / iTileH) * pSrcMeta->tPitches.iLuma);
 
-    int iCropH = (H + iTileH) - pDstMeta->tDim.iHeight;
+      int iCropH = (H + iTileH) - pDstMeta->tDim.iHeight;
 
-    if(iCropH < 0)
-      iCropH = 0;
+      if(iCropH < 0)
+        iCropH = 0;
 
-    for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
-    {
-      int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
+      for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
+      {
+        int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
 
-      if(iCropW < 0)
-        iCropW = 0;
+        if(iCropW < 0)
+          iCropW = 0;
 
-      for(int h = 0; h < iTileH - iCropH; h += 4)
-      {
-        for(int w = 0; w < iTileW - iCropW; w += 4)
+        for(int h = 0; h < iTileH - iCropH; h += 4)
         {
-          uint16_t* pOutY = ((uint16_t*)pDstData) + (H + h) * uDstPitchLuma + (W + w);
-
-          pOutY[0] = pInY[0] & 0x3FF;
-          pOutY[1] = ((pInY[0] >> 10) | (pInY[1] << 6)) & 0x3FF;
-          pOutY[2] = (pInY[1] >> 4) & 0x3FF;
-          pOutY[3] = ((pInY[1] >> 14) | (pInY[2] << 2)) & 0x3FF;
-          pOutY += uDstPitchLuma;
-          pOutY[0] = ((pInY[2] >> 8) | (pInY[3] << 8)) & 0x3FF;
-          pOutY[1] = (pInY[3] >> 2) & 0x3FF;
-          pOutY[2] = ((pInY[3] >> 12) | (pInY[4] << 4)) & 0x3FF;
-          pOutY[3] = pInY[4] >> 6;
-          pOutY += uDstPitchLuma;
-          pOutY[0] = pInY[5] & 0x3FF;
-          pOutY[1] = ((pInY[5] >> 10) | (pInY[6] << 6)) & 0x3FF;
-          pOutY[2] = (pInY[6] >> 4) & 0x3FF;
-          pOutY[3] = ((pInY[6] >> 14) | (pInY[7] << 2)) & 0x3FF;
-          pOutY += uDstPitchLuma;
-          pOutY[0] = ((pInY[7] >> 8) | (pInY[8] << 8)) & 0x3FF;
-          pOutY[1] = (pInY[8] >> 2) & 0x3FF;
-          pOutY[2] = ((pInY[8] >> 12) | (pInY[9] << 4)) & 0x3FF;
-          pOutY[3] = pInY[9] >> 6;
-          pInY += 10;
+          int iNumBlocks = (iTileW - iCropW + 3) / 4;
+          uint16_t* pOutY = ((uint16_t*)pDstData) + (H + h) * uDstPitchLuma + W;
+
+          GetConvKernels()->Untile10(pInY, pOutY, uDstPitchLuma, iNumBlocks);
+          pInY += 10 * iNumBlocks;
+
+          pInY += 5 * iCropW / sizeof(uint16_t);
         }
 
-        pInY += 5 * iCropW / sizeof(uint16_t);
+        pInY += iCropH * iTileW * 5 / 4 / sizeof(uint16_t);
       }
-
-      pInY += iCropH * iTileW * 5 / 4 / sizeof(uint16_t);
     }
-  }
+  });
 
   pDstMeta->tFourCC = FOURCC(Y010);
 }
@@ -2678,56 +2614,39 @@ void T60A_To_P010(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int H = 0; H < iHeightC; H += iTileH)
+  ConvertTileStripes(iHeightC, iTileH, [&](int iBeginRow, int iEndRow)
   {
-    uint16_t* pInC = (uint16_t*)(pSrcData + iSrcLumaSize + (H / iTileH) * pSrcMeta->tPitches.iChroma);
+    for(int H = iBeginRow; H < iEndRow; H += iTileH)
+    {
+      uint16_t* pInC = (uint16_t*)(pSrcData + iSrcLumaSize + (H / iTileH) * pSrcMeta->tPitches.iChroma);
 
-    int iCropH = (H + iTileH) - iHeightC;
+      int iCropH = (H + iTileH) - iHeightC;
 
-    if(iCropH < 0)
-      iCropH = 0;
+      if(iCropH < 0)
+        iCropH = 0;
 
-    for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
-    {
-      int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
+      for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
+      {
+        int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
 
-      if(iCropW < 0)
-        iCropW = 0;
+        if(iCropW < 0)
+          iCropW = 0;
 
-      for(int h = 0; h < iTileH - iCropH; h += 4)
-      {
-        for(int w = 0; w < iTileW - iCropW; w += 4)
+        for(int h = 0; h < iTileH - iCropH; h += 4)
         {
-          uint16_t* pOutC = ((uint16_t*)(pDstData + iOffsetC)) + (H + h) * iDstPitchChroma + (W + w);
-
-          pOutC[0] = pInC[0] & 0x3FF;
-          pOutC[1] = ((pInC[0] >> 10) | (pInC[1] << 6)) & 0x3FF;
-          pOutC[2] = (pInC[1] >> 4) & 0x3FF;
-          pOutC[3] = ((pInC[1] >> 14) | (pInC[2] << 2)) & 0x3FF;
-          pOutC += iDstPitchChroma;
-          pOutC[0] = ((pInC[2] >> 8) | (pInC[3] << 8)) & 0x3FF;
-          pOutC[1] = (pInC[3] >> 2) & 0x3FF;
-          pOutC[2] = ((pInC[3] >> 12) | (pInC[4] << 4)) & 0x3FF;
-          pOutC[3] = pInC[4] >> 6;
-          pOutC += iDstPitchChroma;
-          pOutC[0] = pInC[5] & 0x3FF;
-          pOutC[1] = ((pInC[5] >> 10) | (pInC[6] << 6)) & 0x3FF;
-          pOutC[2] = (pInC[6] >> 4) & 0x3FF;
-          pOutC[3] = ((pInC[6] >> 14) | (pInC[7] << 2)) & 0x3FF;
-          pOutC += iDstPitchChroma;
-          pOutC[0] = ((pInC[7] >> 8) | (pInC[8] << 8)) & 0x3FF;
-          pOutC[1] = (pInC[8] >> 2) & 0x3FF;
-          pOutC[2] = ((pInC[8] >> 12) | (pInC[9] << 4)) & 0x3FF;
-          pOutC[3] = pInC[9] >> 6;
-          pInC += 10;
+          int iNumBlocks = (iTileW - iCropW + 3) / 4;
+          uint16_t* pOutC = ((uint16_t*)(pDstData + iOffsetC)) + (H + h) * iDstPitchChroma + W;
+
+          GetConvKernels()->Untile10(pInC, pOutC, iDstPitchChroma, iNumBlocks);
+          pInC += 10 * iNumBlocks;
+
+          pInC += 5 * iCropW / sizeof(uint16_t);
         }
 
-        pInC += 5 * iCropW / sizeof(uint16_t);
+        pInC += iCropH * iTileW * 5 / 4 / sizeof(uint16_t);
       }
-
-      pInC += iCropH * iTileW * 5 / 4 / sizeof(uint16_t);
     }
-  }
+  });
 
   pDstMeta->tFourCC = FOURCC(P010);
 }
@@ -2754,60 +2673,63 @@ void T60A_To_I0AL(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int H = 0; H < iHeightC; H += iTileH)
+  ConvertTileStripes(iHeightC, iTileH, [&](int iBeginRow, int iEndRow)
   {
-    uint16_t* pInC = (uint16_t*)(pSrcData + iSrcLumaSize + (H / iTileH) * pSrcMeta->tPitches.iChroma);
+    for(int H = iBeginRow; H < iEndRow; H += iTileH)
+    {
+      uint16_t* pInC = (uint16_t*)(pSrcData + iSrcLumaSize + (H / iTileH) * pSrcMeta->tPitches.iChroma);
 
-    int iCropH = (H + iTileH) - iHeightC;
+      int iCropH = (H + iTileH) - iHeightC;
 
-    if(iCropH < 0)
-      iCropH = 0;
+      if(iCropH < 0)
+        iCropH = 0;
 
-    for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
-    {
-      int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
+      for(int W = 0; W < pDstMeta->tDim.iWidth; W += iTileW)
+      {
+        int iCropW = (W + iTileW) - pDstMeta->tDim.iWidth;
 
-      if(iCropW < 0)
-        iCropW = 0;
+        if(iCropW < 0)
+          iCropW = 0;
 
-      for(int h = 0; h < iTileH - iCropH; h += 4)
-      {
-        for(int w = 0; w < iTileW - iCropW; w += 4)
+        for(int h = 0; h < iTileH - iCropH; h += 4)
         {
-          uint16_t* pOutU = ((uint16_t*)(pDstData + iOffsetU)) + (H + h) * iDstPitchChroma + (W + w) / 2;
-          uint16_t* pOutV = ((uint16_t*)(pDstData + iOffsetV)) + (H + h) * iDstPitchChroma + (W + w) / 2;
-
-          pOutU[0] = pInC[0] & 0x3FF;
-          pOutV[0] = ((pInC[0] >> 10) | (pInC[1] << 6)) & 0x3FF;
-          pOutU[1] = (pInC[1] >> 4) & 0x3FF;
-          pOutV[1] = ((pInC[1] >> 14) | (pInC[2] << 2)) & 0x3FF;
-          pOutU += iDstPitchChroma;
-          pOutV += iDstPitchChroma;
-          pOutU[0] = ((pInC[2] >> 8) | (pInC[3] << 8)) & 0x3FF;
-          pOutV[0] = (pInC[3] >> 2) & 0x3FF;
-          pOutU[1] = ((pInC[3] >> 12) | (pInC[4] << 4)) & 0x3FF;
-          pOutV[1] = pInC[4] >> 6;
-          pOutU += iDstPitchChroma;
-          pOutV += iDstPitchChroma;
-          pOutU[0] = pInC[5] & 0x3FF;
-          pOutV[0] = ((pInC[5] >> 10) | (pInC[6] << 6)) & 0x3FF;
-          pOutU[1] = (pInC[6] >> 4) & 0x3FF;
-          pOutV[1] = ((pInC[6] >> 14) | (pInC[7] << 2)) & 0x3FF;
-          pOutU += iDstPitchChroma;
-          pOutV += iDstPitchChroma;
-          pOutU[0] = ((pInC[7] >> 8) | (pInC[8] << 8)) & 0x3FF;
-          pOutV[0] = (pInC[8] >> 2) & 0x3FF;
-          pOutU[1] = ((pInC[8] >> 12) | (pInC[9] << 4)) & 0x3FF;
-          pOutV[1] = pInC[9] >> 6;
-          pInC += 10;
+          for(int w = 0; w < iTileW - iCropW; w += 4)
+          {
+            uint16_t* pOutU = ((uint16_t*)(pDstData + iOffsetU)) + (H + h) * iDstPitchChroma + (W + w) / 2;
+            uint16_t* pOutV = ((uint16_t*)(pDstData + iOffsetV)) + (H + h) * iDstPitchChroma + (W + w) / 2;
+
+            pOutU[0] = pInC[0] & 0x3FF;
+            pOutV[0] = ((pInC[0] >> 10) | (pInC[1] << 6)) & 0x3FF;
+            pOutU[1] = (pInC[1] >> 4) & 0x3FF;
+            pOutV[1] = ((pInC[1] >> 14) | (pInC[2] << 2)) & 0x3FF;
+            pOutU += iDstPitchChroma;
+            pOutV += iDstPitchChroma;
+            pOutU[0] = ((pInC[2] >> 8) | (pInC[3] << 8)) & 0x3FF;
+            pOutV[0] = (pInC[3] >> 2) & 0x3FF;
+            pOutU[1] = ((pInC[3] >> 12) | (pInC[4] << 4)) & 0x3FF;
+            pOutV[1] = pInC[4] >> 6;
+            pOutU += iDstPitchChroma;
+            pOutV += iDstPitchChroma;
+            pOutU[0] = pInC[5] & 0x3FF;
+            pOutV[0] = ((pInC[5] >> 10) | (pInC[6] << 6)) & 0x3FF;
+            pOutU[1] = (pInC[6] >> 4) & 0x3FF;
+            pOutV[1] = ((pInC[6] >> 14) | (pInC[7] << 2)) & 0x3FF;
+            pOutU += iDstPitchChroma;
+            pOutV += iDstPitchChroma;
+            pOutU[0] = ((pInC[7] >> 8) | (pInC[8] << 8)) & 0x3FF;
+            pOutV[0] = (pInC[8] >> 2) & 0x3FF;
+            pOutU[1] = ((pInC[8] >> 12) | (pInC[9] << 4)) & 0x3FF;
+            pOutV[1] = pInC[9] >> 6;
+            pInC += 10;
+          }
+
+          pInC += 5 * iCropW / sizeof(uint16_t);
         }
 
-        pInC += 5 * iCropW / sizeof(uint16_t);
+        pInC += iCropH * iTileW * 5 / 4 / sizeof(uint16_t);
       }
-
-      pInC += iCropH * iTileW * 5 / 4 / sizeof(uint16_t);
     }
-  }
+  });
 
   pDstMeta->tFourCC = FOURCC(I0AL);
 }
@@ -3080,34 +3002,37 @@ static void RXXA_To_I42X(AL_TBuffer const* pSrc, AL_TBuffer* pDst, uint8_t uHrzC
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int h = 0; h < iHeightC; h++)
+  ConvertStripes(iHeightC, 1, [&](int iBeginRow, int iEndRow)
   {
-    uint32_t* pSrc32 = (uint32_t*)(pSrcData + pSrcMeta->tOffsetYC.iChroma + h * pSrcMeta->tPitches.iChroma);
-    uint8_t* pDstU = ((uint8_t*)pDstData) + iDstSizeY + h * pDstMeta->tPitches.iChroma;
-    uint8_t* pDstV = pDstU + iDstSizeC;
+    for(int h = iBeginRow; h < iEndRow; h++)
+    {
+      uint32_t* pSrc32 = (uint32_t*)(pSrcData + pSrcMeta->tOffsetYC.iChroma + h * pSrcMeta->tPitches.iChroma);
+      uint8_t* pDstU = ((uint8_t*)pDstData) + iDstSizeY + h * pDstMeta->tPitches.iChroma;
+      uint8_t* pDstV = pDstU + iDstSizeC;
 
-    int w = pSrcMeta->tDim.iWidth / 6;
+      int w = pSrcMeta->tDim.iWidth / 6;
 
-    while(w--)
-    {
-      Read24BitsOn32Bits(pSrc32, &pDstU, &pDstV);
-      ++pSrc32;
-      Read24BitsOn32Bits(pSrc32, &pDstV, &pDstU);
-      ++pSrc32;
-    }
+      while(w--)
+      {
+        Read24BitsOn32Bits(pSrc32, &pDstU, &pDstV);
+        ++pSrc32;
+        Read24BitsOn32Bits(pSrc32, &pDstV, &pDstU);
+        ++pSrc32;
+      }
 
-    if(pSrcMeta->tDim.iWidth % 6 > 2)
-    {
-      Read24BitsOn32Bits(pSrc32, &pDstU, &pDstV);
-      ++pSrc32;
-      *pDstV++ = (uint8_t)((*pSrc32 >> 2) & 0xFF);
-    }
-    else if(pSrcMeta->tDim.iWidth % 6 > 0)
-    {
-      *pDstU++ = (uint8_t)((*pSrc32 >> 2) & 0xFF);
-      *pDstV++ = (uint8_t)((*pSrc32 >> 12) & 0xFF);
+      if(pSrcMeta->tDim.iWidth % 6 > 2)
+      {
+        Read24BitsOn32Bits(pSrc32, &pDstU, &pDstV);
+        ++pSrc32;
+        *pDstV++ = (uint8_t)((*pSrc32 >> 2) & 0xFF);
+      }
+      else if(pSrcMeta->tDim.iWidth % 6 > 0)
+      {
+        *pDstU++ = (uint8_t)((*pSrc32 >> 2) & 0xFF);
+        *pDstV++ = (uint8_t)((*pSrc32 >> 12) & 0xFF);
+      }
     }
-  }
+  });
 
   SetFourCC(pDstMeta, FOURCC(I420), FOURCC(I422), uHrzCScale * uVrtCScale);
 }
@@ -3135,31 +3060,30 @@ void RX0A_To_Y800(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int h = 0; h < pSrcMeta->tDim.iHeight; h++)
+  ConvertStripes(pSrcMeta->tDim.iHeight, 1, [&](int iBeginRow, int iEndRow)
   {
-    uint32_t* pSrc32 = (uint32_t*)(pSrcData + h * pSrcMeta->tPitches.iLuma);
-    uint8_t* pDstY = (uint8_t*)(pDstData + h * pDstMeta->tPitches.iLuma);
+    for(int h = iBeginRow; h < iEndRow; h++)
+    {
+      uint32_t* pSrc32 = (uint32_t*)(pSrcData + h * pSrcMeta->tPitches.iLuma);
+      uint8_t* pDstY = (uint8_t*)(pDstData + h * pDstMeta->tPitches.iLuma);
 
-    int w = pSrcMeta->tDim.iWidth / 3;
+      int w = pSrcMeta->tDim.iWidth / 3;
 
-    while(w--)
-    {
-      *pDstY++ = (*pSrc32 >> 2) & 0xFF;
-      *pDstY++ = (*pSrc32 >> 12) & 0xFF;
-      *pDstY++ = (*pSrc32 >> 22) & 0xFF;
-      ++pSrc32;
-    }
+      GetConvKernels()->Unpack10To8(pSrc32, pDstY, w);
+      pSrc32 += w;
+      pDstY += 3 * w;
 
-    if(pSrcMeta->tDim.iWidth % 3 > 1)
-    {
-      *pDstY++ = (*pSrc32 >> 2) & 0xFF;
-      *pDstY++ = (*pSrc32 >> 12) & 0xFF;
-    }
-    else if(pSrcMeta->tDim.iWidth % 3 > 0)
-    {
-      *pDstY++ = (*pSrc32 >> 2) & 0xFF;
+      if(pSrcMeta->tDim.iWidth % 3 > 1)
+      {
+        *pDstY++ = (*pSrc32 >> 2) & 0xFF;
+        *pDstY++ = (*pSrc32 >> 12) & 0xFF;
+      }
+      else if(pSrcMeta->tDim.iWidth % 3 > 0)
+      {
+        *pDstY++ = (*pSrc32 >> 2) & 0xFF;
+      }
     }
-  }
+  });
 
   pDstMeta->tFourCC = FOURCC(Y800);
 }
@@ -3175,31 +3099,30 @@ void RX0A_To_Y010(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int h = 0; h < pSrcMeta->tDim.iHeight; h++)
+  ConvertStripes(pSrcMeta->tDim.iHeight, 1, [&](int iBeginRow, int iEndRow)
   {
-    uint32_t* pSrc32 = (uint32_t*)(pSrcData + h * pSrcMeta->tPitches.iLuma);
-    uint16_t* pDstY = (uint16_t*)(pDstData + h * pDstMeta->tPitches.iLuma);
+    for(int h = iBeginRow; h < iEndRow; h++)
+    {
+      uint32_t* pSrc32 = (uint32_t*)(pSrcData + h * pSrcMeta->tPitches.iLuma);
+      uint16_t* pDstY = (uint16_t*)(pDstData + h * pDstMeta->tPitches.iLuma);
 
-    int w = pSrcMeta->tDim.iWidth / 3;
+      int w = pSrcMeta->tDim.iWidth / 3;
 
-    while(w--)
-    {
-      *pDstY++ = (uint16_t)((*pSrc32) & 0x3FF);
-      *pDstY++ = (uint16_t)((*pSrc32 >> 10) & 0x3FF);
-      *pDstY++ = (uint16_t)((*pSrc32 >> 20) & 0x3FF);
-      ++pSrc32;
-    }
+      GetConvKernels()->Unpack10To10(pSrc32, pDstY, w);
+      pSrc32 += w;
+      pDstY += 3 * w;
 
-    if(pSrcMeta->tDim.iWidth % 3 > 1)
-    {
-      *pDstY++ = (uint16_t)((*pSrc32) & 0x3FF);
-      *pDstY++ = (uint16_t)((*pSrc32 >> 10) & 0x3FF);
-    }
-    else if(pSrcMeta->tDim.iWidth % 3 > 0)
-    {
-      *pDstY++ = (uint16_t)((*pSrc32) & 0x3FF);
+      if(pSrcMeta->tDim.iWidth % 3 > 1)
+      {
+        *pDstY++ = (uint16_t)((*pSrc32) & 0x3FF);
+        *pDstY++ = (uint16_t)((*pSrc32 >> 10) & 0x3FF);
+      }
+      else if(pSrcMeta->tDim.iWidth % 3 > 0)
+      {
+        *pDstY++ = (uint16_t)((*pSrc32) & 0x3FF);
+      }
     }
-  }
+  });
 
   pDstMeta->tFourCC = FOURCC(Y010);
 }
@@ -3295,31 +3218,34 @@ void RXXA_To_NV1X(AL_TBuffer const* pSrc, AL_TBuffer* pDst, uint8_t uHrzCScale,
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int h = 0; h < iHeightC; h++)
+  ConvertStripes(iHeightC, 1, [&](int iBeginRow, int iEndRow)
   {
-    uint32_t* pSrc32 = (uint32_t*)(pSrcData + pSrcMeta->tOffsetYC.iChroma + h * pSrcMeta->tPitches.iChroma);
-    uint8_t* pDstC = (uint8_t*)(pDstData + iDstSizeY + h * pDstMeta->tPitches.iChroma);
+    for(int h = iBeginRow; h < iEndRow; h++)
+    {
+      uint32_t* pSrc32 = (uint32_t*)(pSrcData + pSrcMeta->tOffsetYC.iChroma + h * pSrcMeta->tPitches.iChroma);
+      uint8_t* pDstC = (uint8_t*)(pDstData + iDstSizeY + h * pDstMeta->tPitches.iChroma);
 
-    int w = pSrcMeta->tDim.iWidth / 3;
+      int w = pSrcMeta->tDim.iWidth / 3;
 
-    while(w--)
-    {
-      *pDstC++ = (*pSrc32 >> 2) & 0xFF;
-      *pDstC++ = (*pSrc32 >> 12) & 0xFF;
-      *pDstC++ = (*pSrc32 >> 22) & 0xFF;
-      ++pSrc32;
-    }
+      while(w--)
+      {
+        *pDstC++ = (*pSrc32 >> 2) & 0xFF;
+        *pDstC++ = (*pSrc32 >> 12) & 0xFF;
+        *pDstC++ = (*pSrc32 >> 22) & 0xFF;
+        ++pSrc32;
+      }
 
-    if(pSrcMeta->tDim.iWidth % 3 > 1)
-    {
-      *pDstC++ = (*pSrc32 >> 2) & 0xFF;
-      *pDstC++ = (*pSrc32 >> 12) & 0xFF;
-    }
-    else if(pSrcMeta->tDim.iWidth % 3 > 0)
-    {
-      *pDstC++ = (*pSrc32 >> 2) & 0xFF;
+      if(pSrcMeta->tDim.iWidth % 3 > 1)
+      {
+        *pDstC++ = (*pSrc32 >> 2) & 0xFF;
+        *pDstC++ = (*pSrc32 >> 12) & 0xFF;
+      }
+      else if(pSrcMeta->tDim.iWidth % 3 > 0)
+      {
+        *pDstC++ = (*pSrc32 >> 2) & 0xFF;
+      }
     }
-  }
+  });
 
   SetFourCC(pDstMeta, FOURCC(NV12), FOURCC(NV16), uHrzCScale * uVrtCScale);
 }
@@ -3354,31 +3280,34 @@ static void RXXA_To_PX10(AL_TBuffer const* pSrc, AL_TBuffer* pDst, uint8_t uHrzC
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int h = 0; h < iHeightC; h++)
+  ConvertStripes(iHeightC, 1, [&](int iBeginRow, int iEndRow)
   {
-    uint32_t* pSrc32 = (uint32_t*)(pSrcData + pSrcMeta->tOffsetYC.iChroma + h * pSrcMeta->tPitches.iChroma);
-    uint16_t* pDstC = (uint16_t*)(pDstData + iDstSizeY + h * pDstMeta->tPitches.iChroma);
+    for(int h = iBeginRow; h < iEndRow; h++)
+    {
+      uint32_t* pSrc32 = (uint32_t*)(pSrcData + pSrcMeta->tOffsetYC.iChroma + h * pSrcMeta->tPitches.iChroma);
+      uint16_t* pDstC = (uint16_t*)(pDstData + iDstSizeY + h * pDstMeta->tPitches.iChroma);
 
-    int w = pSrcMeta->tDim.iWidth / 3;
+      int w = pSrcMeta->tDim.iWidth / 3;
 
-    while(w--)
-    {
-      *pDstC++ = (uint16_t)((*pSrc32) & 0x3FF);
-      *pDstC++ = (uint16_t)((*pSrc32 >> 10) & 0x3FF);
-      *pDstC++ = (uint16_t)((*pSrc32 >> 20) & 0x3FF);
-      ++pSrc32;
-    }
+      while(w--)
+      {
+        *pDstC++ = (uint16_t)((*pSrc32) & 0x3FF);
+        *pDstC++ = (uint16_t)((*pSrc32 >> 10) & 0x3FF);
+        *pDstC++ = (uint16_t)((*pSrc32 >> 20) & 0x3FF);
+        ++pSrc32;
+      }
 
-    if(pSrcMeta->tDim.iWidth % 3 > 1)
-    {
-      *pDstC++ = (uint16_t)((*pSrc32) & 0x3FF);
-      *pDstC++ = (uint16_t)((*pSrc32 >> 10) & 0x3FF);
-    }
-    else if(pSrcMeta->tDim.iWidth % 3 > 0)
-    {
-      *pDstC++ = (uint16_t)((*pSrc32) & 0x3FF);
+      if(pSrcMeta->tDim.iWidth % 3 > 1)
+      {
+        *pDstC++ = (uint16_t)((*pSrc32) & 0x3FF);
+        *pDstC++ = (uint16_t)((*pSrc32 >> 10) & 0x3FF);
+      }
+      else if(pSrcMeta->tDim.iWidth % 3 > 0)
+      {
+        *pDstC++ = (uint16_t)((*pSrc32) & 0x3FF);
+      }
     }
-  }
+  });
 
   SetFourCC(pDstMeta, FOURCC(P010), FOURCC(P210), uHrzCScale * uVrtCScale);
 }
@@ -3422,34 +3351,37 @@ static void RXXA_To_IXAL(AL_TBuffer const* pSrc, AL_TBuffer* pDst, uint8_t uHrzC
   uint8_t* pSrcData = AL_Buffer_GetData(pSrc);
   uint8_t* pDstData = AL_Buffer_GetData(pDst);
 
-  for(int h = 0; h < iHeightC; h++)
+  ConvertStripes(iHeightC, 1, [&](int iBeginRow, int iEndRow)
   {
-    uint32_t* pSrc32 = (uint32_t*)(pSrcData + pSrcMeta->tOffsetYC.iChroma + h * pSrcMeta->tPitches.iChroma);
-    uint16_t* pDstU = (uint16_t*)(pDstData + iDstSizeY + h * pDstMeta->tPitches.iChroma);
-    uint16_t* pDstV = pDstU + iDstSizeC;
+    for(int h = iBeginRow; h < iEndRow; h++)
+    {
+      uint32_t* pSrc32 = (uint32_t*)(pSrcData + pSrcMeta->tOffsetYC.iChroma + h * pSrcMeta->tPitches.iChroma);
+      uint16_t* pDstU = (uint16_t*)(pDstData + iDstSizeY + h * pDstMeta->tPitches.iChroma);
+      uint16_t* pDstV = pDstU + iDstSizeC;
 
-    int w = pSrcMeta->tDim.iWidth / 6;
+      int w = pSrcMeta->tDim.iWidth / 6;
 
-    while(w--)
-    {
-      Read30BitsOn32Bits(pSrc32, &pDstU, &pDstV);
-      ++pSrc32;
-      Read30BitsOn32Bits(pSrc32, &pDstV, &pDstU);
-      ++pSrc32;
-    }
+      while(w--)
+      {
+        Read30BitsOn32Bits(pSrc32, &pDstU, &pDstV);
+        ++pSrc32;
+        Read30BitsOn32Bits(pSrc32, &pDstV, &pDstU);
+        ++pSrc32;
+      }
 
-    if(pSrcMeta->tDim.iWidth % 6 > 2)
-    {
-      Read30BitsOn32Bits(pSrc32, &pDstU, &pDstV);
-      ++pSrc32;
-      *pDstV++ = (uint16_t)((*pSrc32) & 0x3FF);
-    }
-    else if(pSrcMeta->tDim.iWidth % 6 > 0)
-    {
-      *pDstU++ = (uint16_t)((*pSrc32) & 0x3FF);
-      *pDstV++ = (uint16_t)((*pSrc32 >> 10) & 0x3FF);
+      if(pSrcMeta->tDim.iWidth % 6 > 2)
+      {
+        Read30BitsOn32Bits(pSrc32, &pDstU, &pDstV);
+        ++pSrc32;
+        *pDstV++ = (uint16_t)((*pSrc32) & 0x3FF);
+      }
+      else if(pSrcMeta->tDim.iWidth % 6 > 0)
+      {
+        *pDstU++ = (uint16_t)((*pSrc32) & 0x3FF);
+        *pDstV++ = (uint16_t)((*pSrc32 >> 10) & 0x3FF);
+      }
     }
-  }
+  });
 
   SetFourCC(pDstMeta, FOURCC(I0AL), FOURCC(I2AL), uHrzCScale * uVrtCScale);
 }
@@ -3482,13 +3414,11 @@ static void NV1X_To_I42X(AL_TBuffer const* pSrc, AL_TBuffer* pDst, uint8_t uHrzC
   uint8_t* pBufIn = pSrcData;
   uint8_t* pBufOut = pDstData;
 
-  for(int iH = 0; iH < pDstMeta->tDim.iHeight; ++iH)
+  ConvertStripes(pDstMeta->tDim.iHeight, 1, [&](int iBeginRow, int iEndRow)
   {
-    memcpy(pBufOut, pBufIn, pDstMeta->tDim.iWidth);
-
-    pBufIn += pSrcMeta->tPitches.iLuma;
-    pBufOut += pDstMeta->tPitches.iLuma;
-  }
+    for(int iH = iBeginRow; iH < iEndRow; ++iH)
+      memcpy(pBufOut + iH * pDstMeta->tPitches.iLuma, pBufIn + iH * pSrcMeta->tPitches.iLuma, pDstMeta->tDim.iWidth);
+  });
 
   // Chroma
   uint8_t* pBufInC = pSrcData + pSrcMeta->tOffsetYC.iChroma;
@@ -3498,18 +3428,11 @@ static void NV1X_To_I42X(AL_TBuffer const* pSrc, AL_TBuffer* pDst, uint8_t uHrzC
   int iWidth = pDstMeta->tDim.iWidth / uHrzCScale;
   int iHeight = pDstMeta->tDim.iHeight / uVrtCScale;
 
-  for(int iH = 0; iH < iHeight; ++iH)
+  ConvertStripes(iHeight, 1, [&](int iBeginRow, int iEndRow)
   {
-    for(int iW = 0; iW < iWidth; ++iW)
-    {
-      pBufOutU[iW] = pBufInC[(iW << 1)];
-      pBufOutV[iW] = pBufInC[(iW << 1) + 1];
-    }
-
-    pBufInC += pSrcMeta->tPitches.iChroma;
-    pBufOutU += pDstMeta->tPitches.iChroma;
-    pBufOutV += pDstMeta->tPitches.iChroma;
-  }
+    for(int iH = iBeginRow; iH < iEndRow; ++iH)
+      GetConvKernels()->Deinterleave8(pBufInC + iH * pSrcMeta->tPitches.iChroma, pBufOutU + iH * pDstMeta->tPitches.iChroma, pBufOutV + iH * pDstMeta->tPitches.iChroma, iWidth);
+  });
 
   SetFourCC(pDstMeta, FOURCC(I420), FOURCC(I422), iCScale);
 }
@@ -3556,18 +3479,11 @@ static void NV1X_To_IXAL(AL_TBuffer const* pSrc, AL_TBuffer* pDst, uint8_t uHrzC
   int iWidth = pDstMeta->tDim.iWidth / uHrzCScale;
   int iHeight = pDstMeta->tDim.iHeight / uVrtCScale;
 
-  for(int iH = 0; iH < iHeight; ++iH)
+  ConvertStripes(iHeight, 1, [&](int iBeginRow, int iEndRow)
   {
-    for(int iW = 0; iW < iWidth; ++iW)
-    {
-      pBufOutU[iW] = ((uint16_t)pBufIn[(iW << 1)]) << 2;
-      pBufOutV[iW] = ((uint16_t)pBufIn[(iW << 1) + 1]) << 2;
-    }
-
-    pBufIn += pSrcMeta->tPitches.iChroma;
-    pBufOutU += iDstPitchChroma;
-    pBufOutV += iDstPitchChroma;
-  }
+    for(int iH = iBeginRow; iH < iEndRow; ++iH)
+      GetConvKernels()->Deinterleave8To10(pBufIn + iH * pSrcMeta->tPitches.iChroma, pBufOutU + iH * iDstPitchChroma, pBufOutV + iH * iDstPitchChroma, iWidth);
+  });
 
   SetFourCC(pDstMeta, FOURCC(I0AL), FOURCC(I2AL), iCScale);
 }
@@ -3610,14 +3526,11 @@ static void NV1X_To_PX10(AL_TBuffer const* pSrc, AL_TBuffer* pDst, uint8_t uHrzC
 
   int iDstPitchChroma = pDstMeta->tPitches.iChroma / sizeof(uint16_t);
 
-  for(int iH = 0; iH < iHeight; ++iH)
+  ConvertStripes(iHeight, 1, [&](int iBeginRow, int iEndRow)
   {
-    for(int iW = 0; iW < iWidth; ++iW)
-      pBufOut[iW] = ((uint16_t)pBufIn[iW]) << 2;
-
-    pBufIn += pSrcMeta->tPitches.iChroma;
-    pBufOut += iDstPitchChroma;
-  }
+    for(int iH = iBeginRow; iH < iEndRow; ++iH)
+      GetConvKernels()->Widen8To10(pBufIn + iH * pSrcMeta->tPitches.iChroma, pBufOut + iH * iDstPitchChroma, iWidth);
+  });
 
   SetFourCC(pDstMeta, FOURCC(P010), FOURCC(P210), uHrzCScale * uVrtCScale);
 }
@@ -3650,31 +3563,30 @@ static void NV1X_To_RXXA(AL_TBuffer const* pSrc, AL_TBuffer* pDst, uint8_t uHrzC
   int iHeightC = pSrcMeta->tDim.iHeight / uVrtCScale;
   int iDstSizeY = pDstMeta->tDim.iHeight * pDstMeta->tPitches.iLuma;
 
-  for(int h = 0; h < iHeightC; h++)
+  ConvertStripes(iHeightC, 1, [&](int iBeginRow, int iEndRow)
   {
-    uint32_t* pDst32 = (uint32_t*)(pDstData + iDstSizeY + h * pDstMeta->tPitches.iChroma);
-    uint8_t* pSrcC = (uint8_t*)(pSrcData + pSrcMeta->tOffsetYC.iChroma + h * pSrcMeta->tPitches.iChroma);
+    for(int h = iBeginRow; h < iEndRow; h++)
+    {
+      uint32_t* pDst32 = (uint32_t*)(pDstData + iDstSizeY + h * pDstMeta->tPitches.iChroma);
+      uint8_t* pSrcC = (uint8_t*)(pSrcData + pSrcMeta->tOffsetYC.iChroma + h * pSrcMeta->tPitches.iChroma);
 
-    int w = pSrcMeta->tDim.iWidth / 3;
+      int w = pSrcMeta->tDim.iWidth / 3;
 
-    while(w--)
-    {
-      *pDst32 = ((uint32_t)*pSrcC++) << 2;
-      *pDst32 |= ((uint32_t)*pSrcC++) << 12;
-      *pDst32 |= ((uint32_t)*pSrcC++) << 22;
-      ++pDst32;
-    }
+      GetConvKernels()->Pack8To10(pSrcC, pDst32, w);
+      pSrcC += 3 * w;
+      pDst32 += w;
 
-    if(pSrcMeta->tDim.iWidth % 3 > 1)
-    {
-      *pDst32 = ((uint32_t)*pSrcC++) << 2;
-      *pDst32 |= ((uint32_t)*pSrcC++) << 12;
-    }
-    else if(pSrcMeta->tDim.iWidth % 3 > 0)
-    {
-      *pDst32 = ((uint32_t)*pSrcC++) << 2;
+      if(pSrcMeta->tDim.iWidth % 3 > 1)
+      {
+        *pDst32 = ((uint32_t)*pSrcC++) << 2;
+        *pDst32 |= ((uint32_t)*pSrcC++) << 12;
+      }
+      else if(pSrcMeta->tDim.iWidth % 3 > 0)
+      {
+        *pDst32 = ((uint32_t)*pSrcC++) << 2;
+      }
     }
-  }
+  });
 
   SetFourCC(pDstMeta, FOURCC(RX0A), FOURCC(RX2A), uHrzCScale * uVrtCScale);
 }
@@ -3705,12 +3617,11 @@ void Y800_To_Y800(AL_TBuffer const* pSrc, AL_TBuffer* pDst)
   uint8_t* pBufIn = AL_Buffer_GetData(pSrc);
   uint8_t* pBufOut = AL_Buffer_GetData(pDst);
 
-  for(int iH = 0; iH < pDstMeta->tDim.iHeight; ++iH)
+  ConvertStripes(pDstMeta->tDim.iHeight, 1, [&](int iBeginRow, int iEndRow)
   {
-    memcpy(pBufOut, pBufIn, pDstMeta->tDim.iWidth);
-    pBufIn += pSrcMeta->tPitches.iLuma;
-    pBufOut += pDstMeta->tPitches.iLuma;
-  }
+    for(int iH = iBeginRow; iH < iEndRow; ++iH)
+      memcpy(pBufOut + iH * pDstMeta->tPitches.iLuma, pBufIn + iH * pSrcMeta->tPitches.iLuma, pDstMeta->tDim.iWidth);
+  });
 }
 
 /*@}*/
@@ -0,0 +1,919 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+/****************************************************************************
+   -----------------------------------------------------------------------------
+ **************************************************************************//*!
+   \addtogroup lib_base
+   @{
+   \file
+ *****************************************************************************/
+
+#include <cstdlib>
+#include <cstring>
+
+#include "convert_kernels.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CONV_KERNELS_X86 1
+#include <immintrin.h>
+#define TARGET_SSE4 __attribute__((target("sse4.1")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(__aarch64__)
+#define CONV_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+/****************************************************************************/
+/* Plain C                                                                  */
+/****************************************************************************/
+static void Widen8To10_C(uint8_t const* pIn, uint16_t* pOut, int iNum)
+{
+  for(int i = 0; i < iNum; ++i)
+    pOut[i] = ((uint16_t)pIn[i]) << 2;
+}
+
+/****************************************************************************/
+/* rounded, saturated near full scale: 1022 and 1023 give 255, not 0 */
+static inline uint8_t Round10To8(uint16_t uVal)
+{
+  return (uVal >= 0x3FC) ? 0xFF : (uint8_t)((uVal + 2) >> 2);
+}
+
+/****************************************************************************/
+static void Narrow10To8_C(uint16_t const* pIn, uint8_t* pOut, int iNum)
+{
+  for(int i = 0; i < iNum; ++i)
+    pOut[i] = Round10To8(pIn[i]);
+}
+
+/****************************************************************************/
+static void Interleave8_C(uint8_t const* pU, uint8_t const* pV, uint8_t* pOut, int iNum)
+{
+  for(int i = 0; i < iNum; ++i)
+  {
+    pOut[2 * i] = pU[i];
+    pOut[2 * i + 1] = pV[i];
+  }
+}
+
+/****************************************************************************/
+static void Interleave16_C(uint16_t const* pU, uint16_t const* pV, uint16_t* pOut, int iNum)
+{
+  for(int i = 0; i < iNum; ++i)
+  {
+    pOut[2 * i] = pU[i];
+    pOut[2 * i + 1] = pV[i];
+  }
+}
+
+/****************************************************************************/
+static void Interleave8To10_C(uint8_t const* pU, uint8_t const* pV, uint16_t* pOut, int iNum)
+{
+  for(int i = 0; i < iNum; ++i)
+  {
+    pOut[2 * i] = ((uint16_t)pU[i]) << 2;
+    pOut[2 * i + 1] = ((uint16_t)pV[i]) << 2;
+  }
+}
+
+/****************************************************************************/
+static void Interleave10To8_C(uint16_t const* pU, uint16_t const* pV, uint8_t* pOut, int iNum)
+{
+  for(int i = 0; i < iNum; ++i)
+  {
+    pOut[2 * i] = Round10To8(pU[i]);
+    pOut[2 * i + 1] = Round10To8(pV[i]);
+  }
+}
+
+/****************************************************************************/
+static void Deinterleave8_C(uint8_t const* pIn, uint8_t* pU, uint8_t* pV, int iNum)
+{
+  for(int i = 0; i < iNum; ++i)
+  {
+    pU[i] = pIn[2 * i];
+    pV[i] = pIn[2 * i + 1];
+  }
+}
+
+/****************************************************************************/
+static void Deinterleave16_C(uint16_t const* pIn, uint16_t* pU, uint16_t* pV, int iNum)
+{
+  for(int i = 0; i < iNum; ++i)
+  {
+    pU[i] = pIn[2 * i];
+    pV[i] = pIn[2 * i + 1];
+  }
+}
+
+/****************************************************************************/
+static void Deinterleave8To10_C(uint8_t const* pIn, uint16_t* pU, uint16_t* pV, int iNum)
+{
+  for(int i = 0; i < iNum; ++i)
+  {
+    pU[i] = ((uint16_t)pIn[2 * i]) << 2;
+    pV[i] = ((uint16_t)pIn[2 * i + 1]) << 2;
+  }
+}
+
+/****************************************************************************/
+static void Deinterleave10To8_C(uint16_t const* pIn, uint8_t* pU, uint8_t* pV, int iNum)
+{
+  for(int i = 0; i < iNum; ++i)
+  {
+    pU[i] = Round10To8(pIn[2 * i]);
+    pV[i] = Round10To8(pIn[2 * i + 1]);
+  }
+}
+
+/****************************************************************************/
+static void Pack8To10_C(uint8_t const* pIn, uint32_t* pOut, int iNum)
+{
+  for(int i = 0; i < iNum; ++i)
+  {
+    pOut[i] = ((uint32_t)pIn[0]) << 2;
+    pOut[i] |= ((uint32_t)pIn[1]) << 12;
+    pOut[i] |= ((uint32_t)pIn[2]) << 22;
+    pIn += 3;
+  }
+}
+
+/****************************************************************************/
+static void Pack10_C(uint16_t const* pIn, uint32_t* pOut, int iNum, uint32_t uMask)
+{
+  for(int i = 0; i < iNum; ++i)
+  {
+    pOut[i] = ((uint32_t)pIn[0] & uMask);
+    pOut[i] |= ((uint32_t)pIn[1] & uMask) << 10;
+    pOut[i] |= ((uint32_t)pIn[2] & uMask) << 20;
+    pIn += 3;
+  }
+}
+
+/****************************************************************************/
+static void Unpack10To8_C(uint32_t const* pIn, uint8_t* pOut, int iNum)
+{
+  for(int i = 0; i < iNum; ++i)
+  {
+    *pOut++ = (pIn[i] >> 2) & 0xFF;
+    *pOut++ = (pIn[i] >> 12) & 0xFF;
+    *pOut++ = (pIn[i] >> 22) & 0xFF;
+  }
+}
+
+/****************************************************************************/
+static void Unpack10To10_C(uint32_t const* pIn, uint16_t* pOut, int iNum)
+{
+  for(int i = 0; i < iNum; ++i)
+  {
+    *pOut++ = (uint16_t)((pIn[i]) & 0x3FF);
+    *pOut++ = (uint16_t)((pIn[i] >> 10) & 0x3FF);
+    *pOut++ = (uint16_t)((pIn[i] >> 20) & 0x3FF);
+  }
+}
+
+/****************************************************************************/
+static void Untile8_C(uint8_t const* pIn, uint8_t* pOut, int iPitch, int iNum)
+{
+  for(int i = 0; i < iNum; ++i)
+  {
+    for(int iRow = 0; iRow < 4; ++iRow)
+      memcpy(pOut + iRow * iPitch + 4 * i, pIn + 4 * iRow, 4);
+
+    pIn += 16;
+  }
+}
+
+/****************************************************************************/
+static void Untile10_C(uint16_t const* pIn, uint16_t* pOut, int iPitch, int iNum)
+{
+  for(int i = 0; i < iNum; ++i)
+  {
+    uint16_t* pOutB = pOut + 4 * i;
+
+    pOutB[0] = pIn[0] & 0x3FF;
+    pOutB[1] = ((pIn[0] >> 10) | (pIn[1] << 6)) & 0x3FF;
+    pOutB[2] = (pIn[1] >> 4) & 0x3FF;
+    pOutB[3] = ((pIn[1] >> 14) | (pIn[2] << 2)) & 0x3FF;
+    pOutB += iPitch;
+    pOutB[0] = ((pIn[2] >> 8) | (pIn[3] << 8)) & 0x3FF;
+    pOutB[1] = (pIn[3] >> 2) & 0x3FF;
+    pOutB[2] = ((pIn[3] >> 12) | (pIn[4] << 4)) & 0x3FF;
+    pOutB[3] = pIn[4] >> 6;
+    pOutB += iPitch;
+    pOutB[0] = pIn[5] & 0x3FF;
+    pOutB[1] = ((pIn[5] >> 10) | (pIn[6] << 6)) & 0x3FF;
+    pOutB[2] = (pIn[6] >> 4) & 0x3FF;
+    pOutB[3] = ((pIn[6] >> 14) | (pIn[7] << 2)) & 0x3FF;
+    pOutB += iPitch;
+    pOutB[0] = ((pIn[7] >> 8) | (pIn[8] << 8)) & 0x3FF;
+    pOutB[1] = (pIn[8] >> 2) & 0x3FF;
+    pOutB[2] = ((pIn[8] >> 12) | (pIn[9] << 4)) & 0x3FF;
+    pOutB[3] = pIn[9] >> 6;
+    pIn += 10;
+  }
+}
+
+static TConvKernels const s_tKernelsC =
+{
+  Widen8To10_C,
+  Narrow10To8_C,
+  Interleave8_C,
+  Interleave16_C,
+  Interleave8To10_C,
+  Interleave10To8_C,
+  Deinterleave8_C,
+  Deinterleave16_C,
+  Deinterleave8To10_C,
+  Deinterleave10To8_C,
+  Pack8To10_C,
+  Pack10_C,
+  Unpack10To8_C,
+  Unpack10To10_C,
+  Untile8_C,
+  Untile10_C,
+  "c",
+};
+
+#if CONV_KERNELS_X86
+/****************************************************************************/
+/* SSE4.1                                                                   */
+/****************************************************************************/
+#define LOAD128(p) _mm_loadu_si128((__m128i const*)(p))
+#define STORE128(p, v) _mm_storeu_si128((__m128i*)(p), v)
+
+/* (x + 2) >> 2 on 16 bits lanes, saturated to 255 like the C version */
+static inline TARGET_SSE4 __m128i Narrow_SSE4(__m128i v)
+{
+  v = _mm_srli_epi16(_mm_adds_epu16(v, _mm_set1_epi16(2)), 2);
+  return _mm_min_epu16(v, _mm_set1_epi16(0xFF));
+}
+
+/****************************************************************************/
+static TARGET_SSE4 void Widen8To10_SSE4(uint8_t const* pIn, uint16_t* pOut, int iNum)
+{
+  int i = 0;
+
+  for(; i + 16 <= iNum; i += 16)
+  {
+    __m128i v = LOAD128(pIn + i);
+    STORE128(pOut + i, _mm_slli_epi16(_mm_cvtepu8_epi16(v), 2));
+    STORE128(pOut + i + 8, _mm_slli_epi16(_mm_cvtepu8_epi16(_mm_srli_si128(v, 8)), 2));
+  }
+
+  Widen8To10_C(pIn + i, pOut + i, iNum - i);
+}
+
+/****************************************************************************/
+static TARGET_SSE4 void Narrow10To8_SSE4(uint16_t const* pIn, uint8_t* pOut, int iNum)
+{
+  int i = 0;
+
+  for(; i + 16 <= iNum; i += 16)
+  {
+    __m128i a = Narrow_SSE4(LOAD128(pIn + i));
+    __m128i b = Narrow_SSE4(LOAD128(pIn + i + 8));
+    STORE128(pOut + i, _mm_packus_epi16(a, b));
+  }
+
+  Narrow10To8_C(pIn + i, pOut + i, iNum - i);
+}
+
+/****************************************************************************/
+static TARGET_SSE4 void Interleave8_SSE4(uint8_t const* pU, uint8_t const* pV, uint8_t* pOut, int iNum)
+{
+  int i = 0;
+
+  for(; i + 16 <= iNum; i += 16)
+  {
+    __m128i u = LOAD128(pU + i);
+    __m128i v = LOAD128(pV + i);
+    STORE128(pOut + 2 * i, _mm_unpacklo_epi8(u, v));
+    STORE128(pOut + 2 * i + 16, _mm_unpackhi_epi8(u, v));
+  }
+
+  Interleave8_C(pU + i, pV + i, pOut + 2 * i, iNum - i);
+}
+
+/****************************************************************************/
+static TARGET_SSE4 void Interleave16_SSE4(uint16_t const* pU, uint16_t const* pV, uint16_t* pOut, int iNum)
+{
+  int i = 0;
+
+  for(; i + 8 <= iNum; i += 8)
+  {
+    __m128i u = LOAD128(pU + i);
+    __m128i v = LOAD128(pV + i);
+    STORE128(pOut + 2 * i, _mm_unpacklo_epi16(u, v));
+    STORE128(pOut + 2 * i + 8, _mm_unpackhi_epi16(u, v));
+  }
+
+  Interleave16_C(pU + i, pV + i, pOut + 2 * i, iNum - i);
+}
+
+/****************************************************************************/
+static TARGET_SSE4 void Interleave8To10_SSE4(uint8_t const* pU, uint8_t const* pV, uint16_t* pOut, int iNum)
+{
+  int i = 0;
+
+  for(; i + 16 <= iNum; i += 16)
+  {
+    __m128i u = LOAD128(pU + i);
+    __m128i v = LOAD128(pV + i);
+    __m128i lo = _mm_unpacklo_epi8(u, v);
+    __m128i hi = _mm_unpackhi_epi8(u, v);
+    STORE128(pOut + 2 * i, _mm_slli_epi16(_mm_cvtepu8_epi16(lo), 2));
+    STORE128(pOut + 2 * i + 8, _mm_slli_epi16(_mm_cvtepu8_epi16(_mm_srli_si128(lo, 8)), 2));
+    STORE128(pOut + 2 * i + 16, _mm_slli_epi16(_mm_cvtepu8_epi16(hi), 2));
+    STORE128(pOut + 2 * i + 24, _mm_slli_epi16(_mm_cvtepu8_epi16(_mm_srli_si128(hi, 8)), 2));
+  }
+
+  Interleave8To10_C(pU + i, pV + i, pOut + 2 * i, iNum - i);
+}
+
+/****************************************************************************/
+static TARGET_SSE4 void Interleave10To8_SSE4(uint16_t const* pU, uint16_t const* pV, uint8_t* pOut, int iNum)
+{
+  int i = 0;
+
+  for(; i + 8 <= iNum; i += 8)
+  {
+    __m128i u = Narrow_SSE4(LOAD128(pU + i));
+    __m128i v = Narrow_SSE4(LOAD128(pV + i));
+    STORE128(pOut + 2 * i, _mm_or_si128(u, _mm_slli_epi16(v, 8)));
+  }
+
+  Interleave10To8_C(pU + i, pV + i, pOut + 2 * i, iNum - i);
+}
+
+/****************************************************************************/
+static TARGET_SSE4 void Deinterleave8_SSE4(uint8_t const* pIn, uint8_t* pU, uint8_t* pV, int iNum)
+{
+  __m128i const mask = _mm_set1_epi16(0xFF);
+  int i = 0;
+
+  for(; i + 16 <= iNum; i += 16)
+  {
+    __m128i a = LOAD128(pIn + 2 * i);
+    __m128i b = LOAD128(pIn + 2 * i + 16);
+    STORE128(pU + i, _mm_packus_epi16(_mm_and_si128(a, mask), _mm_and_si128(b, mask)));
+    STORE128(pV + i, _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8)));
+  }
+
+  Deinterleave8_C(pIn + 2 * i, pU + i, pV + i, iNum - i);
+}
+
+/****************************************************************************/
+static TARGET_SSE4 void Deinterleave16_SSE4(uint16_t const* pIn, uint16_t* pU, uint16_t* pV, int iNum)
+{
+  __m128i const mask = _mm_set1_epi32(0xFFFF);
+  int i = 0;
+
+  for(; i + 8 <= iNum; i += 8)
+  {
+    __m128i a = LOAD128(pIn + 2 * i);
+    __m128i b = LOAD128(pIn + 2 * i + 8);
+    STORE128(pU + i, _mm_packus_epi32(_mm_and_si128(a, mask), _mm_and_si128(b, mask)));
+    STORE128(pV + i, _mm_packus_epi32(_mm_srli_epi32(a, 16), _mm_srli_epi32(b, 16)));
+  }
+
+  Deinterleave16_C(pIn + 2 * i, pU + i, pV + i, iNum - i);
+}
+
+/****************************************************************************/
+static TARGET_SSE4 void Deinterleave8To10_SSE4(uint8_t const* pIn, uint16_t* pU, uint16_t* pV, int iNum)
+{
+  __m128i const mask = _mm_set1_epi16(0xFF);
+  int i = 0;
+
+  for(; i + 8 <= iNum; i += 8)
+  {
+    __m128i a = LOAD128(pIn + 2 * i);
+    STORE128(pU + i, _mm_slli_epi16(_mm_and_si128(a, mask), 2));
+    STORE128(pV + i, _mm_slli_epi16(_mm_srli_epi16(a, 8), 2));
+  }
+
+  Deinterleave8To10_C(pIn + 2 * i, pU + i, pV + i, iNum - i);
+}
+
+/****************************************************************************/
+static TARGET_SSE4 void Deinterleave10To8_SSE4(uint16_t const* pIn, uint8_t* pU, uint8_t* pV, int iNum)
+{
+  __m128i const shuffle = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+  int i = 0;
+
+  for(; i + 8 <= iNum; i += 8)
+  {
+    __m128i a = Narrow_SSE4(LOAD128(pIn + 2 * i));
+    __m128i b = Narrow_SSE4(LOAD128(pIn + 2 * i + 8));
+    __m128i uv = _mm_shuffle_epi8(_mm_packus_epi16(a, b), shuffle);
+    _mm_storel_epi64((__m128i*)(pU + i), uv);
+    _mm_storel_epi64((__m128i*)(pV + i), _mm_srli_si128(uv, 8));
+  }
+
+  Deinterleave10To8_C(pIn + 2 * i, pU + i, pV + i, iNum - i);
+}
+
+/****************************************************************************/
+static TARGET_SSE4 void Pack8To10_SSE4(uint8_t const* pIn, uint32_t* pOut, int iNum)
+{
+  __m128i const shuffle0 = _mm_setr_epi8(0, -1, -1, -1, 3, -1, -1, -1, 6, -1, -1, -1, 9, -1, -1, -1);
+  __m128i const shuffle1 = _mm_setr_epi8(1, -1, -1, -1, 4, -1, -1, -1, 7, -1, -1, -1, 10, -1, -1, -1);
+  __m128i const shuffle2 = _mm_setr_epi8(2, -1, -1, -1, 5, -1, -1, -1, 8, -1, -1, -1, 11, -1, -1, -1);
+  int i = 0;
+
+  // 4 words use 12 input bytes, but we load 16 of them
+  for(; i + 6 <= iNum; i += 4)
+  {
+    __m128i v = LOAD128(pIn + 3 * i);
+    __m128i w = _mm_slli_epi32(_mm_shuffle_epi8(v, shuffle0), 2);
+    w = _mm_or_si128(w, _mm_slli_epi32(_mm_shuffle_epi8(v, shuffle1), 12));
+    w = _mm_or_si128(w, _mm_slli_epi32(_mm_shuffle_epi8(v, shuffle2), 22));
+    STORE128(pOut + i, w);
+  }
+
+  Pack8To10_C(pIn + 3 * i, pOut + i, iNum - i);
+}
+
+/****************************************************************************/
+static TARGET_SSE4 void Pack10_SSE4(uint16_t const* pIn, uint32_t* pOut, int iNum, uint32_t uMask)
+{
+  __m128i const shuffleA0 = _mm_setr_epi8(0, 1, -1, -1, 6, 7, -1, -1, 12, 13, -1, -1, -1, -1, -1, -1);
+  __m128i const shuffleB0 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 3, -1, -1);
+  __m128i const shuffleA1 = _mm_setr_epi8(2, 3, -1, -1, 8, 9, -1, -1, 14, 15, -1, -1, -1, -1, -1, -1);
+  __m128i const shuffleB1 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 4, 5, -1, -1);
+  __m128i const shuffleA2 = _mm_setr_epi8(4, 5, -1, -1, 10, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+  __m128i const shuffleB2 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, 0, 1, -1, -1, 6, 7, -1, -1);
+  __m128i const mask = _mm_set1_epi32((int)uMask);
+  int i = 0;
+
+  for(; i + 4 <= iNum; i += 4)
+  {
+    __m128i a = LOAD128(pIn + 3 * i);
+    __m128i b = _mm_loadl_epi64((__m128i const*)(pIn + 3 * i + 8));
+    __m128i s0 = _mm_or_si128(_mm_shuffle_epi8(a, shuffleA0), _mm_shuffle_epi8(b, shuffleB0));
+    __m128i s1 = _mm_or_si128(_mm_shuffle_epi8(a, shuffleA1), _mm_shuffle_epi8(b, shuffleB1));
+    __m128i s2 = _mm_or_si128(_mm_shuffle_epi8(a, shuffleA2), _mm_shuffle_epi8(b, shuffleB2));
+    __m128i w = _mm_and_si128(s0, mask);
+    w = _mm_or_si128(w, _mm_slli_epi32(_mm_and_si128(s1, mask), 10));
+    w = _mm_or_si128(w, _mm_slli_epi32(_mm_and_si128(s2, mask), 20));
+    STORE128(pOut + i, w);
+  }
+
+  Pack10_C(pIn + 3 * i, pOut + i, iNum - i, uMask);
+}
+
+/****************************************************************************/
+static TARGET_SSE4 void Unpack10To8_SSE4(uint32_t const* pIn, uint8_t* pOut, int iNum)
+{
+  __m128i const mask = _mm_set1_epi32(0xFF);
+  __m128i const shuffle = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+  int i = 0;
+
+  for(; i + 4 <= iNum; i += 4)
+  {
+    __m128i w = LOAD128(pIn + i);
+    __m128i t = _mm_and_si128(_mm_srli_epi32(w, 2), mask);
+    t = _mm_or_si128(t, _mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(w, 12), mask), 8));
+    t = _mm_or_si128(t, _mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(w, 22), mask), 16));
+    t = _mm_shuffle_epi8(t, shuffle);
+
+    int32_t iLast = _mm_cvtsi128_si32(_mm_srli_si128(t, 8));
+    _mm_storel_epi64((__m128i*)(pOut + 3 * i), t);
+    memcpy(pOut + 3 * i + 8, &iLast, sizeof(iLast));
+  }
+
+  Unpack10To8_C(pIn + i, pOut + 3 * i, iNum - i);
+}
+
+/****************************************************************************/
+static TARGET_SSE4 void Unpack10To10_SSE4(uint32_t const* pIn, uint16_t* pOut, int iNum)
+{
+  __m128i const mask = _mm_set1_epi32(0x3FF);
+  __m128i const shuffleAB0 = _mm_setr_epi8(0, 1, 2, 3, -1, -1, 4, 5, 6, 7, -1, -1, 8, 9, 10, 11);
+  __m128i const shuffleC0 = _mm_setr_epi8(-1, -1, -1, -1, 0, 1, -1, -1, -1, -1, 2, 3, -1, -1, -1, -1);
+  __m128i const shuffleAB1 = _mm_setr_epi8(-1, -1, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+  __m128i const shuffleC1 = _mm_setr_epi8(4, 5, -1, -1, -1, -1, 6, 7, -1, -1, -1, -1, -1, -1, -1, -1);
+  int i = 0;
+
+  for(; i + 4 <= iNum; i += 4)
+  {
+    __m128i w = LOAD128(pIn + i);
+    __m128i a = _mm_and_si128(w, mask);
+    __m128i b = _mm_and_si128(_mm_srli_epi32(w, 10), mask);
+    __m128i c = _mm_and_si128(_mm_srli_epi32(w, 20), mask);
+    __m128i ab = _mm_or_si128(a, _mm_slli_epi32(b, 16));
+    __m128i cc = _mm_packus_epi32(c, c);
+
+    STORE128(pOut + 3 * i, _mm_or_si128(_mm_shuffle_epi8(ab, shuffleAB0), _mm_shuffle_epi8(cc, shuffleC0)));
+    _mm_storel_epi64((__m128i*)(pOut + 3 * i + 8), _mm_or_si128(_mm_shuffle_epi8(ab, shuffleAB1), _mm_shuffle_epi8(cc, shuffleC1)));
+  }
+
+  Unpack10To10_C(pIn + i, pOut + 3 * i, iNum - i);
+}
+
+/****************************************************************************/
+static TARGET_SSE4 void Untile8_SSE4(uint8_t const* pIn, uint8_t* pOut, int iPitch, int iNum)
+{
+  int i = 0;
+
+  // each block holds 4 rows of 4 bytes: transpose 4 blocks at a time
+  for(; i + 4 <= iNum; i += 4)
+  {
+    __m128i r0 = LOAD128(pIn + 16 * i);
+    __m128i r1 = LOAD128(pIn + 16 * i + 16);
+    __m128i r2 = LOAD128(pIn + 16 * i + 32);
+    __m128i r3 = LOAD128(pIn + 16 * i + 48);
+    __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+    __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+    __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+    __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+    STORE128(pOut + 4 * i, _mm_unpacklo_epi64(t0, t1));
+    STORE128(pOut + iPitch + 4 * i, _mm_unpackhi_epi64(t0, t1));
+    STORE128(pOut + 2 * iPitch + 4 * i, _mm_unpacklo_epi64(t2, t3));
+    STORE128(pOut + 3 * iPitch + 4 * i, _mm_unpackhi_epi64(t2, t3));
+  }
+
+  Untile8_C(pIn + 16 * i, pOut + 4 * i, iPitch, iNum - i);
+}
+
+/****************************************************************************/
+static TARGET_SSE4 void Untile10_SSE4(uint16_t const* pIn, uint16_t* pOut, int iPitch, int iNum)
+{
+  /* a block is a little endian stream of 16 x 10 bits samples (20 bytes).
+   * Gather the 2 bytes holding each sample, then align it on bit 6 with a
+   * per lane multiplication before the final shift */
+  __m128i const shuffleLo = _mm_setr_epi8(0, 1, 1, 2, 2, 3, 3, 4, 5, 6, 6, 7, 7, 8, 8, 9);
+  __m128i const shuffleHi = _mm_setr_epi8(6, 7, 7, 8, 8, 9, 9, 10, 11, 12, 12, 13, 13, 14, 14, 15);
+  __m128i const align = _mm_setr_epi16(64, 16, 4, 1, 64, 16, 4, 1);
+
+  for(int i = 0; i < iNum; ++i)
+  {
+    uint8_t const* pBlock = (uint8_t const*)(pIn + 10 * i);
+    __m128i lo = _mm_shuffle_epi8(LOAD128(pBlock), shuffleLo);
+    __m128i hi = _mm_shuffle_epi8(LOAD128(pBlock + 4), shuffleHi);
+    lo = _mm_srli_epi16(_mm_mullo_epi16(lo, align), 6);
+    hi = _mm_srli_epi16(_mm_mullo_epi16(hi, align), 6);
+
+    uint16_t* pOutB = pOut + 4 * i;
+    _mm_storel_epi64((__m128i*)pOutB, lo);
+    _mm_storel_epi64((__m128i*)(pOutB + iPitch), _mm_srli_si128(lo, 8));
+    _mm_storel_epi64((__m128i*)(pOutB + 2 * iPitch), hi);
+    _mm_storel_epi64((__m128i*)(pOutB + 3 * iPitch), _mm_srli_si128(hi, 8));
+  }
+}
+
+/****************************************************************************/
+/* AVX2                                                                     */
+/****************************************************************************/
+#define LOAD256(p) _mm256_loadu_si256((__m256i const*)(p))
+#define STORE256(p, v) _mm256_storeu_si256((__m256i*)(p), v)
+
+static inline TARGET_AVX2 __m256i Narrow_AVX2(__m256i v)
+{
+  v = _mm256_srli_epi16(_mm256_adds_epu16(v, _mm256_set1_epi16(2)), 2);
+  return _mm256_min_epu16(v, _mm256_set1_epi16(0xFF));
+}
+
+/****************************************************************************/
+static TARGET_AVX2 void Widen8To10_AVX2(uint8_t const* pIn, uint16_t* pOut, int iNum)
+{
+  int i = 0;
+
+  for(; i + 32 <= iNum; i += 32)
+  {
+    STORE256(pOut + i, _mm256_slli_epi16(_mm256_cvtepu8_epi16(LOAD128(pIn + i)), 2));
+    STORE256(pOut + i + 16, _mm256_slli_epi16(_mm256_cvtepu8_epi16(LOAD128(pIn + i + 16)), 2));
+  }
+
+  Widen8To10_SSE4(pIn + i, pOut + i, iNum - i);
+}
+
+/****************************************************************************/
+static TARGET_AVX2 void Narrow10To8_AVX2(uint16_t const* pIn, uint8_t* pOut, int iNum)
+{
+  int i = 0;
+
+  for(; i + 32 <= iNum; i += 32)
+  {
+    __m256i a = Narrow_AVX2(LOAD256(pIn + i));
+    __m256i b = Narrow_AVX2(LOAD256(pIn + i + 16));
+    // packus works per 128 bits lane: restore the sample order
+    STORE256(pOut + i, _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8));
+  }
+
+  Narrow10To8_SSE4(pIn + i, pOut + i, iNum - i);
+}
+
+/****************************************************************************/
+static TARGET_AVX2 void Interleave8_AVX2(uint8_t const* pU, uint8_t const* pV, uint8_t* pOut, int iNum)
+{
+  int i = 0;
+
+  for(; i + 32 <= iNum; i += 32)
+  {
+    __m256i u = LOAD256(pU + i);
+    __m256i v = LOAD256(pV + i);
+    __m256i lo = _mm256_unpacklo_epi8(u, v);
+    __m256i hi = _mm256_unpackhi_epi8(u, v);
+    STORE256(pOut + 2 * i, _mm256_permute2x128_si256(lo, hi, 0x20));
+    STORE256(pOut + 2 * i + 32, _mm256_permute2x128_si256(lo, hi, 0x31));
+  }
+
+  Interleave8_SSE4(pU + i, pV + i, pOut + 2 * i, iNum - i);
+}
+
+/****************************************************************************/
+static TARGET_AVX2 void Deinterleave8_AVX2(uint8_t const* pIn, uint8_t* pU, uint8_t* pV, int iNum)
+{
+  __m256i const mask = _mm256_set1_epi16(0xFF);
+  int i = 0;
+
+  for(; i + 32 <= iNum; i += 32)
+  {
+    __m256i a = LOAD256(pIn + 2 * i);
+    __m256i b = LOAD256(pIn + 2 * i + 32);
+    __m256i u = _mm256_packus_epi16(_mm256_and_si256(a, mask), _mm256_and_si256(b, mask));
+    __m256i v = _mm256_packus_epi16(_mm256_srli_epi16(a, 8), _mm256_srli_epi16(b, 8));
+    STORE256(pU + i, _mm256_permute4x64_epi64(u, 0xD8));
+    STORE256(pV + i, _mm256_permute4x64_epi64(v, 0xD8));
+  }
+
+  Deinterleave8_SSE4(pIn + 2 * i, pU + i, pV + i, iNum - i);
+}
+
+#endif
+
+#if CONV_KERNELS_NEON
+/****************************************************************************/
+/* NEON                                                                     */
+/****************************************************************************/
+static void Widen8To10_NEON(uint8_t const* pIn, uint16_t* pOut, int iNum)
+{
+  int i = 0;
+
+  for(; i + 8 <= iNum; i += 8)
+    vst1q_u16(pOut + i, vshll_n_u8(vld1_u8(pIn + i), 2));
+
+  Widen8To10_C(pIn + i, pOut + i, iNum - i);
+}
+
+/****************************************************************************/
+static void Narrow10To8_NEON(uint16_t const* pIn, uint8_t* pOut, int iNum)
+{
+  int i = 0;
+
+  // the rounding shift does not overflow and the narrowing saturates like the C version
+  for(; i + 8 <= iNum; i += 8)
+    vst1_u8(pOut + i, vqmovn_u16(vrshrq_n_u16(vld1q_u16(pIn + i), 2)));
+
+  Narrow10To8_C(pIn + i, pOut + i, iNum - i);
+}
+
+/****************************************************************************/
+static void Interleave8_NEON(uint8_t const* pU, uint8_t const* pV, uint8_t* pOut, int iNum)
+{
+  int i = 0;
+
+  for(; i + 16 <= iNum; i += 16)
+  {
+    uint8x16x2_t uv = { { vld1q_u8(pU + i), vld1q_u8(pV + i) } };
+    vst2q_u8(pOut + 2 * i, uv);
+  }
+
+  Interleave8_C(pU + i, pV + i, pOut + 2 * i, iNum - i);
+}
+
+/****************************************************************************/
+static void Interleave16_NEON(uint16_t const* pU, uint16_t const* pV, uint16_t* pOut, int iNum)
+{
+  int i = 0;
+
+  for(; i + 8 <= iNum; i += 8)
+  {
+    uint16x8x2_t uv = { { vld1q_u16(pU + i), vld1q_u16(pV + i) } };
+    vst2q_u16(pOut + 2 * i, uv);
+  }
+
+  Interleave16_C(pU + i, pV + i, pOut + 2 * i, iNum - i);
+}
+
+/****************************************************************************/
+static void Interleave8To10_NEON(uint8_t const* pU, uint8_t const* pV, uint16_t* pOut, int iNum)
+{
+  int i = 0;
+
+  for(; i + 8 <= iNum; i += 8)
+  {
+    uint16x8x2_t uv = { { vshll_n_u8(vld1_u8(pU + i), 2), vshll_n_u8(vld1_u8(pV + i), 2) } };
+    vst2q_u16(pOut + 2 * i, uv);
+  }
+
+  Interleave8To10_C(pU + i, pV + i, pOut + 2 * i, iNum - i);
+}
+
+/****************************************************************************/
+static void Interleave10To8_NEON(uint16_t const* pU, uint16_t const* pV, uint8_t* pOut, int iNum)
+{
+  int i = 0;
+
+  for(; i + 8 <= iNum; i += 8)
+  {
+    uint8x8x2_t uv;
+    uv.val[0] = vqmovn_u16(vrshrq_n_u16(vld1q_u16(pU + i), 2));
+    uv.val[1] = vqmovn_u16(vrshrq_n_u16(vld1q_u16(pV + i), 2));
+    vst2_u8(pOut + 2 * i, uv);
+  }
+
+  Interleave10To8_C(pU + i, pV + i, pOut + 2 * i, iNum - i);
+}
+
+/****************************************************************************/
+static void Deinterleave8_NEON(uint8_t const* pIn, uint8_t* pU, uint8_t* pV, int iNum)
+{
+  int i = 0;
+
+  for(; i + 16 <= iNum; i += 16)
+  {
+    uint8x16x2_t uv = vld2q_u8(pIn + 2 * i);
+    vst1q_u8(pU + i, uv.val[0]);
+    vst1q_u8(pV + i, uv.val[1]);
+  }
+
+  Deinterleave8_C(pIn + 2 * i, pU + i, pV + i, iNum - i);
+}
+
+/****************************************************************************/
+static void Deinterleave16_NEON(uint16_t const* pIn, uint16_t* pU, uint16_t* pV, int iNum)
+{
+  int i = 0;
+
+  for(; i + 8 <= iNum; i += 8)
+  {
+    uint16x8x2_t uv = vld2q_u16(pIn + 2 * i);
+    vst1q_u16(pU + i, uv.val[0]);
+    vst1q_u16(pV + i, uv.val[1]);
+  }
+
+  Deinterleave16_C(pIn + 2 * i, pU + i, pV + i, iNum - i);
+}
+
+/****************************************************************************/
+static void Deinterleave8To10_NEON(uint8_t const* pIn, uint16_t* pU, uint16_t* pV, int iNum)
+{
+  int i = 0;
+
+  for(; i + 8 <= iNum; i += 8)
+  {
+    uint8x8x2_t uv = vld2_u8(pIn + 2 * i);
+    vst1q_u16(pU + i, vshll_n_u8(uv.val[0], 2));
+    vst1q_u16(pV + i, vshll_n_u8(uv.val[1], 2));
+  }
+
+  Deinterleave8To10_C(pIn + 2 * i, pU + i, pV + i, iNum - i);
+}
+
+/****************************************************************************/
+static void Deinterleave10To8_NEON(uint16_t const* pIn, uint8_t* pU, uint8_t* pV, int iNum)
+{
+  int i = 0;
+
+  for(; i + 8 <= iNum; i += 8)
+  {
+    uint16x8x2_t uv = vld2q_u16(pIn + 2 * i);
+    vst1_u8(pU + i, vqmovn_u16(vrshrq_n_u16(uv.val[0], 2)));
+    vst1_u8(pV + i, vqmovn_u16(vrshrq_n_u16(uv.val[1], 2)));
+  }
+
+  Deinterleave10To8_C(pIn + 2 * i, pU + i, pV + i, iNum - i);
+}
+
+/****************************************************************************/
+static void Untile8_NEON(uint8_t const* pIn, uint8_t* pOut, int iPitch, int iNum)
+{
+  int i = 0;
+
+  // vld4 deinterleaves the 4 rows of 4 consecutive blocks
+  for(; i + 4 <= iNum; i += 4)
+  {
+    uint32x4x4_t rows = vld4q_u32((uint32_t const*)(pIn + 16 * i));
+
+    for(int iRow = 0; iRow < 4; ++iRow)
+      vst1q_u8(pOut + iRow * iPitch + 4 * i, vreinterpretq_u8_u32(rows.val[iRow]));
+  }
+
+  Untile8_C(pIn + 16 * i, pOut + 4 * i, iPitch, iNum - i);
+}
+
+#endif
+
+/****************************************************************************/
+static TConvKernels SelectConvKernels()
+{
+  TConvKernels tKernels = s_tKernelsC;
+
+  char const* sForce = getenv("AL_CONV_KERNELS");
+
+  if(sForce && !strcmp(sForce, "c"))
+    return tKernels;
+
+#if CONV_KERNELS_X86
+  __builtin_cpu_init();
+
+  if(__builtin_cpu_supports("sse4.1"))
+  {
+    tKernels.Widen8To10 = Widen8To10_SSE4;
+    tKernels.Narrow10To8 = Narrow10To8_SSE4;
+    tKernels.Interleave8 = Interleave8_SSE4;
+    tKernels.Interleave16 = Interleave16_SSE4;
+    tKernels.Interleave8To10 = Interleave8To10_SSE4;
+    tKernels.Interleave10To8 = Interleave10To8_SSE4;
+    tKernels.Deinterleave8 = Deinterleave8_SSE4;
+    tKernels.Deinterleave16 = Deinterleave16_SSE4;
+    tKernels.Deinterleave8To10 = Deinterleave8To10_SSE4;
+    tKernels.Deinterleave10To8 = Deinterleave10To8_SSE4;
+    tKernels.Pack8To10 = Pack8To10_SSE4;
+    tKernels.Pack10 = Pack10_SSE4;
+    tKernels.Unpack10To8 = Unpack10To8_SSE4;
+    tKernels.Unpack10To10 = Unpack10To10_SSE4;
+    tKernels.Untile8 = Untile8_SSE4;
+    tKernels.Untile10 = Untile10_SSE4;
+    tKernels.sName = "sse4.1";
+
+    if(__builtin_cpu_supports("avx2"))
+    {
+      tKernels.Widen8To10 = Widen8To10_AVX2;
+      tKernels.Narrow10To8 = Narrow10To8_AVX2;
+      tKernels.Interleave8 = Interleave8_AVX2;
+      tKernels.Deinterleave8 = Deinterleave8_AVX2;
+      tKernels.sName = "avx2";
+    }
+  }
+#elif CONV_KERNELS_NEON
+  tKernels.Widen8To10 = Widen8To10_NEON;
+  tKernels.Narrow10To8 = Narrow10To8_NEON;
+  tKernels.Interleave8 = Interleave8_NEON;
+  tKernels.Interleave16 = Interleave16_NEON;
+  tKernels.Interleave8To10 = Interleave8To10_NEON;
+  tKernels.Interleave10To8 = Interleave10To8_NEON;
+  tKernels.Deinterleave8 = Deinterleave8_NEON;
+  tKernels.Deinterleave16 = Deinterleave16_NEON;
+  tKernels.Deinterleave8To10 = Deinterleave8To10_NEON;
+  tKernels.Deinterleave10To8 = Deinterleave10To8_NEON;
+  tKernels.Untile8 = Untile8_NEON;
+  tKernels.sName = "neon";
+#endif
+
+  return tKernels;
+}
+
+/****************************************************************************/
+TConvKernels const* GetConvKernels()
+{
+  static TConvKernels const tKernels = SelectConvKernels();
+  return &tKernels;
+}
+
+/****************************************************************************/
+TConvKernels const* GetConvKernelsC()
+{
+  return &s_tKernelsC;
+}
+
+/*@}*/
+
@@ -0,0 +1,102 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+/****************************************************************************
+   -----------------------------------------------------------------------------
+ **************************************************************************//*!
+   \addtogroup lib_base
+   @{
+   \file
+ *****************************************************************************/
+#pragma once
+
+#include <stdint.h>
+
+/*************************************************************************//*!
+   \brief Row kernels used by the pixel format conversions.
+   Every entry points to the fastest implementation supported by the running
+   CPU (AVX2 or SSE4.1 on x86, NEON on aarch64, plain C otherwise). All the
+   implementations produce the same output as the plain C version.
+   Sample counts are per output plane unless stated otherwise.
+*****************************************************************************/
+struct TConvKernels
+{
+  /* 8 bits to 10 bits: pOut[i] = pIn[i] << 2 */
+  void (* Widen8To10)(uint8_t const* pIn, uint16_t* pOut, int iNum);
+  /* 10 bits to 8 bits: pOut[i] = (pIn[i] + 2) >> 2, saturated to 255 */
+  void (* Narrow10To8)(uint16_t const* pIn, uint8_t* pOut, int iNum);
+
+  /* planar U and V to semi-planar UV, iNum samples per component */
+  void (* Interleave8)(uint8_t const* pU, uint8_t const* pV, uint8_t* pOut, int iNum);
+  void (* Interleave16)(uint16_t const* pU, uint16_t const* pV, uint16_t* pOut, int iNum);
+  void (* Interleave8To10)(uint8_t const* pU, uint8_t const* pV, uint16_t* pOut, int iNum);
+  void (* Interleave10To8)(uint16_t const* pU, uint16_t const* pV, uint8_t* pOut, int iNum);
+
+  /* semi-planar UV to planar U and V, iNum samples per component */
+  void (* Deinterleave8)(uint8_t const* pIn, uint8_t* pU, uint8_t* pV, int iNum);
+  void (* Deinterleave16)(uint16_t const* pIn, uint16_t* pU, uint16_t* pV, int iNum);
+  void (* Deinterleave8To10)(uint8_t const* pIn, uint16_t* pU, uint16_t* pV, int iNum);
+  void (* Deinterleave10To8)(uint16_t const* pIn, uint8_t* pU, uint8_t* pV, int iNum);
+
+  /* 3 samples per 32 bits words (RX0A / RX2A / RXmA), iNum full words */
+  void (* Pack8To10)(uint8_t const* pIn, uint32_t* pOut, int iNum);
+  void (* Pack10)(uint16_t const* pIn, uint32_t* pOut, int iNum, uint32_t uMask);
+  void (* Unpack10To8)(uint32_t const* pIn, uint8_t* pOut, int iNum);
+  void (* Unpack10To10)(uint32_t const* pIn, uint16_t* pOut, int iNum);
+
+  /* iNum consecutive 4x4 blocks of a 64x4 tile (T608 / T60A) to 4 raster rows,
+     iPitch is the output pitch in samples */
+  void (* Untile8)(uint8_t const* pIn, uint8_t* pOut, int iPitch, int iNum);
+  void (* Untile10)(uint16_t const* pIn, uint16_t* pOut, int iPitch, int iNum);
+
+  char const* sName;
+};
+
+/*************************************************************************//*!
+   \brief Returns the kernels selected for the running CPU.
+   The selection is done once, on first call. Setting the environment variable
+   AL_CONV_KERNELS to "c" forces the plain C implementation.
+*****************************************************************************/
+TConvKernels const* GetConvKernels();
+
+/*************************************************************************//*!
+   \brief Returns the plain C kernels, used as reference
+*****************************************************************************/
+TConvKernels const* GetConvKernelsC();
+
+/*@}*/
+
@@ -0,0 +1,573 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+
+/****************************************************************************
+   -----------------------------------------------------------------------------
+ **************************************************************************//*!
+   \addtogroup lib_base
+   @{
+   \file
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include "lib_common/BufferSrcMeta.h"
+}
+
+#include "convert.h"
+#include "convert_kernels.h"
+#include "convert_planner.h"
+#include "convert_scheduler.h"
+
+using namespace std;
+
+/****************************************************************************/
+struct TFusedConversion
+{
+  TFourCC tSrcFourCC;
+  TFourCC tDstFourCC;
+  void (* pfnConvert)(AL_TBuffer const* pSrc, AL_TBuffer* pDst);
+};
+
+#define FUSED(Src, Dst) { FOURCC(Src), FOURCC(Dst), Src ## _To_ ## Dst }
+/* single pass conversions of convert.h (I0AL_To_YV12 left to the row tiles) */
+static TFusedConversion const s_FusedConversions[] =
+{
+  FUSED(YV12, I420),
+  FUSED(YV12, IYUV),
+  FUSED(YV12, NV12),
+  FUSED(YV12, Y800),
+  FUSED(YV12, P010),
+  FUSED(YV12, I0AL),
+  FUSED(YV12, RX0A),
+  FUSED(I420, YV12),
+  FUSED(I420, IYUV),
+  FUSED(I420, Y800),
+  FUSED(I420, I0AL),
+  FUSED(I420, Y010),
+  FUSED(I420, NV12),
+  FUSED(I420, P010),
+  FUSED(I420, RX0A),
+  FUSED(I422, NV16),
+  FUSED(I422, P210),
+  FUSED(I422, RX2A),
+  FUSED(IYUV, YV12),
+  FUSED(IYUV, NV12),
+  FUSED(IYUV, Y800),
+  FUSED(IYUV, P010),
+  FUSED(IYUV, I0AL),
+  FUSED(IYUV, RX0A),
+  FUSED(NV12, YV12),
+  FUSED(NV12, IYUV),
+  FUSED(NV12, Y800),
+  FUSED(NV12, I420),
+  FUSED(NV12, I0AL),
+  FUSED(NV12, P010),
+  FUSED(NV12, RX0A),
+  FUSED(NV16, I422),
+  FUSED(NV16, I2AL),
+  FUSED(NV16, P210),
+  FUSED(NV16, RX2A),
+  FUSED(Y800, YV12),
+  FUSED(Y800, I420),
+  FUSED(Y800, IYUV),
+  FUSED(Y800, NV12),
+  FUSED(Y800, P010),
+  FUSED(Y800, I0AL),
+  FUSED(Y800, RX0A),
+  FUSED(Y800, Y010),
+  FUSED(Y800, Y800),
+  FUSED(Y800, RXmA),
+  FUSED(P010, YV12),
+  FUSED(P010, IYUV),
+  FUSED(P010, NV12),
+  FUSED(P010, Y800),
+  FUSED(P010, Y010),
+  FUSED(P010, RX0A),
+  FUSED(P010, I0AL),
+  FUSED(P010, I420),
+  FUSED(P210, I2AL),
+  FUSED(P210, I422),
+  FUSED(Y010, RX0A),
+  FUSED(Y010, RXmA),
+  FUSED(I0AL, I420),
+  FUSED(I0AL, IYUV),
+  FUSED(I0AL, Y800),
+  FUSED(I0AL, Y010),
+  FUSED(I0AL, NV12),
+  FUSED(I0AL, P010),
+  FUSED(I0AL, RX0A),
+  FUSED(I2AL, NV16),
+  FUSED(I2AL, P210),
+  FUSED(I2AL, RX2A),
+  FUSED(T608, YV12),
+  FUSED(T608, I420),
+  FUSED(T608, IYUV),
+  FUSED(T608, NV12),
+  FUSED(T608, Y800),
+  FUSED(T608, Y010),
+  FUSED(T608, P010),
+  FUSED(T608, I0AL),
+  FUSED(T6m8, I420),
+  FUSED(T628, Y800),
+  FUSED(T628, Y010),
+  FUSED(T628, I422),
+  FUSED(T628, NV16),
+  FUSED(T628, I2AL),
+  FUSED(T628, P210),
+  FUSED(T60A, YV12),
+  FUSED(T60A, I420),
+  FUSED(T60A, IYUV),
+  FUSED(T60A, NV12),
+  FUSED(T60A, Y800),
+  FUSED(T60A, Y010),
+  FUSED(T60A, P010),
+  FUSED(T60A, I0AL),
+  FUSED(T62A, Y800),
+  FUSED(T62A, Y010),
+  FUSED(T62A, I422),
+  FUSED(T62A, NV16),
+  FUSED(T62A, I2AL),
+  FUSED(T62A, P210),
+  FUSED(RX0A, YV12),
+  FUSED(RX0A, I420),
+  FUSED(RX0A, IYUV),
+  FUSED(RX0A, NV12),
+  FUSED(RX0A, Y800),
+  FUSED(RX0A, Y010),
+  FUSED(RX0A, P010),
+  FUSED(RX0A, I0AL),
+  FUSED(RX2A, I422),
+  FUSED(RX2A, NV16),
+  FUSED(RX2A, I2AL),
+  FUSED(RX2A, P210),
+};
+
+#undef FUSED
+
+/****************************************************************************/
+enum EPlaneLayout
+{
+  LAYOUT_PLANAR,
+  LAYOUT_SEMIPLANAR,
+  LAYOUT_PACKED_10B, /* 3 samples per 32 bits word */
+  LAYOUT_TILE_64x4,
+};
+
+struct TFormat
+{
+  EPlaneLayout eLayout;
+  AL_EChromaMode eChromaMode;
+  int iBitDepth;
+  bool bSwapUV; /* V plane before U plane */
+  int iSubX;
+  int iSubY;
+};
+
+/* formats the row tile pipeline can read (and write, except the tiled ones) */
+static TFourCC const s_PipelineFourCCs[] =
+{
+  FOURCC(I420), FOURCC(IYUV), FOURCC(YV12), FOURCC(I422), FOURCC(YV16), FOURCC(Y800),
+  FOURCC(I0AL), FOURCC(I2AL), FOURCC(Y010),
+  FOURCC(NV12), FOURCC(NV16), FOURCC(P010), FOURCC(P210),
+  FOURCC(RX0A), FOURCC(RX2A), FOURCC(RXmA),
+  FOURCC(T608), FOURCC(T628), FOURCC(T6m8), FOURCC(T60A), FOURCC(T62A), FOURCC(T6mA),
+};
+
+/****************************************************************************/
+static bool GetFormat(TFourCC tFourCC, TFormat& tFormat)
+{
+  if(find(begin(s_PipelineFourCCs), end(s_PipelineFourCCs), tFourCC) == end(s_PipelineFourCCs))
+    return false;
+
+  if(AL_IsTiled(tFourCC))
+    tFormat.eLayout = LAYOUT_TILE_64x4;
+  else if(AL_Is10bitPacked(tFourCC))
+    tFormat.eLayout = LAYOUT_PACKED_10B;
+  else if(AL_IsSemiPlanar(tFourCC))
+    tFormat.eLayout = LAYOUT_SEMIPLANAR;
+  else
+    tFormat.eLayout = LAYOUT_PLANAR;
+
+  tFormat.eChromaMode = AL_GetChromaMode(tFourCC);
+  tFormat.iBitDepth = AL_GetBitDepth(tFourCC);
+  tFormat.bSwapUV = (tFourCC == FOURCC(YV12)) || (tFourCC == FOURCC(YV16));
+  AL_GetSubsampling(tFourCC, &tFormat.iSubX, &tFormat.iSubY);
+
+  return true;
+}
+
+/****************************************************************************/
+/* Intermediate rows: planar, 10 bits samples */
+struct TRowTile
+{
+  TRowTile(int iWidth, int iWidthC, int iNumRows, int iNumRowsC) :
+    iWidth(iWidth),
+    iWidthC(iWidthC),
+    Y(iWidth * iNumRows),
+    U(iWidthC * iNumRowsC),
+    V(iWidthC * iNumRowsC),
+    Scratch(4 * (iWidth + 64))
+  {
+  }
+
+  int iWidth;
+  int iWidthC;
+  vector<uint16_t> Y;
+  vector<uint16_t> U;
+  vector<uint16_t> V;
+  vector<uint16_t> Scratch; /* interleaved chroma row or untiled rows */
+};
+
+/****************************************************************************/
+static void Unpack10Row(uint32_t const* pIn, uint16_t* pOut, int iNum)
+{
+  int iNumWords = iNum / 3;
+  GetConvKernels()->Unpack10To10(pIn, pOut, iNumWords);
+
+  for(int i = 0; i < iNum % 3; ++i)
+    pOut[3 * iNumWords + i] = (uint16_t)((pIn[iNumWords] >> (10 * i)) & 0x3FF);
+}
+
+/****************************************************************************/
+static void Pack10Row(uint16_t const* pIn, uint32_t* pOut, int iNum)
+{
+  int iNumWords = iNum / 3;
+  GetConvKernels()->Pack10(pIn, pOut, iNumWords, 0x3FF);
+
+  if(iNum % 3 == 0)
+    return;
+
+  uint32_t uWord = 0;
+
+  for(int i = 0; i < iNum % 3; ++i)
+    uWord |= ((uint32_t)pIn[3 * iNumWords + i] & 0x3FF) << (10 * i);
+
+  pOut[iNumWords] = uWord;
+}
+
+/****************************************************************************/
+static void ReadSamples(TFormat const& tFormat, uint8_t const* pIn, uint16_t* pOut, int iNum)
+{
+  if(tFormat.eLayout == LAYOUT_PACKED_10B)
+    Unpack10Row((uint32_t const*)pIn, pOut, iNum);
+  else if(tFormat.iBitDepth == 8)
+    GetConvKernels()->Widen8To10(pIn, pOut, iNum);
+  else
+    memcpy(pOut, pIn, iNum * sizeof(uint16_t));
+}
+
+/****************************************************************************/
+static void WriteSamples(TFormat const& tFormat, uint16_t const* pIn, uint8_t* pOut, int iNum)
+{
+  if(tFormat.eLayout == LAYOUT_PACKED_10B)
+    Pack10Row(pIn, (uint32_t*)pOut, iNum);
+  else if(tFormat.iBitDepth == 8)
+    GetConvKernels()->Narrow10To8(pIn, pOut, iNum);
+  else
+    memcpy(pOut, pIn, iNum * sizeof(uint16_t));
+}
+
+/****************************************************************************/
+/* Untiles the 4 rows of the tile row starting at pIn in the tile scratch */
+static void UntileRow(TFormat const& tFormat, uint8_t const* pIn, int iWidth, TRowTile& tTile)
+{
+  int const iTileW = 64;
+  int iPitch = iWidth + iTileW;
+
+  for(int iTile = 0; iTile * iTileW < iWidth; ++iTile)
+  {
+    int iNumBlocks = (min(iTileW, iWidth - iTile * iTileW) + 3) / 4;
+
+    if(tFormat.iBitDepth == 8)
+      GetConvKernels()->Untile8(pIn + iTile * 256, (uint8_t*)tTile.Scratch.data() + iTile * iTileW, iPitch, iNumBlocks);
+    else
+      GetConvKernels()->Untile10((uint16_t const*)pIn + iTile * 160, tTile.Scratch.data() + iTile * iTileW, iPitch, iNumBlocks);
+  }
+}
+
+/****************************************************************************/
+static void ReadTiledRows(TFormat const& tFormat, AL_TBuffer const* pSrc, int iBeginRow, int iEndRow, bool bChroma, TRowTile& tTile)
+{
+  AL_TSrcMetaData* pMeta = (AL_TSrcMetaData*)AL_Buffer_GetMetaData(pSrc, AL_META_TYPE_SOURCE);
+  uint8_t const* pData = AL_Buffer_GetData(pSrc);
+  int const iTileH = 4;
+  int iWidth = tTile.iWidth;
+  int iPitch = iWidth + 64;
+  TFormat tUntiled = tFormat;
+  tUntiled.eLayout = LAYOUT_PLANAR;
+
+  for(int iRow = iBeginRow; iRow < iEndRow; iRow += iTileH)
+  {
+    UntileRow(tFormat, pData + (iRow / iTileH) * pMeta->tPitches.iLuma, iWidth, tTile);
+
+    for(int h = 0; h < iTileH && iRow + h < iEndRow; ++h)
+    {
+      uint8_t const* pIn = tFormat.iBitDepth == 8 ? (uint8_t const*)tTile.Scratch.data() + h * iPitch : (uint8_t const*)(tTile.Scratch.data() + h * iPitch);
+      ReadSamples(tUntiled, pIn, &tTile.Y[(iRow + h - iBeginRow) * iWidth], iWidth);
+    }
+  }
+
+  if(!bChroma || tFormat.eChromaMode == CHROMA_MONO)
+    return;
+
+  int iHeightC = pMeta->tDim.iHeight / tFormat.iSubY;
+  int iBeginRowC = iBeginRow / tFormat.iSubY;
+  int iEndRowC = min((iEndRow + tFormat.iSubY - 1) / tFormat.iSubY, iHeightC);
+
+  for(int iRow = iBeginRowC; iRow < iEndRowC; iRow += iTileH)
+  {
+    UntileRow(tFormat, pData + pMeta->tOffsetYC.iChroma + (iRow / iTileH) * pMeta->tPitches.iChroma, iWidth, tTile);
+
+    for(int h = 0; h < iTileH && iRow + h < iEndRowC; ++h)
+    {
+      int iOffset = (iRow + h - iBeginRowC) * tTile.iWidthC;
+
+      if(tFormat.iBitDepth == 8)
+        GetConvKernels()->Deinterleave8To10((uint8_t const*)tTile.Scratch.data() + h * iPitch, &tTile.U[iOffset], &tTile.V[iOffset], tTile.iWidthC);
+      else
+        GetConvKernels()->Deinterleave16(tTile.Scratch.data() + h * iPitch, &tTile.U[iOffset], &tTile.V[iOffset], tTile.iWidthC);
+    }
+  }
+}
+
+/****************************************************************************/
+static void ReadRows(TFormat const& tFormat, AL_TBuffer const* pSrc, int iBeginRow, int iEndRow, bool bChroma, TRowTile& tTile)
+{
+  if(tFormat.eLayout == LAYOUT_TILE_64x4)
+  {
+    ReadTiledRows(tFormat, pSrc, iBeginRow, iEndRow, bChroma, tTile);
+    return;
+  }
+
+  AL_TSrcMetaData* pMeta = (AL_TSrcMetaData*)AL_Buffer_GetMetaData(pSrc, AL_META_TYPE_SOURCE);
+  uint8_t const* pData = AL_Buffer_GetData(pSrc);
+  int iWidth = tTile.iWidth;
+  int iWidthC = tTile.iWidthC;
+
+  for(int iRow = iBeginRow; iRow < iEndRow; ++iRow)
+    ReadSamples(tFormat, pData + iRow * pMeta->tPitches.iLuma, &tTile.Y[(iRow - iBeginRow) * iWidth], iWidth);
+
+  if(!bChroma || tFormat.eChromaMode == CHROMA_MONO)
+    return;
+
+  int iHeightC = pMeta->tDim.iHeight / tFormat.iSubY;
+  int iBeginRowC = iBeginRow / tFormat.iSubY;
+  int iEndRowC = min((iEndRow + tFormat.iSubY - 1) / tFormat.iSubY, iHeightC);
+  uint8_t const* pChroma = pData + pMeta->tOffsetYC.iChroma;
+
+  for(int iRow = iBeginRowC; iRow < iEndRowC; ++iRow)
+  {
+    uint8_t const* pIn = pChroma + iRow * pMeta->tPitches.iChroma;
+    uint16_t* pOutU = &tTile.U[(iRow - iBeginRowC) * iWidthC];
+    uint16_t* pOutV = &tTile.V[(iRow - iBeginRowC) * iWidthC];
+
+    switch(tFormat.eLayout)
+    {
+    case LAYOUT_PLANAR:
+    {
+      uint8_t const* pInV = pIn + iHeightC * pMeta->tPitches.iChroma;
+
+      if(tFormat.bSwapUV)
+        swap(pIn, pInV);
+
+      ReadSamples(tFormat, pIn, pOutU, iWidthC);
+      ReadSamples(tFormat, pInV, pOutV, iWidthC);
+      break;
+    }
+    case LAYOUT_SEMIPLANAR:
+
+      if(tFormat.iBitDepth == 8)
+        GetConvKernels()->Deinterleave8To10(pIn, pOutU, pOutV, iWidthC);
+      else
+        GetConvKernels()->Deinterleave16((uint16_t const*)pIn, pOutU, pOutV, iWidthC);
+      break;
+    case LAYOUT_PACKED_10B:
+      Unpack10Row((uint32_t const*)pIn, tTile.Scratch.data(), 2 * iWidthC);
+      GetConvKernels()->Deinterleave16(tTile.Scratch.data(), pOutU, pOutV, iWidthC);
+      break;
+    default:
+      assert(0);
+    }
+  }
+}
+
+/****************************************************************************/
+static void WriteRows(TFormat const& tFormat, TRowTile& tTile, AL_TBuffer* pDst, int iBeginRow, int iEndRow)
+{
+  AL_TSrcMetaData* pMeta = (AL_TSrcMetaData*)AL_Buffer_GetMetaData(pDst, AL_META_TYPE_SOURCE);
+  uint8_t* pData = AL_Buffer_GetData(pDst);
+  int iWidth = tTile.iWidth;
+  int iWidthC = tTile.iWidthC;
+
+  for(int iRow = iBeginRow; iRow < iEndRow; ++iRow)
+    WriteSamples(tFormat, &tTile.Y[(iRow - iBeginRow) * iWidth], pData + iRow * pMeta->tPitches.iLuma, iWidth);
+
+  if(tFormat.eChromaMode == CHROMA_MONO)
+    return;
+
+  int iHeightC = pMeta->tDim.iHeight / tFormat.iSubY;
+  int iBeginRowC = iBeginRow / tFormat.iSubY;
+  int iEndRowC = min((iEndRow + tFormat.iSubY - 1) / tFormat.iSubY, iHeightC);
+  uint8_t* pChroma = pData + pMeta->tOffsetYC.iChroma;
+
+  for(int iRow = iBeginRowC; iRow < iEndRowC; ++iRow)
+  {
+    uint8_t* pOut = pChroma + iRow * pMeta->tPitches.iChroma;
+    uint16_t const* pInU = &tTile.U[(iRow - iBeginRowC) * iWidthC];
+    uint16_t const* pInV = &tTile.V[(iRow - iBeginRowC) * iWidthC];
+
+    switch(tFormat.eLayout)
+    {
+    case LAYOUT_PLANAR:
+    {
+      uint8_t* pOutV = pOut + iHeightC * pMeta->tPitches.iChroma;
+
+      if(tFormat.bSwapUV)
+        swap(pOut, pOutV);
+
+      WriteSamples(tFormat, pInU, pOut, iWidthC);
+      WriteSamples(tFormat, pInV, pOutV, iWidthC);
+      break;
+    }
+    case LAYOUT_SEMIPLANAR:
+
+      if(tFormat.iBitDepth == 8)
+        GetConvKernels()->Interleave10To8(pInU, pInV, pOut, iWidthC);
+      else
+        GetConvKernels()->Interleave16(pInU, pInV, (uint16_t*)pOut, iWidthC);
+      break;
+    case LAYOUT_PACKED_10B:
+      GetConvKernels()->Interleave16(pInU, pInV, tTile.Scratch.data(), iWidthC);
+      Pack10Row(tTile.Scratch.data(), (uint32_t*)pOut, 2 * iWidthC);
+      break;
+    default:
+      assert(0);
+    }
+  }
+}
+
+/****************************************************************************/
+static int GetRowsPerTile(int iWidth)
+{
+  /* keep the intermediate rows (luma and up to 4:2:2 chroma) in the L2 cache */
+  int const iTileSize = 128 * 1024;
+  int iNumRows = iTileSize / (max(iWidth, 1) * 2 * (int)sizeof(uint16_t));
+
+  /* whole chroma tile rows of the 4:2:0 tiled formats */
+  return max(8, iNumRows & ~7);
+}
+
+/****************************************************************************/
+static void ConvertByRowTiles(TFormat const& tSrcFormat, TFormat const& tDstFormat, TFourCC tDstFourCC, AL_TBuffer const* pSrc, AL_TBuffer* pDst)
+{
+  AL_TSrcMetaData* pSrcMeta = (AL_TSrcMetaData*)AL_Buffer_GetMetaData(pSrc, AL_META_TYPE_SOURCE);
+  AL_TSrcMetaData* pDstMeta = (AL_TSrcMetaData*)AL_Buffer_GetMetaData(pDst, AL_META_TYPE_SOURCE);
+
+  pDstMeta->tDim = pSrcMeta->tDim;
+
+  int iWidth = pSrcMeta->tDim.iWidth;
+  int iWidthC = (iWidth + tSrcFormat.iSubX - 1) / tSrcFormat.iSubX;
+  int iRowsPerTile = GetRowsPerTile(iWidth);
+  bool bChroma = tDstFormat.eChromaMode != CHROMA_MONO;
+
+  ConvertStripes(pSrcMeta->tDim.iHeight, iRowsPerTile, [&](int iBeginRow, int iEndRow)
+  {
+    TRowTile tTile(iWidth, iWidthC, iRowsPerTile, iRowsPerTile / tSrcFormat.iSubY);
+
+    for(int iRow = iBeginRow; iRow < iEndRow; iRow += iRowsPerTile)
+    {
+      int iLastRow = min(iRow + iRowsPerTile, iEndRow);
+      ReadRows(tSrcFormat, pSrc, iRow, iLastRow, bChroma, tTile);
+      WriteRows(tDstFormat, tTile, pDst, iRow, iLastRow);
+    }
+  });
+
+  pDstMeta->tFourCC = tDstFourCC;
+}
+
+/****************************************************************************/
+static TFusedConversion const* GetFusedConversion(TFourCC tSrcFourCC, TFourCC tDstFourCC)
+{
+  for(auto const& tFused : s_FusedConversions)
+  {
+    if(tFused.tSrcFourCC == tSrcFourCC && tFused.tDstFourCC == tDstFourCC)
+      return &tFused;
+  }
+
+  return nullptr;
+}
+
+/****************************************************************************/
+bool IsFusedConversion(TFourCC tSrcFourCC, TFourCC tDstFourCC)
+{
+  return GetFusedConversion(tSrcFourCC, tDstFourCC) != nullptr;
+}
+
+/****************************************************************************/
+TConvFunction GetConversion(TFourCC tSrcFourCC, TFourCC tDstFourCC)
+{
+  auto pFused = GetFusedConversion(tSrcFourCC, tDstFourCC);
+
+  if(pFused)
+    return pFused->pfnConvert;
+
+  TFormat tSrcFormat, tDstFormat;
+
+  if(!GetFormat(tSrcFourCC, tSrcFormat) || !GetFormat(tDstFourCC, tDstFormat))
+    return nullptr;
+
+  if(tDstFormat.eLayout == LAYOUT_TILE_64x4)
+    return nullptr;
+
+  /* chroma can be dropped, not resampled */
+  if(tDstFormat.eChromaMode != CHROMA_MONO && tDstFormat.eChromaMode != tSrcFormat.eChromaMode)
+    return nullptr;
+
+  return [=](AL_TBuffer const* pSrc, AL_TBuffer* pDst)
+         {
+           ConvertByRowTiles(tSrcFormat, tDstFormat, tDstFourCC, pSrc, pDst);
+         };
+}
+
+/*@}*/
+
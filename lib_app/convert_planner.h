@@ -0,0 +1,79 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+
+/****************************************************************************
+   -----------------------------------------------------------------------------
+ **************************************************************************//*!
+   \addtogroup lib_base
+   @{
+   \file
+ *****************************************************************************/
+#pragma once
+
+#include <functional>
+
+extern "C" {
+#include "lib_common/BufferAPI.h"
+#include "lib_common/FourCC.h"
+}
+
+typedef std::function<void (AL_TBuffer const* pSrc, AL_TBuffer* pDst)> TConvFunction;
+
+/*************************************************************************//*!
+   \brief Plans the conversion of a frame from one FourCC to another.
+   When convert.h provides a function for the pair, this single pass function
+   is used as is. Otherwise the frame is converted by tiles of a few rows: each
+   tile is unpacked from the source in a cache resident intermediate and
+   packed in the destination right away, so no intermediate frame is written
+   to memory.
+   The destination chroma plane starts at the tOffsetYC.iChroma offset of the
+   destination metadata. Odd widths keep their last chroma sample.
+   \param[in] tSrcFourCC FourCC of the source frame
+   \param[in] tDstFourCC FourCC of the destination frame
+   \return the conversion function, or nullptr when the pair is not supported
+*****************************************************************************/
+TConvFunction GetConversion(TFourCC tSrcFourCC, TFourCC tDstFourCC);
+
+/*************************************************************************//*!
+   \brief Returns true when the conversion between the two FourCC is done by a
+   single pass function of convert.h
+*****************************************************************************/
+bool IsFusedConversion(TFourCC tSrcFourCC, TFourCC tDstFourCC);
+
+/*@}*/
+
@@ -0,0 +1,235 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+
+/****************************************************************************
+   -----------------------------------------------------------------------------
+ **************************************************************************//*!
+   \addtogroup lib_base
+   @{
+   \file
+ *****************************************************************************/
+
+#include "convert_scheduler.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/* set while a thread runs a stripe: a conversion called from a stripe runs inline */
+static thread_local bool s_bInStripe = false;
+
+/****************************************************************************/
+class ConvWorkerPool
+{
+public:
+  explicit ConvWorkerPool(int iNumWorkers);
+  ~ConvWorkerPool();
+
+  /* Runs RunStripe(0) .. RunStripe(iNumStripes - 1) on the workers and on the
+   * calling thread. Returns once every stripe is done. The concurrent runs
+   * are served one after the other. */
+  void Run(int iNumStripes, function<void(int)> const& RunStripe);
+
+private:
+  void WorkerLoop();
+  void ProcessStripes(unique_lock<mutex>& lock);
+
+  mutex m_RunMutex;
+  mutex m_Mutex;
+  condition_variable m_WorkReady;
+  condition_variable m_WorkDone;
+  vector<thread> m_Workers;
+
+  function<void(int)> const* m_pRunStripe = nullptr;
+  int m_iNumStripes = 0;
+  int m_iNextStripe = 0;
+  int m_iPendingStripes = 0;
+  uint64_t m_uJobId = 0;
+  bool m_bExit = false;
+};
+
+/****************************************************************************/
+ConvWorkerPool::ConvWorkerPool(int iNumWorkers)
+{
+  for(int i = 0; i < iNumWorkers; ++i)
+    m_Workers.push_back(thread(&ConvWorkerPool::WorkerLoop, this));
+}
+
+/****************************************************************************/
+ConvWorkerPool::~ConvWorkerPool()
+{
+  {
+    lock_guard<mutex> lock(m_Mutex);
+    m_bExit = true;
+  }
+  m_WorkReady.notify_all();
+
+  for(auto& worker : m_Workers)
+    worker.join();
+}
+
+/****************************************************************************/
+void ConvWorkerPool::ProcessStripes(unique_lock<mutex>& lock)
+{
+  while(m_iNextStripe < m_iNumStripes)
+  {
+    int iStripe = m_iNextStripe++;
+    auto const& RunStripe = *m_pRunStripe;
+
+    lock.unlock();
+    s_bInStripe = true;
+    RunStripe(iStripe);
+    s_bInStripe = false;
+    lock.lock();
+
+    if(--m_iPendingStripes == 0)
+      m_WorkDone.notify_all();
+  }
+}
+
+/****************************************************************************/
+void ConvWorkerPool::WorkerLoop()
+{
+  uint64_t uLastJobId = 0;
+  unique_lock<mutex> lock(m_Mutex);
+
+  while(true)
+  {
+    m_WorkReady.wait(lock, [&]() { return m_bExit || m_uJobId != uLastJobId; });
+
+    if(m_bExit)
+      return;
+
+    uLastJobId = m_uJobId;
+    ProcessStripes(lock);
+  }
+}
+
+/****************************************************************************/
+void ConvWorkerPool::Run(int iNumStripes, function<void(int)> const& RunStripe)
+{
+  lock_guard<mutex> runLock(m_RunMutex);
+  unique_lock<mutex> lock(m_Mutex);
+  m_pRunStripe = &RunStripe;
+  m_iNumStripes = iNumStripes;
+  m_iNextStripe = 0;
+  m_iPendingStripes = iNumStripes;
+  ++m_uJobId;
+  m_WorkReady.notify_all();
+
+  ProcessStripes(lock);
+  m_WorkDone.wait(lock, [&]() { return m_iPendingStripes == 0; });
+  m_pRunStripe = nullptr;
+}
+
+/* protects the pool configuration. A conversion keeps a reference on the pool
+ * it runs on, so the pool can be replaced during the conversion */
+static mutex s_PoolMutex;
+static shared_ptr<ConvWorkerPool> s_pPool;
+static int s_iNumThreads = 1;
+
+/****************************************************************************/
+void SetConversionThreads(int iNumThreads)
+{
+  if(iNumThreads <= 0)
+    iNumThreads = max(1, (int)thread::hardware_concurrency());
+
+  lock_guard<mutex> lock(s_PoolMutex);
+
+  if(iNumThreads == s_iNumThreads)
+    return;
+
+  s_pPool.reset();
+
+  if(iNumThreads > 1)
+    s_pPool = make_shared<ConvWorkerPool>(iNumThreads - 1);
+
+  s_iNumThreads = iNumThreads;
+}
+
+/****************************************************************************/
+int GetConversionThreads()
+{
+  lock_guard<mutex> lock(s_PoolMutex);
+  return s_iNumThreads;
+}
+
+/****************************************************************************/
+void ConvertStripes(int iNumRows, int iRowAlign, function<void(int iBeginRow, int iEndRow)> const& ConvertRows)
+{
+  if(iNumRows <= 0)
+    return;
+
+  if(s_bInStripe)
+  {
+    ConvertRows(0, iNumRows);
+    return;
+  }
+
+  shared_ptr<ConvWorkerPool> pPool;
+  int iNumThreads;
+  {
+    lock_guard<mutex> lock(s_PoolMutex);
+    pPool = s_pPool;
+    iNumThreads = s_iNumThreads;
+  }
+
+  int iNumUnits = (iNumRows + iRowAlign - 1) / iRowAlign;
+  int iNumStripes = min(iNumThreads, iNumUnits);
+
+  if(!pPool || iNumStripes <= 1)
+  {
+    ConvertRows(0, iNumRows);
+    return;
+  }
+
+  pPool->Run(iNumStripes, [&](int iStripe)
+  {
+    int iBeginRow = (int)((int64_t)iNumUnits * iStripe / iNumStripes) * iRowAlign;
+    int iEndRow = (int)((int64_t)iNumUnits * (iStripe + 1) / iNumStripes) * iRowAlign;
+    ConvertRows(iBeginRow, min(iEndRow, iNumRows));
+  });
+}
+
+/*@}*/
+
@@ -0,0 +1,75 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+
+/****************************************************************************
+   -----------------------------------------------------------------------------
+ **************************************************************************//*!
+   \addtogroup lib_base
+   @{
+   \file
+ *****************************************************************************/
+#pragma once
+
+#include <functional>
+
+/*************************************************************************//*!
+   \brief Sets the number of threads used by the pixel format conversions.
+   The conversions split the frame in horizontal stripes which are processed
+   by a persistent worker pool. With 1 thread (default), every conversion runs
+   on the calling thread.
+   \param[in] iNumThreads Number of threads (0: one per online cpu)
+*****************************************************************************/
+void SetConversionThreads(int iNumThreads);
+
+/*************************************************************************//*!
+   \brief Returns the number of threads used by the pixel format conversions
+*****************************************************************************/
+int GetConversionThreads();
+
+/*************************************************************************//*!
+   \brief Splits the rows [0, iNumRows) in stripes and runs them in parallel.
+   Each stripe starts on a multiple of iRowAlign so that a stripe never splits
+   a chroma row pair or a tile row. Returns once every stripe is done.
+   \param[in] iNumRows Number of rows to process
+   \param[in] iRowAlign Granularity of the stripes, in rows
+   \param[in] ConvertRows Called with the [iBeginRow, iEndRow) range of a stripe
+*****************************************************************************/
+void ConvertStripes(int iNumRows, int iRowAlign, std::function<void(int iBeginRow, int iEndRow)> const& ConvertRows);
+
+/*@}*/
+
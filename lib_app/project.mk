@@ -2,9 +2,15 @@ LIB_APP_SRC:=
 
 LIB_APP_SRC+=lib_app/utils.cpp\
 	     lib_app/convert.cpp\
+	     lib_app/convert_kernels.cpp\
+	     lib_app/convert_scheduler.cpp\
+	     lib_app/convert_planner.cpp\
+	     lib_app/read_ahead.cpp\
 	     lib_app/BufPool.c\
 	     lib_app/BufferMetaFactory.c\
 			 lib_app/AllocatorTracker.cpp\
+	     lib_app/StageReport.cpp\
+	     lib_app/TraceExport.cpp\
 
 
 ifeq ($(findstring mingw,$(TARGET)),mingw)
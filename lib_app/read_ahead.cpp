@@ -0,0 +1,136 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+
+/****************************************************************************
+   -----------------------------------------------------------------------------
+ **************************************************************************//*!
+   \addtogroup lib_base
+   @{
+   \file
+ *****************************************************************************/
+
+#include "read_ahead.h"
+
+#include <algorithm>
+
+using namespace std;
+
+/****************************************************************************/
+ReadAhead::ReadAhead(Producer produce, int iDepth) : m_Produce(produce), m_iDepth(max(iDepth, 1))
+{
+  m_Producer = thread(&ReadAhead::ProducerLoop, this);
+}
+
+/****************************************************************************/
+ReadAhead::~ReadAhead()
+{
+  {
+    lock_guard<mutex> lock(m_Mutex);
+    m_bExit = true;
+    /* the waiting frames go back to their pool, a producer blocked on it can end */
+    m_Frames.clear();
+  }
+  m_SlotFree.notify_all();
+  m_Producer.join();
+}
+
+/****************************************************************************/
+void ReadAhead::ProducerLoop()
+{
+  unique_lock<mutex> lock(m_Mutex);
+
+  while(true)
+  {
+    m_SlotFree.wait(lock, [&]() { return m_bExit || (int)m_Frames.size() < m_iDepth; });
+
+    if(m_bExit)
+      return;
+
+    lock.unlock();
+
+    shared_ptr<AL_TBuffer> frame;
+    exception_ptr error;
+
+    try
+    {
+      frame = m_Produce();
+    }
+    catch(...)
+    {
+      error = current_exception();
+    }
+
+    lock.lock();
+
+    if(m_bExit)
+      return;
+
+    if(!frame)
+    {
+      m_Error = error;
+      m_bEnd = true;
+      m_FrameReady.notify_all();
+      return;
+    }
+
+    m_Frames.push_back(frame);
+    m_FrameReady.notify_all();
+  }
+}
+
+/****************************************************************************/
+shared_ptr<AL_TBuffer> ReadAhead::Next()
+{
+  unique_lock<mutex> lock(m_Mutex);
+  m_FrameReady.wait(lock, [&]() { return m_bEnd || !m_Frames.empty(); });
+
+  if(m_Frames.empty())
+  {
+    if(m_Error)
+      rethrow_exception(m_Error);
+    return nullptr;
+  }
+
+  auto frame = m_Frames.front();
+  m_Frames.pop_front();
+  m_SlotFree.notify_all();
+  return frame;
+}
+
+/*@}*/
+
@@ -0,0 +1,98 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+
+/****************************************************************************
+   -----------------------------------------------------------------------------
+ **************************************************************************//*!
+   \addtogroup lib_base
+   @{
+   \file
+ *****************************************************************************/
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+extern "C"
+{
+#include "lib_common/BufferAPI.h"
+}
+
+/*************************************************************************//*!
+   \brief Runs a frame producer on a dedicated thread, ahead of the consumer.
+   The producer is called until it returns nullptr (end of the input). At most
+   iDepth produced frames wait for the consumer: the producer thread sleeps
+   when they are not consumed.
+*****************************************************************************/
+class ReadAhead
+{
+public:
+  typedef std::function<std::shared_ptr<AL_TBuffer>(void)> Producer;
+
+  ReadAhead(Producer produce, int iDepth);
+  ~ReadAhead();
+
+  /*************************************************************************//*!
+     \brief Returns the next produced frame, nullptr at the end of the input.
+     An exception thrown by the producer is rethrown here, in order.
+  *****************************************************************************/
+  std::shared_ptr<AL_TBuffer> Next();
+
+private:
+  void ProducerLoop();
+
+  Producer const m_Produce;
+  int const m_iDepth;
+
+  std::mutex m_Mutex;
+  std::condition_variable m_FrameReady;
+  std::condition_variable m_SlotFree;
+  std::deque<std::shared_ptr<AL_TBuffer>> m_Frames;
+  std::exception_ptr m_Error;
+  bool m_bEnd = false;
+  bool m_bExit = false;
+  std::thread m_Producer;
+};
+
+/*@}*/
+
@@ -0,0 +1,195 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "lib_app/convert_kernels.h"
+#include "lib_app/convert_planner.h"
+
+extern "C"
+{
+#include "lib_common/Allocator.h"
+#include "lib_common/BufferSrcMeta.h"
+}
+
+using namespace std;
+
+static uint8_t Expected10To8(uint16_t uVal)
+{
+  return (uVal >= 0x3FC) ? 0xFF : (uVal + 2) >> 2;
+}
+
+/* every 10 bits value, long enough to go through the SIMD bodies and the C tails */
+static vector<uint16_t> AllSamples()
+{
+  vector<uint16_t> samples;
+
+  for(int i = 0; i < 1024 + 37; ++i)
+    samples.push_back(i % 1024);
+
+  return samples;
+}
+
+static void CheckNarrowKernels(TConvKernels const* pKernels)
+{
+  SCOPED_TRACE(pKernels->sName);
+  auto const samples = AllSamples();
+  int const iNum = samples.size();
+  vector<uint8_t> out(2 * iNum), u(iNum), v(iNum);
+
+  pKernels->Narrow10To8(samples.data(), out.data(), iNum);
+
+  for(int i = 0; i < iNum; ++i)
+    ASSERT_EQ(Expected10To8(samples[i]), out[i]) << "sample " << samples[i];
+
+  pKernels->Interleave10To8(samples.data(), samples.data(), out.data(), iNum);
+
+  for(int i = 0; i < iNum; ++i)
+  {
+    ASSERT_EQ(Expected10To8(samples[i]), out[2 * i]) << "sample " << samples[i];
+    ASSERT_EQ(Expected10To8(samples[i]), out[2 * i + 1]) << "sample " << samples[i];
+  }
+
+  pKernels->Deinterleave10To8(samples.data(), u.data(), v.data(), iNum / 2);
+
+  for(int i = 0; i < iNum / 2; ++i)
+  {
+    ASSERT_EQ(Expected10To8(samples[2 * i]), u[i]) << "sample " << samples[2 * i];
+    ASSERT_EQ(Expected10To8(samples[2 * i + 1]), v[i]) << "sample " << samples[2 * i + 1];
+  }
+}
+
+TEST(ConvKernels, Narrow10To8SaturatesNearFullScale)
+{
+  CheckNarrowKernels(GetConvKernelsC());
+  CheckNarrowKernels(GetConvKernels());
+}
+
+/****************************************************************************/
+typedef unique_ptr<AL_TBuffer, decltype(&AL_Buffer_Destroy)> FramePtr;
+
+static FramePtr CreateFrame(TFourCC tFourCC, int iWidth, int iHeight, int iPitchY, int iPitchC, int iOffsetC, size_t zSize)
+{
+  AL_TBuffer* pBuf = AL_Buffer_Create_And_Allocate(AL_GetDefaultAllocator(), zSize, NULL);
+  AL_TDimension tDim = { iWidth, iHeight };
+  AL_TPitches tPitches = { iPitchY, iPitchC };
+  AL_TOffsetYC tOffsetYC = { 0, iOffsetC };
+  AL_Buffer_AddMetaData(pBuf, (AL_TMetaData*)AL_SrcMetaData_Create(tDim, tPitches, tOffsetYC, tFourCC));
+  return FramePtr(pBuf, &AL_Buffer_Destroy);
+}
+
+static uint16_t NearWhite(int i)
+{
+  return 1020 + i % 4;
+}
+
+TEST(ConvPlanner, Y010ToY800SaturatesNearWhite)
+{
+  ASSERT_FALSE(IsFusedConversion(FOURCC(Y010), FOURCC(Y800)));
+
+  int const iWidth = 70, iHeight = 6;
+  auto pSrc = CreateFrame(FOURCC(Y010), iWidth, iHeight, 2 * iWidth, 0, 0, 2 * iWidth * iHeight);
+  auto pDst = CreateFrame(FOURCC(Y800), iWidth, iHeight, iWidth, 0, 0, iWidth * iHeight);
+
+  auto pSrcData = (uint16_t*)AL_Buffer_GetData(pSrc.get());
+
+  for(int i = 0; i < iWidth * iHeight; ++i)
+    pSrcData[i] = NearWhite(i);
+
+  auto Convert = GetConversion(FOURCC(Y010), FOURCC(Y800));
+  ASSERT_TRUE(Convert != nullptr);
+  Convert(pSrc.get(), pDst.get());
+
+  auto pDstData = AL_Buffer_GetData(pDst.get());
+
+  for(int i = 0; i < iWidth * iHeight; ++i)
+    ASSERT_EQ(0xFF, pDstData[i]) << "sample " << NearWhite(i);
+}
+
+TEST(ConvPlanner, P210ToNV16SaturatesAndHonoursChromaOffset)
+{
+  ASSERT_FALSE(IsFusedConversion(FOURCC(P210), FOURCC(NV16)));
+
+  /* odd width: the last chroma pair only has its left luma sample */
+  int const iWidth = 69, iHeight = 4;
+  int const iWidthC = (iWidth + 1) / 2;
+  int const iPitchSrc = 2 * (iWidth + 1);
+  auto pSrc = CreateFrame(FOURCC(P210), iWidth, iHeight, iPitchSrc, iPitchSrc, iPitchSrc * iHeight, 2 * iPitchSrc * iHeight);
+
+  /* gap between the luma and the chroma planes of the destination */
+  int const iPitchDst = iWidth + 11;
+  int const iGap = 3 * iPitchDst;
+  int const iOffsetC = iPitchDst * iHeight + iGap;
+  auto pDst = CreateFrame(FOURCC(NV16), iWidth, iHeight, iPitchDst, iPitchDst, iOffsetC, iOffsetC + iPitchDst * iHeight);
+
+  auto pSrcData = AL_Buffer_GetData(pSrc.get());
+
+  for(int h = 0; h < iHeight; ++h)
+  {
+    auto pY = (uint16_t*)(pSrcData + h * iPitchSrc);
+    auto pUV = (uint16_t*)(pSrcData + iPitchSrc * iHeight + h * iPitchSrc);
+
+    for(int w = 0; w < iWidth; ++w)
+      pY[w] = NearWhite(w);
+
+    for(int w = 0; w < 2 * iWidthC; ++w)
+      pUV[w] = (w & 1) ? NearWhite(w) : 512;
+  }
+
+  auto pDstData = AL_Buffer_GetData(pDst.get());
+  memset(pDstData, 0x55, pDst->zSize);
+
+  auto Convert = GetConversion(FOURCC(P210), FOURCC(NV16));
+  ASSERT_TRUE(Convert != nullptr);
+  Convert(pSrc.get(), pDst.get());
+
+  for(int h = 0; h < iHeight; ++h)
+  {
+    for(int w = 0; w < iWidth; ++w)
+      ASSERT_EQ(0xFF, pDstData[h * iPitchDst + w]) << "luma " << w << "x" << h;
+
+    for(int w = 0; w < 2 * iWidthC; ++w)
+      ASSERT_EQ((w & 1) ? 0xFF : 0x80, pDstData[iOffsetC + h * iPitchDst + w]) << "chroma " << w << "x" << h;
+  }
+
+  for(int i = 0; i < iGap; ++i)
+    ASSERT_EQ(0x55, pDstData[iPitchDst * iHeight + i]) << "gap byte " << i;
+}
+
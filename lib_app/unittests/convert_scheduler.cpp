@@ -0,0 +1,136 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "lib_app/convert_scheduler.h"
+
+using namespace std;
+
+/* every row of each conversion must be converted exactly once */
+static void ConvertConcurrently(int iNumConverters, int iNumRuns)
+{
+  vector<thread> converters;
+  atomic<int> iErrors { 0 };
+
+  for(int i = 0; i < iNumConverters; ++i)
+  {
+    converters.push_back(thread([&]()
+    {
+      for(int iRun = 0; iRun < iNumRuns; ++iRun)
+      {
+        int const iNumRows = 64 + iRun % 37;
+        vector<atomic<int>> rows(iNumRows);
+
+        for(auto& row : rows)
+          row = 0;
+
+        ConvertStripes(iNumRows, 2, [&](int iBeginRow, int iEndRow)
+        {
+          for(int iRow = iBeginRow; iRow < iEndRow; ++iRow)
+            ++rows[iRow];
+        });
+
+        for(auto& row : rows)
+          iErrors += row != 1;
+      }
+    }));
+  }
+
+  for(auto& converter : converters)
+    converter.join();
+
+  EXPECT_EQ(0, iErrors);
+}
+
+TEST(ConvertScheduler, InlineConversionsRunConcurrently)
+{
+  SetConversionThreads(1);
+
+  /* both conversions have to be in their rows at the same time to finish */
+  atomic<int> iInside { 0 };
+  atomic<int> iTimeouts { 0 };
+  auto WaitOther = [&](int, int)
+  {
+    ++iInside;
+    auto const deadline = chrono::steady_clock::now() + chrono::seconds(2);
+
+    while(iInside < 2)
+    {
+      if(chrono::steady_clock::now() > deadline)
+      {
+        ++iTimeouts;
+        return;
+      }
+      this_thread::yield();
+    }
+  };
+
+  thread other([&]() { ConvertStripes(16, 2, WaitOther); });
+  ConvertStripes(16, 2, WaitOther);
+  other.join();
+
+  EXPECT_EQ(0, iTimeouts);
+}
+
+TEST(ConvertScheduler, ConvertsEachRowOnceFromSeveralThreads)
+{
+  SetConversionThreads(4);
+  ConvertConcurrently(4, 200);
+  SetConversionThreads(1);
+  ConvertConcurrently(4, 50);
+}
+
+TEST(ConvertScheduler, ReconfiguresDuringConversions)
+{
+  atomic<bool> bStop { false };
+  thread reconfigure([&]()
+  {
+    for(int i = 0; !bStop; ++i)
+      SetConversionThreads(1 + i % 4);
+  });
+
+  ConvertConcurrently(3, 300);
+  bStop = true;
+  reconfigure.join();
+  SetConversionThreads(1);
+}
@@ -94,5 +94,6 @@ enum SCHEDULER_TYPE
 {
   SCHEDULER_TYPE_CPU,
   SCHEDULER_TYPE_MCU,
+  SCHEDULER_TYPE_SIM, // software stand-in for the MCU, see lib_common/SimDevice.h
 };
 
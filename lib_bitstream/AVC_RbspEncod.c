@@ -324,7 +324,7 @@ static void writePps(AL_TBitStreamLite* pBS, AL_TPps const* pIPps)
 }
 
 /******************************************************************************/
-static void writeSeiBufferingPeriod(AL_TBitStreamLite* pBS, AL_TSps const* pISps, int iCpbInitialDelay, int iCpbInitialOffset)
+static void writeSeiBufferingPeriod(AL_TBitStreamLite* pBS, AL_TSps const* pISps, int iCpbInitialDelay, int iCpbInitialOffset, AL_TSeiPatchPoints* pPoints)
 {
   (void)iCpbInitialOffset;
   AL_TAvcSps* pSps = (AL_TAvcSps*)pISps;
@@ -335,7 +335,7 @@ static void writeSeiBufferingPeriod(AL_TBitStreamLite* pBS, AL_TSps const* pISps
   AL_BitStreamLite_PutUE(pBS, pSps->seq_parameter_set_id);
 
   int iIniCPBLength = pSps->vui_param.hrd_param.initial_cpb_removal_delay_length_minus1 + 1;
-  AL_BitStreamLite_PutU(pBS, iIniCPBLength, iCpbInitialDelay);
+  AL_RbspEncoding_PutSeiField(pBS, pPoints, AL_SEI_FIELD_INITIAL_CPB_REMOVAL_DELAY, iIniCPBLength, iCpbInitialDelay);
   AL_BitStreamLite_PutU(pBS, iIniCPBLength, 0); // offset
 
   AL_BitStreamLite_EndOfSEIPayload(pBS);
@@ -358,7 +358,7 @@ static void writeSeiRecoveryPoint(AL_TBitStreamLite* pBS)
 }
 
 /******************************************************************************/
-static void writeSeiPictureTiming(AL_TBitStreamLite* pBS, AL_TSps const* pISps, int iCpbRemovalDelay, int iDpbOutputDelay, int iPicStruct)
+static void writeSeiPictureTiming(AL_TBitStreamLite* pBS, AL_TSps const* pISps, int iCpbRemovalDelay, int iDpbOutputDelay, int iPicStruct, AL_TSeiPatchPoints* pPoints)
 {
   AL_TAvcSps* pSps = (AL_TAvcSps*)pISps;
   // Table D-1
@@ -372,8 +372,8 @@ static void writeSeiPictureTiming(AL_TBitStreamLite* pBS, AL_TSps const* pISps,
 
   if(pSps->vui_param.hrd_param.nal_hrd_parameters_present_flag || pSps->vui_param.hrd_param.vcl_hrd_parameters_present_flag)
   {
-    AL_BitStreamLite_PutU(pBS, 32, iCpbRemovalDelay);
-    AL_BitStreamLite_PutU(pBS, 32, iDpbOutputDelay);
+    AL_RbspEncoding_PutSeiField(pBS, pPoints, AL_SEI_FIELD_CPB_REMOVAL_DELAY, 32, iCpbRemovalDelay);
+    AL_RbspEncoding_PutSeiField(pBS, pPoints, AL_SEI_FIELD_DPB_OUTPUT_DELAY, 32, iDpbOutputDelay);
   }
 
   if(pSps->vui_param.pic_struct_present_flag)
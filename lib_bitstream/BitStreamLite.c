@@ -81,8 +81,10 @@ void AL_BitStreamLite_PutBit(AL_TBitStreamLite* pBS, uint8_t iBit)
 /******************************************************************************/
 void AL_BitStreamLite_AlignWithBits(AL_TBitStreamLite* pBS, uint8_t iBit)
 {
-  while(pBS->m_iBitCount % 8 != 0)
-    AL_BitStreamLite_PutBit(pBS, iBit);
+  uint8_t numBits = (8 - (pBS->m_iBitCount & 7)) & 7;
+
+  if(numBits)
+    AL_BitStreamLite_PutBits(pBS, numBits, iBit ? (1 << numBits) - 1 : 0);
 }
 
 /******************************************************************************/
@@ -97,43 +99,36 @@ void AL_BitStreamLite_EndOfSEIPayload(AL_TBitStreamLite* pBS)
   }
 }
 
-/* Assume that iNumBits will be small enough to fit in current byte */
-static void PutInByte(AL_TBitStreamLite* pBS, uint8_t iNumBits, uint32_t uValue)
-{
-  uint32_t byteNum = pBS->m_iBitCount >> 3;
-  uint8_t byteOffset = pBS->m_iBitCount & 7;
-
-  assert(byteOffset + iNumBits <= 8);
-
-  if(byteOffset == 0)
-  {
-    pBS->m_pData[byteNum] = uValue << (8 - iNumBits);
-  }
-  else
-  {
-    uint8_t bitsLeft = 8 - byteOffset;
-    pBS->m_pData[byteNum] += uValue << (bitsLeft - iNumBits);
-  }
-  pBS->m_iBitCount += iNumBits;
-}
-
 /******************************************************************************/
 void AL_BitStreamLite_PutBits(AL_TBitStreamLite* pBS, uint8_t iNumBits, uint32_t uValue)
 {
+  assert(iNumBits <= 32);
   assert(iNumBits == 32 || (uValue >> iNumBits) == 0);
 
-  uint8_t numBitsToWrite = 8 - (pBS->m_iBitCount & 7);
+  if(iNumBits == 0)
+    return;
+
+  /* the bits already written in the current byte and the new ones are
+   * gathered in a 64-bit accumulator, then stored with one write per byte */
+  uint8_t* pByte = pBS->m_pData + (pBS->m_iBitCount >> 3);
+  uint8_t byteOffset = pBS->m_iBitCount & 7;
+  uint8_t numBits = byteOffset + iNumBits;
+
+  uint64_t uAcc = (uint64_t)uValue << (64 - numBits);
+
+  if(byteOffset)
+    uAcc |= (uint64_t)(pByte[0] & (0xFF00 >> byteOffset)) << 56;
 
-  while(iNumBits > numBitsToWrite)
+  switch((numBits + 7) >> 3)
   {
-    uint8_t byteValue = uValue >> (iNumBits - numBitsToWrite);
-    PutInByte(pBS, numBitsToWrite, byteValue);
-    uValue &= (0xffffffff >> numBitsToWrite);
-    iNumBits -= numBitsToWrite;
-    numBitsToWrite = 8 - (pBS->m_iBitCount & 7);
+  case 5: pByte[4] = (uint8_t)(uAcc >> 24); // fallthrough
+  case 4: pByte[3] = (uint8_t)(uAcc >> 32); // fallthrough
+  case 3: pByte[2] = (uint8_t)(uAcc >> 40); // fallthrough
+  case 2: pByte[1] = (uint8_t)(uAcc >> 48); // fallthrough
+  default: pByte[0] = (uint8_t)(uAcc >> 56);
   }
 
-  PutInByte(pBS, iNumBits, uValue);
+  pBS->m_iBitCount += iNumBits;
 }
 
 void AL_BitStreamLite_SkipBits(AL_TBitStreamLite* pBS, int numBits)
@@ -154,6 +149,11 @@ static void putVclBits(AL_TBitStreamLite* pBS, uint32_t uCodeLength, uint32_t uV
   {
     AL_BitStreamLite_PutU(pBS, 1, 1);
   }
+  else if(uCodeLength <= 32)
+  {
+    /* the leading zeros and the info bits are the value + 1 on uCodeLength bits */
+    AL_BitStreamLite_PutBits(pBS, uCodeLength, uValue + 1);
+  }
   else
   {
     int32_t iInfoLength = (uCodeLength - 1) >> 1;
@@ -610,7 +610,7 @@ static void writeSeiActiveParameterSets(AL_TBitStreamLite* pBS, AL_THevcVps cons
 }
 
 /******************************************************************************/
-static void writeSeiBufferingPeriod(AL_TBitStreamLite* pBS, AL_TSps const* pISps, int iInitialCpbRemovalDelay, int iInitialCpbRemovalOffset)
+static void writeSeiBufferingPeriod(AL_TBitStreamLite* pBS, AL_TSps const* pISps, int iInitialCpbRemovalDelay, int iInitialCpbRemovalOffset, AL_TSeiPatchPoints* pPoints)
 {
   AL_THevcSps* pSps = (AL_THevcSps*)pISps;
 
@@ -644,7 +644,7 @@ static void writeSeiBufferingPeriod(AL_TBitStreamLite* pBS, AL_TSps const* pISps
   {
     for(int i = 0; i <= (int)pSps->vui_param.hrd_param.cpb_cnt_minus1[0]; ++i)
     {
-      AL_BitStreamLite_PutU(pBS, pSps->vui_param.hrd_param.au_cpb_removal_delay_length_minus1 + 1, iInitialCpbRemovalDelay);
+      AL_RbspEncoding_PutSeiField(pBS, pPoints, AL_SEI_FIELD_INITIAL_CPB_REMOVAL_DELAY, pSps->vui_param.hrd_param.au_cpb_removal_delay_length_minus1 + 1, iInitialCpbRemovalDelay);
       AL_BitStreamLite_PutU(pBS, pSps->vui_param.hrd_param.au_cpb_removal_delay_length_minus1 + 1, iInitialCpbRemovalOffset);
 
       if(pSps->vui_param.hrd_param.sub_pic_hrd_params_present_flag || uIRAPCpbParamsPresentFLag)
@@ -659,7 +659,7 @@ static void writeSeiBufferingPeriod(AL_TBitStreamLite* pBS, AL_TSps const* pISps
   {
     for(int i = 0; i <= (int)pSps->vui_param.hrd_param.cpb_cnt_minus1[0]; ++i)
     {
-      AL_BitStreamLite_PutU(pBS, pSps->vui_param.hrd_param.au_cpb_removal_delay_length_minus1 + 1, iInitialCpbRemovalDelay);
+      AL_RbspEncoding_PutSeiField(pBS, pPoints, AL_SEI_FIELD_INITIAL_CPB_REMOVAL_DELAY, pSps->vui_param.hrd_param.au_cpb_removal_delay_length_minus1 + 1, iInitialCpbRemovalDelay);
       AL_BitStreamLite_PutU(pBS, pSps->vui_param.hrd_param.au_cpb_removal_delay_length_minus1 + 1, iInitialCpbRemovalOffset);
 
       if(pSps->vui_param.hrd_param.sub_pic_hrd_params_present_flag || uIRAPCpbParamsPresentFLag)
@@ -689,7 +689,7 @@ static void writeSeiRecoveryPoint(AL_TBitStreamLite* pBS)
 }
 
 /******************************************************************************/
-static void writeSeiPictureTiming(AL_TBitStreamLite* pBS, AL_TSps const* pISps, int iAuCpbRemovalDelay, int iPicDpbOutputDelay, int iPicStruct)
+static void writeSeiPictureTiming(AL_TBitStreamLite* pBS, AL_TSps const* pISps, int iAuCpbRemovalDelay, int iPicDpbOutputDelay, int iPicStruct, AL_TSeiPatchPoints* pPoints)
 {
   AL_THevcSps* pSps = (AL_THevcSps*)pISps;
 
@@ -714,8 +714,8 @@ static void writeSeiPictureTiming(AL_TBitStreamLite* pBS, AL_TSps const* pISps,
 
   if(pSps->vui_param.hrd_param.nal_hrd_parameters_present_flag || pSps->vui_param.hrd_param.vcl_hrd_parameters_present_flag)
   {
-    AL_BitStreamLite_PutU(pBS, 32, iAuCpbRemovalDelay);
-    AL_BitStreamLite_PutU(pBS, 32, iPicDpbOutputDelay);
+    AL_RbspEncoding_PutSeiField(pBS, pPoints, AL_SEI_FIELD_CPB_REMOVAL_DELAY, 32, iAuCpbRemovalDelay);
+    AL_RbspEncoding_PutSeiField(pBS, pPoints, AL_SEI_FIELD_DPB_OUTPUT_DELAY, 32, iPicDpbOutputDelay);
 
     if(pSps->vui_param.hrd_param.sub_pic_hrd_params_present_flag)
     {
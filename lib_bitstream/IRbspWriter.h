@@ -38,6 +38,7 @@
 #pragma once
 
 #include "BitStreamLite.h"
+#include "RbspEncod.h"
 #include "lib_common/SPS.h"
 #include "lib_common/PPS.h"
 
@@ -48,9 +49,9 @@ typedef struct rbspWriter
   void (* WriteSPS)(AL_TBitStreamLite* writer, AL_TSps const* pSps);
   void (* WritePPS)(AL_TBitStreamLite* writer, AL_TPps const* pPps);
   void (* WriteSEI_ActiveParameterSets)(AL_TBitStreamLite* writer, AL_THevcVps const* pVps, AL_TSps const* pISps);
-  void (* WriteSEI_BufferingPeriod)(AL_TBitStreamLite* writer, AL_TSps const* pISps, int iInitialCpbRemovalDelay, int iInitialCpbRemovalOffset);
+  void (* WriteSEI_BufferingPeriod)(AL_TBitStreamLite* writer, AL_TSps const* pISps, int iInitialCpbRemovalDelay, int iInitialCpbRemovalOffset, AL_TSeiPatchPoints* pPoints);
   void (* WriteSEI_RecoveryPoint)(AL_TBitStreamLite* writer);
-  void (* WriteSEI_PictureTiming)(AL_TBitStreamLite* writer, AL_TSps const* pISps, int iAuCpbRemovalDelay, int iPicDpbOutputDelay, int iPicStruct);
+  void (* WriteSEI_PictureTiming)(AL_TBitStreamLite* writer, AL_TSps const* pISps, int iAuCpbRemovalDelay, int iPicDpbOutputDelay, int iPicStruct, AL_TSeiPatchPoints* pPoints);
   void (* WriteSEI_UserDataUnregistered)(AL_TBitStreamLite* writer, uint8_t uuid[16]);
 }IRbspWriter;
 
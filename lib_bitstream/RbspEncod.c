@@ -100,5 +100,54 @@ void AL_RbspEncoding_WriteUserDataUnregistered(AL_TBitStreamLite* pBS, uint8_t u
   AL_RbspEncoding_CloseSEI(pBS);
 }
 
+/******************************************************************************/
+void AL_RbspEncoding_PutSeiField(AL_TBitStreamLite* pBS, AL_TSeiPatchPoints* pPoints, AL_ESeiField eField, int iNumBits, uint32_t uValue)
+{
+  if(pPoints && pPoints->iNumPoints >= 0)
+  {
+    if(pPoints->iNumPoints < AL_MAX_SEI_PATCH_POINTS)
+    {
+      AL_TSeiPatchPoint* pPoint = &pPoints->tPoints[pPoints->iNumPoints++];
+      pPoint->eField = eField;
+      pPoint->uNumBits = iNumBits;
+      pPoint->uBitOffset = AL_BitStreamLite_GetBitsCount(pBS);
+    }
+    else
+      pPoints->iNumPoints = -1;
+  }
+
+  AL_BitStreamLite_PutU(pBS, iNumBits, uValue);
+}
+
+/******************************************************************************/
+static void PatchBits(uint8_t* pData, int iBitOffset, int iNumBits, uint32_t uValue)
+{
+  while(iNumBits)
+  {
+    uint8_t* pByte = pData + (iBitOffset >> 3);
+    int iBitsLeft = 8 - (iBitOffset & 7);
+    int iBits = iNumBits < iBitsLeft ? iNumBits : iBitsLeft;
+    uint8_t uMask = ((1 << iBits) - 1) << (iBitsLeft - iBits);
+    uint8_t uBits = (uValue >> (iNumBits - iBits)) << (iBitsLeft - iBits);
+
+    *pByte = (*pByte & ~uMask) | (uBits & uMask);
+
+    iBitOffset += iBits;
+    iNumBits -= iBits;
+  }
+}
+
+/******************************************************************************/
+void AL_RbspEncoding_PatchSeiField(uint8_t* pRbsp, AL_TSeiPatchPoints const* pPoints, AL_ESeiField eField, uint32_t uValue)
+{
+  for(int i = 0; i < pPoints->iNumPoints; ++i)
+  {
+    AL_TSeiPatchPoint const* pPoint = &pPoints->tPoints[i];
+
+    if(pPoint->eField == eField)
+      PatchBits(pRbsp, pPoint->uBitOffset, pPoint->uNumBits, uValue);
+  }
+}
+
 /*@}*/
 
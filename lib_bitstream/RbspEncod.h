@@ -63,6 +63,50 @@ int AL_RbspEncoding_BeginSEI(AL_TBitStreamLite* pRE, uint8_t payloadType);
 void AL_RbspEncoding_EndSEI(AL_TBitStreamLite* pRE, int bookmarkSEI);
 void AL_RbspEncoding_CloseSEI(AL_TBitStreamLite* pRE);
 void AL_RbspEncoding_WriteUserDataUnregistered(AL_TBitStreamLite* pRE, uint8_t uuid[16]);
+
+/*************************************************************************//*!
+   \brief Fields of the SEI messages that change from one picture to the other
+*****************************************************************************/
+typedef enum
+{
+  AL_SEI_FIELD_INITIAL_CPB_REMOVAL_DELAY,
+  AL_SEI_FIELD_CPB_REMOVAL_DELAY,
+  AL_SEI_FIELD_DPB_OUTPUT_DELAY,
+}AL_ESeiField;
+
+#define AL_MAX_SEI_PATCH_POINTS 16
+
+typedef struct
+{
+  uint8_t eField;
+  uint8_t uNumBits;
+  uint16_t uBitOffset; /*!< From the beginning of the bitstream */
+}AL_TSeiPatchPoint;
+
+typedef struct
+{
+  int iNumPoints; /*!< -1 when the messages have more fields than AL_MAX_SEI_PATCH_POINTS */
+  AL_TSeiPatchPoint tPoints[AL_MAX_SEI_PATCH_POINTS];
+}AL_TSeiPatchPoints;
+
+/*********************************************************************//*!
+   \brief Writes a SEI field and records its position
+   \param[in] pRE Pointer to the bitstream
+   \param[in] pPoints Positions of the fields written so far, may be NULL
+   \param[in] eField Field written
+   \param[in] iNumBits Size of the field
+   \param[in] uValue Value of the field
+*************************************************************************/
+void AL_RbspEncoding_PutSeiField(AL_TBitStreamLite* pRE, AL_TSeiPatchPoints* pPoints, AL_ESeiField eField, int iNumBits, uint32_t uValue);
+
+/*********************************************************************//*!
+   \brief Overwrites a SEI field at every position recorded for it
+   \param[in] pRbsp Bitstream the SEI messages were written in
+   \param[in] pPoints Positions recorded by AL_RbspEncoding_PutSeiField
+   \param[in] eField Field to overwrite
+   \param[in] uValue New value of the field
+*************************************************************************/
+void AL_RbspEncoding_PatchSeiField(uint8_t* pRbsp, AL_TSeiPatchPoints const* pPoints, AL_ESeiField eField, uint32_t uValue);
 /****************************************************************************/
 
 #endif
@@ -0,0 +1,190 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+extern "C"
+{
+#include "lib_bitstream/BitStreamLite.h"
+}
+
+using namespace std;
+
+/* one bit per element, written the obvious way */
+struct RefWriter
+{
+  vector<uint8_t> bits;
+
+  void PutBits(int iNumBits, uint32_t uValue)
+  {
+    for(int i = iNumBits - 1; i >= 0; --i)
+      bits.push_back((uValue >> i) & 1);
+  }
+
+  void PutUE(uint32_t uValue)
+  {
+    uint64_t uCode = (uint64_t)uValue + 1;
+    int iInfoLength = 0;
+
+    while(uCode >> (iInfoLength + 1))
+      ++iInfoLength;
+
+    PutBits(iInfoLength, 0);
+
+    for(int i = iInfoLength; i >= 0; --i)
+      bits.push_back((uCode >> i) & 1);
+  }
+
+  void PutSE(int32_t iValue)
+  {
+    PutUE(iValue > 0 ? 2 * iValue - 1 : -2 * iValue);
+  }
+
+  void Align(int iBit)
+  {
+    while(bits.size() % 8)
+      bits.push_back(iBit);
+  }
+
+  vector<uint8_t> Bytes() const
+  {
+    vector<uint8_t> bytes((bits.size() + 7) / 8);
+
+    for(size_t i = 0; i < bits.size(); ++i)
+      bytes[i / 8] |= bits[i] << (7 - i % 8);
+
+    return bytes;
+  }
+};
+
+static void ExpectSameBytes(RefWriter const& ref, AL_TBitStreamLite* pStream)
+{
+  ASSERT_EQ((int)ref.bits.size(), AL_BitStreamLite_GetBitsCount(pStream));
+  auto const expected = ref.Bytes();
+  auto const pData = AL_BitStreamLite_GetData(pStream);
+  EXPECT_EQ(expected, vector<uint8_t>(pData, pData + expected.size()));
+}
+
+TEST(BitStreamLite, PutBitsMatchesABitWriter)
+{
+  mt19937 gen(1);
+  vector<uint8_t> buf(64 * 1024, 0xA5);
+  AL_TBitStreamLite stream;
+  AL_BitStreamLite_Init(&stream, buf.data());
+  RefWriter ref;
+
+  while(ref.bits.size() < 8 * (buf.size() - 64))
+  {
+    int iNumBits = gen() % 33;
+    uint32_t uValue = iNumBits == 32 ? gen() : gen() & ((1u << iNumBits) - 1);
+    AL_BitStreamLite_PutBits(&stream, iNumBits, uValue);
+    ref.PutBits(iNumBits, uValue);
+  }
+
+  ExpectSameBytes(ref, &stream);
+}
+
+TEST(BitStreamLite, ExpGolombMatchesABitWriter)
+{
+  mt19937 gen(2);
+  vector<uint8_t> buf(64 * 1024, 0x5A);
+  AL_TBitStreamLite stream;
+  AL_BitStreamLite_Init(&stream, buf.data());
+  RefWriter ref;
+
+  for(int i = 0; i < 4000; ++i)
+  {
+    /* short codes in the single write path and long ones up to 61 bits */
+    uint32_t uValue = (gen() >> 2) >> (gen() % 30);
+
+    switch(gen() % 4)
+    {
+    case 0:
+      AL_BitStreamLite_PutUE(&stream, uValue);
+      ref.PutUE(uValue);
+      break;
+    case 1:
+    {
+      int32_t iValue = (int32_t)(uValue >> 2) * ((gen() & 1) ? 1 : -1);
+      AL_BitStreamLite_PutSE(&stream, iValue);
+      ref.PutSE(iValue);
+      break;
+    }
+    case 2:
+    {
+      int iBit = gen() & 1;
+      AL_BitStreamLite_AlignWithBits(&stream, iBit);
+      ref.Align(iBit);
+      break;
+    }
+    default:
+    {
+      uint8_t uBit = gen() & 1;
+      AL_BitStreamLite_PutBit(&stream, uBit);
+      ref.bits.push_back(uBit);
+    }
+    }
+  }
+
+  ExpectSameBytes(ref, &stream);
+}
+
+TEST(BitStreamLite, BytesAreWrittenAfterEachCall)
+{
+  /* the callers patch the buffer in place between the writes */
+  vector<uint8_t> buf(16, 0xFF);
+  AL_TBitStreamLite stream;
+  AL_BitStreamLite_Init(&stream, buf.data());
+
+  AL_BitStreamLite_PutBits(&stream, 3, 0x5);
+  EXPECT_EQ(0xA0, buf[0]);
+  AL_BitStreamLite_PutBits(&stream, 13, 0x1234);
+  EXPECT_EQ(0xB2, buf[0]);
+  EXPECT_EQ(0x34, buf[1]);
+
+  buf[2] = 0x00;
+  AL_BitStreamLite_SkipBits(&stream, 8);
+  AL_BitStreamLite_PutUE(&stream, 0);
+  EXPECT_EQ(0x00, buf[2]);
+  EXPECT_EQ(0x80, buf[3]);
+  AL_BitStreamLite_AlignWithBits(&stream, 1);
+  EXPECT_EQ(0xFF, buf[3]);
+  EXPECT_EQ(32, AL_BitStreamLite_GetBitsCount(&stream));
+}
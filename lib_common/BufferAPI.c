@@ -36,16 +36,38 @@
 ******************************************************************************/
 
 #include "lib_common/BufferAPI.h"
+#include "Slab.h"
 #include "assert.h"
 
+/* number of metadata stored in the buffer itself, without any heap allocation */
+#define AL_BUFFER_INLINE_META 4
+
+typedef struct
+{
+  AL_EMetaType eType; /*!< copied from the metadata, so that readers never dereference a removed one */
+  AL_TMetaData* pMeta;
+}AL_TMetaEntry;
+
+/* heap storage used when more metadata are attached. The previous arrays are kept
+ * until the buffer is destroyed as a lockless reader could still be scanning them */
+typedef struct al_t_MetaArray
+{
+  struct al_t_MetaArray* pPrev;
+  AL_TMetaEntry entries[];
+}AL_TMetaArray;
+
 typedef struct al_t_BufferImpl
 {
   AL_TBuffer buf;
-  AL_MUTEX pLock;
+  int32_t iLock; /*!< serializes the metadata updates */
+  int32_t iMetaSeq; /*!< odd while the metadata are updated */
   int32_t iRefCount;
 
-  AL_TMetaData** pMeta;
+  AL_TMetaEntry* pMeta;
   int iMetaCount;
+  int iMetaCapacity;
+  AL_TMetaArray* pMetaArray; /*!< last heap array, NULL while the inline one is enough */
+  AL_TMetaEntry inlineMeta[AL_BUFFER_INLINE_META];
 
   void* pUserData; /*!< user private data */
   PFN_RefCount_CallBack pCallBack; /*!< user callback. called when the buffer refcount reaches 0 */
@@ -53,18 +75,35 @@ typedef struct al_t_BufferImpl
   uint8_t* pData; /*!< Buffer data mapped in userspace */
 }AL_TBufferImpl;
 
-static void* Realloc(void* pPtr, size_t zOldSize, size_t zNewSize)
+static void LockMetaData(AL_TBufferImpl* pBuf)
 {
-  void* pNewPtr = Rtos_Malloc(zNewSize);
+  while(!Rtos_AtomicCompareAndSwap(&pBuf->iLock, 0, 1))
+    Rtos_Yield();
 
-  if(pPtr)
-  {
-    size_t zSizeToCopy = zOldSize < zNewSize ? zOldSize : zNewSize;
-    Rtos_Memcpy(pNewPtr, pPtr, zSizeToCopy);
-  }
+  Rtos_AtomicIncrement(&pBuf->iMetaSeq);
+}
+
+static void UnlockMetaData(AL_TBufferImpl* pBuf)
+{
+  Rtos_AtomicIncrement(&pBuf->iMetaSeq);
+  Rtos_AtomicStore(&pBuf->iLock, 0);
+}
 
-  Rtos_Free(pPtr);
-  return pNewPtr;
+static bool GrowMetaData(AL_TBufferImpl* pBuf)
+{
+  int iNewCapacity = pBuf->iMetaCapacity * 2;
+  AL_TMetaArray* pArray = Rtos_Malloc(sizeof(AL_TMetaArray) + iNewCapacity * sizeof(AL_TMetaEntry));
+
+  if(!pArray)
+    return false;
+
+  Rtos_Memcpy(pArray->entries, pBuf->pMeta, pBuf->iMetaCount * sizeof(AL_TMetaEntry));
+  pArray->pPrev = pBuf->pMetaArray;
+  pBuf->pMetaArray = pArray;
+  pBuf->pMeta = pArray->entries;
+  pBuf->iMetaCapacity = iNewCapacity;
+
+  return true;
 }
 
 static bool AL_Buffer_InitData(AL_TBufferImpl* pBuf, AL_TAllocator* pAllocator, AL_HANDLE hBuf, size_t zSize, PFN_RefCount_CallBack pCallBack)
@@ -74,14 +113,15 @@ static bool AL_Buffer_InitData(AL_TBufferImpl* pBuf, AL_TAllocator* pAllocator,
   pBuf->pCallBack = pCallBack;
   pBuf->buf.hBuf = hBuf;
   pBuf->pData = NULL;
-  pBuf->pMeta = NULL;
+  pBuf->pUserData = NULL;
+  pBuf->pMeta = pBuf->inlineMeta;
   pBuf->iMetaCount = 0;
+  pBuf->iMetaCapacity = AL_BUFFER_INLINE_META;
+  pBuf->pMetaArray = NULL;
 
   pBuf->iRefCount = 0;
-  pBuf->pLock = Rtos_CreateMutex();
-
-  if(!pBuf->pLock)
-    return false;
+  pBuf->iLock = 0;
+  pBuf->iMetaSeq = 0;
 
   return true;
 }
@@ -91,7 +131,7 @@ static AL_TBuffer* createBuffer(AL_TAllocator* pAllocator, AL_HANDLE hBuf, size_
   if(zSize && !hBuf)
     return NULL;
 
-  AL_TBufferImpl* pBuf = Rtos_Malloc(sizeof(*pBuf));
+  AL_TBufferImpl* pBuf = AL_Slab_Alloc(AL_SLAB_BUFFER, sizeof(*pBuf));
 
   if(!pBuf)
     return NULL;
@@ -102,7 +142,7 @@ static AL_TBuffer* createBuffer(AL_TAllocator* pAllocator, AL_HANDLE hBuf, size_
   return (AL_TBuffer*)pBuf;
 
   fail_init_data:
-  Rtos_Free(pBuf);
+  AL_Slab_Free(AL_SLAB_BUFFER, pBuf);
   return NULL;
 }
 
@@ -142,38 +182,32 @@ AL_TBuffer* AL_Buffer_Create_And_Allocate(AL_TAllocator* pAllocator, size_t zSiz
 void AL_Buffer_Destroy(AL_TBuffer* hBuf)
 {
   AL_TBufferImpl* pBuf = (AL_TBufferImpl*)hBuf;
-  Rtos_GetMutex(pBuf->pLock);
 
   assert(pBuf->iRefCount == 0);
 
   for(int i = 0; i < pBuf->iMetaCount; ++i)
-    pBuf->pMeta[i]->MetaDestroy(pBuf->pMeta[i]);
+    pBuf->pMeta[i].pMeta->MetaDestroy(pBuf->pMeta[i].pMeta);
 
-  Rtos_Free(pBuf->pMeta);
-  Rtos_ReleaseMutex(pBuf->pLock);
+  while(pBuf->pMetaArray)
+  {
+    AL_TMetaArray* pPrev = pBuf->pMetaArray->pPrev;
+    Rtos_Free(pBuf->pMetaArray);
+    pBuf->pMetaArray = pPrev;
+  }
 
-  Rtos_DeleteMutex(pBuf->pLock);
-  Rtos_Free(pBuf);
+  AL_Slab_Free(AL_SLAB_BUFFER, pBuf);
 }
 
 void AL_Buffer_SetUserData(AL_TBuffer* hBuf, void* pUserData)
 {
   AL_TBufferImpl* pBuf = (AL_TBufferImpl*)hBuf;
-
-  Rtos_GetMutex(pBuf->pLock);
   pBuf->pUserData = pUserData;
-  Rtos_ReleaseMutex(pBuf->pLock);
 }
 
 void* AL_Buffer_GetUserData(AL_TBuffer* hBuf)
 {
   AL_TBufferImpl* pBuf = (AL_TBufferImpl*)hBuf;
-
-  Rtos_GetMutex(pBuf->pLock);
-  void* pUserData = pBuf->pUserData;
-  Rtos_ReleaseMutex(pBuf->pLock);
-
-  return pUserData;
+  return pBuf->pUserData;
 }
 
 /****************************************************************************/
@@ -202,19 +236,36 @@ void AL_Buffer_Unref(AL_TBuffer* hBuf)
 AL_TMetaData* AL_Buffer_GetMetaData(AL_TBuffer const* hBuf, AL_EMetaType eType)
 {
   AL_TBufferImpl* pBuf = (AL_TBufferImpl*)hBuf;
-  Rtos_GetMutex(pBuf->pLock);
 
-  for(int i = 0; i < pBuf->iMetaCount; ++i)
+  /* lockless: retry if the metadata were updated during the lookup */
+  for(;;)
   {
-    if(pBuf->pMeta[i]->eType == eType)
+    int32_t iSeq = Rtos_AtomicLoad(&pBuf->iMetaSeq);
+
+    if(iSeq & 1)
     {
-      Rtos_ReleaseMutex(pBuf->pLock);
-      return pBuf->pMeta[i];
+      Rtos_Yield();
+      continue;
     }
-  }
 
-  Rtos_ReleaseMutex(pBuf->pLock);
-  return NULL;
+    AL_TMetaEntry const* pMeta = pBuf->pMeta;
+    int iMetaCount = pBuf->iMetaCount;
+    AL_TMetaData* pFound = NULL;
+
+    for(int i = 0; i < iMetaCount; ++i)
+    {
+      if(pMeta[i].eType == eType)
+      {
+        pFound = pMeta[i].pMeta;
+        break;
+      }
+    }
+
+    Rtos_AcquireFence();
+
+    if(Rtos_AtomicLoad(&pBuf->iMetaSeq) == iSeq)
+      return pFound;
+  }
 }
 
 /****************************************************************************/
@@ -222,23 +273,19 @@ bool AL_Buffer_AddMetaData(AL_TBuffer* hBuf, AL_TMetaData* pMeta)
 {
   AL_TBufferImpl* pBuf = (AL_TBufferImpl*)hBuf;
 
-  Rtos_GetMutex(pBuf->pLock);
-
-  size_t const zOldSize = sizeof(AL_TMetaData*) * pBuf->iMetaCount;
-  size_t const zNewSize = sizeof(AL_TMetaData*) * (pBuf->iMetaCount + 1);
-  AL_TMetaData** pNewBuffer = Realloc(pBuf->pMeta, zOldSize, zNewSize);
+  LockMetaData(pBuf);
 
-  if(!pNewBuffer)
+  if(pBuf->iMetaCount == pBuf->iMetaCapacity && !GrowMetaData(pBuf))
   {
-    Rtos_ReleaseMutex(pBuf->pLock);
+    UnlockMetaData(pBuf);
     return false;
   }
 
-  pBuf->pMeta = pNewBuffer;
-  pBuf->pMeta[pBuf->iMetaCount] = pMeta;
+  pBuf->pMeta[pBuf->iMetaCount].eType = pMeta->eType;
+  pBuf->pMeta[pBuf->iMetaCount].pMeta = pMeta;
   pBuf->iMetaCount++;
 
-  Rtos_ReleaseMutex(pBuf->pLock);
+  UnlockMetaData(pBuf);
 
   return true;
 }
@@ -248,21 +295,20 @@ bool AL_Buffer_RemoveMetaData(AL_TBuffer* hBuf, AL_TMetaData* pMeta)
 {
   AL_TBufferImpl* pBuf = (AL_TBufferImpl*)hBuf;
 
-  Rtos_GetMutex(pBuf->pLock);
+  LockMetaData(pBuf);
 
   for(int i = 0; i < pBuf->iMetaCount; ++i)
   {
-    if(pBuf->pMeta[i] == pMeta)
+    if(pBuf->pMeta[i].pMeta == pMeta)
     {
       pBuf->pMeta[i] = pBuf->pMeta[pBuf->iMetaCount - 1];
-      pBuf->pMeta = Realloc(pBuf->pMeta, sizeof(void*) * pBuf->iMetaCount, sizeof(void*) * (pBuf->iMetaCount - 1));
       pBuf->iMetaCount--;
-      Rtos_ReleaseMutex(pBuf->pLock);
+      UnlockMetaData(pBuf);
       return true;
     }
   }
 
-  Rtos_ReleaseMutex(pBuf->pLock);
+  UnlockMetaData(pBuf);
   return false;
 }
 
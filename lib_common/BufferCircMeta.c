@@ -37,16 +37,17 @@
 
 #include "lib_rtos/lib_rtos.h"
 #include "BufferCircMeta.h"
+#include "Slab.h"
 
 static bool destroy(AL_TMetaData* pMeta)
 {
-  Rtos_Free(pMeta);
+  AL_Slab_Free(AL_SLAB_CIRC_META, pMeta);
   return true;
 }
 
 AL_TCircMetaData* AL_CircMetaData_Create(uint32_t uOffset, uint32_t uAvailSize, bool bLastBuffer)
 {
-  AL_TCircMetaData* pMeta = Rtos_Malloc(sizeof(*pMeta));
+  AL_TCircMetaData* pMeta = AL_Slab_Alloc(AL_SLAB_CIRC_META, sizeof(*pMeta));
 
   if(!pMeta)
     return NULL;
@@ -37,17 +37,18 @@
 
 #include "lib_rtos/lib_rtos.h"
 #include "lib_common/BufferSrcMeta.h"
+#include "Slab.h"
 #include <assert.h>
 
 static bool SrcMeta_Destroy(AL_TMetaData* pMeta)
 {
-  Rtos_Free(pMeta);
+  AL_Slab_Free(AL_SLAB_SRC_META, pMeta);
   return true;
 }
 
 AL_TSrcMetaData* AL_SrcMetaData_Create(AL_TDimension tDim, AL_TPitches tPitches, AL_TOffsetYC tOffsetYC, TFourCC tFourCC)
 {
-  AL_TSrcMetaData* pMeta = Rtos_Malloc(sizeof(*pMeta));
+  AL_TSrcMetaData* pMeta = AL_Slab_Alloc(AL_SLAB_SRC_META, sizeof(*pMeta));
 
   if(!pMeta)
     return NULL;
@@ -37,11 +37,32 @@
 
 #include "lib_common/BufferStreamMeta.h"
 #include "lib_rtos/lib_rtos.h"
+#include "Slab.h"
 #include <assert.h>
 
+/* the sections of the usual stream metadata are allocated with it in the slab */
+typedef struct
+{
+  AL_TStreamMetaData tStreamMeta;
+  AL_TStreamSection sections[AL_MAX_SECTION];
+}AL_TStreamMetaDataWithSections;
+
+static bool HasSlabSections(AL_TStreamMetaData* pMeta)
+{
+  return pMeta->pSections == ((AL_TStreamMetaDataWithSections*)pMeta)->sections;
+}
+
 static bool StreamMeta_Destroy(AL_TMetaData* pMeta)
 {
   AL_TStreamMetaData* pStreamMeta = (AL_TStreamMetaData*)pMeta;
+
+  if(pStreamMeta->uMaxNumSection <= AL_MAX_SECTION)
+  {
+    assert(HasSlabSections(pStreamMeta));
+    AL_Slab_Free(AL_SLAB_STREAM_META, pMeta);
+    return true;
+  }
+
   Rtos_Free(pStreamMeta->pSections);
   Rtos_Free(pMeta);
   return true;
@@ -54,6 +75,23 @@ AL_TStreamMetaData* AL_StreamMetaData_Create(uint16_t uMaxNumSection)
   if(uMaxNumSection == 0)
     return NULL;
 
+  if(uMaxNumSection <= AL_MAX_SECTION)
+  {
+    AL_TStreamMetaDataWithSections* pMetaWithSections = AL_Slab_Alloc(AL_SLAB_STREAM_META, sizeof(*pMetaWithSections));
+
+    if(!pMetaWithSections)
+      return NULL;
+
+    pMeta = &pMetaWithSections->tStreamMeta;
+    pMeta->tMeta.eType = AL_META_TYPE_STREAM;
+    pMeta->tMeta.MetaDestroy = StreamMeta_Destroy;
+    pMeta->uMaxNumSection = uMaxNumSection;
+    pMeta->uNumSection = 0;
+    pMeta->pSections = pMetaWithSections->sections;
+
+    return pMeta;
+  }
+
   pMeta = Rtos_Malloc(sizeof(*pMeta));
 
   if(!pMeta)
@@ -37,7 +37,10 @@
 
 #include "Fifo.h"
 
-bool AL_Fifo_Init(AL_TFifo* pFifo, size_t zMaxElem)
+/* number of failed attempts before a lockless fifo puts the thread to sleep */
+#define AL_FIFO_SPIN_COUNT 256
+
+static bool InitLocked(AL_TFifo* pFifo, size_t zMaxElem)
 {
   pFifo->m_zMaxElem = zMaxElem + 1;
   pFifo->m_zTail = 0;
@@ -71,8 +74,79 @@ bool AL_Fifo_Init(AL_TFifo* pFifo, size_t zMaxElem)
   return true;
 }
 
+static bool InitLockless(AL_TFifo* pFifo, size_t zMaxElem)
+{
+  /* power of 2 ring so that the free running indexes can wrap */
+  size_t zRingSize = 1;
+
+  while(zRingSize < zMaxElem)
+    zRingSize <<= 1;
+
+  pFifo->m_zMaxElem = zRingSize;
+  pFifo->iNumElems = 0;
+  pFifo->iNumSpaces = zMaxElem;
+  pFifo->iTail = 0;
+  pFifo->iHead = 0;
+  pFifo->pSeq = NULL;
+  pFifo->hMutex = NULL;
+
+  pFifo->m_ElemBuffer = Rtos_Malloc(zRingSize * sizeof(void*));
+
+  if(!pFifo->m_ElemBuffer)
+    return false;
+
+  if(pFifo->eMode == AL_FIFO_MPMC)
+  {
+    pFifo->pSeq = Rtos_Malloc(zRingSize * sizeof(int32_t));
+
+    if(!pFifo->pSeq)
+      goto fail_seq;
+
+    for(size_t i = 0; i < zRingSize; ++i)
+      pFifo->pSeq[i] = i;
+  }
+
+  pFifo->hCountSem = Rtos_CreateSemaphore(0);
+
+  if(!pFifo->hCountSem)
+    goto fail_count_sem;
+
+  pFifo->hSpaceSem = Rtos_CreateSemaphore(0);
+
+  if(!pFifo->hSpaceSem)
+    goto fail_space_sem;
+
+  return true;
+
+  fail_space_sem:
+  Rtos_DeleteSemaphore(pFifo->hCountSem);
+  fail_count_sem:
+  Rtos_Free(pFifo->pSeq);
+  fail_seq:
+  Rtos_Free(pFifo->m_ElemBuffer);
+  return false;
+}
+
+bool AL_Fifo_InitWithMode(AL_TFifo* pFifo, size_t zMaxElem, AL_EFifoMode eMode)
+{
+  pFifo->eMode = eMode;
+
+  if(eMode == AL_FIFO_LOCKED)
+    return InitLocked(pFifo, zMaxElem);
+
+  return InitLockless(pFifo, zMaxElem);
+}
+
+bool AL_Fifo_Init(AL_TFifo* pFifo, size_t zMaxElem)
+{
+  return AL_Fifo_InitWithMode(pFifo, zMaxElem, AL_FIFO_LOCKED);
+}
+
 bool AL_Fifo_Empty(AL_TFifo* pFifo)
 {
+  if(pFifo->eMode != AL_FIFO_LOCKED)
+    return Rtos_AtomicLoad(&pFifo->iNumElems) <= 0;
+
   return pFifo->m_zHead == pFifo->m_zTail;
 }
 
@@ -81,11 +155,127 @@ void AL_Fifo_Deinit(AL_TFifo* pFifo)
   Rtos_Free(pFifo->m_ElemBuffer);
   Rtos_DeleteSemaphore(pFifo->hCountSem);
   Rtos_DeleteSemaphore(pFifo->hSpaceSem);
-  Rtos_DeleteMutex(pFifo->hMutex);
+
+  if(pFifo->eMode == AL_FIFO_LOCKED)
+    Rtos_DeleteMutex(pFifo->hMutex);
+  else
+    Rtos_Free(pFifo->pSeq);
+}
+
+/* A lockless counter is the number of available elements (or spaces). A negative value
+ * is the number of threads sleeping on the associated semaphore. */
+static bool TryTake(int32_t* pCount)
+{
+  int32_t iCount = Rtos_AtomicLoad(pCount);
+
+  while(iCount > 0)
+  {
+    if(Rtos_AtomicCompareAndSwap(pCount, iCount, iCount - 1))
+      return true;
+    iCount = Rtos_AtomicLoad(pCount);
+  }
+
+  return false;
+}
+
+static bool Take(int32_t* pCount, AL_SEMAPHORE hSem, uint32_t uWait)
+{
+  if(TryTake(pCount))
+    return true;
+
+  if(uWait == AL_NO_WAIT)
+    return false;
+
+  for(int iSpin = 0; iSpin < AL_FIFO_SPIN_COUNT; ++iSpin)
+  {
+    if(TryTake(pCount))
+      return true;
+  }
+
+  if(Rtos_AtomicDecrement(pCount) >= 0)
+    return true;
+
+  if(Rtos_GetSemaphore(hSem, uWait))
+    return true;
+
+  /* timeout: stop waiting unless a release is already on its way */
+  int32_t iCount = Rtos_AtomicLoad(pCount);
+
+  while(iCount < 0)
+  {
+    if(Rtos_AtomicCompareAndSwap(pCount, iCount, iCount + 1))
+      return false;
+    iCount = Rtos_AtomicLoad(pCount);
+  }
+
+  Rtos_GetSemaphore(hSem, AL_WAIT_FOREVER);
+  return true;
+}
+
+static void Give(int32_t* pCount, AL_SEMAPHORE hSem)
+{
+  if(Rtos_AtomicIncrement(pCount) <= 0)
+    Rtos_ReleaseSemaphore(hSem);
+}
+
+static void QueueLockless(AL_TFifo* pFifo, void* pElem)
+{
+  uint32_t uMask = pFifo->m_zMaxElem - 1;
+
+  if(pFifo->eMode == AL_FIFO_SPSC)
+  {
+    /* the space counter orders this write after the read of the previous lap */
+    pFifo->m_ElemBuffer[pFifo->iTail] = pElem;
+    pFifo->iTail = (pFifo->iTail + 1) & uMask;
+    return;
+  }
+
+  /* our space is reserved: only wait for the consumer of the previous lap to leave the slot */
+  uint32_t uPos = Rtos_AtomicIncrement(&pFifo->iTail) - 1;
+  int32_t* pSeq = &pFifo->pSeq[uPos & uMask];
+
+  while(Rtos_AtomicLoad(pSeq) != (int32_t)uPos)
+    Rtos_Yield();
+
+  pFifo->m_ElemBuffer[uPos & uMask] = pElem;
+  Rtos_AtomicStore(pSeq, uPos + 1);
+}
+
+static void* DequeueLockless(AL_TFifo* pFifo)
+{
+  uint32_t uMask = pFifo->m_zMaxElem - 1;
+
+  if(pFifo->eMode == AL_FIFO_SPSC)
+  {
+    void* pElem = pFifo->m_ElemBuffer[pFifo->iHead];
+    pFifo->iHead = (pFifo->iHead + 1) & uMask;
+    return pElem;
+  }
+
+  /* our element is reserved: only wait for its producer to finish the write */
+  uint32_t uPos = Rtos_AtomicIncrement(&pFifo->iHead) - 1;
+  int32_t* pSeq = &pFifo->pSeq[uPos & uMask];
+
+  while(Rtos_AtomicLoad(pSeq) != (int32_t)(uPos + 1))
+    Rtos_Yield();
+
+  void* pElem = pFifo->m_ElemBuffer[uPos & uMask];
+  Rtos_AtomicStore(pSeq, uPos + uMask + 1);
+  return pElem;
 }
 
 bool AL_Fifo_Queue(AL_TFifo* pFifo, void* pElem, uint32_t uWait)
 {
+  if(pFifo->eMode != AL_FIFO_LOCKED)
+  {
+    if(!Take(&pFifo->iNumSpaces, pFifo->hSpaceSem, uWait))
+      return false;
+
+    QueueLockless(pFifo, pElem);
+    Give(&pFifo->iNumElems, pFifo->hCountSem);
+    return true;
+  }
+
   if(!Rtos_GetSemaphore(pFifo->hSpaceSem, uWait))
     return false;
 
@@ -102,6 +292,16 @@ bool AL_Fifo_Queue(AL_TFifo* pFifo, void* pElem, uint32_t uWait)
 
 void* AL_Fifo_Dequeue(AL_TFifo* pFifo, uint32_t uWait)
 {
+  if(pFifo->eMode != AL_FIFO_LOCKED)
+  {
+    if(!Take(&pFifo->iNumElems, pFifo->hCountSem, uWait))
+      return NULL;
+
+    void* pElem = DequeueLockless(pFifo);
+    Give(&pFifo->iNumSpaces, pFifo->hSpaceSem);
+    return pElem;
+  }
+
   /* wait if no items */
   if(!Rtos_GetSemaphore(pFifo->hCountSem, uWait))
     return NULL;
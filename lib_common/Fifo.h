@@ -39,8 +39,16 @@
 
 #include "lib_rtos/lib_rtos.h"
 
+typedef enum
+{
+  AL_FIFO_LOCKED, /* mutex and semaphores, any number of producers and consumers */
+  AL_FIFO_SPSC, /* lockless, one producer thread, one consumer thread */
+  AL_FIFO_MPMC, /* lockless, any number of producers and consumers */
+}AL_EFifoMode;
+
 typedef struct
 {
+  AL_EFifoMode eMode;
   size_t m_zMaxElem;
   size_t m_zTail;
   size_t m_zHead;
@@ -48,10 +56,18 @@ typedef struct
   AL_MUTEX hMutex;
   AL_SEMAPHORE hCountSem;
   AL_SEMAPHORE hSpaceSem;
+
+  /* lockless modes: the semaphores are only used to park a thread when a counter goes negative */
+  int32_t iNumElems;
+  int32_t iNumSpaces;
+  int32_t iTail;
+  int32_t iHead;
+  int32_t* pSeq; /* per slot sequence number (AL_FIFO_MPMC only) */
 }AL_TFifo;
-/* lockless, one producer, one consumer */
 
 bool AL_Fifo_Init(AL_TFifo* pFifo, size_t zMaxElem);
+/* The lockless modes keep the blocking semantics: they spin briefly, then sleep on the semaphores */
+bool AL_Fifo_InitWithMode(AL_TFifo* pFifo, size_t zMaxElem, AL_EFifoMode eMode);
 void AL_Fifo_Deinit(AL_TFifo* pFifo);
 bool AL_Fifo_Queue(AL_TFifo* pFifo, void* pElem, uint32_t uWait);
 void* AL_Fifo_Dequeue(AL_TFifo* pFifo, uint32_t uWait);
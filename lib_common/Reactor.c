@@ -0,0 +1,433 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include "Reactor.h"
+
+#if __linux__
+
+#include <stdint.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#define AL_REACTOR_NUM_THREADS 2
+#define AL_REACTOR_STOP_TOKEN UINT64_MAX
+
+typedef struct
+{
+  int fd;
+  AL_FN_ReactorHandler pfnHandler;
+  void* pUserParam;
+  int iSlot;
+  uint32_t uGeneration; /* invalidates the events of a previous use of the slot */
+  bool bUsed;
+  bool bRunning;
+  int iWaiters; /* AL_Reactor_Unwatch waiting for the end of the handler: the slot can't be reused */
+  AL_EVENT HandlerDone;
+}AL_TReactorWatch;
+
+struct AL_t_Reactor
+{
+  int iEpollFd;
+  int iStopFd;
+  AL_THREAD Threads[AL_REACTOR_NUM_THREADS];
+  int iNumThreads;
+
+  AL_MUTEX Lock;
+  AL_TReactorWatch** ppWatches;
+  int iNumWatches;
+  int iMaxWatches;
+};
+
+/* the process wide reactor is created on first use: a spin lock needs no creation */
+static int32_t s_iReactorLock = 0;
+static AL_TReactor* s_pReactor = NULL;
+static int s_iReactorRefCount = 0;
+static __thread AL_TReactorWatch* s_pCurrentWatch = NULL;
+
+/****************************************************************************/
+static void LockProcessReactor(void)
+{
+  while(!Rtos_AtomicCompareAndSwap(&s_iReactorLock, 0, 1))
+    Rtos_Yield();
+}
+
+/****************************************************************************/
+static void UnlockProcessReactor(void)
+{
+  Rtos_AtomicStore(&s_iReactorLock, 0);
+}
+
+/****************************************************************************/
+static uint64_t GetToken(AL_TReactorWatch* pWatch)
+{
+  return ((uint64_t)pWatch->uGeneration << 32) | (uint32_t)pWatch->iSlot;
+}
+
+/****************************************************************************/
+static bool Arm(AL_TReactor* pReactor, AL_TReactorWatch* pWatch, int iOp)
+{
+  struct epoll_event tEvent = { 0 };
+  tEvent.events = EPOLLIN | EPOLLPRI | EPOLLONESHOT;
+  tEvent.data.u64 = GetToken(pWatch);
+  return epoll_ctl(pReactor->iEpollFd, iOp, pWatch->fd, &tEvent) == 0;
+}
+
+/****************************************************************************/
+/* locked */
+static AL_TReactorWatch* GetWatch(AL_TReactor* pReactor, uint64_t uToken)
+{
+  uint32_t uSlot = (uint32_t)uToken;
+  uint32_t uGeneration = (uint32_t)(uToken >> 32);
+
+  if(uSlot >= (uint32_t)pReactor->iNumWatches)
+    return NULL;
+
+  AL_TReactorWatch* pWatch = pReactor->ppWatches[uSlot];
+
+  if(!pWatch->bUsed || pWatch->uGeneration != uGeneration)
+    return NULL;
+
+  return pWatch;
+}
+
+/****************************************************************************/
+static void Dispatch(AL_TReactor* pReactor, uint64_t uToken)
+{
+  Rtos_GetMutex(pReactor->Lock);
+  AL_TReactorWatch* pWatch = GetWatch(pReactor, uToken);
+
+  if(!pWatch)
+  {
+    Rtos_ReleaseMutex(pReactor->Lock);
+    return;
+  }
+
+  pWatch->bRunning = true;
+  Rtos_ReleaseMutex(pReactor->Lock);
+
+  s_pCurrentWatch = pWatch;
+  bool bKeepWatching = pWatch->pfnHandler(pWatch->pUserParam);
+  s_pCurrentWatch = NULL;
+
+  Rtos_GetMutex(pReactor->Lock);
+  pWatch->bRunning = false;
+
+  /* the handle is disarmed after each event: arm it again for the next one */
+  if(bKeepWatching && GetWatch(pReactor, uToken) == pWatch)
+    Arm(pReactor, pWatch, EPOLL_CTL_MOD);
+
+  if(pWatch->iWaiters)
+    Rtos_SetEvent(pWatch->HandlerDone);
+
+  Rtos_ReleaseMutex(pReactor->Lock);
+}
+
+/****************************************************************************/
+static void* Reactor_ThreadEntry(void* pParam)
+{
+  AL_TReactor* pReactor = pParam;
+
+  while(true)
+  {
+    struct epoll_event tEvent;
+    int iNumEvents = epoll_wait(pReactor->iEpollFd, &tEvent, 1, -1);
+
+    if(iNumEvents < 0 && errno == EINTR)
+      continue;
+
+    if(iNumEvents < 0 || tEvent.data.u64 == AL_REACTOR_STOP_TOKEN)
+      break;
+
+    if(iNumEvents == 1)
+      Dispatch(pReactor, tEvent.data.u64);
+  }
+
+  return NULL;
+}
+
+/****************************************************************************/
+static void Reactor_Destroy(AL_TReactor* pReactor)
+{
+  /* the stop event stays signaled: every thread sees it */
+  uint64_t uStop = 1;
+
+  if(write(pReactor->iStopFd, &uStop, sizeof(uStop)) != sizeof(uStop))
+    return;
+
+  for(int i = 0; i < pReactor->iNumThreads; ++i)
+  {
+    Rtos_JoinThread(pReactor->Threads[i]);
+    Rtos_DeleteThread(pReactor->Threads[i]);
+  }
+
+  for(int i = 0; i < pReactor->iNumWatches; ++i)
+  {
+    Rtos_DeleteEvent(pReactor->ppWatches[i]->HandlerDone);
+    Rtos_Free(pReactor->ppWatches[i]);
+  }
+
+  Rtos_Free(pReactor->ppWatches);
+  close(pReactor->iStopFd);
+  close(pReactor->iEpollFd);
+  Rtos_DeleteMutex(pReactor->Lock);
+  Rtos_Free(pReactor);
+}
+
+/****************************************************************************/
+static AL_TReactor* Reactor_Create(void)
+{
+  AL_TReactor* pReactor = Rtos_Malloc(sizeof(*pReactor));
+
+  if(!pReactor)
+    return NULL;
+
+  Rtos_Memset(pReactor, 0, sizeof(*pReactor));
+  pReactor->Lock = Rtos_CreateMutex();
+  pReactor->iEpollFd = epoll_create1(EPOLL_CLOEXEC);
+  pReactor->iStopFd = eventfd(0, EFD_CLOEXEC);
+
+  struct epoll_event tStop = { 0 };
+  tStop.events = EPOLLIN;
+  tStop.data.u64 = AL_REACTOR_STOP_TOKEN;
+
+  if(!pReactor->Lock || pReactor->iEpollFd < 0 || pReactor->iStopFd < 0 || epoll_ctl(pReactor->iEpollFd, EPOLL_CTL_ADD, pReactor->iStopFd, &tStop))
+    goto fail;
+
+  for(int i = 0; i < AL_REACTOR_NUM_THREADS; ++i)
+  {
+    pReactor->Threads[i] = Rtos_CreateThread(&Reactor_ThreadEntry, pReactor);
+
+    if(!pReactor->Threads[i])
+      goto fail;
+
+    ++pReactor->iNumThreads;
+  }
+
+  return pReactor;
+
+  fail:
+
+  if(!pReactor->Lock || pReactor->iEpollFd < 0 || pReactor->iStopFd < 0)
+  {
+    if(pReactor->iEpollFd >= 0)
+      close(pReactor->iEpollFd);
+
+    if(pReactor->iStopFd >= 0)
+      close(pReactor->iStopFd);
+
+    if(pReactor->Lock)
+      Rtos_DeleteMutex(pReactor->Lock);
+    Rtos_Free(pReactor);
+    return NULL;
+  }
+
+  Reactor_Destroy(pReactor);
+  return NULL;
+}
+
+/****************************************************************************/
+AL_TReactor* AL_Reactor_Acquire(void)
+{
+  LockProcessReactor();
+
+  if(!s_pReactor)
+    s_pReactor = Reactor_Create();
+
+  if(s_pReactor)
+    ++s_iReactorRefCount;
+
+  AL_TReactor* pReactor = s_pReactor;
+  UnlockProcessReactor();
+
+  return pReactor;
+}
+
+/****************************************************************************/
+void AL_Reactor_Release(AL_TReactor* pReactor)
+{
+  if(!pReactor)
+    return;
+
+  LockProcessReactor();
+
+  if(--s_iReactorRefCount == 0)
+  {
+    Reactor_Destroy(s_pReactor);
+    s_pReactor = NULL;
+  }
+
+  UnlockProcessReactor();
+}
+
+/****************************************************************************/
+/* locked */
+static AL_TReactorWatch* GetFreeWatch(AL_TReactor* pReactor)
+{
+  /* a slot can only be reused once its last handler returned */
+  for(int i = 0; i < pReactor->iNumWatches; ++i)
+  {
+    AL_TReactorWatch* pWatch = pReactor->ppWatches[i];
+
+    if(!pWatch->bUsed && !pWatch->bRunning && !pWatch->iWaiters)
+      return pWatch;
+  }
+
+  if(pReactor->iNumWatches == pReactor->iMaxWatches)
+  {
+    int iMaxWatches = pReactor->iMaxWatches ? 2 * pReactor->iMaxWatches : 16;
+    AL_TReactorWatch** ppWatches = Rtos_Malloc(iMaxWatches * sizeof(*ppWatches));
+
+    if(!ppWatches)
+      return NULL;
+
+    if(pReactor->ppWatches)
+      Rtos_Memcpy(ppWatches, pReactor->ppWatches, pReactor->iNumWatches * sizeof(*ppWatches));
+
+    Rtos_Free(pReactor->ppWatches);
+    pReactor->ppWatches = ppWatches;
+    pReactor->iMaxWatches = iMaxWatches;
+  }
+
+  AL_TReactorWatch* pWatch = Rtos_Malloc(sizeof(*pWatch));
+
+  if(!pWatch)
+    return NULL;
+
+  Rtos_Memset(pWatch, 0, sizeof(*pWatch));
+  pWatch->HandlerDone = Rtos_CreateEvent(false);
+
+  if(!pWatch->HandlerDone)
+  {
+    Rtos_Free(pWatch);
+    return NULL;
+  }
+
+  pWatch->iSlot = pReactor->iNumWatches;
+  pReactor->ppWatches[pReactor->iNumWatches++] = pWatch;
+
+  return pWatch;
+}
+
+/****************************************************************************/
+AL_HANDLE AL_Reactor_Watch(AL_TReactor* pReactor, int fd, AL_FN_ReactorHandler pfnHandler, void* pUserParam)
+{
+  if(!pReactor || fd < 0)
+    return NULL;
+
+  Rtos_GetMutex(pReactor->Lock);
+  AL_TReactorWatch* pWatch = GetFreeWatch(pReactor);
+
+  if(pWatch)
+  {
+    pWatch->fd = fd;
+    pWatch->pfnHandler = pfnHandler;
+    pWatch->pUserParam = pUserParam;
+    pWatch->bUsed = true;
+
+    /* fails on handles whose driver doesn't implement poll */
+    if(!Arm(pReactor, pWatch, EPOLL_CTL_ADD))
+    {
+      pWatch->bUsed = false;
+      pWatch = NULL;
+    }
+  }
+
+  Rtos_ReleaseMutex(pReactor->Lock);
+  return pWatch;
+}
+
+/****************************************************************************/
+void AL_Reactor_Unwatch(AL_TReactor* pReactor, AL_HANDLE hWatch)
+{
+  AL_TReactorWatch* pWatch = hWatch;
+
+  if(!pWatch)
+    return;
+
+  Rtos_GetMutex(pReactor->Lock);
+  epoll_ctl(pReactor->iEpollFd, EPOLL_CTL_DEL, pWatch->fd, NULL);
+  pWatch->bUsed = false;
+  ++pWatch->uGeneration;
+
+  /* the slot isn't reused while we wait: the end of this handler wakes us */
+  bool bWait = pWatch->bRunning && pWatch != s_pCurrentWatch;
+
+  if(bWait)
+    ++pWatch->iWaiters;
+
+  Rtos_ReleaseMutex(pReactor->Lock);
+
+  if(!bWait)
+    return;
+
+  Rtos_WaitEvent(pWatch->HandlerDone, AL_WAIT_FOREVER);
+
+  Rtos_GetMutex(pReactor->Lock);
+  --pWatch->iWaiters;
+  Rtos_ReleaseMutex(pReactor->Lock);
+}
+
+#else
+
+/****************************************************************************/
+AL_TReactor* AL_Reactor_Acquire(void)
+{
+  return NULL;
+}
+
+/****************************************************************************/
+void AL_Reactor_Release(AL_TReactor* pReactor)
+{
+  (void)pReactor;
+}
+
+/****************************************************************************/
+AL_HANDLE AL_Reactor_Watch(AL_TReactor* pReactor, int fd, AL_FN_ReactorHandler pfnHandler, void* pUserParam)
+{
+  (void)pReactor, (void)fd, (void)pfnHandler, (void)pUserParam;
+  return NULL;
+}
+
+/****************************************************************************/
+void AL_Reactor_Unwatch(AL_TReactor* pReactor, AL_HANDLE hWatch)
+{
+  (void)pReactor, (void)hWatch;
+}
+
+#endif
@@ -0,0 +1,65 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#pragma once
+
+#include "lib_rtos/lib_rtos.h"
+
+/* Process wide completion reactor: the device handles of all the channels are
+ * watched by a few threads, and a handler is called when one of them is ready.
+ * The handler of a watch is never called concurrently with itself, so the
+ * completions of a channel are processed in order.
+ * The threads are shared by all the channels: a handler only completes the
+ * jobs of its channel and must not block, or the completions of the other
+ * channels wait behind it. The end of job callbacks of the encoder and of the
+ * decoder are called from there (see AL_CB_EndEncoding and AL_CB_Display). */
+typedef struct AL_t_Reactor AL_TReactor;
+
+/* Called when the watched handle is ready. Return false to stop watching it:
+ * the watch is then kept until AL_Reactor_Unwatch */
+typedef bool (* AL_FN_ReactorHandler)(void* pUserParam);
+
+/* Returns NULL when there is no reactor on this platform */
+AL_TReactor* AL_Reactor_Acquire(void);
+void AL_Reactor_Release(AL_TReactor* pReactor);
+
+/* Returns NULL if the handle cannot be polled: the caller must then wait for
+ * its completions in a thread of its own */
+AL_HANDLE AL_Reactor_Watch(AL_TReactor* pReactor, int fd, AL_FN_ReactorHandler pfnHandler, void* pUserParam);
+
+/* Waits for the end of the handler if it is running, unless called from the handler itself */
+void AL_Reactor_Unwatch(AL_TReactor* pReactor, AL_HANDLE hWatch);
@@ -0,0 +1,216 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include "SimDevice.h"
+
+#include <assert.h>
+
+#define AL_SIM_MAX_JOBS 64
+
+typedef struct
+{
+  AL_FN_SimJob pfnJob;
+  AL_64U uPostTime;
+  union
+  {
+    AL_64U uAlign;
+    void* pAlign;
+    uint8_t Data[AL_SIM_JOB_PAYLOAD_SIZE];
+  }Payload;
+}AL_TSimJob;
+
+struct AL_t_SimDevice
+{
+  AL_TSimDeviceSettings tSettings;
+  AL_MUTEX hLock;
+  AL_SEMAPHORE hFreeJobs;
+  AL_SEMAPHORE hPendingJobs;
+  AL_TSimJob Jobs[AL_SIM_MAX_JOBS];
+  int iHead; /* only used by the thread of the device */
+  int iTail;
+  AL_THREAD hThread;
+};
+
+/****************************************************************************/
+static AL_64U GetCompletionTime(AL_TSimDevice* pDevice, AL_TSimJob const* pJob, AL_64U uLastCompletion)
+{
+  AL_64U uTime = pJob->uPostTime + pDevice->tSettings.uLatency;
+
+  if(pDevice->tSettings.uJobsPerSecond)
+  {
+    AL_64U uEarliest = uLastCompletion + 1000000 / pDevice->tSettings.uJobsPerSecond;
+
+    if(uTime < uEarliest)
+      uTime = uEarliest;
+  }
+
+  return uTime;
+}
+
+/****************************************************************************/
+static void* SimDevice_Run(void* p)
+{
+  AL_TSimDevice* pDevice = (AL_TSimDevice*)p;
+  AL_64U uLastCompletion = 0;
+
+  while(true)
+  {
+    Rtos_GetSemaphore(pDevice->hPendingJobs, AL_WAIT_FOREVER);
+
+    AL_TSimJob* pJob = &pDevice->Jobs[pDevice->iHead];
+
+    if(!pJob->pfnJob)
+      break;
+
+    AL_64U uCompletion = GetCompletionTime(pDevice, pJob, uLastCompletion);
+    AL_64U uNow = Rtos_GetTimeUs();
+
+    if(uNow < uCompletion)
+      Rtos_SleepUs((uint32_t)(uCompletion - uNow));
+
+    uLastCompletion = uNow < uCompletion ? uCompletion : uNow;
+    pJob->pfnJob(pJob->Payload.Data);
+
+    pDevice->iHead = (pDevice->iHead + 1) % AL_SIM_MAX_JOBS;
+    Rtos_ReleaseSemaphore(pDevice->hFreeJobs);
+  }
+
+  return NULL;
+}
+
+/****************************************************************************/
+static void SpendMessageCost(AL_TSimDevice* pDevice)
+{
+  if(!pDevice->tSettings.uMessageCost)
+    return;
+
+  /* busy: the cost of a system call is paid by the calling thread */
+  AL_64U uEnd = Rtos_GetTimeUs() + pDevice->tSettings.uMessageCost;
+
+  while(Rtos_GetTimeUs() < uEnd)
+    ;
+}
+
+/****************************************************************************/
+static void PushJob(AL_TSimDevice* pDevice, AL_FN_SimJob pfnJob, void const* pPayload, size_t zSize)
+{
+  Rtos_GetSemaphore(pDevice->hFreeJobs, AL_WAIT_FOREVER);
+
+  Rtos_GetMutex(pDevice->hLock);
+  AL_TSimJob* pJob = &pDevice->Jobs[pDevice->iTail];
+  pJob->pfnJob = pfnJob;
+  pJob->uPostTime = Rtos_GetTimeUs();
+
+  if(zSize)
+    Rtos_Memcpy(pJob->Payload.Data, pPayload, zSize);
+  pDevice->iTail = (pDevice->iTail + 1) % AL_SIM_MAX_JOBS;
+  Rtos_ReleaseMutex(pDevice->hLock);
+
+  Rtos_ReleaseSemaphore(pDevice->hPendingJobs);
+}
+
+/****************************************************************************/
+AL_TSimDevice* AL_SimDevice_Create(AL_TSimDeviceSettings const* pSettings)
+{
+  AL_TSimDevice* pDevice = (AL_TSimDevice*)Rtos_Malloc(sizeof(*pDevice));
+
+  if(!pDevice)
+    return NULL;
+
+  Rtos_Memset(pDevice, 0, sizeof(*pDevice));
+  pDevice->tSettings = *pSettings;
+  pDevice->hLock = Rtos_CreateMutex();
+  pDevice->hFreeJobs = Rtos_CreateSemaphore(AL_SIM_MAX_JOBS);
+  pDevice->hPendingJobs = Rtos_CreateSemaphore(0);
+
+  if(!pDevice->hLock || !pDevice->hFreeJobs || !pDevice->hPendingJobs)
+    goto fail;
+
+  pDevice->hThread = Rtos_CreateThread(&SimDevice_Run, pDevice);
+
+  if(!pDevice->hThread)
+    goto fail;
+
+  return pDevice;
+
+  fail:
+
+  if(pDevice->hPendingJobs)
+    Rtos_DeleteSemaphore(pDevice->hPendingJobs);
+
+  if(pDevice->hFreeJobs)
+    Rtos_DeleteSemaphore(pDevice->hFreeJobs);
+
+  if(pDevice->hLock)
+    Rtos_DeleteMutex(pDevice->hLock);
+  Rtos_Free(pDevice);
+  return NULL;
+}
+
+/****************************************************************************/
+void AL_SimDevice_Destroy(AL_TSimDevice* pDevice)
+{
+  /* the jobs are completed in order: the thread stops after the pending ones */
+  PushJob(pDevice, NULL, NULL, 0);
+  Rtos_JoinThread(pDevice->hThread);
+  Rtos_DeleteThread(pDevice->hThread);
+
+  Rtos_DeleteSemaphore(pDevice->hPendingJobs);
+  Rtos_DeleteSemaphore(pDevice->hFreeJobs);
+  Rtos_DeleteMutex(pDevice->hLock);
+  Rtos_Free(pDevice);
+}
+
+/****************************************************************************/
+bool AL_SimDevice_Post(AL_TSimDevice* pDevice, AL_FN_SimJob pfnJob, void const* pPayload, size_t zSize)
+{
+  assert(pfnJob);
+
+  if(zSize > AL_SIM_JOB_PAYLOAD_SIZE)
+    return false;
+
+  SpendMessageCost(pDevice);
+  PushJob(pDevice, pfnJob, pPayload, zSize);
+  return true;
+}
+
+/****************************************************************************/
+void AL_SimDevice_Send(AL_TSimDevice* pDevice)
+{
+  SpendMessageCost(pDevice);
+}
+
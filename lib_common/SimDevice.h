@@ -0,0 +1,71 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#pragma once
+
+#include "lib_rtos/lib_rtos.h"
+
+/* Stand-in for the MCU when there is no hardware: the jobs posted to a device
+ * are completed in order by a thread of its own, once an artificial latency
+ * has elapsed and no faster than the configured throughput. It makes the
+ * host-side cost of a frame or of a channel measurable without the device. */
+typedef struct AL_t_SimDeviceSettings
+{
+  uint32_t uLatency; /* time between the posting of a job and its completion, in microseconds */
+  uint32_t uJobsPerSecond; /* number of jobs completed per second, 0 for no limit */
+  uint32_t uMessageCost; /* host time spent sending each message, like the system call of the driver, in microseconds */
+}AL_TSimDeviceSettings;
+
+typedef struct AL_t_SimDevice AL_TSimDevice;
+
+/* Called by the thread of the device when the job completes. pPayload is the
+ * copy of the payload given to AL_SimDevice_Post. A job must not post to its own
+ * device: the device queue might be full */
+typedef void (* AL_FN_SimJob)(void* pPayload);
+
+#define AL_SIM_JOB_PAYLOAD_SIZE 128
+
+AL_TSimDevice* AL_SimDevice_Create(AL_TSimDeviceSettings const* pSettings);
+
+/* The pending jobs are completed first */
+void AL_SimDevice_Destroy(AL_TSimDevice* pDevice);
+
+/* Blocks while the queue of the device is full */
+bool AL_SimDevice_Post(AL_TSimDevice* pDevice, AL_FN_SimJob pfnJob, void const* pPayload, size_t zSize);
+
+/* Sends a message which doesn't complete any job: only its cost is spent */
+void AL_SimDevice_Send(AL_TSimDevice* pDevice);
@@ -0,0 +1,173 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include "Slab.h"
+#include "lib_common/BufferAPI.h"
+#include "lib_common/Utils.h"
+#include <assert.h>
+
+/* a block holds as many objects as fit in AL_SLAB_BLOCK_SIZE, and at least AL_SLAB_MIN_OBJ_PER_BLOCK */
+#define AL_SLAB_BLOCK_SIZE 4096
+#define AL_SLAB_MIN_OBJ_PER_BLOCK 4
+#define AL_SLAB_ALIGNMENT 16
+
+typedef struct al_t_SlabBlock
+{
+  struct al_t_SlabBlock* pNext;
+}AL_TSlabBlock;
+
+typedef struct
+{
+  int32_t iLock;
+  size_t zObjSize;
+  int iObjPerBlock;
+  void* pFreeList; /* each free object starts with a pointer to the next one */
+  AL_TSlabBlock* pBlocks;
+  int32_t iNumLive;
+  int32_t iNumPeak;
+}AL_TSlab;
+
+static AL_TSlab s_Slabs[AL_SLAB_MAX_ENUM];
+
+/****************************************************************************/
+static void Lock(AL_TSlab* pSlab)
+{
+  while(!Rtos_AtomicCompareAndSwap(&pSlab->iLock, 0, 1))
+    Rtos_Yield();
+}
+
+/****************************************************************************/
+static void Unlock(AL_TSlab* pSlab)
+{
+  Rtos_AtomicStore(&pSlab->iLock, 0);
+}
+
+/****************************************************************************/
+static size_t GetBlockHeaderSize()
+{
+  return (sizeof(AL_TSlabBlock) + AL_SLAB_ALIGNMENT - 1) & ~(size_t)(AL_SLAB_ALIGNMENT - 1);
+}
+
+/****************************************************************************/
+static bool AddBlock(AL_TSlab* pSlab)
+{
+  size_t zHeaderSize = GetBlockHeaderSize();
+  AL_TSlabBlock* pBlock = Rtos_Malloc(zHeaderSize + pSlab->iObjPerBlock * pSlab->zObjSize);
+
+  if(!pBlock)
+    return false;
+
+  pBlock->pNext = pSlab->pBlocks;
+  pSlab->pBlocks = pBlock;
+
+  uint8_t* pObj = (uint8_t*)pBlock + zHeaderSize;
+
+  for(int i = 0; i < pSlab->iObjPerBlock; ++i, pObj += pSlab->zObjSize)
+  {
+    *(void**)pObj = pSlab->pFreeList;
+    pSlab->pFreeList = pObj;
+  }
+
+  return true;
+}
+
+/****************************************************************************/
+void* AL_Slab_Alloc(AL_ESlabType eType, size_t zSize)
+{
+  AL_TSlab* pSlab = &s_Slabs[eType];
+  size_t zObjSize = (zSize + AL_SLAB_ALIGNMENT - 1) & ~(size_t)(AL_SLAB_ALIGNMENT - 1);
+
+  Lock(pSlab);
+
+  if(!pSlab->zObjSize)
+  {
+    pSlab->zObjSize = zObjSize;
+    pSlab->iObjPerBlock = Max(AL_SLAB_BLOCK_SIZE / zObjSize, AL_SLAB_MIN_OBJ_PER_BLOCK);
+  }
+  assert(pSlab->zObjSize == zObjSize);
+
+  if(!pSlab->pFreeList && !AddBlock(pSlab))
+  {
+    Unlock(pSlab);
+    return NULL;
+  }
+
+  void* pObj = pSlab->pFreeList;
+  pSlab->pFreeList = *(void**)pObj;
+
+  if(++pSlab->iNumLive > pSlab->iNumPeak)
+    pSlab->iNumPeak = pSlab->iNumLive;
+
+  Unlock(pSlab);
+  return pObj;
+}
+
+/****************************************************************************/
+void AL_Slab_Free(AL_ESlabType eType, void* pObj)
+{
+  AL_TSlab* pSlab = &s_Slabs[eType];
+
+  if(!pObj)
+    return;
+
+  Lock(pSlab);
+  *(void**)pObj = pSlab->pFreeList;
+  pSlab->pFreeList = pObj;
+  --pSlab->iNumLive;
+  Unlock(pSlab);
+}
+
+/****************************************************************************/
+static void GetCounters(AL_ESlabType eType, AL_TObjectCounter* pCounter)
+{
+  AL_TSlab* pSlab = &s_Slabs[eType];
+
+  Lock(pSlab);
+  pCounter->iNumLive = pSlab->iNumLive;
+  pCounter->iNumPeak = pSlab->iNumPeak;
+  Unlock(pSlab);
+}
+
+/****************************************************************************/
+void AL_Buffer_GetObjectCounters(AL_TBufferObjectCounters* pCounters)
+{
+  GetCounters(AL_SLAB_BUFFER, &pCounters->tBuffers);
+  GetCounters(AL_SLAB_SRC_META, &pCounters->tSrcMetaData);
+  GetCounters(AL_SLAB_CIRC_META, &pCounters->tCircMetaData);
+  GetCounters(AL_SLAB_STREAM_META, &pCounters->tStreamMetaData);
+}
+
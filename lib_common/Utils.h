@@ -100,6 +100,12 @@ static AL_INLINE int RoundUp(int iVal, int iRnd)
   return (iVal + iRnd - 1) & (~(iRnd - 1));
 }
 
+/***************************************************************************/
+static AL_INLINE bool HasZeroByte(uint64_t uWord)
+{
+  return ((uWord - 0x0101010101010101ULL) & ~uWord & 0x8080808080808080ULL) != 0;
+}
+
 AL_INLINE static AL_ECodec AL_GetCodec(AL_EProfile eProf)
 {
 
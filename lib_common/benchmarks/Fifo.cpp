@@ -0,0 +1,108 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+extern "C"
+{
+#include "lib_common/Fifo.h"
+}
+
+using namespace std;
+
+static int const NUM_ELEMS = 64 * 1024;
+static int const FIFO_SIZE = 16;
+
+/* moves NUM_ELEMS elements from range(0) producers to range(1) consumers,
+ * all of them blocking on the fifo as the buffer pools do */
+template<AL_EFifoMode eMode>
+static void BM_Fifo(benchmark::State& state)
+{
+  int const iNumProducers = state.range(0);
+  int const iNumConsumers = state.range(1);
+  AL_TFifo fifo;
+
+  if(!AL_Fifo_InitWithMode(&fifo, FIFO_SIZE, eMode))
+  {
+    state.SkipWithError("cannot create the fifo");
+    return;
+  }
+
+  for(auto _ : state)
+  {
+    atomic<int> iNumToDequeue { NUM_ELEMS };
+    vector<thread> threads;
+
+    for(int p = 0; p < iNumProducers; ++p)
+    {
+      threads.emplace_back([&, p]()
+      {
+        for(int i = p; i < NUM_ELEMS; i += iNumProducers)
+          AL_Fifo_Queue(&fifo, (void*)(uintptr_t)(i + 1), AL_WAIT_FOREVER);
+      });
+    }
+
+    for(int c = 0; c < iNumConsumers; ++c)
+    {
+      threads.emplace_back([&]()
+      {
+        while(iNumToDequeue.fetch_sub(1) > 0)
+          AL_Fifo_Dequeue(&fifo, AL_WAIT_FOREVER);
+      });
+    }
+
+    for(auto& t : threads)
+      t.join();
+  }
+
+  AL_Fifo_Deinit(&fifo);
+  state.SetItemsProcessed(int64_t(state.iterations()) * NUM_ELEMS);
+}
+
+/* 1:1, N:1 and N:N producers and consumers */
+static void Threads(benchmark::internal::Benchmark* pBench)
+{
+  pBench->Args({ 1, 1 })->Args({ 4, 1 })->Args({ 4, 4 });
+}
+
+BENCHMARK_TEMPLATE(BM_Fifo, AL_FIFO_LOCKED)->Apply(Threads)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Fifo, AL_FIFO_SPSC)->Args({ 1, 1 })->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Fifo, AL_FIFO_MPMC)->Apply(Threads)->UseRealTime();
@@ -15,6 +15,9 @@ LIB_COMMON_SRC:=\
 	lib_common/BufferStreamMeta.c\
 	lib_common/BufferAccess.c\
 	lib_common/Fifo.c\
+	lib_common/Slab.c\
+	lib_common/Reactor.c\
+	lib_common/SimDevice.c\
 	lib_common/AvcLevelsLimit.c\
 	lib_common/StreamBuffer.c\
 	lib_common/FourCC.c\
@@ -25,3 +28,4 @@ LIB_COMMON_MCU_SRC:=\
 UNITTEST+=$(shell find lib_common/unittests -name "*.cpp")
 UNITTEST+=$(LIB_COMMON_SRC)
 
+BENCHMARK+=$(shell find lib_common/benchmarks -name "*.cpp")
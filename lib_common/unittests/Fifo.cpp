@@ -0,0 +1,306 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+extern "C"
+{
+#include "lib_common/Fifo.h"
+}
+
+using namespace std;
+
+static AL_EFifoMode const MODES[] = { AL_FIFO_LOCKED, AL_FIFO_SPSC, AL_FIFO_MPMC };
+static AL_EFifoMode const LOCKLESS_MODES[] = { AL_FIFO_SPSC, AL_FIFO_MPMC };
+
+struct Fifo
+{
+  AL_TFifo fifo;
+
+  Fifo(size_t zMaxElem, AL_EFifoMode eMode)
+  {
+    EXPECT_TRUE(AL_Fifo_InitWithMode(&fifo, zMaxElem, eMode));
+  }
+
+  ~Fifo()
+  {
+    AL_Fifo_Deinit(&fifo);
+  }
+};
+
+/* the fifo elements are never null */
+static void* ToElem(uintptr_t uValue)
+{
+  return (void*)(uValue + 1);
+}
+
+static uintptr_t ToValue(void* pElem)
+{
+  return (uintptr_t)pElem - 1;
+}
+
+/* waits for the lockless counter to reach iValue */
+static void WaitCounter(int32_t* pCounter, int32_t iValue)
+{
+  for(int i = 0; i < 5000 && Rtos_AtomicLoad(pCounter) != iValue; ++i)
+    Rtos_SleepUs(1000);
+
+  ASSERT_EQ(iValue, Rtos_AtomicLoad(pCounter));
+}
+
+TEST(Fifo, KeepsTheQueueOrder)
+{
+  for(auto eMode : MODES)
+  {
+    SCOPED_TRACE(eMode);
+    Fifo f(5, eMode);
+    uintptr_t uNext = 0;
+    uintptr_t uExpected = 0;
+
+    for(int iLap = 0; iLap < 4; ++iLap)
+    {
+      for(int i = 0; i < 5; ++i)
+        EXPECT_TRUE(AL_Fifo_Queue(&f.fifo, ToElem(uNext++), AL_NO_WAIT));
+
+      EXPECT_FALSE(AL_Fifo_Queue(&f.fifo, ToElem(uNext), AL_NO_WAIT));
+      EXPECT_FALSE(AL_Fifo_Empty(&f.fifo));
+
+      for(int i = 0; i < 5; ++i)
+        EXPECT_EQ(uExpected++, ToValue(AL_Fifo_Dequeue(&f.fifo, AL_NO_WAIT)));
+
+      EXPECT_EQ(nullptr, AL_Fifo_Dequeue(&f.fifo, AL_NO_WAIT));
+      EXPECT_TRUE(AL_Fifo_Empty(&f.fifo));
+    }
+  }
+}
+
+TEST(Fifo, TimesOutWhenEmptyOrFull)
+{
+  for(auto eMode : MODES)
+  {
+    SCOPED_TRACE(eMode);
+    Fifo f(3, eMode);
+
+    AL_64U uStart = Rtos_GetTime();
+    EXPECT_EQ(nullptr, AL_Fifo_Dequeue(&f.fifo, 20));
+    EXPECT_LE(15u, Rtos_GetTime() - uStart);
+
+    for(uintptr_t u = 0; u < 3; ++u)
+      EXPECT_TRUE(AL_Fifo_Queue(&f.fifo, ToElem(u), AL_NO_WAIT));
+
+    uStart = Rtos_GetTime();
+    EXPECT_FALSE(AL_Fifo_Queue(&f.fifo, ToElem(3), 20));
+    EXPECT_LE(15u, Rtos_GetTime() - uStart);
+
+    /* the timed out waits gave their place back */
+    if(eMode != AL_FIFO_LOCKED)
+    {
+      EXPECT_EQ(3, Rtos_AtomicLoad(&f.fifo.iNumElems));
+      EXPECT_EQ(0, Rtos_AtomicLoad(&f.fifo.iNumSpaces));
+    }
+
+    for(uintptr_t u = 0; u < 3; ++u)
+      EXPECT_EQ(u, ToValue(AL_Fifo_Dequeue(&f.fifo, 20)));
+
+    EXPECT_EQ(nullptr, AL_Fifo_Dequeue(&f.fifo, AL_NO_WAIT));
+    EXPECT_TRUE(AL_Fifo_Queue(&f.fifo, ToElem(4), 20));
+    EXPECT_EQ(4u, ToValue(AL_Fifo_Dequeue(&f.fifo, 20)));
+  }
+}
+
+/* a sleeping consumer is counted as a negative number of elements, the
+ * queue that brings the counter back to zero wakes it */
+TEST(Fifo, ParkedConsumersAreWokenByTheProducers)
+{
+  for(auto eMode : LOCKLESS_MODES)
+  {
+    SCOPED_TRACE(eMode);
+    int const iNumConsumers = eMode == AL_FIFO_SPSC ? 1 : 4;
+    Fifo f(2, eMode);
+    vector<atomic<int>> received(iNumConsumers);
+    vector<thread> consumers;
+
+    for(int i = 0; i < iNumConsumers; ++i)
+      consumers.emplace_back([&]() { ++received[ToValue(AL_Fifo_Dequeue(&f.fifo, AL_WAIT_FOREVER))]; });
+
+    WaitCounter(&f.fifo.iNumElems, -iNumConsumers);
+
+    for(int i = 0; i < iNumConsumers; ++i)
+      EXPECT_TRUE(AL_Fifo_Queue(&f.fifo, ToElem(i), AL_WAIT_FOREVER));
+
+    for(auto& consumer : consumers)
+      consumer.join();
+
+    for(auto& iReceived : received)
+      EXPECT_EQ(1, iReceived);
+
+    EXPECT_EQ(0, Rtos_AtomicLoad(&f.fifo.iNumElems));
+    EXPECT_EQ(2, Rtos_AtomicLoad(&f.fifo.iNumSpaces));
+  }
+}
+
+TEST(Fifo, ParkedProducersAreWokenByTheConsumers)
+{
+  for(auto eMode : LOCKLESS_MODES)
+  {
+    SCOPED_TRACE(eMode);
+    int const iNumProducers = eMode == AL_FIFO_SPSC ? 1 : 4;
+    Fifo f(2, eMode);
+
+    EXPECT_TRUE(AL_Fifo_Queue(&f.fifo, ToElem(100), AL_NO_WAIT));
+    EXPECT_TRUE(AL_Fifo_Queue(&f.fifo, ToElem(101), AL_NO_WAIT));
+
+    vector<thread> producers;
+
+    for(int i = 0; i < iNumProducers; ++i)
+      producers.emplace_back([&f, i]() { EXPECT_TRUE(AL_Fifo_Queue(&f.fifo, ToElem(i), AL_WAIT_FOREVER)); });
+
+    WaitCounter(&f.fifo.iNumSpaces, -iNumProducers);
+
+    vector<int> received(iNumProducers);
+    EXPECT_EQ(100u, ToValue(AL_Fifo_Dequeue(&f.fifo, AL_WAIT_FOREVER)));
+    EXPECT_EQ(101u, ToValue(AL_Fifo_Dequeue(&f.fifo, AL_WAIT_FOREVER)));
+
+    for(int i = 0; i < iNumProducers; ++i)
+      ++received[ToValue(AL_Fifo_Dequeue(&f.fifo, AL_WAIT_FOREVER))];
+
+    for(auto& producer : producers)
+      producer.join();
+
+    for(auto iReceived : received)
+      EXPECT_EQ(1, iReceived);
+
+    EXPECT_EQ(0, Rtos_AtomicLoad(&f.fifo.iNumElems));
+    EXPECT_EQ(2, Rtos_AtomicLoad(&f.fifo.iNumSpaces));
+  }
+}
+
+/* the producers and the consumers wait with short timeouts, so that the
+ * timeouts race with the releases. Each element must be received once, and
+ * a consumer must see the elements of a producer in their queue order */
+static void StressFifo(AL_EFifoMode eMode, int iNumProducers, int iNumConsumers, int iNumPerProducer)
+{
+  SCOPED_TRACE(eMode);
+  Fifo f(4, eMode);
+  int const iTotal = iNumProducers * iNumPerProducer;
+  vector<atomic<int>> received(iTotal);
+  atomic<int> iNumReceived { 0 };
+  atomic<bool> bOrdered { true };
+
+  for(auto& iReceived : received)
+    iReceived = 0;
+
+  vector<thread> threads;
+
+  for(int p = 0; p < iNumProducers; ++p)
+  {
+    threads.emplace_back([&, p]()
+    {
+      for(int i = 0; i < iNumPerProducer; ++i)
+      {
+        while(!AL_Fifo_Queue(&f.fifo, ToElem(p * iNumPerProducer + i), 1))
+          ;
+      }
+    });
+  }
+
+  for(int c = 0; c < iNumConsumers; ++c)
+  {
+    threads.emplace_back([&]()
+    {
+      vector<int> last(iNumProducers, -1);
+
+      while(iNumReceived < iTotal)
+      {
+        void* pElem = AL_Fifo_Dequeue(&f.fifo, 1);
+
+        if(!pElem)
+          continue;
+
+        int const iValue = ToValue(pElem);
+        int const p = iValue / iNumPerProducer;
+
+        if(iValue % iNumPerProducer <= last[p])
+          bOrdered = false;
+
+        last[p] = iValue % iNumPerProducer;
+        ++received[iValue];
+        ++iNumReceived;
+      }
+    });
+  }
+
+  for(auto& t : threads)
+    t.join();
+
+  EXPECT_TRUE(bOrdered);
+
+  int iNumWrong = 0;
+
+  for(auto& iReceived : received)
+    iNumWrong += iReceived != 1;
+
+  EXPECT_EQ(0, iNumWrong);
+  EXPECT_TRUE(AL_Fifo_Empty(&f.fifo));
+
+  if(eMode != AL_FIFO_LOCKED)
+  {
+    EXPECT_EQ(0, Rtos_AtomicLoad(&f.fifo.iNumElems));
+    EXPECT_EQ(4, Rtos_AtomicLoad(&f.fifo.iNumSpaces));
+  }
+}
+
+TEST(Fifo, SpscTransfersEachElementOnce)
+{
+  StressFifo(AL_FIFO_SPSC, 1, 1, 20000);
+}
+
+TEST(Fifo, MpmcTransfersEachElementOnce)
+{
+  StressFifo(AL_FIFO_MPMC, 4, 4, 5000);
+  StressFifo(AL_FIFO_MPMC, 4, 1, 5000);
+  StressFifo(AL_FIFO_MPMC, 1, 4, 20000);
+}
+
+TEST(Fifo, LockedTransfersEachElementOnce)
+{
+  StressFifo(AL_FIFO_LOCKED, 4, 4, 5000);
+}
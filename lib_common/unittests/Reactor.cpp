@@ -0,0 +1,187 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+extern "C"
+{
+#include "lib_common/Reactor.h"
+}
+
+using namespace std;
+
+struct Handle
+{
+  int fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  atomic<int> iCalls { 0 };
+  atomic<bool> bInHandler { false };
+  atomic<bool> bRelease { true };
+  bool bKeepWatching = true;
+
+  ~Handle() { close(fd); }
+
+  void Signal()
+  {
+    uint64_t uOne = 1;
+    ASSERT_EQ((ssize_t)sizeof(uOne), write(fd, &uOne, sizeof(uOne)));
+  }
+
+  void WaitCalls(int iNum)
+  {
+    for(int i = 0; i < 5000 && iCalls < iNum; ++i)
+      Rtos_SleepUs(1000);
+
+    ASSERT_EQ(iNum, iCalls);
+  }
+};
+
+static bool OnReady(void* pUserParam)
+{
+  Handle* pHandle = (Handle*)pUserParam;
+  uint64_t uCount;
+
+  if(read(pHandle->fd, &uCount, sizeof(uCount)) != sizeof(uCount))
+    return true;
+
+  pHandle->bInHandler = true;
+
+  while(!pHandle->bRelease)
+    Rtos_SleepUs(100);
+
+  pHandle->bInHandler = false;
+  ++pHandle->iCalls;
+  return pHandle->bKeepWatching;
+}
+
+TEST(Reactor, HandlerIsCalledForEachEvent)
+{
+  AL_TReactor* pReactor = AL_Reactor_Acquire();
+  ASSERT_NE(nullptr, pReactor);
+
+  Handle handle;
+  AL_HANDLE hWatch = AL_Reactor_Watch(pReactor, handle.fd, &OnReady, &handle);
+  ASSERT_NE(nullptr, hWatch);
+
+  for(int i = 1; i <= 3; ++i)
+  {
+    handle.Signal();
+    handle.WaitCalls(i);
+  }
+
+  AL_Reactor_Unwatch(pReactor, hWatch);
+  AL_Reactor_Release(pReactor);
+}
+
+TEST(Reactor, UnwatchWaitsForTheRunningHandler)
+{
+  AL_TReactor* pReactor = AL_Reactor_Acquire();
+  Handle handle;
+  handle.bRelease = false;
+  AL_HANDLE hWatch = AL_Reactor_Watch(pReactor, handle.fd, &OnReady, &handle);
+  ASSERT_NE(nullptr, hWatch);
+
+  handle.Signal();
+
+  while(!handle.bInHandler)
+    Rtos_SleepUs(100);
+
+  atomic<bool> bUnwatched { false };
+  thread unwatcher([&]() { AL_Reactor_Unwatch(pReactor, hWatch); bUnwatched = true; });
+
+  Rtos_SleepUs(20000);
+  EXPECT_FALSE(bUnwatched);
+
+  handle.bRelease = true;
+  unwatcher.join();
+  EXPECT_EQ(1, handle.iCalls);
+
+  /* the slot is reused by the next watch and the old events don't reach it */
+  Handle other;
+  AL_HANDLE hOther = AL_Reactor_Watch(pReactor, other.fd, &OnReady, &other);
+  ASSERT_NE(nullptr, hOther);
+  other.Signal();
+  other.WaitCalls(1);
+  EXPECT_EQ(1, handle.iCalls);
+
+  AL_Reactor_Unwatch(pReactor, hOther);
+  AL_Reactor_Release(pReactor);
+}
+
+TEST(Reactor, HandlerStopsWatching)
+{
+  AL_TReactor* pReactor = AL_Reactor_Acquire();
+  Handle handle;
+  handle.bKeepWatching = false;
+  AL_HANDLE hWatch = AL_Reactor_Watch(pReactor, handle.fd, &OnReady, &handle);
+
+  handle.Signal();
+  handle.WaitCalls(1);
+  handle.Signal();
+  Rtos_SleepUs(20000);
+  EXPECT_EQ(1, handle.iCalls);
+
+  AL_Reactor_Unwatch(pReactor, hWatch);
+  AL_Reactor_Release(pReactor);
+}
+
+TEST(Reactor, ManyWatches)
+{
+  AL_TReactor* pReactor = AL_Reactor_Acquire();
+  vector<Handle> handles(40);
+  vector<AL_HANDLE> watches;
+
+  for(auto& handle : handles)
+    watches.push_back(AL_Reactor_Watch(pReactor, handle.fd, &OnReady, &handle));
+
+  for(auto& handle : handles)
+    handle.Signal();
+
+  for(auto& handle : handles)
+    handle.WaitCalls(1);
+
+  for(auto hWatch : watches)
+    AL_Reactor_Unwatch(pReactor, hWatch);
+
+  AL_Reactor_Release(pReactor);
+}
+
@@ -47,10 +47,13 @@
 #include "lib_common/Utils.h"
 #include "lib_common_dec/DecBuffers.h"
 #include "RbspParser.h"
+#include "StartCodeScan.h"
 
 #define odd(a) ((a) & 1)
 #define even(a) (!odd(a))
 
+/* fallback of count_leading_zeros for the compilers without builtin */
+#if !defined(__GNUC__)
 static const int tab_log2[256] =
 {
   0, 0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
@@ -91,6 +94,7 @@ static uint32_t al_log2(uint32_t value)
 
   return n;
 }
+#endif
 
 /*****************************************************************************/
 static void remove_trailing_bits(AL_TRbspParser* pRP)
@@ -120,44 +124,46 @@ static bool fetch_data(AL_TRbspParser* pRP)
   uint8_t* pBuf = pRP->m_pBufIn;
   uint8_t* pBufOut = &pRP->m_pBuffer[byte_offset];
 
-  uint32_t uOffset = pRP->m_uBufInOffset;
-  uint32_t uEnd = uOffset + ANTI_EMUL_GRANULARITY;
-
-  if(uEnd > uOffset + NON_VCL_NAL_SIZE)
-    uEnd = uOffset + NON_VCL_NAL_SIZE;
+  uint32_t uZeroBytesCount = pRP->m_uZeroBytesCount;
+  uint32_t uToRead = UnsignedMin(ANTI_EMUL_GRANULARITY, NON_VCL_NAL_SIZE);
 
   // Replaces in m_pBuffer all sequences such as 0x00 0x00 0x03 0xZZ with 0x00 0x00 0xZZ (0x03 removal)
   // iff 0xZZ == 0x00 or 0x01 or 0x02 or 0x03.
-  for(uint32_t uRead = uOffset; uRead < uEnd; ++uRead)
+  // The circular buffer is read by linear spans, up to its end then from its start.
+  while(uToRead > 0 && pRP->m_uNumScDetect < 2)
   {
-    pRP->m_uBufInOffset = (pRP->m_uBufInOffset + 1) % pRP->m_uBufInSize;
+    uint32_t uOffset = pRP->m_uBufInOffset;
+    uint32_t uSpan = UnsignedMin(uToRead, pRP->m_uBufInSize - uOffset);
+    uint8_t const* pSpan = &pBuf[uOffset];
 
-    const uint8_t read = pBuf[uRead % pRP->m_uBufInSize];
+    uint32_t uRead = AL_FindStartCodeOrAntiEmul(pSpan, uSpan, &uZeroBytesCount);
+    memcpy(&pBufOut[uWrite], pSpan, uRead);
+    uWrite += uRead;
 
-    if((pRP->m_uZeroBytesCount == 2) && (read == 0x03))
+    if(uRead < uSpan)
     {
-      pRP->m_uZeroBytesCount = 0;
-      continue;
-    }
+      const uint8_t read = pSpan[uRead++];
 
-    if((pRP->m_uZeroBytesCount >= 2) && (read == 0x01))
-    {
-      ++pRP->m_uNumScDetect;
+      bool bAntiEmul = (uZeroBytesCount == 2) && (read == 0x03);
+      bool bNextNal = !bAntiEmul && (read == 0x01) && (++pRP->m_uNumScDetect == 2);
 
-      if(pRP->m_uNumScDetect == 2)
-        break;
-    }
+      if(!bNextNal)
+      {
+        if(!bAntiEmul)
+          pBufOut[uWrite++] = read;
 
-    pRP->m_iTrailingBitOneIndex += 8;
-    pRP->m_iTrailingBitOneIndexConceal += 8;
-    pBufOut[uWrite++] = read;
+        uZeroBytesCount = 0;
+      }
+    }
 
-    if(read == 0x00)
-      ++pRP->m_uZeroBytesCount;
-    else
-      pRP->m_uZeroBytesCount = 0;
+    pRP->m_uBufInOffset = (uOffset + uRead) % pRP->m_uBufInSize;
+    uToRead -= uRead;
   }
 
+  pRP->m_uZeroBytesCount = (uint8_t)UnsignedMin(uZeroBytesCount, 0xFF);
+  pRP->m_iTrailingBitOneIndex += 8 * uWrite;
+  pRP->m_iTrailingBitOneIndexConceal += 8 * uWrite;
+
   if(pRP->m_uNumScDetect == 2)
     remove_trailing_bits(pRP);
   return true;
@@ -301,20 +307,61 @@ uint8_t get_next_bit(AL_TRbspParser* pRP)
 }
 
 /*****************************************************************************/
-uint32_t get_cache_24(AL_TRbspParser* pRP)
+static int count_leading_zeros(uint64_t uValue)
 {
-  if((pRP->m_iTrailingBitOneIndex - pRP->m_iTotalBitIndex) < 32)
+#if defined(__GNUC__)
+  return uValue ? __builtin_clzll(uValue) : 64;
+#else
+  uint32_t uHigh = (uint32_t)(uValue >> 32);
+  uint32_t uLow = (uint32_t)uValue;
+
+  if(uHigh)
+    return 31 - al_log2(uHigh);
+
+  return uLow ? 63 - al_log2(uLow) : 64;
+#endif
+}
+
+/*************************************************************************//*!
+   \brief Returns the next 64 bits of the rbsp, msb first, without consuming them.
+   Bits past the fetched data read as zero.
+*****************************************************************************/
+static uint64_t get_cache_64(AL_TRbspParser* pRP)
+{
+  if((pRP->m_iTrailingBitOneIndex - pRP->m_iTotalBitIndex) < 64)
     fetch_data(pRP);
 
   int bit_offset = (int)(pRP->m_iTotalBitIndex & 0x7);
-  int byte_offset = (int)(pRP->m_iTotalBitIndex >> 3);
+  uint32_t byte_offset = pRP->m_iTotalBitIndex >> 3;
+  uint32_t uNumBytes = pRP->m_iTrailingBitOneIndexConceal >> 3;
+  uint8_t const* pBuf = &pRP->m_pBuffer[byte_offset];
+
+  uint64_t cache = 0;
+  uint8_t next = 0;
 
-  uint32_t b0 = ((uint32_t)pRP->m_pBuffer[byte_offset + 0]) << 24;
-  uint32_t b1 = pRP->m_pBuffer[byte_offset + 1] << 16;
-  uint32_t b2 = pRP->m_pBuffer[byte_offset + 2] << 8;
-  uint32_t b3 = pRP->m_pBuffer[byte_offset + 3] << 0;
-  uint32_t aligned = b0 | b1 | b2 | b3;
-  return (aligned >> (8 - bit_offset)) & 0x00FFFFFF;
+  if(byte_offset + 9 <= uNumBytes)
+  {
+    for(int k = 0; k < 8; ++k)
+      cache = (cache << 8) | pBuf[k];
+
+    next = pBuf[8];
+  }
+  else
+  {
+    for(uint32_t k = 0; k < 8; ++k)
+      cache = (cache << 8) | ((byte_offset + k < uNumBytes) ? pBuf[k] : 0);
+  }
+
+  if(bit_offset)
+    cache = (cache << bit_offset) | (next >> (8 - bit_offset));
+
+  return cache;
+}
+
+/*****************************************************************************/
+uint32_t get_cache_24(AL_TRbspParser* pRP)
+{
+  return (uint32_t)(get_cache_64(pRP) >> 40);
 }
 
 /*****************************************************************************/
@@ -349,20 +396,18 @@ uint32_t u(AL_TRbspParser* pRP, uint8_t iNumBits)
   {
     return get_next_bit(pRP);
   }
-  else if(iNumBits <= 24)
+  else if(iNumBits <= 32)
   {
-    uint32_t c = get_cache_24(pRP);
-    uint32_t mask = ((1 << iNumBits) - 1);
-    uint32_t val2 = (c >> (24 - iNumBits)) & mask;
+    uint32_t val = (uint32_t)(get_cache_64(pRP) >> (64 - iNumBits));
     skip(pRP, iNumBits);
-    return val2;
+    return val;
   }
   else
   {
-    uint32_t val = get_cache_24(pRP);
-    skip(pRP, 24);
+    uint32_t val = (uint32_t)(get_cache_64(pRP) >> 32);
+    skip(pRP, 32);
 
-    for(int i = 0; i < iNumBits - 24; ++i)
+    for(int i = 0; i < iNumBits - 32; ++i)
     {
       val <<= 1;
       val |= get_next_bit(pRP);
@@ -396,30 +441,30 @@ uint32_t ue(AL_TRbspParser* pRP)
     return 0;
   else
   {
-    uint32_t c = get_cache_24(pRP);
-    int n = 23 - al_log2(c);
+    uint64_t c = get_cache_64(pRP);
+    int n = count_leading_zeros(c);
 
-    // if the code is too long, fallback to classic decoding
-    if(n == 23)
+    // the whole code word (2n + 1 bits) is in the cache
+    if(n < 32)
     {
-      // See section 9.1
-      n = 0;
-
-      for(;;)
-      {
-        uint8_t bit = get_next_bit(pRP);
+      skip(pRP, 2 * n + 1);
+      return (uint32_t)((c >> (63 - 2 * n)) - 1);
+    }
 
-        if(bit == 1)
-          break;
-        else if(bit == 255)
-          return 0;
+    // if the code is too long, fallback to classic decoding
+    // See section 9.1
+    n = 0;
 
-        ++n;
-      }
-    }
-    else
+    for(;;)
     {
-      skip(pRP, n + 1);
+      uint8_t bit = get_next_bit(pRP);
+
+      if(bit == 1)
+        break;
+      else if(bit == 255)
+        return 0;
+
+      ++n;
     }
 
     if(n)
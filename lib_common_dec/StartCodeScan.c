@@ -0,0 +1,188 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+/****************************************************************************
+   -----------------------------------------------------------------------------
+ **************************************************************************//*!
+   \addtogroup lib_base
+   @{
+   \file
+ *****************************************************************************/
+#include <string.h>
+#include <assert.h>
+#include "StartCodeScan.h"
+#include "lib_common/Utils.h"
+
+typedef uint64_t TScanWord;
+
+#define SCAN_WORD_SIZE ((uint32_t)sizeof(TScanWord))
+
+/*****************************************************************************/
+static uint32_t SkipNonZeroWords(uint8_t const* pBuf, uint32_t uLength)
+{
+  uint32_t uRead = 0;
+
+  while(uRead + SCAN_WORD_SIZE <= uLength)
+  {
+    TScanWord uWord;
+    memcpy(&uWord, pBuf + uRead, SCAN_WORD_SIZE);
+
+    if(HasZeroByte(uWord))
+      break;
+
+    uRead += SCAN_WORD_SIZE;
+  }
+
+  return uRead;
+}
+
+/*****************************************************************************/
+uint32_t AL_FindStartCodeOrAntiEmul(uint8_t const* pBuf, uint32_t uLength, uint32_t* pZeroBytes)
+{
+  uint32_t uZeroBytes = *pZeroBytes;
+  uint32_t uRead = 0;
+
+  while(uRead < uLength)
+  {
+    /* a pattern needs two zero bytes: jump over the words without any */
+    if(uZeroBytes == 0)
+      uRead += SkipNonZeroWords(pBuf + uRead, uLength - uRead);
+
+    if(uRead >= uLength)
+      break;
+
+    uint8_t const uByte = pBuf[uRead];
+
+    if(uByte == 0x00)
+      ++uZeroBytes;
+    else
+    {
+      if(uZeroBytes >= 2 && (uByte == 0x01 || uByte == 0x03))
+      {
+        *pZeroBytes = uZeroBytes;
+        return uRead;
+      }
+
+      uZeroBytes = 0;
+    }
+
+    ++uRead;
+  }
+
+  *pZeroBytes = uZeroBytes;
+  return uLength;
+}
+
+/*****************************************************************************/
+static void FillNalInfo(AL_TScTable* pSC, bool bAVC, uint8_t const* pBuf, uint32_t uSize, uint32_t uHdrPos)
+{
+  uint8_t const uByte0 = pBuf[uHdrPos % uSize];
+
+  if(bAVC)
+  {
+    pSC->uNUT = uByte0 & 0x1F;
+    pSC->TemporalID = 0;
+  }
+  else
+  {
+    uint8_t const uByte1 = pBuf[(uHdrPos + 1) % uSize];
+    pSC->uNUT = (uByte0 >> 1) & 0x3F;
+    pSC->TemporalID = (uByte1 & 0x07) - 1;
+  }
+  pSC->Reserved = 0;
+}
+
+/*****************************************************************************/
+void AL_DetectStartCodes(AL_TScParam const* pScP, TCircBuffer const* pStream, AL_TScTable* pTable, AL_TScStatus* pStatus)
+{
+  assert(pScP->StopCondIdc == 0);
+
+  bool const bAVC = pScP->AVC != 0;
+  uint32_t const uNalHdrSize = bAVC ? 1 : 2;
+  uint32_t const uMaxSC = pScP->MaxSize; /* in 8 bytes units, i.e. in table entries */
+  uint8_t const* pBuf = pStream->tMD.pVirtualAddr;
+  uint32_t const uSize = pStream->tMD.uSize;
+  uint32_t const uOffset = pStream->uOffset;
+
+  pStatus->uNumSC = 0;
+  pStatus->uNumBytes = 0;
+
+  /* the nal header must follow the start code in the parsed bytes */
+  if((uint32_t)pStream->uAvailSize <= uNalHdrSize)
+    return;
+
+  uint32_t const uScanSize = pStream->uAvailSize - uNalHdrSize;
+  uint32_t uZeroBytes = 0;
+  uint32_t uRead = 0;
+
+  while(uRead < uScanSize)
+  {
+    /* scan linear spans of the circular buffer */
+    uint32_t const uPos = (uOffset + uRead) % uSize;
+    uint32_t const uSpan = UnsignedMin(uScanSize - uRead, uSize - uPos);
+    uint32_t const uFound = AL_FindStartCodeOrAntiEmul(pBuf + uPos, uSpan, &uZeroBytes);
+
+    uRead += uFound;
+
+    if(uFound == uSpan)
+      continue;
+
+    if(pBuf[uPos + uFound] == 0x01)
+    {
+      uint32_t const uStartCode = uRead - 2;
+
+      if(pStatus->uNumSC >= uMaxSC)
+      {
+        pStatus->uNumBytes = uStartCode;
+        return;
+      }
+
+      AL_TScTable* pSC = &pTable[pStatus->uNumSC++];
+      pSC->uPosition = (uOffset + uStartCode) % uSize;
+      FillNalInfo(pSC, bAVC, pBuf, uSize, uOffset + uRead + 1);
+    }
+
+    uZeroBytes = 0;
+    ++uRead;
+  }
+
+  /* keep the trailing zero bytes: they may be the beginning of a start code */
+  pStatus->uNumBytes = uScanSize - UnsignedMin(uZeroBytes, 2);
+}
+
+/*@}*/
+
@@ -0,0 +1,80 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+/****************************************************************************
+   -----------------------------------------------------------------------------
+ **************************************************************************//*!
+   \addtogroup lib_base
+   @{
+   \file
+ *****************************************************************************/
+#pragma once
+
+#include "lib_rtos/types.h"
+#include "lib_common/BufCommon.h"
+#include "StartCodeParam.h"
+
+/*************************************************************************//*!
+   \brief Looks in a linear span of the stream for the next start code
+   (0x00 0x00 0x01) or emulation prevention byte (0x00 0x00 0x03).
+   Runs of non-zero bytes are skipped a machine word at a time.
+   \param[in]     pBuf        Pointer to the first byte of the span
+   \param[in]     uLength     Number of bytes of the span
+   \param[in,out] pZeroBytes  Number of consecutive zero bytes before pBuf.
+                              On return, number of consecutive zero bytes
+                              before the returned position.
+   \return the index of the 0x01 or 0x03 byte that follows at least two zero
+   bytes, uLength if there is none in the span. Note that a 0x03 byte following
+   more than two zero bytes is not an emulation prevention byte
+*****************************************************************************/
+uint32_t AL_FindStartCodeOrAntiEmul(uint8_t const* pBuf, uint32_t uLength, uint32_t* pZeroBytes);
+
+/*************************************************************************//*!
+   \brief Software implementation of the start code detector. Fills the same
+   table as the IP from the available part of the circular stream buffer.
+   Only the "no stop condition" mode (StopCondIdc = 0) is supported.
+   \param[in]  pScP     Start code detector parameters
+   \param[in]  pStream  Circular stream buffer. Its virtual address is used
+   \param[out] pTable   Start code table, room for ScP.MaxSize entries
+   \param[out] pStatus  Number of start codes found and number of bytes of the
+                        stream that were parsed. The bytes of a start code that
+                        could be incomplete are not parsed.
+*****************************************************************************/
+void AL_DetectStartCodes(AL_TScParam const* pScP, TCircBuffer const* pStream, AL_TScTable* pTable, AL_TScStatus* pStatus);
+
+/*@}*/
+
@@ -0,0 +1,180 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+extern "C"
+{
+#include "lib_common_dec/RbspParser.h"
+}
+
+using namespace std;
+
+static int const NUM_VALUES = 16 * 1024;
+
+struct BitWriter
+{
+  vector<uint8_t> bytes;
+  int iBits = 0;
+
+  void Put(uint32_t uValue, int iNumBits)
+  {
+    for(int k = iNumBits - 1; k >= 0; --k)
+    {
+      if(iBits % 8 == 0)
+        bytes.push_back(0);
+
+      bytes.back() |= ((uValue >> k) & 1) << (7 - iBits % 8);
+      ++iBits;
+    }
+  }
+
+  void PutUE(uint32_t uValue)
+  {
+    int iLen = 0;
+
+    while((uValue + 1) >> (iLen + 1))
+      ++iLen;
+
+    Put(0, iLen);
+    Put(uValue + 1, iLen + 1);
+  }
+};
+
+/* a nal of exp-golomb codes, mostly short like the slice header and
+ * parameter set fields, with the emulation prevention bytes inserted */
+struct Nal
+{
+  vector<uint32_t> values;
+  vector<uint8_t> stream;
+
+  Nal()
+  {
+    mt19937 gen(5);
+    BitWriter rbsp;
+
+    for(int k = 0; k < NUM_VALUES; ++k)
+    {
+      uint32_t uValue = gen() >> (8 + gen() % 24);
+      values.push_back(uValue);
+      rbsp.PutUE(uValue);
+    }
+
+    rbsp.Put(1, 1);
+    rbsp.Put(0, (8 - rbsp.iBits % 8) % 8);
+
+    stream = { 0x00, 0x00, 0x01 };
+    int iZeros = 0;
+
+    for(uint8_t uByte : rbsp.bytes)
+    {
+      if(iZeros == 2 && uByte <= 0x03)
+      {
+        stream.push_back(0x03);
+        iZeros = 0;
+      }
+      stream.push_back(uByte);
+      iZeros = uByte ? 0 : iZeros + 1;
+    }
+
+    vector<uint8_t> const next = { 0x00, 0x00, 0x01, 0x09, 0x10 };
+    stream.insert(stream.end(), next.begin(), next.end());
+  }
+};
+
+static Nal const& GetNal()
+{
+  static Nal const nal;
+  return nal;
+}
+
+/* reads one bit at a time, as the parser did before the bit cache */
+static uint32_t ReadUEByBit(AL_TRbspParser* pRP)
+{
+  int n = 0;
+
+  while(get_next_bit(pRP) == 0)
+    ++n;
+
+  uint32_t uValue = 1;
+
+  for(int k = 0; k < n; ++k)
+    uValue = (uValue << 1) | get_next_bit(pRP);
+
+  return uValue - 1;
+}
+
+template<uint32_t(*ReadUE)(AL_TRbspParser*)>
+static void BM_ReadExpGolomb(benchmark::State& state)
+{
+  auto const& nal = GetNal();
+  vector<uint8_t> stream = nal.stream;
+  vector<uint8_t> rbsp(2 * stream.size() + 64);
+
+  TCircBuffer tStream {};
+  tStream.tMD.pVirtualAddr = stream.data();
+  tStream.tMD.uSize = stream.size();
+  tStream.uAvailSize = stream.size();
+
+  for(auto _ : state)
+  {
+    AL_TRbspParser rp;
+    InitRbspParser(&tStream, rbsp.data(), &rp);
+    skip(&rp, 24);
+
+    for(int k = 0; k < NUM_VALUES; ++k)
+    {
+      uint32_t uValue = ReadUE(&rp);
+
+      if(uValue != nal.values[k])
+      {
+        state.SkipWithError("wrong exp-golomb value");
+        break;
+      }
+    }
+  }
+
+  state.SetBytesProcessed(int64_t(state.iterations()) * stream.size());
+  state.SetItemsProcessed(int64_t(state.iterations()) * NUM_VALUES);
+}
+
+BENCHMARK_TEMPLATE(BM_ReadExpGolomb, ReadUEByBit);
+BENCHMARK_TEMPLATE(BM_ReadExpGolomb, ue);
+
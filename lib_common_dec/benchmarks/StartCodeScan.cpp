@@ -0,0 +1,144 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+extern "C"
+{
+#include "lib_common_dec/StartCodeScan.h"
+}
+
+using namespace std;
+
+/* byte by byte scan with a modulo per byte, as the parsers did before the word scan */
+static uint32_t CountMatchesByByte(vector<uint8_t> const& stream, uint32_t uOffset)
+{
+  uint32_t const uSize = stream.size();
+  uint32_t uZeroBytes = 0;
+  uint32_t uMatches = 0;
+
+  for(uint32_t uRead = uOffset; uRead < uOffset + uSize; ++uRead)
+  {
+    uint8_t const uByte = stream[uRead % uSize];
+
+    if(uZeroBytes >= 2 && (uByte == 0x01 || uByte == 0x03))
+      ++uMatches;
+
+    uZeroBytes = (uByte == 0x00) ? uZeroBytes + 1 : 0;
+  }
+
+  return uMatches;
+}
+
+/* the same walk as two linear spans of the circular buffer */
+static uint32_t CountMatchesByWord(vector<uint8_t> const& stream, uint32_t uOffset)
+{
+  uint32_t const uSize = stream.size();
+  uint32_t uZeroBytes = 0;
+  uint32_t uMatches = 0;
+  uint32_t uRead = 0;
+
+  while(uRead < uSize)
+  {
+    uint32_t const uPos = (uOffset + uRead) % uSize;
+    uint32_t const uSpan = min(uSize - uRead, uSize - uPos);
+    uint32_t const uFound = AL_FindStartCodeOrAntiEmul(stream.data() + uPos, uSpan, &uZeroBytes);
+
+    uRead += uFound;
+
+    if(uFound == uSpan)
+      continue;
+
+    ++uMatches;
+    uZeroBytes = 0;
+    ++uRead;
+  }
+
+  return uMatches;
+}
+
+/* random payload with a zero byte every iZeroPeriod bytes on average and a
+ * start code every 64 kB, so both the word skip and the byte path are used */
+static vector<uint8_t> const& Stream(int iZeroPeriod)
+{
+  static vector<uint8_t> stream;
+  static int iCurPeriod = -1;
+
+  if(iCurPeriod == iZeroPeriod)
+    return stream;
+
+  mt19937 gen(iZeroPeriod);
+  uniform_int_distribution<int> byteDist(1, 255);
+  uniform_int_distribution<int> zeroDist(0, iZeroPeriod - 1);
+  stream.resize(8 * 1024 * 1024);
+
+  for(size_t i = 0; i < stream.size(); ++i)
+    stream[i] = zeroDist(gen) ? byteDist(gen) : 0x00;
+
+  for(size_t i = 0; i + 4 < stream.size(); i += 64 * 1024)
+  {
+    stream[i] = stream[i + 1] = 0x00;
+    stream[i + 2] = 0x01;
+  }
+
+  iCurPeriod = iZeroPeriod;
+  return stream;
+}
+
+template<uint32_t(*CountMatches)(vector<uint8_t> const &, uint32_t)>
+static void BM_ScanStartCodes(benchmark::State& state)
+{
+  auto const& stream = Stream(state.range(0));
+  /* start past the middle: the scan wraps around the end of the buffer */
+  uint32_t const uOffset = stream.size() / 2 + 13;
+
+  if(CountMatches(stream, uOffset) != CountMatchesByByte(stream, uOffset))
+    state.SkipWithError("word scan differs from the byte scan");
+
+  for(auto _ : state)
+    benchmark::DoNotOptimize(CountMatches(stream, uOffset));
+
+  state.SetBytesProcessed(int64_t(state.iterations()) * stream.size());
+}
+
+/* 256: typical coded slice data, 4: zero heavy content */
+BENCHMARK_TEMPLATE(BM_ScanStartCodes, CountMatchesByByte)->Arg(256)->Arg(4);
+BENCHMARK_TEMPLATE(BM_ScanStartCodes, CountMatchesByWord)->Arg(256)->Arg(4);
+
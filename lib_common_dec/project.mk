@@ -6,6 +6,7 @@ LIB_COMMON_DEC_SRC:=\
 	lib_common_dec/DecHwScalingList.c\
 	lib_common_dec/DecInfo.c\
 	lib_common_dec/RbspParser.c\
+	lib_common_dec/StartCodeScan.c\
 
 LIB_COMMON_DEC_MCU_SRC:=\
 	$(LIB_COMMON_DEC_BASE_SRC)
@@ -13,3 +14,5 @@ LIB_COMMON_DEC_MCU_SRC:=\
 UNITTEST+=$(shell find lib_common_dec/unittests -name "*.cpp")
 UNITTEST+=$(LIB_COMMON_DEC_SRC)
 
+BENCHMARK+=$(shell find lib_common_dec/benchmarks -name "*.cpp")
+
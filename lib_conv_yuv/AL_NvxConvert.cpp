@@ -48,6 +48,7 @@ extern "C"
 }
 
 #include "lib_app/convert.h"
+#include "lib_app/convert_planner.h"
 
 using namespace std;
 
@@ -73,6 +74,20 @@ static string FourCCToString(TFourCC tFourCC)
   return ss.str();
 };
 
+static void convertWithPlanner(AL_TBuffer const* pSrcIn, TFourCC inFourCC, TFourCC outFourCC, AL_TBuffer* pSrcOut)
+{
+  auto Convert = GetConversion(inFourCC, outFourCC);
+
+  if(!Convert)
+  {
+    cout << "No conversion known from " << FourCCToString(inFourCC) << endl;
+    assert(0);
+    return;
+  }
+
+  Convert(pSrcIn, pSrcOut);
+}
+
 static void convertToY010(AL_TBuffer const* pSrcIn, TFourCC inFourCC, AL_TBuffer* pSrcOut)
 {
   switch(inFourCC)
@@ -93,8 +108,8 @@ static void convertToY010(AL_TBuffer const* pSrcIn, TFourCC inFourCC, AL_TBuffer
     break;
 
   default:
-    cout << "No conversion known from " << FourCCToString(inFourCC) << endl;
-    assert(0);
+    convertWithPlanner(pSrcIn, inFourCC, FOURCC(Y010), pSrcOut);
+    break;
   }
 }
 
@@ -110,8 +125,8 @@ static void convertToY800(AL_TBuffer const* pSrcIn, TFourCC inFourCC, AL_TBuffer
     I420_To_Y800(pSrcIn, pSrcOut);
     break;
   default:
-    cout << "No conversion known from " << FourCCToString(inFourCC) << endl;
-    assert(0);
+    convertWithPlanner(pSrcIn, inFourCC, FOURCC(Y800), pSrcOut);
+    break;
   }
 }
 
@@ -141,8 +156,8 @@ static void convertToNV12(AL_TBuffer const* pSrcIn, TFourCC inFourCC, AL_TBuffer
     I0AL_To_NV12(pSrcIn, pSrcOut);
     break;
   default:
-    cout << "No conversion known from " << FourCCToString(inFourCC) << endl;
-    assert(0);
+    convertWithPlanner(pSrcIn, inFourCC, FOURCC(NV12), pSrcOut);
+    break;
   }
 }
 
@@ -163,8 +178,8 @@ static void convertToNV16(AL_TBuffer const* pSrcIn, TFourCC inFourCC, AL_TBuffer
     I2AL_To_NV16(pSrcIn, pSrcOut);
     break;
   default:
-    cout << "No conversion known from " << FourCCToString(inFourCC) << endl;
-    assert(0);
+    convertWithPlanner(pSrcIn, inFourCC, FOURCC(NV16), pSrcOut);
+    break;
   }
 }
 
@@ -194,8 +209,8 @@ static void convertToRx0A(AL_TBuffer const* pSrcIn, TFourCC inFourCC, AL_TBuffer
     I0AL_To_RX0A(pSrcIn, pSrcOut);
     break;
   default:
-    cout << "No conversion known from " << FourCCToString(inFourCC) << endl;
-    assert(0);
+    convertWithPlanner(pSrcIn, inFourCC, FOURCC(RX0A), pSrcOut);
+    break;
   }
 }
 
@@ -216,8 +231,8 @@ static void convertToRx2A(AL_TBuffer const* pSrcIn, TFourCC inFourCC, AL_TBuffer
     I2AL_To_RX2A(pSrcIn, pSrcOut);
     break;
   default:
-    cout << "No conversion known from " << FourCCToString(inFourCC) << endl;
-    assert(0);
+    convertWithPlanner(pSrcIn, inFourCC, FOURCC(RX2A), pSrcOut);
+    break;
   }
 }
 
@@ -242,8 +257,8 @@ static void convertToRxmA(AL_TBuffer const* pSrcIn, TFourCC inFourCC, AL_TBuffer
     break;
 
   default:
-    cout << "No conversion known from " << FourCCToString(inFourCC) << endl;
-    assert(0);
+    convertWithPlanner(pSrcIn, inFourCC, FOURCC(RXmA), pSrcOut);
+    break;
   }
 }
 
@@ -273,8 +288,8 @@ static void convertToP010(AL_TBuffer const* pSrcIn, TFourCC inFourCC, AL_TBuffer
     I0AL_To_P010(pSrcIn, pSrcOut);
     break;
   default:
-    cout << "No conversion known from " << FourCCToString(inFourCC) << endl;
-    assert(0);
+    convertWithPlanner(pSrcIn, inFourCC, FOURCC(P010), pSrcOut);
+    break;
   }
 }
 
@@ -298,8 +313,8 @@ static void convertToP210(AL_TBuffer const* pSrcIn, TFourCC inFourCC, AL_TBuffer
     NV16_To_P210(pSrcIn, pSrcOut);
     break;
   default:
-    cout << "No conversion known from " << FourCCToString(inFourCC) << endl;
-    assert(0);
+    convertWithPlanner(pSrcIn, inFourCC, FOURCC(P210), pSrcOut);
+    break;
   }
 }
 
@@ -51,6 +51,8 @@
 #include "lib_parsing/Hevc_PictMngr.h"
 #include "lib_parsing/SliceHdrParsing.h"
 
+#include "lib_perfs/StageStats.h"
+
 #include "FrameParam.h"
 #include "I_DecoderCtx.h"
 #include "DefaultDecoder.h"
@@ -470,7 +472,9 @@ static bool decodeSliceData(AL_TAup* pIAUP, AL_TDecCtx* pCtx, AL_ENut eNUT, bool
   Rtos_Memset(pSlice, 0, sizeof(AL_TAvcSliceHdr));
   AL_TConceal* pConceal = &pCtx->m_tConceal;
   AL_TAvcAup* pAUP = &pIAUP->avcAup;
+  AL_TStageClock tParse = AL_StageStats_Begin();
   bool isValid = AL_AVC_ParseSliceHeader(pSlice, &rp, pConceal, pAUP->m_pPPS);
+  AL_StageStats_End(AL_STAGE_SLICE_HEADER, tParse);
   bool bSliceBelongsToSameFrame = true;
 
   if(isValid)
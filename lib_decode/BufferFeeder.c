@@ -46,17 +46,35 @@ static void notifyDecoder(AL_TBufferFeeder* this)
 static bool enqueueBuffer(AL_TBufferFeeder* this, AL_TBuffer* pBuf, AL_EBufMode eMode)
 {
   AL_Buffer_Ref(pBuf);
+  /* accounted before queuing so that no chunk can be lent over the copy */
+  AL_Patchworker_UpdatePendingCopies(&this->patchworker, 1);
 
   if(!AL_Fifo_Queue(&this->fifo, pBuf, AL_GetWaitMode(eMode)))
   {
+    AL_Patchworker_UpdatePendingCopies(&this->patchworker, -1);
     AL_Buffer_Unref(pBuf);
     return false;
   }
   return true;
 }
 
+AL_TBuffer* AL_BufferFeeder_GetChunk(AL_TBufferFeeder* this, size_t zMaxSize)
+{
+  return AL_Patchworker_GetChunk(&this->patchworker, zMaxSize);
+}
+
 bool AL_BufferFeeder_PushBuffer(AL_TBufferFeeder* this, AL_TBuffer* pBuf, AL_EBufMode eMode, size_t uSize, bool bLastBuffer)
 {
+  /* the data is already in the circular buffer */
+  if(AL_Patchworker_IsChunk(&this->patchworker, pBuf))
+  {
+    if(!AL_Patchworker_CommitChunk(&this->patchworker, pBuf, uSize))
+      return false;
+
+    notifyDecoder(this);
+    return true;
+  }
+
   AL_TMetaData* pMetaCirc = (AL_TMetaData*)AL_CircMetaData_Create(0, uSize, bLastBuffer);
 
   if(!pMetaCirc)
@@ -64,7 +82,7 @@ bool AL_BufferFeeder_PushBuffer(AL_TBufferFeeder* this, AL_TBuffer* pBuf, AL_EBu
 
   if(!AL_Buffer_AddMetaData(pBuf, pMetaCirc))
   {
-    Rtos_Free(pMetaCirc);
+    pMetaCirc->MetaDestroy(pMetaCirc);
     return false;
   }
 
@@ -112,7 +130,7 @@ AL_TBufferFeeder* AL_BufferFeeder_Create(AL_HANDLE hDec, TCircBuffer* circularBu
 
   this->eosBuffer = NULL;
 
-  if(uMaxBufNum == 0 || !AL_Fifo_Init(&this->fifo, uMaxBufNum))
+  if(uMaxBufNum == 0 || !AL_Fifo_InitWithMode(&this->fifo, uMaxBufNum, AL_FIFO_MPMC))
     goto fail_queue_allocation;
 
   if(!AL_Patchworker_Init(&this->patchworker, circularBuf, &this->fifo))
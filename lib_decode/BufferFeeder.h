@@ -57,6 +57,8 @@ typedef struct al_t_BufferFeeder
 
 AL_TBufferFeeder* AL_BufferFeeder_Create(AL_HANDLE hDec, TCircBuffer* circularBuf, AL_UINT uMaxBufNum, AL_CB_Error* errorCallback);
 void AL_BufferFeeder_Destroy(AL_TBufferFeeder* pFeeder);
+/* get a window of the circular buffer to fill in place. Pushing it back doesn't copy it */
+AL_TBuffer* AL_BufferFeeder_GetChunk(AL_TBufferFeeder* pFeeder, size_t zMaxSize);
 /* push a buffer in the queue. it will be fed to the decoder when possible */
 bool AL_BufferFeeder_PushBuffer(AL_TBufferFeeder* pFeeder, AL_TBuffer* pBuf, AL_EBufMode eMode, size_t uSize, bool bLastBuffer);
 /* tell the buffer queue that the decoder finished decoding a frame */
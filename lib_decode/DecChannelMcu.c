@@ -36,6 +36,7 @@
 ******************************************************************************/
 
 #include "lib_decode/I_DecChannel.h"
+#include "lib_decode/DecChannelMcu.h"
 
 #if __linux__
 
@@ -53,6 +54,8 @@
 #include "allegro_ioctl_mcu_dec.h"
 #include "lib_common/List.h"
 #include "lib_common/Error.h"
+#include "lib_common/Reactor.h"
+#include "lib_perfs/Trace.h"
 #include <assert.h>
 
 #define DCACHE_OFFSET 0x80000000
@@ -110,23 +113,41 @@ typedef struct
 {
   int fd;
   AL_THREAD thread;
+  AL_TReactor* reactor;
+  AL_HANDLE hWatch; /* the status are waited for by the reactor, or by the thread if the handle can't be polled */
   bool bBeingDestroyed;
 
   AL_CB_EndFrameDecoding endFrameDecodingCB;
 }Channel;
 
+typedef struct AL_t_Event
+{
+  void* pPriv;
+  AL_ListHead List;
+}AL_Event;
+
 typedef struct
 {
   int fd;
   AL_CB_EndStartCode endStartCodeCB;
+  struct t_StartCodeEventQueue* pSCQueue;
+  AL_HANDLE hWatch;
   bool bEnded;
+  bool bPooled; /* belongs to the channel pool: kept open for the next search */
+  AL_Event Event;
 }SCMsg;
 
-typedef struct AL_t_Event
+/* Maximum number of start code searches in flight without opening a new device handle */
+#define SC_MSG_POOL_SIZE 4
+
+typedef struct
 {
-  void* pPriv;
-  AL_ListHead List;
-}AL_Event;
+  SCMsg Msgs[SC_MSG_POOL_SIZE];
+  SCMsg* pFree[SC_MSG_POOL_SIZE];
+  int iNumFree;
+  pthread_mutex_t Lock;
+  AL_TScSearchStats Stats;
+}SCMsgPool;
 
 typedef struct AL_t_EventQueue
 {
@@ -135,9 +156,16 @@ typedef struct AL_t_EventQueue
   pthread_mutex_t Lock;
 }AL_EventQueue;
 
-typedef struct
+/* Without reactor, the searches are queued to ScNotificationThread.
+ * With the reactor, the queue holds the searches in flight: only the first
+ * one is watched, so that the callbacks are called in order. */
+typedef struct t_StartCodeEventQueue
 {
   AL_EventQueue EventQueue;
+  SCMsgPool Pool;
+  SCMsg EndMsg;
+  AL_TReactor* reactor;
+  bool bUseReactor;
 }StartCodeEventQueue;
 
 struct DecChanMcuCtx
@@ -188,6 +216,100 @@ int AL_EventQueue_Fetch(AL_EventQueue* EventQueue, AL_Event** pEvent, bool (* is
   return 0;
 }
 
+/****************************************************************************/
+static void SCMsgPool_Init(SCMsgPool* pPool)
+{
+  pthread_mutex_init(&pPool->Lock, NULL);
+  memset(&pPool->Stats, 0, sizeof(pPool->Stats));
+
+  for(int i = 0; i < SC_MSG_POOL_SIZE; ++i)
+  {
+    pPool->Msgs[i].fd = -1;
+    pPool->Msgs[i].bPooled = true;
+    pPool->pFree[i] = &pPool->Msgs[i];
+  }
+
+  pPool->iNumFree = SC_MSG_POOL_SIZE;
+}
+
+/****************************************************************************/
+static void SCMsgPool_Deinit(SCMsgPool* pPool)
+{
+  for(int i = 0; i < SC_MSG_POOL_SIZE; ++i)
+  {
+    if(pPool->Msgs[i].fd >= 0)
+      close(pPool->Msgs[i].fd);
+  }
+
+  pthread_mutex_destroy(&pPool->Lock);
+}
+
+/****************************************************************************/
+static SCMsg* SCMsgPool_Get(SCMsgPool* pPool)
+{
+  SCMsg* pMsg = NULL;
+
+  pthread_mutex_lock(&pPool->Lock);
+
+  if(pPool->iNumFree > 0)
+    pMsg = pPool->pFree[--pPool->iNumFree];
+  else
+    ++pPool->Stats.iNumExhausted;
+
+  pthread_mutex_unlock(&pPool->Lock);
+
+  if(!pMsg)
+  {
+    /* more searches in flight than expected: fall back to a one shot handle */
+    pMsg = Rtos_Malloc(sizeof(*pMsg));
+
+    if(!pMsg)
+      return NULL;
+
+    pMsg->fd = -1;
+    pMsg->bPooled = false;
+  }
+
+  if(pMsg->fd < 0)
+    pMsg->fd = open(deviceFile, O_RDWR);
+
+  pMsg->bEnded = false;
+  pMsg->Event.pPriv = pMsg;
+  return pMsg;
+}
+
+/****************************************************************************/
+static void SCMsgPool_Put(SCMsgPool* pPool, SCMsg* pMsg)
+{
+  if(!pMsg->bPooled)
+  {
+    if(pMsg->fd >= 0)
+      close(pMsg->fd);
+    Rtos_Free(pMsg);
+    return;
+  }
+
+  pthread_mutex_lock(&pPool->Lock);
+  pPool->pFree[pPool->iNumFree++] = pMsg;
+  pthread_mutex_unlock(&pPool->Lock);
+}
+
+/****************************************************************************/
+static void SCMsgPool_UpdateInFlight(SCMsgPool* pPool, int iDelta)
+{
+  pthread_mutex_lock(&pPool->Lock);
+  pPool->Stats.iNumInFlight += iDelta;
+
+  if(iDelta > 0)
+  {
+    ++pPool->Stats.iNumSearches;
+
+    if(pPool->Stats.iNumInFlight > pPool->Stats.iMaxInFlight)
+      pPool->Stats.iMaxInFlight = pPool->Stats.iNumInFlight;
+  }
+  pthread_mutex_unlock(&pPool->Lock);
+}
+
 void setPictParam(struct al5_params* msg, AL_TDecPicParam* pPictParam)
 {
   static_assert(sizeof(*pPictParam) <= sizeof(msg->opaque), "Driver pict_param struct is too small");
@@ -250,7 +372,9 @@ static void processStatusMsg(Channel* chan, struct al5_params* msg)
 {
   AL_TDecPicStatus status;
   memcpy(&status, msg->opaque, msg->size);
+  AL_Trace_Begin("end_decoding");
   chan->endFrameDecodingCB.func(chan->endFrameDecodingCB.userParam, &status);
+  AL_Trace_End("end_decoding");
 }
 
 static void* NotificationThread(void* p)
@@ -270,18 +394,32 @@ static void* NotificationThread(void* p)
   return 0;
 }
 
+static bool OnStatusReady(void* p)
+{
+  Channel* chan = p;
+  struct al5_params msg = { 0 };
+
+  if(!getStatusMsg(chan, &msg))
+    return false;
+
+  processStatusMsg(chan, &msg);
+  return true;
+}
+
 static void setScStatus(AL_TScStatus* status, struct al5_scstatus* msg)
 {
   status->uNumSC = msg->num_sc;
   status->uNumBytes = msg->num_bytes;
 }
 
-static void processScStatusMsg(SCMsg* pMsg, struct al5_scstatus* StatusMsg)
+static void processScStatusMsg(AL_CB_EndStartCode endStartCodeCB, struct al5_scstatus* StatusMsg)
 {
   AL_TScStatus status;
 
   setScStatus(&status, StatusMsg);
-  pMsg->endStartCodeCB.func(pMsg->endStartCodeCB.userParam, &status);
+  AL_Trace_Begin("end_start_code");
+  endStartCodeCB.func(endStartCodeCB.userParam, &status);
+  AL_Trace_End("end_start_code");
 }
 
 /* One reader, no race condition */
@@ -291,6 +429,83 @@ bool isSCReady(void* p)
   return !AL_ListEmpty(&pCtx->List);
 }
 
+static bool OnScReady(void* p);
+
+/* locked */
+static bool WatchStartCode(StartCodeEventQueue* pSCQueue, SCMsg* pMsg)
+{
+  pMsg->hWatch = AL_Reactor_Watch(pSCQueue->reactor, pMsg->fd, &OnScReady, pMsg);
+  return pMsg->hWatch != NULL;
+}
+
+static bool OnScReady(void* p)
+{
+  SCMsg* pMsg = p;
+  StartCodeEventQueue* pSCQueue = pMsg->pSCQueue;
+  AL_EventQueue* pEventQueue = &pSCQueue->EventQueue;
+  struct al5_scstatus StatusMsg = { 0 };
+
+  if(getScStatusMsg(pMsg, &StatusMsg))
+    processScStatusMsg(pMsg->endStartCodeCB, &StatusMsg);
+
+  /* the search leaves the queue after its callback:
+   * a search posted by the callback is watched here, after this one */
+  pthread_mutex_lock(&pEventQueue->Lock);
+  AL_HANDLE hWatch = pMsg->hWatch;
+  AL_ListDel(&pMsg->Event.List);
+  SCMsg* pNext = NULL;
+  bool bNextWatched = true;
+
+  if(!AL_ListEmpty(&pEventQueue->List))
+  {
+    AL_Event* pNextEvent = AL_ListFirstEntry(&pEventQueue->List, AL_Event, List);
+    pNext = pNextEvent->pPriv;
+    bNextWatched = WatchStartCode(pSCQueue, pNext);
+  }
+  pthread_mutex_unlock(&pEventQueue->Lock);
+
+  AL_Reactor_Unwatch(pSCQueue->reactor, hWatch);
+  SCMsgPool_UpdateInFlight(&pSCQueue->Pool, -1);
+  SCMsgPool_Put(&pSCQueue->Pool, pMsg);
+  AL_WakeUp(&pEventQueue->Queue);
+
+  /* couldn't watch the next search: wait for it here */
+  if(!bNextWatched)
+    OnScReady(pNext);
+
+  return false;
+}
+
+static bool isSCQueueEmpty(void* p)
+{
+  AL_EventQueue* pEventQueue = p;
+  pthread_mutex_lock(&pEventQueue->Lock);
+  bool bEmpty = AL_ListEmpty(&pEventQueue->List);
+  pthread_mutex_unlock(&pEventQueue->Lock);
+  return bEmpty;
+}
+
+static bool IgnoreEvent(void* p)
+{
+  (void)p;
+  return false;
+}
+
+/* The driver may not implement poll: check it once on a handle of our own */
+static bool CanWatchDevice(AL_TReactor* reactor)
+{
+  int fd = open(deviceFile, O_RDWR);
+
+  if(fd < 0)
+    return false;
+
+  AL_HANDLE hWatch = AL_Reactor_Watch(reactor, fd, &IgnoreEvent, NULL);
+  AL_Reactor_Unwatch(reactor, hWatch);
+  close(fd);
+
+  return hWatch != NULL;
+}
+
 static void* ScNotificationThread(void* p)
 {
   StartCodeEventQueue* pSCQueue = p;
@@ -302,19 +517,19 @@ static void* ScNotificationThread(void* p)
     AL_Event* pEvent;
     AL_EventQueue_Fetch(pEventQueue, &pEvent, isSCReady, pEventQueue);
     SCMsg* pMsg = pEvent->pPriv;
-    Rtos_Free(pEvent);
 
     if(pMsg->bEnded)
-    {
-      Rtos_Free(pMsg);
       break;
-    }
 
-    if(getScStatusMsg(pMsg, &StatusMsg))
-      processScStatusMsg(pMsg, &StatusMsg);
+    bool bStatus = getScStatusMsg(pMsg, &StatusMsg);
+    AL_CB_EndStartCode endStartCodeCB = pMsg->endStartCodeCB;
 
-    close(pMsg->fd);
-    Rtos_Free(pMsg);
+    /* give the handle back first: the callback may post the next search */
+    SCMsgPool_UpdateInFlight(&pSCQueue->Pool, -1);
+    SCMsgPool_Put(&pSCQueue->Pool, pMsg);
+
+    if(bStatus)
+      processScStatusMsg(endStartCodeCB, &StatusMsg);
   }
 
   return NULL;
@@ -338,6 +553,14 @@ static bool DecChannelMcu_Init(struct DecChanMcuCtx* decChanMcu)
   decChanMcu->chanIsConfigured = false;
 
   AL_EventQueue_Init(&SCQueue->EventQueue);
+  SCMsgPool_Init(&SCQueue->Pool);
+
+  SCQueue->reactor = AL_Reactor_Acquire();
+  SCQueue->bUseReactor = CanWatchDevice(SCQueue->reactor);
+  decChanMcu->pSCThread = NULL;
+
+  if(SCQueue->bUseReactor)
+    return true;
 
   decChanMcu->pSCThread = Rtos_CreateThread(&ScNotificationThread, SCQueue);
 
@@ -363,10 +586,14 @@ static bool DecChannelMcu_DestroyChannel(Channel* chan)
     goto exit;
   }
 
-  Rtos_JoinThread(chan->thread);
-  Rtos_DeleteThread(chan->thread);
+  if(!chan->hWatch)
+  {
+    Rtos_JoinThread(chan->thread);
+    Rtos_DeleteThread(chan->thread);
+  }
 
   exit:
+  AL_Reactor_Unwatch(chan->reactor, chan->hWatch);
   close(chan->fd);
 
   return bRet;
@@ -378,28 +605,30 @@ static void DecChannelMcu_Destroy(AL_TIDecChannel* pDecChannel)
   struct DecChanMcuCtx* decChanMcu = (struct DecChanMcuCtx*)pDecChannel;
   StartCodeEventQueue* SCQueue = &decChanMcu->SCQueue;
 
-  AL_Event* pEvent = Rtos_Malloc(sizeof(*pEvent));
-
-  if(!pEvent)
-    goto fail_event;
-  SCMsg* pMsg = Rtos_Malloc(sizeof(*pMsg));
-
-  if(!pMsg)
-    goto fail_msg;
-
-  pMsg->bEnded = true;
-  pEvent->pPriv = pMsg;
-  AL_EventQueue_Push(&SCQueue->EventQueue, pEvent);
+  if(SCQueue->bUseReactor)
+    AL_WaitEvent(&SCQueue->EventQueue.Queue, isSCQueueEmpty, &SCQueue->EventQueue);
+  else
+  {
+    SCMsg* pMsg = &SCQueue->EndMsg;
+    pMsg->bEnded = true;
+    pMsg->Event.pPriv = pMsg;
+    AL_EventQueue_Push(&SCQueue->EventQueue, &pMsg->Event);
+  }
 
   if(decChanMcu->chanIsConfigured)
     DecChannelMcu_DestroyChannel(&decChanMcu->chan);
 
-  if(!Rtos_JoinThread(decChanMcu->pSCThread))
-    goto fail_join;
+  if(decChanMcu->pSCThread)
+  {
+    if(!Rtos_JoinThread(decChanMcu->pSCThread))
+      goto fail_join;
 
-  Rtos_DeleteThread(decChanMcu->pSCThread);
+    Rtos_DeleteThread(decChanMcu->pSCThread);
+  }
 
+  SCMsgPool_Deinit(&SCQueue->Pool);
   AL_EventQueue_Deinit(&SCQueue->EventQueue);
+  AL_Reactor_Release(SCQueue->reactor);
 
   Rtos_Free(decChanMcu);
 
@@ -407,10 +636,6 @@ static void DecChannelMcu_Destroy(AL_TIDecChannel* pDecChannel)
 
   fail_join:
   AL_EventQueue_Deinit(&SCQueue->EventQueue);
-  fail_msg:
-  Rtos_Free(pEvent);
-  fail_event:
-  return;
 }
 
 /****************************************************************************/
@@ -426,6 +651,8 @@ static AL_ERR DecChannelMcu_ConfigChannel(AL_TIDecChannel* pDecChannel, AL_TDecC
   chan->endFrameDecodingCB = callback;
 
   chan->fd = open(deviceFile, O_RDWR);
+  chan->reactor = decChanMcu->SCQueue.reactor;
+  chan->hWatch = NULL;
 
   if(chan->fd < 0)
   {
@@ -448,10 +675,15 @@ static AL_ERR DecChannelMcu_ConfigChannel(AL_TIDecChannel* pDecChannel, AL_TDecC
 
   getParamUpdateByMcu(&msg.status, pChParam);
 
-  chan->thread = Rtos_CreateThread(&NotificationThread, chan);
+  chan->hWatch = AL_Reactor_Watch(chan->reactor, chan->fd, &OnStatusReady, chan);
 
-  if(!chan->thread)
-    goto fail_open;
+  if(!chan->hWatch)
+  {
+    chan->thread = Rtos_CreateThread(&NotificationThread, chan);
+
+    if(!chan->thread)
+      goto fail_open;
+  }
 
   decChanMcu->chanIsConfigured = true;
   return AL_SUCCESS;
@@ -488,26 +720,19 @@ static void DecChannelMcu_SearchSC(AL_TIDecChannel* pDecChannel, AL_TScParam* pS
 {
   struct DecChanMcuCtx* decChanMcu = (struct DecChanMcuCtx*)pDecChannel;
   struct al5_search_sc_msg search_msg = { 0 };
-  AL_EventQueue* pEventQueue = &decChanMcu->SCQueue.EventQueue;
-  AL_Event* pEvent = Rtos_Malloc(sizeof(*pEvent));
-  SCMsg* pMsg = Rtos_Malloc(sizeof(*pMsg));
-
-  if(!pEvent)
-    goto fail_event;
+  StartCodeEventQueue* SCQueue = &decChanMcu->SCQueue;
+  SCMsg* pMsg = SCMsgPool_Get(&SCQueue->Pool);
 
   if(!pMsg)
-    goto fail_msg;
+    return;
 
-  pMsg->bEnded = false;
   pMsg->endStartCodeCB = endStartCodeCB;
 
-  pMsg->fd = open(deviceFile, O_RDWR);
-
   if(pMsg->fd < 0)
   {
     perror("Cannot open device file");
     printf("%s\n", deviceFile);
-    goto fail_open;
+    goto fail;
   }
 
   setSearchStartCodeMsg(&search_msg, pScParam, pBufAddrs);
@@ -515,21 +740,33 @@ static void DecChannelMcu_SearchSC(AL_TIDecChannel* pDecChannel, AL_TScParam* pS
   if(!PostMessage(pMsg->fd, AL_MCU_SEARCH_START_CODE, &search_msg))
   {
     perror("Failed to search start code");
-    goto fail_open;
+    goto fail;
   }
 
-  pEvent->pPriv = pMsg;
-  AL_EventQueue_Push(pEventQueue, pEvent);
+  SCMsgPool_UpdateInFlight(&SCQueue->Pool, 1);
 
-  return;
+  if(!SCQueue->bUseReactor)
+  {
+    AL_EventQueue_Push(&SCQueue->EventQueue, &pMsg->Event);
+    return;
+  }
+
+  pMsg->pSCQueue = SCQueue;
+  AL_EventQueue* pEventQueue = &SCQueue->EventQueue;
+  pthread_mutex_lock(&pEventQueue->Lock);
+  bool bFirst = AL_ListEmpty(&pEventQueue->List);
+  AL_ListAddTail(&pMsg->Event.List, &pEventQueue->List);
+  bool bWatched = !bFirst || WatchStartCode(SCQueue, pMsg);
+  pthread_mutex_unlock(&pEventQueue->Lock);
+
+  /* couldn't watch the search: wait for it here */
+  if(!bWatched)
+    OnScReady(pMsg);
 
-  fail_open:
-  close(pMsg->fd);
-  Rtos_Free(pMsg);
-  fail_msg:
-  Rtos_Free(pEvent);
-  fail_event:
   return;
+
+  fail:
+  SCMsgPool_Put(&SCQueue->Pool, pMsg);
 }
 
 static void prepareDecodeMessage(struct al5_decode_msg* msg, AL_TDecPicParam* pPictParam, AL_TDecPicBufferAddrs* pPictAddrs, TMemDesc* hSliceParam)
@@ -582,8 +819,20 @@ static const AL_TIDecChannelVtable DecChannelMcu =
   DecChannelMcu_SearchSC,
   DecChannelMcu_DecodeOneFrame,
   DecChannelMcu_DecodeOneSlice,
+  NULL, /* the driver interface has no message for several slices */
 };
 
+/******************************************************************************/
+void AL_DecChannelMcu_GetScStats(AL_TIDecChannel* pDecChannel, AL_TScSearchStats* pStats)
+{
+  struct DecChanMcuCtx* decChanMcu = (struct DecChanMcuCtx*)pDecChannel;
+  SCMsgPool* pPool = &decChanMcu->SCQueue.Pool;
+
+  pthread_mutex_lock(&pPool->Lock);
+  *pStats = pPool->Stats;
+  pthread_mutex_unlock(&pPool->Lock);
+}
+
 /******************************************************************************/
 AL_TIDecChannel* AL_DecChannelMcu_Create()
 {
@@ -598,6 +847,12 @@ AL_TIDecChannel* AL_DecChannelMcu_Create()
 
 #else
 
+void AL_DecChannelMcu_GetScStats(AL_TIDecChannel* pDecChannel, AL_TScSearchStats* pStats)
+{
+  (void)pDecChannel;
+  *pStats = (AL_TScSearchStats) { 0 };
+}
+
 AL_TIDecChannel* AL_DecChannelMcu_Create()
 {
   return NULL;
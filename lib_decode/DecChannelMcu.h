@@ -0,0 +1,74 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+/****************************************************************************
+   -----------------------------------------------------------------------------
+ **************************************************************************//*!
+   \addtogroup lib_decode_hls
+   @{
+   \file
+ *****************************************************************************/
+
+#pragma once
+
+#include "lib_decode/I_DecChannel.h"
+
+/*************************************************************************//*!
+   \brief Start code searches statistics of a MCU decoder channel
+*****************************************************************************/
+typedef struct
+{
+  int iNumSearches;  /*!< Number of searches posted to the MCU */
+  int iNumInFlight;  /*!< Number of searches waiting for their status */
+  int iMaxInFlight;  /*!< Highest number of searches in flight */
+  int iNumExhausted; /*!< Number of searches that needed a device handle outside of the channel pool */
+}AL_TScSearchStats;
+
+/*************************************************************************//*!
+   \brief Creates a decoder channel driving the MCU through the device driver
+   \return the decoder channel, NULL if the MCU isn't available
+*****************************************************************************/
+AL_TIDecChannel* AL_DecChannelMcu_Create();
+
+/*************************************************************************//*!
+   \brief Retrieves the start code searches statistics of a MCU decoder channel
+   \param[in]  pDecChannel Decoder channel created by AL_DecChannelMcu_Create
+   \param[out] pStats      Statistics
+*****************************************************************************/
+void AL_DecChannelMcu_GetScStats(AL_TIDecChannel* pDecChannel, AL_TScSearchStats* pStats);
+
+/*@}*/
@@ -0,0 +1,233 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include "lib_decode/DecChannelSim.h"
+#include "lib_common/Error.h"
+#include "lib_common_dec/StartCodeScan.h"
+#include "lib_fpga/DmaAllocSim.h"
+#include "lib_perfs/Trace.h"
+#include "lib_rtos/lib_rtos.h"
+
+struct DecChanSimCtx
+{
+  AL_TIDecChannel base;
+  AL_TAllocator* pAllocator;
+  AL_TSimDevice* pDecoder;
+  AL_TSimDevice* pStartCodeDetector; /* separate block, not throttled by the decoding */
+  AL_CB_EndFrameDecoding endFrameDecodingCB;
+};
+
+typedef struct
+{
+  struct DecChanSimCtx* pChan;
+  uint8_t uFrmID;
+  uint8_t uMvID;
+}DecodeJob;
+
+typedef struct
+{
+  struct DecChanSimCtx* pChan;
+  AL_TScParam ScParam;
+  AL_TScBufferAddrs BufAddrs;
+  AL_CB_EndStartCode endStartCodeCB;
+}StartCodeJob;
+
+/****************************************************************************/
+static void DecChannelSim_Destroy(AL_TIDecChannel* pDecChannel)
+{
+  struct DecChanSimCtx* pChan = (struct DecChanSimCtx*)pDecChannel;
+
+  if(pChan->pStartCodeDetector)
+    AL_SimDevice_Destroy(pChan->pStartCodeDetector);
+
+  if(pChan->pDecoder)
+    AL_SimDevice_Destroy(pChan->pDecoder);
+  Rtos_Free(pChan);
+}
+
+/****************************************************************************/
+static AL_ERR DecChannelSim_ConfigChannel(AL_TIDecChannel* pDecChannel, AL_TDecChanParam* pChParam, AL_CB_EndFrameDecoding callback)
+{
+  struct DecChanSimCtx* pChan = (struct DecChanSimCtx*)pDecChannel;
+
+  /* the core count is chosen by the MCU */
+  if(pChParam->uNumCore == 0)
+    pChParam->uNumCore = 1;
+
+  pChan->endFrameDecodingCB = callback;
+  return AL_SUCCESS;
+}
+
+/****************************************************************************/
+static void SearchStartCodes(void* pPayload)
+{
+  StartCodeJob* pJob = (StartCodeJob*)pPayload;
+  AL_TAllocator* pAllocator = pJob->pChan->pAllocator;
+  AL_TScBufferAddrs* pBufAddrs = &pJob->BufAddrs;
+  AL_TScStatus ScStatus = { 0 };
+
+  TCircBuffer Stream;
+  Stream.tMD.pVirtualAddr = AL_SimDmaAllocator_GetVirtualAddrFromPhysical(pAllocator, pBufAddrs->pStream);
+  Stream.tMD.uPhysicalAddr = pBufAddrs->pStream;
+  Stream.tMD.uSize = pBufAddrs->uMaxSize;
+  Stream.uOffset = pBufAddrs->uOffset;
+  Stream.uAvailSize = pBufAddrs->uAvailSize;
+
+  AL_TScTable* pTable = (AL_TScTable*)AL_SimDmaAllocator_GetVirtualAddrFromPhysical(pAllocator, pBufAddrs->pBufOut);
+
+  if(Stream.tMD.pVirtualAddr && pTable)
+    AL_DetectStartCodes(&pJob->ScParam, &Stream, pTable, &ScStatus);
+
+  AL_Trace_Begin("end_start_code");
+  pJob->endStartCodeCB.func(pJob->endStartCodeCB.userParam, &ScStatus);
+  AL_Trace_End("end_start_code");
+}
+
+/****************************************************************************/
+static void DecChannelSim_SearchSC(AL_TIDecChannel* pDecChannel, AL_TScParam* pScParam, AL_TScBufferAddrs* pBufAddrs, AL_CB_EndStartCode endStartCodeCB)
+{
+  struct DecChanSimCtx* pChan = (struct DecChanSimCtx*)pDecChannel;
+  StartCodeJob Job;
+
+  Job.pChan = pChan;
+  Job.ScParam = *pScParam;
+  Job.BufAddrs = *pBufAddrs;
+  Job.endStartCodeCB = endStartCodeCB;
+
+  AL_SimDevice_Post(pChan->pStartCodeDetector, &SearchStartCodes, &Job, sizeof(Job));
+}
+
+/****************************************************************************/
+static void EndFrameDecoding(void* pPayload)
+{
+  DecodeJob* pJob = (DecodeJob*)pPayload;
+  AL_CB_EndFrameDecoding* pCB = &pJob->pChan->endFrameDecodingCB;
+  AL_TDecPicStatus PicStatus = { 0 };
+
+  PicStatus.uFrmID = pJob->uFrmID;
+  PicStatus.uMvID = pJob->uMvID;
+
+  AL_Trace_Begin("end_decoding");
+  pCB->func(pCB->userParam, &PicStatus);
+  AL_Trace_End("end_decoding");
+}
+
+/****************************************************************************/
+static void PostDecodeJob(struct DecChanSimCtx* pChan, AL_TDecPicParam const* pPictParam)
+{
+  DecodeJob Job;
+
+  Job.pChan = pChan;
+  Job.uFrmID = pPictParam->FrmID;
+  Job.uMvID = pPictParam->MvID;
+
+  AL_SimDevice_Post(pChan->pDecoder, &EndFrameDecoding, &Job, sizeof(Job));
+}
+
+/****************************************************************************/
+static void DecChannelSim_DecodeOneFrame(AL_TIDecChannel* pDecChannel, AL_TDecPicParam* pPictParam, AL_TDecPicBufferAddrs* pPictAddrs, TMemDesc* hSliceParam)
+{
+  (void)pPictAddrs;
+  (void)hSliceParam;
+  PostDecodeJob((struct DecChanSimCtx*)pDecChannel, pPictParam);
+}
+
+/****************************************************************************/
+static void DecChannelSim_DecodeOneSlice(AL_TIDecChannel* pDecChannel, AL_TDecPicParam* pPictParam, AL_TDecPicBufferAddrs* pPictAddrs, TMemDesc* hSliceParam)
+{
+  (void)pPictAddrs;
+  struct DecChanSimCtx* pChan = (struct DecChanSimCtx*)pDecChannel;
+  AL_TDecSliceParam const* pSP = (AL_TDecSliceParam const*)hSliceParam->pVirtualAddr;
+
+  /* like the MCU, a status is only sent once the last slice of the picture is decoded */
+  if(pSP->bIsLastSlice)
+    PostDecodeJob(pChan, pPictParam);
+  else
+    AL_SimDevice_Send(pChan->pDecoder);
+}
+
+/****************************************************************************/
+static void DecChannelSim_DecodeSlices(AL_TIDecChannel* pDecChannel, AL_TDecPicParam* pPictParam, AL_TDecPicBufferAddrs* pPictAddrs, TMemDesc* hSliceParams, int iNumSlices)
+{
+  (void)pPictAddrs;
+  struct DecChanSimCtx* pChan = (struct DecChanSimCtx*)pDecChannel;
+  AL_TDecSliceParam const* pSP = (AL_TDecSliceParam const*)hSliceParams->pVirtualAddr;
+
+  if(pSP[iNumSlices - 1].bIsLastSlice)
+    PostDecodeJob(pChan, pPictParam);
+  else
+    AL_SimDevice_Send(pChan->pDecoder);
+}
+
+/******************************************************************************/
+static const AL_TIDecChannelVtable DecChannelSim =
+{
+  DecChannelSim_Destroy,
+  DecChannelSim_ConfigChannel,
+  DecChannelSim_SearchSC,
+  DecChannelSim_DecodeOneFrame,
+  DecChannelSim_DecodeOneSlice,
+  DecChannelSim_DecodeSlices,
+};
+
+/******************************************************************************/
+AL_TIDecChannel* AL_DecChannelSim_Create(AL_TAllocator* pAllocator, AL_TSimDeviceSettings const* pSettings)
+{
+  struct DecChanSimCtx* pChan = (struct DecChanSimCtx*)Rtos_Malloc(sizeof(*pChan));
+
+  if(!pChan)
+    return NULL;
+
+  Rtos_Memset(pChan, 0, sizeof(*pChan));
+  pChan->base.vtable = &DecChannelSim;
+  pChan->pAllocator = pAllocator;
+
+  AL_TSimDeviceSettings ScdSettings = *pSettings;
+  ScdSettings.uJobsPerSecond = 0;
+
+  pChan->pDecoder = AL_SimDevice_Create(pSettings);
+  pChan->pStartCodeDetector = AL_SimDevice_Create(&ScdSettings);
+
+  if(!pChan->pDecoder || !pChan->pStartCodeDetector)
+  {
+    DecChannelSim_Destroy(&pChan->base);
+    return NULL;
+  }
+
+  return &pChan->base;
+}
+
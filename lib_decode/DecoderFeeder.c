@@ -76,7 +76,7 @@ static bool Slave_Process(DecoderFeederSlave* slave, TCircBuffer* decodeBuffer)
 
     uint32_t uNewOffset = AL_Decoder_GetStrOffset(hDec);
 
-    CircBuffer_ConsumeUpToOffset(slave->patchworker->outputCirc, uNewOffset);
+    AL_Patchworker_ConsumeUpToOffset(slave->patchworker, uNewOffset);
 
     decodeBuffer->uAvailSize += AL_Patchworker_Transfer(slave->patchworker);
 
@@ -99,7 +99,7 @@ static bool Slave_Process(DecoderFeederSlave* slave, TCircBuffer* decodeBuffer)
       AL_Default_Decoder_WaitFrameSent(hDec);
 
       uint32_t uNewOffset = AL_Decoder_GetStrOffset(hDec);
-      CircBuffer_ConsumeUpToOffset(slave->patchworker->outputCirc, uNewOffset);
+      AL_Patchworker_ConsumeUpToOffset(slave->patchworker, uNewOffset);
 
       if(CircBuffer_IsFull(slave->patchworker->outputCirc))
       {
@@ -50,6 +50,7 @@
 #include "DefaultDecoder.h"
 #include "I_DecoderCtx.h"
 #include "NalUnitParser.h"
+#include "SliceDataParsing.h"
 
 #include "lib_common/Error.h"
 #include "lib_common/StreamBuffer.h"
@@ -59,6 +60,9 @@
 
 #include "lib_parsing/I_PictMngr.h"
 #include "lib_decode/I_DecChannel.h"
+#include "lib_common_dec/StartCodeScan.h"
+#include "lib_perfs/StageStats.h"
+#include "lib_perfs/Trace.h"
 
 
 #define AVC_NAL_HDR_SIZE 4
@@ -207,6 +211,13 @@ void AL_Default_Decoder_EndDecoding(void* pUserParam, AL_TDecPicStatus* pStatus)
   AL_TDecCtx* pCtx = (AL_TDecCtx*)pUserParam;
   uint8_t const uFrameID = pStatus->uFrmID;
   uint8_t const uMotionVectorID = pStatus->uMvID;
+  AL_TStageClock tCallback = AL_StageStats_Begin();
+
+  AL_Trace_AsyncEnd("decode_frame", AL_TRACE_ID(pCtx, uFrameID));
+
+  /* give the IP the next frame before anything else */
+  if(pCtx->m_chanParam.eDecUnit == AL_AU_UNIT)
+    AL_LaunchReadyFrame(pCtx);
 
   AL_PictMngr_UpdateDisplayBufferCRC(&pCtx->m_PictMngr, uFrameID, pStatus->uCRC);
   AL_PictMngr_EndDecoding(&pCtx->m_PictMngr, uFrameID, uMotionVectorID);
@@ -224,6 +235,7 @@ void AL_Default_Decoder_EndDecoding(void* pUserParam, AL_TDecPicStatus* pStatus)
 
   AL_BufferFeeder_Signal(pCtx->m_Feeder);
   AL_sDecoder_CallBacks(pCtx, uFrameID);
+  AL_StageStats_End(AL_STAGE_CALLBACK, tCallback);
 
   Rtos_ReleaseSemaphore(pCtx->m_Sem);
 }
@@ -242,6 +254,16 @@ static void AL_Decoder_EndScd(void* pUserParam, AL_TScStatus* pStatus)
   Rtos_SetEvent(pCtx->m_ScDetectionComplete);
 }
 
+/*****************************************************************************/
+static void WaitStartCodeSearch(AL_TDecCtx* pCtx)
+{
+  if(!pCtx->m_bScdPending)
+    return;
+
+  Rtos_WaitEvent(pCtx->m_ScDetectionComplete, AL_WAIT_FOREVER);
+  pCtx->m_bScdPending = false;
+}
+
 /***************************************************************************/
 /*                           Lib functions                                 */
 /***************************************************************************/
@@ -329,6 +351,8 @@ void AL_Default_Decoder_Destroy(AL_TDecoder* pAbsDec)
   if(pCtx->m_Feeder)
     AL_BufferFeeder_Destroy(pCtx->m_Feeder);
 
+  WaitStartCodeSearch(pCtx);
+
   if(pCtx->m_eosBuffer)
     AL_Buffer_Unref(pCtx->m_eosBuffer);
 
@@ -345,6 +369,7 @@ void AL_Default_Decoder_Destroy(AL_TDecoder* pAbsDec)
   Rtos_DeleteSemaphore(pCtx->m_Sem);
   Rtos_DeleteEvent(pCtx->m_ScDetectionComplete);
   Rtos_DeleteMutex(pCtx->m_DecMutex);
+  Rtos_DeleteMutex(pCtx->m_SubmitMutex);
 
   Rtos_Free(pDec);
 }
@@ -389,22 +414,22 @@ static bool enoughStartCode(int iNumStartCode)
 /*****************************************************************************/
 static bool SearchNextDecodingUnit(AL_TDecCtx* pCtx, TCircBuffer* pStream, int* pLastNalInDecodingUnit, int* iLastVclNalInDecodingUnit)
 {
-  if(!enoughStartCode(pCtx->m_uNumSC))
+  if(!enoughStartCode(pCtx->m_ScRing.uNumSC))
     return false;
 
-  int const iNalCount = (int)pCtx->m_uNumSC;
+  int const iNalCount = (int)pCtx->m_ScRing.uNumSC;
   AL_ECodec const eCodec = pCtx->m_chanParam.eCodec;
   int const notFound = -1;
   int iLastVclNal = notFound;
   int iLastNonVclNal = notFound;
 
-  AL_TScTable* pTable = (AL_TScTable*)pCtx->m_SCTable.tMD.pVirtualAddr;
   uint8_t* pBuf = pStream->tMD.pVirtualAddr;
   uint32_t uSize = pStream->tMD.uSize;
 
   for(int iNal = 0; iNal < iNalCount; ++iNal)
   {
-    AL_ENut eNUT = pTable[iNal].uNUT;
+    AL_TScTable const* pSC = AL_ScRing_Get(&pCtx->m_ScRing, iNal);
+    AL_ENut eNUT = pSC->uNUT;
 
     // The NAL returned by the last start code of the SCD may not be complete
     if((iNal == iNalCount - 1) && !isAud(eCodec, eNUT))
@@ -415,7 +440,7 @@ static bool SearchNextDecodingUnit(AL_TDecCtx* pCtx, TCircBuffer* pStream, int*
     if(bIsVcl)
     {
       // Start Code
-      uint32_t uPos = pTable[iNal].uPosition;
+      uint32_t uPos = pSC->uPosition;
 
       assert(pBuf[uPos % uSize] == 0x00);
       assert(pBuf[(uPos + 1) % uSize] == 0x00);
@@ -511,51 +536,110 @@ static void GenerateIpTraces(AL_TDecCtx* pCtx, AL_TScParam ScP, AL_TScBufferAddr
 /*****************************************************************************/
 static bool canStoreMoreStartCodes(AL_TDecCtx* pCtx)
 {
-  return (pCtx->m_uNumSC + 1) * sizeof(AL_TScTable) <= pCtx->m_SCTable.tMD.uSize - pCtx->m_BufSCD.tMD.uSize;
+  /* room for the result of a whole search, and one more start code */
+  return AL_ScRing_GetFree(&pCtx->m_ScRing) > pCtx->m_BufSCD.tMD.uSize / sizeof(AL_TScTable);
 }
 
 /*****************************************************************************/
 static void ResetStartCodes(AL_TDecCtx* pCtx)
 {
-  pCtx->m_uNumSC = 0;
+  AL_ScRing_Reset(&pCtx->m_ScRing);
 }
 
 /*****************************************************************************/
-static bool RefillStartCodes(AL_TDecCtx* pCtx, TCircBuffer* pBufStream)
+static bool SoftwareRefillStartCodes(AL_TDecCtx* pCtx, TCircBuffer* pBufStream, AL_TScParam* pScP)
 {
-  AL_TScParam ScP = { 0 };
-  AL_TScBufferAddrs ScdBuffer = { 0 };
-  TMemDesc scBuffer = pCtx->m_BufSCD.tMD;
+  /* the detector writes straight after the start codes already in the table,
+   * up to the end of the ring: the next refill continues from its beginning */
+  uint32_t uNumFree;
+  AL_TScTable* pTable = AL_ScRing_GetFreeSpan(&pCtx->m_ScRing, &uNumFree);
+  pScP->MaxSize = UnsignedMin(pScP->MaxSize, uNumFree);
 
-  ScP.MaxSize = scBuffer.uSize >> 3;
-  ScP.AVC = isAVC(pCtx->m_chanParam.eCodec);
+  AL_DetectStartCodes(pScP, pBufStream, pTable, &pCtx->m_ScdStatus);
 
-  if(pBufStream->uAvailSize <= 4)
-    return false;
+  pBufStream->uOffset = (pBufStream->uOffset + pCtx->m_ScdStatus.uNumBytes) % pBufStream->tMD.uSize;
+  pBufStream->uAvailSize -= pCtx->m_ScdStatus.uNumBytes;
+  AL_ScRing_Commit(&pCtx->m_ScRing, pCtx->m_ScdStatus.uNumSC);
 
-  ScdBuffer.pBufOut = scBuffer.uPhysicalAddr;
-  ScdBuffer.pStream = pBufStream->tMD.uPhysicalAddr;
-  ScdBuffer.uMaxSize = pBufStream->tMD.uSize;
-  ScdBuffer.uOffset = pBufStream->uOffset;
-  ScdBuffer.uAvailSize = pBufStream->uAvailSize;
+  return pCtx->m_ScdStatus.uNumSC > 0;
+}
+
+/*****************************************************************************/
+static void LaunchStartCodeSearch(AL_TDecCtx* pCtx, TCircBuffer* pBufStream)
+{
+  AL_TScParam* pScP = &pCtx->m_ScdParam;
+  AL_TScBufferAddrs* pScdBuffer = &pCtx->m_ScdBufferAddrs;
+  TMemDesc scBuffer = pCtx->m_BufSCD.tMD;
+
+  Rtos_Memset(pScP, 0, sizeof(*pScP));
+  pScP->MaxSize = scBuffer.uSize >> 3;
+  pScP->AVC = isAVC(pCtx->m_chanParam.eCodec);
+
+  pScdBuffer->pBufOut = scBuffer.uPhysicalAddr;
+  pScdBuffer->pStream = pBufStream->tMD.uPhysicalAddr;
+  pScdBuffer->uMaxSize = pBufStream->tMD.uSize;
+  pScdBuffer->uOffset = pBufStream->uOffset;
+  pScdBuffer->uAvailSize = pBufStream->uAvailSize;
 
   AL_CleanupMemory(scBuffer.pVirtualAddr, scBuffer.uSize);
 
+  pCtx->m_bScdPending = true;
   AL_CB_EndStartCode callback = { AL_Decoder_EndScd, pCtx };
-  AL_IDecChannel_SearchSC(pCtx->m_pDecChannel, &ScP, &ScdBuffer, callback);
-  Rtos_WaitEvent(pCtx->m_ScDetectionComplete, AL_WAIT_FOREVER);
+  AL_IDecChannel_SearchSC(pCtx->m_pDecChannel, pScP, pScdBuffer, callback);
+}
 
-  GenerateIpTraces(pCtx, ScP, ScdBuffer, *pBufStream, scBuffer);
+/*****************************************************************************/
+static bool CollectStartCodes(AL_TDecCtx* pCtx, TCircBuffer* pBufStream)
+{
+  TMemDesc scBuffer = pCtx->m_BufSCD.tMD;
+
+  WaitStartCodeSearch(pCtx);
+
+  GenerateIpTraces(pCtx, pCtx->m_ScdParam, pCtx->m_ScdBufferAddrs, *pBufStream, scBuffer);
   pBufStream->uOffset = (pBufStream->uOffset + pCtx->m_ScdStatus.uNumBytes) % pBufStream->tMD.uSize;
   pBufStream->uAvailSize -= pCtx->m_ScdStatus.uNumBytes;
 
-  Rtos_Memcpy(pCtx->m_SCTable.tMD.pVirtualAddr + pCtx->m_uNumSC * sizeof(AL_TScTable), scBuffer.pVirtualAddr, pCtx->m_ScdStatus.uNumSC * sizeof(AL_TScTable));
-
-  pCtx->m_uNumSC += pCtx->m_ScdStatus.uNumSC;
+  AL_ScRing_Append(&pCtx->m_ScRing, (AL_TScTable*)scBuffer.pVirtualAddr, pCtx->m_ScdStatus.uNumSC);
 
   return pCtx->m_ScdStatus.uNumSC > 0;
 }
 
+/*****************************************************************************/
+static bool RefillStartCodes(AL_TDecCtx* pCtx, TCircBuffer* pBufStream)
+{
+  /* the search launched while the previous unit was decoded only covers the
+   * data available at that time: search again if it didn't find anything */
+  if(pCtx->m_bScdPending && CollectStartCodes(pCtx, pBufStream))
+    return true;
+
+  if(pBufStream->uAvailSize <= 4)
+    return false;
+
+  if(pCtx->m_eScdMode == AL_SCD_SOFTWARE)
+  {
+    AL_TScParam ScP = { 0 };
+    ScP.MaxSize = pCtx->m_BufSCD.tMD.uSize >> 3;
+    ScP.AVC = isAVC(pCtx->m_chanParam.eCodec);
+    return SoftwareRefillStartCodes(pCtx, pBufStream, &ScP);
+  }
+
+  LaunchStartCodeSearch(pCtx, pBufStream);
+  return CollectStartCodes(pCtx, pBufStream);
+}
+
+/*****************************************************************************/
+static void PrefetchStartCodes(AL_TDecCtx* pCtx, TCircBuffer* pBufStream)
+{
+  /* the software detector runs on the calling thread: nothing to overlap */
+  if(pCtx->m_eScdMode == AL_SCD_SOFTWARE || pCtx->m_bScdPending)
+    return;
+
+  if(pBufStream->uAvailSize <= 4)
+    return;
+
+  LaunchStartCodeSearch(pCtx, pBufStream);
+}
+
 /*****************************************************************************/
 static int FindNextDecodingUnit(AL_TDecCtx* pCtx, TCircBuffer* pBufStream, int* iLastVclNalInAU)
 {
@@ -570,7 +654,11 @@ static int FindNextDecodingUnit(AL_TDecCtx* pCtx, TCircBuffer* pBufStream, int*
       ResetStartCodes(pCtx);
     }
 
-    if(!RefillStartCodes(pCtx, pBufStream))
+    AL_TStageClock tScd = AL_StageStats_Begin();
+    bool bRefilled = RefillStartCodes(pCtx, pBufStream);
+    AL_StageStats_End(AL_STAGE_SCD, tScd);
+
+    if(!bRefilled)
       return 0;
   }
 
@@ -589,8 +677,6 @@ static size_t DeltaPosition(uint32_t uFirstPos, uint32_t uSecondPos, uint32_t uS
 /*****************************************************************************/
 static bool DecodeOneUnit(AL_TDecCtx* pCtx, TCircBuffer* pBufStream, int iNalCount, int iLastVclNalInAU)
 {
-  AL_TScTable* nals = (AL_TScTable*)pCtx->m_SCTable.tMD.pVirtualAddr;
-
   /* copy start code buffer stream information into decoder stream buffer */
   pCtx->m_Stream.tMD = pBufStream->tMD;
 
@@ -600,8 +686,8 @@ static bool DecodeOneUnit(AL_TDecCtx* pCtx, TCircBuffer* pBufStream, int iNalCou
   {
     bool bIsLastVclNal = (iNal == iLastVclNalInAU);
 
-    AL_TScTable CurNal = nals[iNal];
-    AL_TScTable NextNal = nals[iNal + 1];
+    AL_TScTable CurNal = *AL_ScRing_Get(&pCtx->m_ScRing, iNal);
+    AL_TScTable NextNal = *AL_ScRing_Get(&pCtx->m_ScRing, iNal + 1);
 
     pCtx->m_Stream.uOffset = CurNal.uPosition;
     pCtx->m_Stream.uAvailSize = DeltaPosition(CurNal.uPosition, NextNal.uPosition, pBufStream->tMD.uSize);
@@ -618,8 +704,7 @@ static bool DecodeOneUnit(AL_TDecCtx* pCtx, TCircBuffer* pBufStream, int iNalCou
     }
   }
 
-  pCtx->m_uNumSC -= iNalCount;
-  Rtos_Memmove(nals, nals + iNalCount, pCtx->m_uNumSC * sizeof(AL_TScTable));
+  AL_ScRing_Consume(&pCtx->m_ScRing, iNalCount);
 
   return true;
 }
@@ -636,7 +721,14 @@ AL_ERR AL_Default_Decoder_TryDecodeOneAU(AL_TDecoder* pAbsDec, TCircBuffer* pBuf
   if(iNalCount == 0)
     return AL_ERR_NO_FRAME_DECODED; /* no AU found */
 
-  if(!DecodeOneUnit(pCtx, pBufStream, iNalCount, iLastVclNalInAU))
+  /* search the next start codes while this unit is parsed and sent to the IP */
+  PrefetchStartCodes(pCtx, pBufStream);
+
+  AL_Trace_Begin("decode_unit");
+  bool bDecoded = DecodeOneUnit(pCtx, pBufStream, iNalCount, iLastVclNalInAU);
+  AL_Trace_End("decode_unit");
+
+  if(!bDecoded)
     return AL_ERR_INIT_FAILED;
 
   return AL_SUCCESS;
@@ -650,6 +742,14 @@ bool AL_Default_Decoder_PushBuffer(AL_TDecoder* pAbsDec, AL_TBuffer* pBuf, size_
   return AL_BufferFeeder_PushBuffer(pCtx->m_Feeder, pBuf, eMode, uSize, false);
 }
 
+/*****************************************************************************/
+AL_TBuffer* AL_Default_Decoder_GetStreamChunk(AL_TDecoder* pAbsDec, size_t zMaxSize)
+{
+  AL_TDefaultDecoder* pDec = (AL_TDefaultDecoder*)pAbsDec;
+  AL_TDecCtx* pCtx = &pDec->ctx;
+  return AL_BufferFeeder_GetChunk(pCtx->m_Feeder, zMaxSize);
+}
+
 /*****************************************************************************/
 void AL_Default_Decoder_Flush(AL_TDecoder* pAbsDec)
 {
@@ -683,6 +783,8 @@ void AL_Default_Decoder_FlushInput(AL_TDecoder* pAbsDec)
 {
   AL_TDefaultDecoder* pDec = (AL_TDefaultDecoder*)pAbsDec;
   AL_TDecCtx* pCtx = &pDec->ctx;
+  /* the result of a search in flight refers to the stream being dropped */
+  WaitStartCodeSearch(pCtx);
   ResetStartCodes(pCtx);
   Rtos_GetMutex(pCtx->m_DecMutex);
   pCtx->m_iCurOffset = 0;
@@ -858,6 +960,12 @@ static bool CheckSettings(AL_TDecSettings* const pSettings)
   if((iStack < 1) || (iStack > MAX_STACK_SIZE))
     return false;
 
+  if((pSettings->iLookahead < 0) || (iStack + pSettings->iLookahead > MAX_STACK_SIZE))
+    return false;
+
+  if(isSubframe(pSettings->eDecUnit) && pSettings->iLookahead)
+    return false;
+
   if(pSettings->bIsAvc && pSettings->bParallelWPP)
     return false;
 
@@ -870,9 +978,14 @@ static bool CheckSettings(AL_TDecSettings* const pSettings)
 /*****************************************************************************/
 static void AssignSettings(AL_TDecCtx* const pCtx, AL_TDecSettings* const pSettings)
 {
-  pCtx->m_iStackSize = pSettings->iStackSize;
+  /* the frames parsed ahead need their own buffers, the IP isn't given more commands */
+  pCtx->m_iStackSize = pSettings->iStackSize + pSettings->iLookahead;
+  pCtx->m_iMaxFramesInFlight = pSettings->iStackSize;
   pCtx->m_bForceFrameRate = pSettings->bForceFrameRate;
   pCtx->m_eDpbMode = pSettings->eDpbMode;
+  pCtx->m_eScdMode = pSettings->eScdMode;
+  pCtx->m_uSliceBatchCount = pSettings->uSliceBatchCount;
+  pCtx->m_uSliceBatchBytes = pSettings->uSliceBatchBytes;
   pCtx->m_tStreamSettings = pSettings->tStream;
 
   AL_TDecChanParam* pChan = &pCtx->m_chanParam;
@@ -957,6 +1070,7 @@ const AL_TDecoderVtable AL_Default_Decoder_Vtable =
   &AL_Default_Decoder_Destroy,
   &AL_Default_Decoder_SetParam,
   &AL_Default_Decoder_PushBuffer,
+  &AL_Default_Decoder_GetStreamChunk,
   &AL_Default_Decoder_Flush,
   &AL_Default_Decoder_PutDecPict,
   &AL_Default_Decoder_GetMaxBD,
@@ -1012,6 +1126,7 @@ AL_ERR AL_CreateDefaultDecoder(AL_TDecoder** hDec, AL_TIDecChannel* pDecChannel,
   pCtx->m_Sem = Rtos_CreateSemaphore(pCtx->m_iStackSize);
   pCtx->m_ScDetectionComplete = Rtos_CreateEvent(0);
   pCtx->m_DecMutex = Rtos_CreateMutex();
+  pCtx->m_SubmitMutex = Rtos_CreateMutex();
 
   AL_Default_Decoder_SetParam((AL_TDecoder*)pDec, false, false, 0, 0);
 
@@ -1065,7 +1180,8 @@ AL_ERR AL_CreateDefaultDecoder(AL_TDecoder** hDec, AL_TIDecChannel* pDecChannel,
   SAFE_ALLOC(pCtx, &pCtx->m_SCTable.tMD, pCtx->m_iStackSize * MAX_NAL_UNIT * sizeof(AL_TScTable), "sctable");
   AL_CleanupMemory(pCtx->m_SCTable.tMD.pVirtualAddr, pCtx->m_SCTable.tMD.uSize);
 
-  pCtx->m_uNumSC = 0;
+  AL_ScRing_Init(&pCtx->m_ScRing, (AL_TScTable*)pCtx->m_SCTable.tMD.pVirtualAddr, pCtx->m_SCTable.tMD.uSize / sizeof(AL_TScTable));
+  pCtx->m_bScdPending = false;
 
   // Alloc Decoder buffers
   for(int i = 0; i < pCtx->m_iStackSize; ++i)
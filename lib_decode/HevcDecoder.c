@@ -49,6 +49,8 @@
 #include "lib_parsing/Hevc_PictMngr.h"
 #include "lib_parsing/SliceHdrParsing.h"
 
+#include "lib_perfs/StageStats.h"
+
 #include "FrameParam.h"
 #include "I_DecoderCtx.h"
 #include "DefaultDecoder.h"
@@ -545,7 +547,9 @@ static bool decodeSliceData(AL_TAup* pIAUP, AL_TDecCtx* pCtx, AL_ENut eNUT, bool
   Rtos_Memset(pSlice, 0, sizeof(*pSlice));
   AL_TConceal* pConceal = &pCtx->m_tConceal;
   AL_THevcAup* pAUP = &pIAUP->hevcAup;
+  AL_TStageClock tParse = AL_StageStats_Begin();
   bool isValid = AL_HEVC_ParseSliceHeader(pSlice, &pCtx->m_HevcSliceHdr[pCtx->m_uCurID], &rp, pConceal, pAUP->m_pPPS);
+  AL_StageStats_End(AL_STAGE_SLICE_HEADER, tParse);
   bool bSliceBelongsToSameFrame = true;
 
   if(isValid)
@@ -92,6 +92,8 @@ typedef struct AL_t_IDecChannelVtable
   void (* SearchSC)(AL_TIDecChannel* pDecChannel, AL_TScParam* pScParam, AL_TScBufferAddrs* pBufferAddrs, AL_CB_EndStartCode callback);
   void (* DecodeOneFrame)(AL_TIDecChannel* pDecChannel, AL_TDecPicParam* pPictParam, AL_TDecPicBufferAddrs* pPictAddrs, TMemDesc* pSliceParams);
   void (* DecodeOneSlice)(AL_TIDecChannel* pDecChannel, AL_TDecPicParam* pPictParam, AL_TDecPicBufferAddrs* pPictAddrs, TMemDesc* pSliceParams);
+  /* optional: NULL when the channel can only send one slice per message */
+  void (* DecodeSlices)(AL_TIDecChannel* pDecChannel, AL_TDecPicParam* pPictParam, AL_TDecPicBufferAddrs* pPictAddrs, TMemDesc* pSliceParams, int iNumSlices);
 
 }AL_TIDecChannelVtable;
 
@@ -161,5 +163,29 @@ void AL_IDecChannel_DecodeOneSlice(AL_TIDecChannel* pThis, AL_TDecPicParam* pPic
   return pThis->vtable->DecodeOneSlice(pThis, pPictParam, pPictAddrs, pSliceParams);
 }
 
+/*************************************************************************//*!
+   \brief Asks the scheduler to process the decoding of consecutive slices
+   \param[in] pThis Decoder channel
+   \param[in] pPictParam  Pointer to the picture parameters structure
+   \param[in] pPictAddrs Pointer to the picture buffers addresses
+   \param[in] pSliceParams Slice parameters of the first slice
+   \param[in] iNumSlices Number of slices, their parameters follow each other
+*****************************************************************************/
+static inline
+void AL_IDecChannel_DecodeSlices(AL_TIDecChannel* pThis, AL_TDecPicParam* pPictParam, AL_TDecPicBufferAddrs* pPictAddrs, TMemDesc* pSliceParams, int iNumSlices)
+{
+  if(pThis->vtable->DecodeSlices)
+    return pThis->vtable->DecodeSlices(pThis, pPictParam, pPictAddrs, pSliceParams, iNumSlices);
+
+  TMemDesc SliceParam = *pSliceParams;
+
+  for(int i = 0; i < iNumSlices; ++i)
+  {
+    pThis->vtable->DecodeOneSlice(pThis, pPictParam, pPictAddrs, &SliceParam);
+    SliceParam.pVirtualAddr += sizeof(AL_TDecSliceParam);
+    SliceParam.uPhysicalAddr += sizeof(AL_TDecSliceParam);
+  }
+}
+
 /*@}*/
 
@@ -55,6 +55,7 @@ typedef struct
   void (* pfnDecoderDestroy)(AL_TDecoder* pDec);
   void (* pfnSetParam)(AL_TDecoder* pDec, bool bConceal, bool bUseBoard, int iFrmID, int iNumFrm);
   bool (* pfnPushBuffer)(AL_TDecoder* pDec, AL_TBuffer* pBuf, size_t uSize, AL_EBufMode eMode);
+  AL_TBuffer* (* pfnGetStreamChunk)(AL_TDecoder* pDec, size_t zMaxSize);
   void (* pfnFlush)(AL_TDecoder* pDec);
   void (* pfnPutDisplayPicture)(AL_TDecoder* pDec, AL_TBuffer* pDisplay);
   int (* pfnGetMaxBD)(AL_TDecoder* pDec);
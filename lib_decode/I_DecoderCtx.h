@@ -55,6 +55,7 @@
 #include "lib_decode/I_DecChannel.h"
 #include "lib_decode/lib_decode.h"
 #include "BufferFeeder.h"
+#include "StartCodeRing.h"
 
 typedef enum AL_e_ChanState
 {
@@ -92,8 +93,12 @@ typedef struct t_Dec_Ctx
   // Start code members
   TBuffer m_BufSCD;             // Holds the Start Code Detector Table results
   TBuffer m_SCTable;            //
-  uint16_t m_uNumSC;             //
+  AL_TScRing m_ScRing;          // Pending start codes, in m_SCTable
   AL_TScStatus m_ScdStatus;
+  AL_TScParam m_ScdParam;         // Parameters of the last search sent to the IP
+  AL_TScBufferAddrs m_ScdBufferAddrs;
+  bool m_bScdPending;             // A search is in flight: m_BufSCD and m_ScdStatus belong to the IP
+  AL_EScdMode m_eScdMode;
 
   // decoder pool buffer
   TBuffer m_PoolSclLst[MAX_STACK_SIZE];      // Scaling List pool buffer
@@ -109,6 +114,21 @@ typedef struct t_Dec_Ctx
   AL_TDecPicBuffers m_PoolPB[MAX_STACK_SIZE]; // Picture Buffers
   uint8_t m_uCurID; // ID of the last independent slice
 
+  // slices waiting to be sent to the IP in one message
+  uint16_t m_uBatchFirstSlice;
+  uint16_t m_uBatchNumSlices;
+  uint32_t m_uBatchBytes;
+  uint16_t m_uSliceBatchCount;
+  uint32_t m_uSliceBatchBytes;
+
+  // frames parsed ahead, waiting for room in the command stack of the IP
+  AL_MUTEX m_SubmitMutex;
+  uint8_t m_uReadyFrames[MAX_STACK_SIZE]; // toggles of the ready frames, in decoding order
+  int m_iReadyHead;
+  int m_iNumReadyFrames;
+  int m_iNumFramesInFlight;
+  int m_iMaxFramesInFlight;
+
   AL_TDecChanParam m_chanParam;
   AL_EDpbMode m_eDpbMode;
   bool m_bUseBoard;
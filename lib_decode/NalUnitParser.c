@@ -51,6 +51,7 @@
 #include "lib_common_dec/DecSliceParam.h"
 #include "lib_common_dec/DecBuffers.h"
 #include "lib_common_dec/RbspParser.h"
+#include "lib_common_dec/StartCodeScan.h"
 
 #include "lib_parsing/Avc_PictMngr.h"
 #include "lib_parsing/Hevc_PictMngr.h"
@@ -72,29 +73,35 @@ static uint32_t AL_sCount_AntiEmulBytes(TCircBuffer* pStream, uint32_t uLength)
   uint8_t uSCDetect = 0;
   uint32_t uNumAE = 0;
   uint32_t uZeroBytesCount = 0;
-  uint32_t uRead;
 
   uint8_t* pBuf = pStream->tMD.pVirtualAddr;
 
   uint32_t uSize = pStream->tMD.uSize;
-  uint32_t uOffset = pStream->uOffset;
-  uint32_t uEnd = uOffset + uLength;
+  uint32_t uRead = pStream->uOffset;
+  uint32_t uEnd = uRead + uLength;
 
   // Replaces in m_pBuffer all sequences such as 0x00 0x00 0x03 0xZZ with 0x00 0x00 0xZZ (0x03 removal)
   // iff 0xZZ == 0x00 or 0x01 or 0x02 or 0x03.
-  for(uRead = uOffset; uRead < uEnd; ++uRead)
+  while(uRead < uEnd)
   {
-    const uint8_t read = pBuf[uRead % uSize];
+    uint32_t uPos = uRead % uSize;
+    uint32_t uSpan = UnsignedMin(uEnd - uRead, uSize - uPos);
+    uint32_t uFound = AL_FindStartCodeOrAntiEmul(&pBuf[uPos], uSpan, &uZeroBytesCount);
+
+    uRead += uFound;
+
+    if(uFound == uSpan)
+      continue;
+
+    const uint8_t read = pBuf[uPos + uFound];
+    ++uRead;
 
     if((uZeroBytesCount == 2) && (read == 0x03))
     {
-      uZeroBytesCount = 0;
       ++uEnd;
       ++uNumAE;
-      continue;
     }
-
-    if((uZeroBytesCount >= 2) && (read == 0x01))
+    else if(read == 0x01)
     {
       ++uSCDetect;
 
@@ -102,10 +109,7 @@ static uint32_t AL_sCount_AntiEmulBytes(TCircBuffer* pStream, uint32_t uLength)
         return uNumAE;
     }
 
-    if(read == 0x00)
-      ++uZeroBytesCount;
-    else
-      uZeroBytesCount = 0;
+    uZeroBytesCount = 0;
   }
 
   return uNumAE;
@@ -114,37 +118,32 @@ static uint32_t AL_sCount_AntiEmulBytes(TCircBuffer* pStream, uint32_t uLength)
 /*****************************************************************************/
 static uint32_t GetNonVclSize(uint32_t uOffset, TCircBuffer* pBufStream)
 {
-  int iNumZeros = 0;
   int iNumNALFound = 0;
   uint8_t* pParseBuf = pBufStream->tMD.pVirtualAddr;
   uint32_t uSize = pBufStream->tMD.uSize;
-  uint32_t uLengthNAL = 0;
-  uint32_t i;
+  uint32_t uZeroBytesCount = 0;
+  uint32_t uRead = uOffset;
+  uint32_t uEnd = uOffset + uSize;
 
-  for(i = uOffset; i < uOffset + uSize; ++i)
+  while(uRead < uEnd)
   {
-    uint8_t uRead = pParseBuf[i % uSize];
+    uint32_t uPos = uRead % uSize;
+    uint32_t uSpan = UnsignedMin(uEnd - uRead, uSize - uPos);
+    uint32_t uFound = AL_FindStartCodeOrAntiEmul(&pParseBuf[uPos], uSpan, &uZeroBytesCount);
 
-    if(iNumZeros >= 2 && uRead == 0x01)
-    {
-      if(++iNumNALFound == 2)
-      {
-        uLengthNAL -= iNumZeros;
-        break;
-      }
-      else
-        iNumZeros = 0;
-    }
+    uRead += uFound;
+
+    if(uFound == uSpan)
+      continue;
 
-    if(uRead == 0x00)
-      ++iNumZeros;
-    else
-      iNumZeros = 0;
+    if(pParseBuf[uPos + uFound] == 0x01 && ++iNumNALFound == 2)
+      return RoundUp(uRead - uOffset - uZeroBytesCount, ANTI_EMUL_GRANULARITY);
 
-    ++uLengthNAL;
+    uZeroBytesCount = 0;
+    ++uRead;
   }
 
-  return RoundUp(uLengthNAL, ANTI_EMUL_GRANULARITY);
+  return RoundUp(uRead - uOffset, ANTI_EMUL_GRANULARITY);
 }
 
 /*****************************************************************************/
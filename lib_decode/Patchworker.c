@@ -153,6 +153,9 @@ bool AL_Patchworker_Init(AL_TPatchworker* this, TCircBuffer* pCircularBuf, AL_TF
   this->lock = Rtos_CreateMutex();
   this->workBuf = NULL;
   this->inputFifo = pInputFifo;
+  this->chunkBuf = NULL;
+  this->zCommittedSize = 0;
+  this->iNumPendingCopies = 0;
   CircBuffer_Init(this->outputCirc);
 
   /* prevent trailing_zero_bits*/
@@ -169,12 +172,126 @@ void AL_Patchworker_Deinit(AL_TPatchworker* this)
     this->workBuf = NULL;
   }
 
+  /* the application may still hold the lent chunk */
+  Rtos_GetMutex(this->lock);
+
+  if(this->chunkBuf)
+  {
+    AL_Buffer_SetUserData(this->chunkBuf, NULL);
+    this->chunkBuf = NULL;
+  }
+  Rtos_ReleaseMutex(this->lock);
+
   Rtos_DeleteMutex(this->lock);
 }
 
+static void releaseChunk(AL_TBuffer* pBuf)
+{
+  AL_TPatchworker* this = (AL_TPatchworker*)AL_Buffer_GetUserData(pBuf);
+
+  if(this)
+  {
+    Rtos_GetMutex(this->lock);
+
+    if(this->chunkBuf == pBuf)
+      this->chunkBuf = NULL;
+    Rtos_ReleaseMutex(this->lock);
+  }
+
+  AL_Buffer_Destroy(pBuf);
+}
+
+static size_t GetContiguousFreeSize(TCircBuffer* stream)
+{
+  uint32_t uEndStream = (stream->uOffset + stream->uAvailSize) % stream->tMD.uSize;
+  size_t unusedAreaSize = stream->tMD.uSize - stream->uAvailSize;
+  return UnsignedMin(unusedAreaSize, stream->tMD.uSize - uEndStream);
+}
+
+AL_TBuffer* AL_Patchworker_GetChunk(AL_TPatchworker* this, size_t zMaxSize)
+{
+  AL_TBuffer* pChunk = NULL;
+
+  Rtos_GetMutex(this->lock);
+
+  /* the chunk must follow the data already queued for copy */
+  if(this->chunkBuf || this->iNumPendingCopies)
+    goto exit;
+
+  TCircBuffer* stream = this->outputCirc;
+  size_t zChunkSize = UnsignedMin(GetContiguousFreeSize(stream), zMaxSize);
+
+  if(zChunkSize == 0)
+    goto exit;
+
+  uint32_t uEndStream = (stream->uOffset + stream->uAvailSize) % stream->tMD.uSize;
+  pChunk = AL_Buffer_WrapData(stream->tMD.pVirtualAddr + uEndStream, zChunkSize, &releaseChunk);
+
+  if(!pChunk)
+    goto exit;
+
+  AL_Buffer_SetUserData(pChunk, this);
+  AL_Buffer_Ref(pChunk);
+  this->chunkBuf = pChunk;
+
+  exit:
+  Rtos_ReleaseMutex(this->lock);
+  return pChunk;
+}
+
+bool AL_Patchworker_IsChunk(AL_TPatchworker* this, AL_TBuffer* pBuf)
+{
+  Rtos_GetMutex(this->lock);
+  bool bRet = pBuf && this->chunkBuf == pBuf;
+  Rtos_ReleaseMutex(this->lock);
+  return bRet;
+}
+
+bool AL_Patchworker_CommitChunk(AL_TPatchworker* this, AL_TBuffer* pBuf, size_t zSize)
+{
+  Rtos_GetMutex(this->lock);
+
+  /* the chunk was invalidated by a reset */
+  if(!pBuf || this->chunkBuf != pBuf)
+  {
+    Rtos_ReleaseMutex(this->lock);
+    return false;
+  }
+
+  zSize = UnsignedMin(zSize, pBuf->zSize);
+  this->outputCirc->uAvailSize += zSize;
+  this->zCommittedSize += zSize;
+  this->chunkBuf = NULL;
+
+  Rtos_ReleaseMutex(this->lock);
+  return true;
+}
+
+void AL_Patchworker_UpdatePendingCopies(AL_TPatchworker* this, int iNumCopies)
+{
+  Rtos_GetMutex(this->lock);
+  this->iNumPendingCopies += iNumCopies;
+  assert(this->iNumPendingCopies >= 0);
+  Rtos_ReleaseMutex(this->lock);
+}
+
+void AL_Patchworker_ConsumeUpToOffset(AL_TPatchworker* this, uint32_t uNewOffset)
+{
+  Rtos_GetMutex(this->lock);
+  CircBuffer_ConsumeUpToOffset(this->outputCirc, uNewOffset);
+  Rtos_ReleaseMutex(this->lock);
+}
+
 size_t AL_Patchworker_Transfer(AL_TPatchworker* this)
 {
-  size_t zTotalSize = 0;
+  Rtos_GetMutex(this->lock);
+  size_t zTotalSize = this->zCommittedSize;
+  this->zCommittedSize = 0;
+  bool bChunkLent = this->chunkBuf != NULL;
+  Rtos_ReleaseMutex(this->lock);
+
+  if(bChunkLent)
+    return zTotalSize; /* the lent chunk is where the next copy would go */
 
   assert(this->inputFifo);
 
@@ -196,6 +313,7 @@ size_t AL_Patchworker_Transfer(AL_TPatchworker* this)
   /* buffer is totally copied to the circular buffer and isn't needed anymore */
   AL_Buffer_Unref(this->workBuf);
   this->workBuf = NULL;
+  AL_Patchworker_UpdatePendingCopies(this, -1);
 
   return zTotalSize;
 }
@@ -231,6 +349,7 @@ void AL_Patchworker_Drop(AL_TPatchworker* this)
   while(this->workBuf)
   {
     AL_Buffer_Unref(this->workBuf);
+    AL_Patchworker_UpdatePendingCopies(this, -1);
     this->workBuf = AL_Fifo_Dequeue(this->inputFifo, AL_NO_WAIT);
   }
 }
@@ -242,6 +361,8 @@ void AL_Patchworker_Reset(AL_TPatchworker* this)
   this->endOfInput = false;
   AL_Patchworker_Drop(this);
   CircBuffer_Init(this->outputCirc);
+  this->chunkBuf = NULL;
+  this->zCommittedSize = 0;
   Rtos_ReleaseMutex(this->lock);
 }
 
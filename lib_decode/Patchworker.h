@@ -51,6 +51,11 @@ typedef struct al_t_Patchworker
   AL_TFifo* inputFifo;
   TCircBuffer* outputCirc;
   AL_TBuffer* workBuf;
+
+  /* in place input: window of the circular buffer currently lent to the application */
+  AL_TBuffer* chunkBuf;
+  size_t zCommittedSize; /* bytes written in place and not yet reported by AL_Patchworker_Transfer */
+  int iNumPendingCopies; /* buffers pushed in the fifo and not entirely copied yet */
 }AL_TPatchworker;
 
 /*
@@ -62,6 +67,27 @@ size_t AL_Patchworker_CopyBuffer(AL_TPatchworker* pPatchworker, AL_TBuffer* pBuf
 /* Transfer as much data as possible from one buffer of the fifo to the circular buffer */
 size_t AL_Patchworker_Transfer(AL_TPatchworker* pPatchworker);
 
+/*
+ * Lend the next free contiguous area of the circular buffer (at most zMaxSize bytes).
+ * The application fills it and gives it back with AL_Patchworker_CommitChunk: its data
+ * then becomes part of the stream without any copy.
+ * return NULL if buffers waiting to be copied are queued, if a chunk is already lent
+ * or if the circular buffer is full.
+ */
+AL_TBuffer* AL_Patchworker_GetChunk(AL_TPatchworker* pPatchworker, size_t zMaxSize);
+
+/* return true if pBuf is the chunk currently lent by AL_Patchworker_GetChunk */
+bool AL_Patchworker_IsChunk(AL_TPatchworker* pPatchworker, AL_TBuffer* pBuf);
+
+/* Add the zSize first bytes of the lent chunk to the stream. The chunk isn't lent anymore */
+bool AL_Patchworker_CommitChunk(AL_TPatchworker* pPatchworker, AL_TBuffer* pBuf, size_t zSize);
+
+/* Account for buffers queued in (positive) or removed from (negative) the input fifo */
+void AL_Patchworker_UpdatePendingCopies(AL_TPatchworker* pPatchworker, int iNumCopies);
+
+/* Release the circular buffer area the decoder doesn't need anymore */
+void AL_Patchworker_ConsumeUpToOffset(AL_TPatchworker* pPatchworker, uint32_t uNewOffset);
+
 void AL_Patchworker_NotifyEndOfInput(AL_TPatchworker* pPatchworker);
 bool AL_Patchworker_IsEndOfInput(AL_TPatchworker* pPatchworker);
 bool AL_Patchworker_IsAllDataTransfered(AL_TPatchworker* pPatchworker);
@@ -54,6 +54,8 @@
 #include "lib_parsing/Hevc_PictMngr.h"
 
 #include "lib_decode/I_DecChannel.h"
+#include "lib_perfs/StageStats.h"
+#include "lib_perfs/Trace.h"
 #include "I_DecoderCtx.h"
 #include "FrameParam.h"
 
@@ -123,9 +125,9 @@ static void AL_sSaveNalStreamBlk1(AL_TDecCtx* pCtx)
 }
 
 /*****************************************************************************/
-static AL_TDecPicBufferAddrs AL_SetBufferAddrs(AL_TDecCtx* pCtx)
+static AL_TDecPicBufferAddrs AL_SetBufferAddrs(AL_TDecCtx* pCtx, uint8_t uToggle)
 {
-  AL_TDecPicBuffers* pPictBuffers = &pCtx->m_PoolPB[pCtx->m_uToggle];
+  AL_TDecPicBuffers* pPictBuffers = &pCtx->m_PoolPB[uToggle];
   AL_TDecPicBufferAddrs BufAddrs;
 
   BufAddrs.pCompData = pPictBuffers->tCompData.tMD.uPhysicalAddr;
@@ -160,33 +162,74 @@ static void UpdateStreamOffset(AL_TDecCtx* pCtx)
 }
 
 /*****************************************************************************/
-void AL_LaunchSliceDecoding(AL_TDecCtx* pCtx, bool bIsLastAUNal)
+static void SendPendingSlices(AL_TDecCtx* pCtx)
+{
+  if(!pCtx->m_uBatchNumSlices)
+    return;
+
+  AL_TDecPicBufferAddrs BufAddrs = AL_SetBufferAddrs(pCtx, pCtx->m_uToggle);
+  TBuffer* pPoolSP = &pCtx->m_PoolSP[pCtx->m_uToggle];
+
+  TMemDesc SP;
+  SP.pVirtualAddr = pPoolSP->tMD.pVirtualAddr + pCtx->m_uBatchFirstSlice * sizeof(AL_TDecSliceParam);
+  SP.uPhysicalAddr = pPoolSP->tMD.uPhysicalAddr + pCtx->m_uBatchFirstSlice * sizeof(AL_TDecSliceParam);
+
+  AL_TStageClock tSubmit = AL_StageStats_Begin();
+  AL_Trace_Begin("submit_slices");
+  AL_IDecChannel_DecodeSlices(pCtx->m_pDecChannel, &pCtx->m_PoolPP[pCtx->m_uToggle], &BufAddrs, &SP, pCtx->m_uBatchNumSlices);
+  AL_Trace_End("submit_slices");
+  AL_StageStats_End(AL_STAGE_SUBMIT, tSubmit);
+
+  pCtx->m_uBatchNumSlices = 0;
+  pCtx->m_uBatchBytes = 0;
+}
+
+/*****************************************************************************/
+static bool IsBatchFull(AL_TDecCtx const* pCtx)
 {
-  AL_TDecPicBufferAddrs BufAddrs = AL_SetBufferAddrs(pCtx);
+  if(!pCtx->m_uSliceBatchCount && !pCtx->m_uSliceBatchBytes)
+    return true;
+
+  if(pCtx->m_uSliceBatchCount && pCtx->m_uBatchNumSlices >= pCtx->m_uSliceBatchCount)
+    return true;
+
+  return pCtx->m_uSliceBatchBytes && pCtx->m_uBatchBytes >= pCtx->m_uSliceBatchBytes;
+}
 
+/*****************************************************************************/
+static void AddPendingSlice(AL_TDecCtx* pCtx, uint16_t uSliceID)
+{
+  /* the parameters of the slices of one message follow each other */
+  if(pCtx->m_uBatchNumSlices && pCtx->m_uBatchFirstSlice + pCtx->m_uBatchNumSlices != uSliceID)
+    SendPendingSlices(pCtx);
+
+  AL_TDecSliceParam* pSP = &(((AL_TDecSliceParam*)pCtx->m_PoolSP[pCtx->m_uToggle].tMD.pVirtualAddr)[uSliceID]);
+
+  if(!pCtx->m_uBatchNumSlices)
+    pCtx->m_uBatchFirstSlice = uSliceID;
+
+  ++pCtx->m_uBatchNumSlices;
+  pCtx->m_uBatchBytes += pSP->uStrAvailSize;
+
+  if(IsBatchFull(pCtx))
+    SendPendingSlices(pCtx);
+}
+
+/*****************************************************************************/
+void AL_LaunchSliceDecoding(AL_TDecCtx* pCtx, bool bIsLastAUNal)
+{
   uint16_t uSliceID = pCtx->m_PictMngr.m_uNumSlice - 1;
 
 
   UpdateStreamOffset(pCtx);
 
   if(uSliceID)
-  {
-    AL_TDecSliceParam* pPrevSP_v = &(((AL_TDecSliceParam*)pCtx->m_PoolSP[pCtx->m_uToggle].tMD.pVirtualAddr)[uSliceID - 1]);
-    AL_PADDR pPrevSP_p = (AL_PADDR)(uintptr_t)&(((AL_TDecSliceParam*)(uintptr_t)pCtx->m_PoolSP[pCtx->m_uToggle].tMD.uPhysicalAddr)[uSliceID - 1]);
-    TMemDesc pPrevSP;
-    pPrevSP.pVirtualAddr = (AL_VADDR)pPrevSP_v;
-    pPrevSP.uPhysicalAddr = pPrevSP_p;
-    AL_IDecChannel_DecodeOneSlice(pCtx->m_pDecChannel, &pCtx->m_PoolPP[pCtx->m_uToggle], &BufAddrs, &pPrevSP);
-  }
+    AddPendingSlice(pCtx, uSliceID - 1);
 
   if(bIsLastAUNal)
   {
-    AL_TDecSliceParam* pSP_v = &(((AL_TDecSliceParam*)pCtx->m_PoolSP[pCtx->m_uToggle].tMD.pVirtualAddr)[uSliceID]);
-    AL_PADDR pSP_p = (AL_PADDR)(uintptr_t)&(((AL_TDecSliceParam*)(uintptr_t)pCtx->m_PoolSP[pCtx->m_uToggle].tMD.uPhysicalAddr)[uSliceID]);
-    TMemDesc pSP;
-    pSP.pVirtualAddr = (AL_VADDR)pSP_v;
-    pSP.uPhysicalAddr = pSP_p;
-    AL_IDecChannel_DecodeOneSlice(pCtx->m_pDecChannel, &pCtx->m_PoolPP[pCtx->m_uToggle], &BufAddrs, &pSP);
+    AddPendingSlice(pCtx, uSliceID);
+    SendPendingSlices(pCtx);
 
     pCtx->m_uCurTileID = 0;
 
@@ -198,14 +241,40 @@ void AL_LaunchSliceDecoding(AL_TDecCtx* pCtx, bool bIsLastAUNal)
 }
 
 /*****************************************************************************/
-void AL_LaunchFrameDecoding(AL_TDecCtx* pCtx)
+static void SendFrame(AL_TDecCtx* pCtx, uint8_t uToggle)
 {
-  AL_TDecPicBufferAddrs BufAddrs = AL_SetBufferAddrs(pCtx);
+  AL_TDecPicBufferAddrs BufAddrs = AL_SetBufferAddrs(pCtx, uToggle);
 
+  AL_TStageClock tSubmit = AL_StageStats_Begin();
+  AL_Trace_Begin("submit_frame");
+  AL_IDecChannel_DecodeOneFrame(pCtx->m_pDecChannel, &pCtx->m_PoolPP[uToggle], &BufAddrs, &pCtx->m_PoolSP[uToggle].tMD);
+  AL_Trace_End("submit_frame");
+  AL_StageStats_End(AL_STAGE_SUBMIT, tSubmit);
+}
 
+/*****************************************************************************/
+void AL_LaunchFrameDecoding(AL_TDecCtx* pCtx)
+{
   UpdateStreamOffset(pCtx);
 
-  AL_IDecChannel_DecodeOneFrame(pCtx->m_pDecChannel, &pCtx->m_PoolPP[pCtx->m_uToggle], &BufAddrs, &pCtx->m_PoolSP[pCtx->m_uToggle].tMD);
+  /* the frame stays ready in its buffers until the IP has room for it.
+   * The submit mutex is held while sending to keep the decoding order */
+  Rtos_GetMutex(pCtx->m_SubmitMutex);
+
+  if(pCtx->m_iNumFramesInFlight < pCtx->m_iMaxFramesInFlight)
+  {
+    ++pCtx->m_iNumFramesInFlight;
+    SendFrame(pCtx, pCtx->m_uToggle);
+  }
+  else
+  {
+    int iTail = (pCtx->m_iReadyHead + pCtx->m_iNumReadyFrames) % MAX_STACK_SIZE;
+    pCtx->m_uReadyFrames[iTail] = pCtx->m_uToggle;
+    ++pCtx->m_iNumReadyFrames;
+    AL_Trace_Instant("frame_ready");
+  }
+
+  Rtos_ReleaseMutex(pCtx->m_SubmitMutex);
 
   pCtx->m_uCurTileID = 0;
 
@@ -215,6 +284,25 @@ void AL_LaunchFrameDecoding(AL_TDecCtx* pCtx)
   Rtos_ReleaseMutex(pCtx->m_DecMutex);
 }
 
+/*****************************************************************************/
+void AL_LaunchReadyFrame(AL_TDecCtx* pCtx)
+{
+  Rtos_GetMutex(pCtx->m_SubmitMutex);
+  --pCtx->m_iNumFramesInFlight;
+
+  if(pCtx->m_iNumReadyFrames)
+  {
+    uint8_t uToggle = pCtx->m_uReadyFrames[pCtx->m_iReadyHead];
+    pCtx->m_iReadyHead = (pCtx->m_iReadyHead + 1) % MAX_STACK_SIZE;
+    --pCtx->m_iNumReadyFrames;
+
+    ++pCtx->m_iNumFramesInFlight;
+    SendFrame(pCtx, uToggle);
+  }
+
+  Rtos_ReleaseMutex(pCtx->m_SubmitMutex);
+}
+
 /*****************************************************************************/
 static void AL_InitIntermediateBuffers(AL_TDecCtx* pCtx, AL_TDecPicBuffers* pBufs)
 {
@@ -251,6 +339,7 @@ void AL_InitFrameBuffers(AL_TDecCtx* pCtx, AL_TDecPicBuffers* pBufs, AL_TDimensi
   {
     pPP->FrmID = AL_PictMngr_GetCurrentFrmID(&pCtx->m_PictMngr);
     pPP->MvID = AL_PictMngr_GetCurrentMvID(&pCtx->m_PictMngr);
+    AL_Trace_AsyncBegin("decode_frame", AL_TRACE_ID(pCtx, pPP->FrmID));
     AL_InitIntermediateBuffers(pCtx, pBufs);
   }
 }
@@ -57,6 +57,13 @@
 *****************************************************************************/
 void AL_LaunchFrameDecoding(AL_TDecCtx* pCtx);
 
+/*************************************************************************//*!
+   \brief The AL_LaunchReadyFrame function gives the oldest frame parsed ahead to the Hardware IP
+   once a frame decoding is over
+   \param[in]  pCtx              Pointer to a decoder context object
+*****************************************************************************/
+void AL_LaunchReadyFrame(AL_TDecCtx* pCtx);
+
 /*************************************************************************//*!
    \brief The AL_LaunchSliceDecoding function launch a slice decoding request to the Hardware IP
    \param[in]  pCtx              Pointer to a decoder context object
@@ -0,0 +1,115 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include "StartCodeRing.h"
+#include "lib_common/Utils.h"
+#include "lib_rtos/lib_rtos.h"
+#include <assert.h>
+
+/*****************************************************************************/
+static uint32_t GetIndex(AL_TScRing const* pRing, uint32_t uNal)
+{
+  uint32_t uIdx = pRing->uHead + uNal;
+  return uIdx >= pRing->uSize ? uIdx - pRing->uSize : uIdx;
+}
+
+/*****************************************************************************/
+void AL_ScRing_Init(AL_TScRing* pRing, AL_TScTable* pEntries, uint32_t uSize)
+{
+  pRing->pEntries = pEntries;
+  pRing->uSize = uSize;
+  AL_ScRing_Reset(pRing);
+}
+
+/*****************************************************************************/
+void AL_ScRing_Reset(AL_TScRing* pRing)
+{
+  pRing->uHead = 0;
+  pRing->uNumSC = 0;
+}
+
+/*****************************************************************************/
+AL_TScTable* AL_ScRing_Get(AL_TScRing const* pRing, int iNal)
+{
+  assert(iNal >= 0 && (uint32_t)iNal < pRing->uNumSC);
+  return pRing->pEntries + GetIndex(pRing, iNal);
+}
+
+/*****************************************************************************/
+uint32_t AL_ScRing_GetFree(AL_TScRing const* pRing)
+{
+  return pRing->uSize - pRing->uNumSC;
+}
+
+/*****************************************************************************/
+AL_TScTable* AL_ScRing_GetFreeSpan(AL_TScRing const* pRing, uint32_t* pNumFree)
+{
+  uint32_t uTail = GetIndex(pRing, pRing->uNumSC);
+  *pNumFree = UnsignedMin(AL_ScRing_GetFree(pRing), pRing->uSize - uTail);
+  return pRing->pEntries + uTail;
+}
+
+/*****************************************************************************/
+void AL_ScRing_Commit(AL_TScRing* pRing, uint32_t uNumSC)
+{
+  assert(uNumSC <= AL_ScRing_GetFree(pRing));
+  pRing->uNumSC += uNumSC;
+}
+
+/*****************************************************************************/
+void AL_ScRing_Append(AL_TScRing* pRing, AL_TScTable const* pStartCodes, uint32_t uNumSC)
+{
+  uint32_t uFirstPart;
+  AL_TScTable* pTail = AL_ScRing_GetFreeSpan(pRing, &uFirstPart);
+
+  assert(uNumSC <= AL_ScRing_GetFree(pRing));
+  uFirstPart = UnsignedMin(uNumSC, uFirstPart);
+
+  Rtos_Memcpy(pTail, pStartCodes, uFirstPart * sizeof(AL_TScTable));
+  Rtos_Memcpy(pRing->pEntries, pStartCodes + uFirstPart, (uNumSC - uFirstPart) * sizeof(AL_TScTable));
+
+  pRing->uNumSC += uNumSC;
+}
+
+/*****************************************************************************/
+void AL_ScRing_Consume(AL_TScRing* pRing, uint32_t uNumSC)
+{
+  assert(uNumSC <= pRing->uNumSC);
+  pRing->uHead = GetIndex(pRing, uNumSC);
+  pRing->uNumSC -= uNumSC;
+}
+
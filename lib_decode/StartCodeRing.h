@@ -0,0 +1,120 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+/****************************************************************************
+   -----------------------------------------------------------------------------
+ **************************************************************************//*!
+   \addtogroup lib_decode_hls
+   @{
+   \file
+ *****************************************************************************/
+
+#pragma once
+
+#include "lib_rtos/types.h"
+#include "lib_common_dec/StartCodeParam.h"
+
+/*************************************************************************//*!
+   \brief Ring of the start codes found in the stream and not decoded yet.
+   Decoding a unit moves the head, so that no entry is moved in the table.
+*****************************************************************************/
+typedef struct AL_t_ScRing
+{
+  AL_TScTable* pEntries;
+  uint32_t uSize;  /*!< Number of entries of the table */
+  uint32_t uHead;  /*!< Index of the first pending start code */
+  uint32_t uNumSC; /*!< Number of pending start codes */
+}AL_TScRing;
+
+/*************************************************************************//*!
+   \brief Initializes an empty ring over a start code table
+   \param[out] pRing    Ring to initialize
+   \param[in]  pEntries Table of the ring
+   \param[in]  uSize    Number of entries of the table
+*****************************************************************************/
+void AL_ScRing_Init(AL_TScRing* pRing, AL_TScTable* pEntries, uint32_t uSize);
+
+/*************************************************************************//*!
+   \brief Drops all the pending start codes
+*****************************************************************************/
+void AL_ScRing_Reset(AL_TScRing* pRing);
+
+/*************************************************************************//*!
+   \brief Gives access to a pending start code
+   \param[in] pRing Start code ring
+   \param[in] iNal  Rank of the start code, 0 is the oldest pending one
+   \return the entry of the start code in the table
+*****************************************************************************/
+AL_TScTable* AL_ScRing_Get(AL_TScRing const* pRing, int iNal);
+
+/*************************************************************************//*!
+   \brief Number of entries that can be appended before the ring is full
+*****************************************************************************/
+uint32_t AL_ScRing_GetFree(AL_TScRing const* pRing);
+
+/*************************************************************************//*!
+   \brief Gives the free entries that directly follow the last pending start
+   code, so that a detector can fill them in place. The span stops at the end
+   of the table: the entries at its beginning are reached by the next call.
+   \param[in]  pRing     Start code ring
+   \param[out] pNumFree  Number of contiguous free entries
+   \return the first free entry
+*****************************************************************************/
+AL_TScTable* AL_ScRing_GetFreeSpan(AL_TScRing const* pRing, uint32_t* pNumFree);
+
+/*************************************************************************//*!
+   \brief Makes the uNumSC entries written by the caller after the last
+   pending start code part of the ring. See AL_ScRing_GetFreeSpan
+*****************************************************************************/
+void AL_ScRing_Commit(AL_TScRing* pRing, uint32_t uNumSC);
+
+/*************************************************************************//*!
+   \brief Copies start codes after the last pending one. The caller checks
+   that uNumSC entries are free.
+   \param[in] pRing       Start code ring
+   \param[in] pStartCodes Start codes to append
+   \param[in] uNumSC      Number of start codes to append
+*****************************************************************************/
+void AL_ScRing_Append(AL_TScRing* pRing, AL_TScTable const* pStartCodes, uint32_t uNumSC);
+
+/*************************************************************************//*!
+   \brief Removes the uNumSC oldest pending start codes
+*****************************************************************************/
+void AL_ScRing_Consume(AL_TScRing* pRing, uint32_t uNumSC);
+
+/*@}*/
+
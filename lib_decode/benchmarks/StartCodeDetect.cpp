@@ -0,0 +1,180 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+extern "C"
+{
+#include "lib_common_dec/StartCodeScan.h"
+#include "lib_decode/DecChannelSim.h"
+#include "lib_fpga/DmaAllocSim.h"
+#include "lib_rtos/lib_rtos.h"
+}
+
+using namespace std;
+
+static uint16_t const SC_TABLE_SIZE = 512;
+
+/* an access unit of iNumSlices hevc slices of iSliceSize bytes, followed by
+ * the start code of the next one so that the last slice can be parsed */
+static vector<uint8_t> AccessUnit(int iNumSlices, int iSliceSize)
+{
+  mt19937 gen(iNumSlices * iSliceSize);
+  uniform_int_distribution<int> byteDist(1, 255);
+  vector<uint8_t> au;
+
+  for(int i = 0; i <= iNumSlices; ++i)
+  {
+    vector<uint8_t> const header = { 0x00, 0x00, 0x01, 0x02, 0x01 };
+    au.insert(au.end(), header.begin(), header.end());
+
+    for(int k = 0; i < iNumSlices && k < iSliceSize; ++k)
+      au.push_back((k % 97) ? byteDist(gen) : 0x00);
+  }
+
+  return au;
+}
+
+/* the start code of the next access unit is found too */
+static bool CheckStatus(benchmark::State& state, AL_TScStatus const& tStatus)
+{
+  if(tStatus.uNumSC == state.range(0) + 1)
+    return true;
+
+  state.SkipWithError("wrong number of start codes");
+  return false;
+}
+
+/* the detector runs on the calling thread */
+static void BM_DetectStartCodes_Software(benchmark::State& state)
+{
+  vector<uint8_t> au = AccessUnit(state.range(0), state.range(1));
+  vector<AL_TScTable> table(SC_TABLE_SIZE);
+
+  TCircBuffer tStream {};
+  tStream.tMD.pVirtualAddr = au.data();
+  tStream.tMD.uSize = au.size();
+  tStream.uAvailSize = au.size();
+
+  AL_TScParam tScP {};
+  tScP.MaxSize = SC_TABLE_SIZE;
+
+  AL_TScStatus tStatus {};
+  AL_DetectStartCodes(&tScP, &tStream, table.data(), &tStatus);
+
+  if(!CheckStatus(state, tStatus))
+    return;
+
+  for(auto _ : state)
+    AL_DetectStartCodes(&tScP, &tStream, table.data(), &tStatus);
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+struct ScdWait
+{
+  AL_EVENT hDone;
+  AL_TScStatus tStatus;
+};
+
+static void EndStartCode(void* pUserParam, AL_TScStatus* pStatus)
+{
+  ScdWait* pWait = (ScdWait*)pUserParam;
+  pWait->tStatus = *pStatus;
+  Rtos_SetEvent(pWait->hDone);
+}
+
+/* the search is posted to the simulated device, with no latency, and the
+ * caller waits for its completion, as RefillStartCodes does with the MCU */
+static void BM_DetectStartCodes_Device(benchmark::State& state)
+{
+  vector<uint8_t> const au = AccessUnit(state.range(0), state.range(1));
+
+  AL_TAllocator* pAllocator = DmaAllocSim_Create();
+  AL_TSimDeviceSettings tSettings {};
+  AL_TIDecChannel* pChan = AL_DecChannelSim_Create(pAllocator, &tSettings);
+
+  AL_HANDLE hStream = AL_Allocator_Alloc(pAllocator, au.size());
+  AL_HANDLE hTable = AL_Allocator_Alloc(pAllocator, SC_TABLE_SIZE * sizeof(AL_TScTable));
+  Rtos_Memcpy(AL_Allocator_GetVirtualAddr(pAllocator, hStream), au.data(), au.size());
+
+  AL_TScParam tScP {};
+  tScP.MaxSize = SC_TABLE_SIZE;
+
+  AL_TScBufferAddrs tAddrs {};
+  tAddrs.pStream = AL_Allocator_GetPhysicalAddr(pAllocator, hStream);
+  tAddrs.uMaxSize = au.size();
+  tAddrs.uAvailSize = au.size();
+  tAddrs.pBufOut = AL_Allocator_GetPhysicalAddr(pAllocator, hTable);
+
+  ScdWait tWait {};
+  tWait.hDone = Rtos_CreateEvent(false);
+  AL_CB_EndStartCode callback = { &EndStartCode, &tWait };
+
+  AL_IDecChannel_SearchSC(pChan, &tScP, &tAddrs, callback);
+  Rtos_WaitEvent(tWait.hDone, AL_WAIT_FOREVER);
+
+  if(CheckStatus(state, tWait.tStatus))
+  {
+    for(auto _ : state)
+    {
+      AL_IDecChannel_SearchSC(pChan, &tScP, &tAddrs, callback);
+      Rtos_WaitEvent(tWait.hDone, AL_WAIT_FOREVER);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  Rtos_DeleteEvent(tWait.hDone);
+  AL_IDecChannel_Destroy(pChan);
+  AL_Allocator_Free(pAllocator, hTable);
+  AL_Allocator_Free(pAllocator, hStream);
+  AL_Allocator_Destroy(pAllocator);
+}
+
+/* slices per access unit, bytes per slice */
+static void AccessUnits(benchmark::internal::Benchmark* pBench)
+{
+  pBench->Args({ 8, 300 })->Args({ 32, 100 })->Args({ 4, 20000 })->Args({ 256, 40 });
+}
+
+BENCHMARK(BM_DetectStartCodes_Software)->Apply(AccessUnits);
+BENCHMARK(BM_DetectStartCodes_Device)->Apply(AccessUnits)->UseRealTime();
+
@@ -0,0 +1,163 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <vector>
+
+extern "C"
+{
+#include "lib_common_dec/DecBuffers.h"
+#include "lib_decode/StartCodeRing.h"
+}
+
+using namespace std;
+
+/* entries written by one search of the start code detector */
+static uint32_t const SCD_NUM_SC = SCD_SIZE / sizeof(AL_TScTable);
+
+/* the table the decoder compacted with a memmove after each unit */
+struct CompactedTable
+{
+  vector<AL_TScTable> entries;
+  uint32_t uNumSC = 0;
+
+  explicit CompactedTable(uint32_t uSize) : entries(uSize) {}
+
+  uint32_t GetFree() const { return entries.size() - uNumSC; }
+  uint32_t GetNumSC() const { return uNumSC; }
+  AL_TScTable const& Get(int iNal) const { return entries[iNal]; }
+
+  void Append(AL_TScTable const* pStartCodes, uint32_t uNum)
+  {
+    memcpy(&entries[uNumSC], pStartCodes, uNum * sizeof(AL_TScTable));
+    uNumSC += uNum;
+  }
+
+  void Consume(uint32_t uNum)
+  {
+    uNumSC -= uNum;
+    memmove(&entries[0], &entries[uNum], uNumSC * sizeof(AL_TScTable));
+  }
+};
+
+struct RingTable
+{
+  vector<AL_TScTable> entries;
+  AL_TScRing ring;
+
+  explicit RingTable(uint32_t uSize) : entries(uSize)
+  {
+    AL_ScRing_Init(&ring, entries.data(), uSize);
+  }
+
+  uint32_t GetFree() const { return AL_ScRing_GetFree(&ring); }
+  uint32_t GetNumSC() const { return ring.uNumSC; }
+  AL_TScTable const& Get(int iNal) const { return *AL_ScRing_Get(&ring, iNal); }
+  void Append(AL_TScTable const* pStartCodes, uint32_t uNum) { AL_ScRing_Append(&ring, pStartCodes, uNum); }
+  void Consume(uint32_t uNum) { AL_ScRing_Consume(&ring, uNum); }
+};
+
+/* Table operations of the decoding of 16 frames of iSlices slices, one slice
+ * per unit (subframe decoding). The detector is called while the table has
+ * room for a whole search, as FindNextDecodingUnit does. When the table is
+ * smaller than a frame, it fills up before the end of the frame and the
+ * decoding of the units frees it. The ring wraps around as it goes. */
+template<typename Table>
+static void BM_StartCodeTable(benchmark::State& state)
+{
+  uint32_t const uSlices = state.range(0);
+  uint32_t const uNumNal = 16 * uSlices;
+  uint32_t const uTableSize = state.range(1);
+
+  vector<AL_TScTable> search(SCD_NUM_SC);
+  uint64_t uChecksum = 0;
+
+  for(auto _ : state)
+  {
+    Table table(uTableSize);
+    uint32_t uFound = 0;
+    uint32_t uDecoded = 0;
+
+    while(uDecoded + 1 < uNumNal)
+    {
+      while(uFound < uNumNal && table.GetFree() > SCD_NUM_SC)
+      {
+        uint32_t const uNum = min(SCD_NUM_SC, uNumNal - uFound);
+
+        for(uint32_t i = 0; i < uNum; ++i)
+          search[i].uPosition = uFound + i;
+
+        table.Append(search.data(), uNum);
+        uFound += uNum;
+      }
+
+      /* the last start code may not end its nal unit yet */
+      while(table.GetNumSC() > 1)
+      {
+        if(table.Get(0).uPosition != uDecoded || table.Get(1).uPosition != uDecoded + 1)
+        {
+          state.SkipWithError("start codes out of order");
+          return;
+        }
+
+        uChecksum += table.Get(0).uPosition;
+        table.Consume(1);
+        ++uDecoded;
+      }
+    }
+  }
+
+  benchmark::DoNotOptimize(uChecksum);
+  state.SetItemsProcessed(int64_t(state.iterations()) * uNumNal);
+}
+
+/* slices per frame, entries of the table: whole frames fit in the table of the
+ * decoder (stack of 1, MAX_NAL_UNIT entries), the second half fills it up */
+static void SliceConfigs(benchmark::internal::Benchmark* pBench)
+{
+  for(int iSlices : { 256, 512 })
+  {
+    pBench->Args({ iSlices, MAX_NAL_UNIT });
+    pBench->Args({ iSlices, iSlices / 2 + (int)SCD_NUM_SC });
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_StartCodeTable, CompactedTable)->Apply(SliceConfigs);
+BENCHMARK_TEMPLATE(BM_StartCodeTable, RingTable)->Apply(SliceConfigs);
+
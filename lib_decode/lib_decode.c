@@ -76,6 +76,13 @@ bool AL_Decoder_PushBuffer(AL_HDecoder hDec, AL_TBuffer* pBuf, size_t uSize, AL_
   return pDec->vtable->pfnPushBuffer(pDec, pBuf, uSize, eMode);
 }
 
+/*****************************************************************************/
+AL_TBuffer* AL_Decoder_GetStreamChunk(AL_HDecoder hDec, size_t zMaxSize)
+{
+  AL_TDecoder* pDec = (AL_TDecoder*)hDec;
+  return pDec->vtable->pfnGetStreamChunk(pDec, zMaxSize);
+}
+
 /*****************************************************************************/
 void AL_Decoder_Flush(AL_HDecoder hDec)
 {
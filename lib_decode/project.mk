@@ -19,6 +19,8 @@ LIB_DECODE_SRC+=\
 		lib_decode/BufferFeeder.c\
 		lib_decode/Patchworker.c\
 		lib_decode/DecoderFeeder.c\
+		lib_decode/DecChannelSim.c\
+		lib_decode/StartCodeRing.c\
 
 LIB_DECODER_SRC:=\
   $(LIB_RTOS_SRC)\
@@ -50,3 +52,5 @@ TARGETS+=$(LIB_DECODER_DLL)
 UNITTEST+=$(shell find lib_decode/unittests -name "*.cpp")
 UNITTEST+=$(LIB_DECODE_SRC)
 
+BENCHMARK+=$(shell find lib_decode/benchmarks -name "*.cpp")
+
@@ -0,0 +1,133 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+extern "C"
+{
+#include "lib_decode/StartCodeRing.h"
+}
+
+using namespace std;
+
+static vector<AL_TScTable> StartCodes(uint32_t uFirstPos, uint32_t uNumSC)
+{
+  vector<AL_TScTable> startCodes(uNumSC);
+
+  for(uint32_t i = 0; i < uNumSC; ++i)
+    startCodes[i].uPosition = uFirstPos + i;
+
+  return startCodes;
+}
+
+static void ExpectPending(AL_TScRing const& ring, uint32_t uFirstPos, uint32_t uNumSC)
+{
+  ASSERT_EQ(uNumSC, ring.uNumSC);
+
+  for(uint32_t i = 0; i < uNumSC; ++i)
+    EXPECT_EQ(uFirstPos + i, AL_ScRing_Get(&ring, i)->uPosition) << "start code " << i;
+}
+
+TEST(ScRing, AppendWrapsAroundTheEndOfTheTable)
+{
+  vector<AL_TScTable> table(8);
+  AL_TScRing ring;
+  AL_ScRing_Init(&ring, table.data(), table.size());
+
+  AL_ScRing_Append(&ring, StartCodes(0, 6).data(), 6);
+  AL_ScRing_Consume(&ring, 5);
+  AL_ScRing_Append(&ring, StartCodes(6, 5).data(), 5);
+
+  ExpectPending(ring, 5, 6);
+  EXPECT_EQ(5u, ring.uHead);
+  EXPECT_EQ(8u, table[0].uPosition);
+  EXPECT_EQ(10u, table[2].uPosition);
+}
+
+TEST(ScRing, FreeSpanStopsAtTheEndOfTheTable)
+{
+  vector<AL_TScTable> table(8);
+  AL_TScRing ring;
+  AL_ScRing_Init(&ring, table.data(), table.size());
+
+  AL_ScRing_Append(&ring, StartCodes(0, 6).data(), 6);
+  AL_ScRing_Consume(&ring, 4);
+
+  uint32_t uNumFree;
+  AL_TScTable* pFree = AL_ScRing_GetFreeSpan(&ring, &uNumFree);
+  EXPECT_EQ(&table[6], pFree);
+  EXPECT_EQ(2u, uNumFree);
+  EXPECT_EQ(6u, AL_ScRing_GetFree(&ring));
+
+  pFree[0].uPosition = 6;
+  pFree[1].uPosition = 7;
+  AL_ScRing_Commit(&ring, 2);
+
+  /* the next span starts at the beginning of the table, up to the head */
+  pFree = AL_ScRing_GetFreeSpan(&ring, &uNumFree);
+  EXPECT_EQ(&table[0], pFree);
+  EXPECT_EQ(4u, uNumFree);
+
+  ExpectPending(ring, 4, 4);
+}
+
+TEST(ScRing, FullRing)
+{
+  vector<AL_TScTable> table(8);
+  AL_TScRing ring;
+  AL_ScRing_Init(&ring, table.data(), table.size());
+
+  AL_ScRing_Append(&ring, StartCodes(0, 3).data(), 3);
+  AL_ScRing_Consume(&ring, 3);
+  AL_ScRing_Append(&ring, StartCodes(3, 8).data(), 8);
+
+  uint32_t uNumFree;
+  AL_ScRing_GetFreeSpan(&ring, &uNumFree);
+  EXPECT_EQ(0u, uNumFree);
+  EXPECT_EQ(0u, AL_ScRing_GetFree(&ring));
+  ExpectPending(ring, 3, 8);
+
+  AL_ScRing_Consume(&ring, 2);
+  AL_ScRing_GetFreeSpan(&ring, &uNumFree);
+  EXPECT_EQ(2u, uNumFree);
+
+  AL_ScRing_Reset(&ring);
+  EXPECT_EQ(8u, AL_ScRing_GetFree(&ring));
+}
+
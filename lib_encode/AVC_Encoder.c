@@ -73,7 +73,9 @@ static void EndEncoding(void* pUserParam, AL_TEncPicStatus* pPicStatus, AL_TBuff
 
   if(!(pPicStatus->eErrorCode & AL_ERROR || pPicStatus->bSkip))
   {
-    AL_AVC_UpdatePPS(&pCtx->m_pps, pPicStatus);
+    if(AL_AVC_UpdatePPS(&pCtx->m_pps, pPicStatus))
+      InvalidateCachedNal(&pCtx->m_paramSetsCache.pps);
+
     AVC_GenerateSections(pCtx, pStream, pPicStatus);
 
     if(pPicStatus->eType == SLICE_I)
@@ -214,6 +216,7 @@ AL_ERR AL_AVC_Encoder_Create(AL_TEncCtx** hCtx, TScheduler* pScheduler, AL_TAllo
 
   AL_AVC_GenerateSPS(&pCtx->m_sps, &pCtx->m_Settings, pCtx->m_iMaxNumRef, pChParam->tRCParam.uCPBSize);
   AL_AVC_GeneratePPS(&pCtx->m_pps, &pCtx->m_Settings, pCtx->m_iMaxNumRef);
+  ResetParamSetsCache(&pCtx->m_paramSetsCache);
 
   if(pSettings->eScalingList != AL_SCL_FLAT)
     AL_AVC_PreprocessScalingList(&pCtx->m_sps.m_AvcSPS.scaling_list_param, &pCtx->m_tBufEP1);
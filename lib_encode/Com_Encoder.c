@@ -44,6 +44,8 @@
 #include <assert.h>
 #include "lib_common/Utils.h"
 #include "lib_preprocess/LoadLda.h"
+#include "lib_perfs/StageStats.h"
+#include "lib_perfs/Trace.h"
 
 
 /***************************************************************************/
@@ -70,6 +72,9 @@ static void RemoveSourceSent(AL_TEncCtx* pCtx, AL_TBuffer const* const pSrc)
 /***************************************************************************/
 void AL_Common_Encoder_EndEncoding2(AL_TEncCtx* pCtx, AL_TBuffer* pStream, AL_TBuffer* pSrc, AL_TBuffer* pQpTable, bool IsEndOfFrame, bool shouldReleaseSrc)
 {
+  if(IsEndOfFrame && pSrc)
+    AL_Trace_AsyncEnd("encode_frame", (AL_64U)(uintptr_t)pSrc);
+
   if(pCtx->m_callback.func)
     (*pCtx->m_callback.func)(pCtx->m_callback.userParam, pStream, pSrc);
 
@@ -272,6 +277,8 @@ bool AL_Common_Encoder_Process(AL_TEncoder* pEnc, AL_TBuffer* pFrame, AL_TBuffer
   if(!pFrame)
     return AL_ISchedulerEnc_EncodeOneFrame(pCtx->m_pScheduler, pCtx->m_hChannel, NULL, NULL, NULL);
 
+  AL_Trace_AsyncBegin("encode_frame", (AL_64U)(uintptr_t)pFrame);
+
   const int AL_DEFAULT_PPS_QP_26 = 26;
   AL_TFrameInfo* pFI = &pCtx->m_Pool[pCtx->m_iCurPool];
   AL_TEncRequestInfo* pReqInfo = &pFI->tRequestInfo;
@@ -329,7 +336,11 @@ bool AL_Common_Encoder_Process(AL_TEncoder* pEnc, AL_TBuffer* pFrame, AL_TBuffer
   pCtx->m_iCurPool = (pCtx->m_iCurPool + 1) % ENC_MAX_CMD;
 
   AddSourceSent(pCtx, pFrame);
+  AL_TStageClock tSubmit = AL_StageStats_Begin();
+  AL_Trace_Begin("submit_frame");
   bool bRet = AL_ISchedulerEnc_EncodeOneFrame(pCtx->m_pScheduler, pCtx->m_hChannel, pEI, pReqInfo, &addresses);
+  AL_Trace_End("submit_frame");
+  AL_StageStats_End(AL_STAGE_SUBMIT, tSubmit);
 
   Rtos_Memset(pReqInfo, 0, sizeof(*pReqInfo));
   Rtos_Memset(pEI, 0, sizeof(*pEI));
@@ -520,6 +531,7 @@ NalsData AL_ExtractNalsData(AL_TEncCtx* pCtx)
   data.vps = &pCtx->m_vps;
   data.sps = &pCtx->m_sps;
   data.pps = &pCtx->m_pps;
+  data.paramSetsCache = &pCtx->m_paramSetsCache;
   data.shouldWriteAud = pCtx->m_Settings.bEnableAUD;
   data.shouldWriteFillerData = pCtx->m_Settings.bEnableFillerData;
 
@@ -78,7 +78,9 @@ static void EndEncoding(void* pUserParam, AL_TEncPicStatus* pPicStatus, AL_TBuff
 
   if(!(pPicStatus->eErrorCode & AL_ERROR || pPicStatus->bSkip))
   {
-    AL_HEVC_UpdatePPS(&pCtx->m_pps, pPicStatus);
+    if(AL_HEVC_UpdatePPS(&pCtx->m_pps, pPicStatus))
+      InvalidateCachedNal(&pCtx->m_paramSetsCache.pps);
+
     HEVC_GenerateSections(pCtx, pStream, pPicStatus);
 
     if(pPicStatus->eType == SLICE_I)
@@ -235,6 +237,7 @@ AL_ERR AL_HEVC_Encoder_Create(AL_TEncCtx** hCtx, TScheduler* pScheduler, AL_TAll
   AL_HEVC_GenerateSPS(&pCtx->m_sps, &pCtx->m_Settings, pCtx->m_iMaxNumRef, pChParam->tRCParam.uCPBSize);
   AL_HEVC_GeneratePPS(&pCtx->m_pps, &pCtx->m_Settings, pCtx->m_iMaxNumRef);
   AL_HEVC_GenerateVPS(&pCtx->m_vps, &pCtx->m_Settings, pCtx->m_iMaxNumRef);
+  ResetParamSetsCache(&pCtx->m_paramSetsCache);
 
   if(pSettings->eScalingList != AL_SCL_FLAT)
     AL_HEVC_PreprocessScalingList(&pCtx->m_sps.m_HevcSPS.scaling_list_param, &pCtx->m_tBufEP1);
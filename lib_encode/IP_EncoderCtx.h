@@ -102,6 +102,7 @@ typedef struct AL_t_EncCtx
   int m_iLastIdrId;
 
   AL_SeiData m_seiData;
+  ParamSetsCache m_paramSetsCache;
 
   AL_TSrcBufferChecker m_srcBufferChecker;
   int m_iMaxNumRef;
@@ -42,6 +42,7 @@
 #include "lib_rtos/lib_rtos.h"
 #include "IP_Stream.h"
 #include "lib_common/SliceConsts.h"
+#include "lib_common/Utils.h"
 
 /****************************************************************************/
 NalHeader GetNalHeaderHevc(uint8_t uNUT, uint8_t uNalIdc)
@@ -75,9 +76,81 @@ static bool Matches(uint8_t const* pData)
   return !((pData[0] & 0xFF) || (pData[1] & 0xFF) || pData[2] & 0xFC);
 }
 
+/****************************************************************************/
+static uint64_t ReadWord(uint8_t const* pData)
+{
+  uint64_t uWord = 0;
+
+  for(int i = 0; i < 8; ++i)
+    uWord |= (uint64_t)pData[i] << (8 * i);
+
+  return uWord;
+}
+
+/****************************************************************************/
+/* Returns the position of the next 00 00 0x pattern (x <= 3) starting in
+ * [iByte, iLastByte], or iLastByte + 1 if there is none */
+static int FindEmulation(uint8_t const* pData, int iByte, int iLastByte)
+{
+  while(iByte <= iLastByte)
+  {
+    // no pattern can start in a word without zero byte
+    if(iByte + 8 <= iLastByte + 3)
+    {
+      if(!HasZeroByte(ReadWord(pData + iByte)))
+      {
+        iByte += 8;
+        continue;
+      }
+    }
+
+    if(pData[iByte + 2] > 3)
+      iByte += 3;
+    else if(pData[iByte + 1])
+      iByte += 2;
+    else if(pData[iByte])
+      iByte += 1;
+    else
+      return iByte;
+  }
+
+  return iLastByte + 1;
+}
+
+/****************************************************************************/
+static void AntiEmulBulk(AL_TBitStreamLite* pStream, uint8_t const* pData, int iNumBytes)
+{
+  uint8_t* pOut = AL_BitStreamLite_GetData(pStream) + AL_BitStreamLite_GetBitsCount(pStream) / 8;
+  uint8_t* const pOutStart = pOut;
+  int const iLastByte = iNumBytes - 3;
+  int iSpan = 0;
+  int iByte = 0;
+
+  // copy the clean spans and insert an emulation prevention byte after each 00 00
+  while((iByte = FindEmulation(pData, iByte, iLastByte)) <= iLastByte)
+  {
+    iByte += 2;
+    Rtos_Memcpy(pOut, pData + iSpan, iByte - iSpan);
+    pOut += iByte - iSpan;
+    *pOut++ = 0x03;
+    iSpan = iByte;
+  }
+
+  Rtos_Memcpy(pOut, pData + iSpan, iNumBytes - iSpan);
+  pOut += iNumBytes - iSpan;
+
+  AL_BitStreamLite_SkipBits(pStream, (pOut - pOutStart) * 8);
+}
+
 /****************************************************************************/
 static void AntiEmul(AL_TBitStreamLite* pStream, uint8_t const* pData, int iNumBytes)
 {
+  if(AL_BitStreamLite_GetBitsCount(pStream) % 8 == 0)
+  {
+    AntiEmulBulk(pStream, pData, iNumBytes);
+    return;
+  }
+
   // Write all but the last two bytes.
   int iByte;
 
@@ -1028,34 +1028,57 @@ void AL_HEVC_GeneratePPS(AL_TPps* pIPPS, AL_TEncSettings const* pSettings, int i
   pPPS->log2_parallel_merge_level_minus2 = 0; // parallel merge at 16x16 granularity
 }
 
-void AL_HEVC_UpdatePPS(AL_TPps* pIPPS, AL_TEncPicStatus const* pPicStatus)
+static bool UpdateS8(int8_t* pField, int8_t iValue)
+{
+  bool bChanged = *pField != iValue;
+  *pField = iValue;
+  return bChanged;
+}
+
+static bool UpdateU8(uint8_t* pField, uint8_t uValue)
+{
+  bool bChanged = *pField != uValue;
+  *pField = uValue;
+  return bChanged;
+}
+
+static bool UpdateU16(uint16_t* pField, uint16_t uValue)
+{
+  bool bChanged = *pField != uValue;
+  *pField = uValue;
+  return bChanged;
+}
+
+bool AL_HEVC_UpdatePPS(AL_TPps* pIPPS, AL_TEncPicStatus const* pPicStatus)
 {
   AL_THevcPps* pPPS = (AL_THevcPps*)pIPPS;
 
-  pPPS->init_qp_minus26 = pPicStatus->iPpsQP - 26;
+  bool bChanged = UpdateS8(&pPPS->init_qp_minus26, pPicStatus->iPpsQP - 26);
   int32_t const iNumClmn = pPicStatus->uNumClmn;
   int32_t const iNumRow = pPicStatus->uNumRow;
   int32_t const* pTileWidth = pPicStatus->iTileWidth;
   int32_t const* pTileHeight = pPicStatus->iTileHeight;
 
-  pPPS->num_tile_columns_minus1 = iNumClmn - 1;
-  pPPS->num_tile_rows_minus1 = iNumRow - 1;
+  bChanged |= UpdateU16(&pPPS->num_tile_columns_minus1, iNumClmn - 1);
+  bChanged |= UpdateU16(&pPPS->num_tile_rows_minus1, iNumRow - 1);
 
   if(!pPPS->num_tile_columns_minus1 && !pPPS->num_tile_rows_minus1)
-    pPPS->tiles_enabled_flag = 0;
+    bChanged |= UpdateU8(&pPPS->tiles_enabled_flag, 0);
   else
   {
     for(int iClmn = 0; iClmn < iNumClmn - 1; ++iClmn)
-      pPPS->column_width[iClmn] = pTileWidth[iClmn];
+      bChanged |= UpdateU16(&pPPS->column_width[iClmn], pTileWidth[iClmn]);
 
     for(int iRow = 0; iRow < iNumRow - 1; ++iRow)
-      pPPS->row_height[iRow] = pTileHeight[iRow];
+      bChanged |= UpdateU16(&pPPS->row_height[iRow], pTileHeight[iRow]);
   }
+
+  return bChanged;
 }
 
-void AL_AVC_UpdatePPS(AL_TPps* pIPPS, AL_TEncPicStatus const* pPicStatus)
+bool AL_AVC_UpdatePPS(AL_TPps* pIPPS, AL_TEncPicStatus const* pPicStatus)
 {
   AL_TAvcPps* pPPS = (AL_TAvcPps*)pIPPS;
-  pPPS->pic_init_qp_minus26 = pPicStatus->iPpsQP - 26;
+  return UpdateS8(&pPPS->pic_init_qp_minus26, pPicStatus->iPpsQP - 26);
 }
 
@@ -37,6 +37,7 @@
 
 #include "NalWriters.h"
 #include "lib_bitstream/RbspEncod.h"
+#include "lib_rtos/lib_rtos.h"
 
 static void audWrite(IRbspWriter* writer, AL_TBitStreamLite* bitstream, void const* param)
 {
@@ -82,10 +83,64 @@ AL_NalUnit AL_CreateVps(AL_THevcVps* vps)
   return nal;
 }
 
+void ResetSeiTemplates(SeiTemplates* templates)
+{
+  for(int i = 0; i < ENC_MAX_SEI_TEMPLATES; ++i)
+    templates->templates[i].iNumBits = 0;
+
+  templates->next = 0;
+}
+
+static SeiTemplate* getSeiTemplate(SeiTemplates* templates, uint32_t uFlags, int iPicStruct)
+{
+  for(int i = 0; i < ENC_MAX_SEI_TEMPLATES; ++i)
+  {
+    SeiTemplate* pTemplate = &templates->templates[i];
+
+    if(pTemplate->iNumBits && pTemplate->uFlags == uFlags && pTemplate->iPicStruct == iPicStruct)
+      return pTemplate;
+  }
+
+  SeiTemplate* pTemplate = &templates->templates[templates->next];
+  templates->next = (templates->next + 1) % ENC_MAX_SEI_TEMPLATES;
+
+  pTemplate->uFlags = uFlags;
+  pTemplate->iPicStruct = iPicStruct;
+  pTemplate->iNumBits = 0;
+  pTemplate->points.iNumPoints = 0;
+
+  return pTemplate;
+}
+
+static void seiPrefixPatch(SeiPrefixCtx const* pCtx, SeiTemplate const* pTemplate, AL_TBitStreamLite* bitstream)
+{
+  uint8_t* pData = AL_BitStreamLite_GetData(bitstream) + AL_BitStreamLite_GetBitsCount(bitstream) / 8;
+  Rtos_Memcpy(pData, pTemplate->data, pTemplate->iNumBits / 8);
+
+  AL_RbspEncoding_PatchSeiField(pData, &pTemplate->points, AL_SEI_FIELD_INITIAL_CPB_REMOVAL_DELAY, pCtx->cpbInitialRemovalDelay);
+  AL_RbspEncoding_PatchSeiField(pData, &pTemplate->points, AL_SEI_FIELD_CPB_REMOVAL_DELAY, pCtx->cpbRemovalDelay);
+  AL_RbspEncoding_PatchSeiField(pData, &pTemplate->points, AL_SEI_FIELD_DPB_OUTPUT_DELAY, pCtx->pPicStatus->uDpbOutputDelay);
+
+  AL_BitStreamLite_SkipBits(bitstream, pTemplate->iNumBits);
+}
+
 static void seiPrefixWrite(IRbspWriter* writer, AL_TBitStreamLite* bitstream, void const* param)
 {
   SeiPrefixCtx* pCtx = (SeiPrefixCtx*)param;
   uint32_t uFlags = pCtx->uFlags;
+  int const iStart = AL_BitStreamLite_GetBitsCount(bitstream);
+  SeiTemplate* pTemplate = NULL;
+
+  if(pCtx->templates && iStart % 8 == 0)
+    pTemplate = getSeiTemplate(pCtx->templates, uFlags, pCtx->pPicStatus->ePicStruct);
+
+  if(pTemplate && pTemplate->iNumBits)
+  {
+    seiPrefixPatch(pCtx, pTemplate, bitstream);
+    return;
+  }
+
+  AL_TSeiPatchPoints* pPoints = pTemplate ? &pTemplate->points : NULL;
 
   while(uFlags)
   {
@@ -93,7 +148,7 @@ static void seiPrefixWrite(IRbspWriter* writer, AL_TBitStreamLite* bitstream, vo
     {
       if(writer->WriteSEI_ActiveParameterSets)
         writer->WriteSEI_ActiveParameterSets(bitstream, pCtx->vps, pCtx->sps);
-      writer->WriteSEI_BufferingPeriod(bitstream, pCtx->sps, pCtx->cpbInitialRemovalDelay, 0);
+      writer->WriteSEI_BufferingPeriod(bitstream, pCtx->sps, pCtx->cpbInitialRemovalDelay, 0, pPoints);
       uFlags &= ~SEI_BP;
     }
     else if(uFlags & SEI_RP)
@@ -105,13 +160,28 @@ static void seiPrefixWrite(IRbspWriter* writer, AL_TBitStreamLite* bitstream, vo
     {
       writer->WriteSEI_PictureTiming(bitstream, pCtx->sps,
                                      pCtx->cpbRemovalDelay,
-                                     pCtx->pPicStatus->uDpbOutputDelay, pCtx->pPicStatus->ePicStruct);
+                                     pCtx->pPicStatus->uDpbOutputDelay, pCtx->pPicStatus->ePicStruct, pPoints);
       uFlags &= ~SEI_PT;
     }
 
     if(!uFlags)
       AL_RbspEncoding_CloseSEI(bitstream);
   }
+
+  if(!pTemplate || pTemplate->points.iNumPoints < 0)
+    return;
+
+  int const iNumBits = AL_BitStreamLite_GetBitsCount(bitstream) - iStart;
+
+  if(iNumBits / 8 > ENC_MAX_SEI_TEMPLATE_SIZE)
+    return;
+
+  Rtos_Memcpy(pTemplate->data, AL_BitStreamLite_GetData(bitstream) + iStart / 8, iNumBits / 8);
+
+  for(int i = 0; i < pTemplate->points.iNumPoints; ++i)
+    pTemplate->points.tPoints[i].uBitOffset -= iStart;
+
+  pTemplate->iNumBits = iNumBits;
 }
 
 AL_NalUnit AL_CreateSeiPrefix(SeiPrefixCtx* ctx, int nut)
@@ -54,6 +54,28 @@ AL_NalUnit AL_CreateSps(int nut, AL_TSps* sps);
 AL_NalUnit AL_CreatePps(int nut, AL_TPps* pps);
 AL_NalUnit AL_CreateVps(AL_THevcVps* vps);
 
+#define ENC_MAX_SEI_TEMPLATES 4
+#define ENC_MAX_SEI_TEMPLATE_SIZE 256
+
+/* sei prefix rbsp written once for a set of messages, only the fields
+ * given by the patch points change from one picture to the other */
+typedef struct
+{
+  uint32_t uFlags;
+  int iPicStruct;
+  int iNumBits; // 0 when the template isn't written yet
+  uint8_t data[ENC_MAX_SEI_TEMPLATE_SIZE];
+  AL_TSeiPatchPoints points;
+}SeiTemplate;
+
+typedef struct
+{
+  SeiTemplate templates[ENC_MAX_SEI_TEMPLATES];
+  int next; // template replaced when none matches
+}SeiTemplates;
+
+void ResetSeiTemplates(SeiTemplates* templates);
+
 #include "lib_common_enc/EncPicInfo.h"
 typedef struct t_SeiPrefixCtx
 {
@@ -64,6 +86,7 @@ typedef struct t_SeiPrefixCtx
   int cpbRemovalDelay;
   uint32_t uFlags;
   AL_TEncPicStatus const* pPicStatus;
+  SeiTemplates* templates; // may be NULL
 }SeiPrefixCtx;
 
 AL_NalUnit AL_CreateSeiPrefix(SeiPrefixCtx* ctx, int nut);
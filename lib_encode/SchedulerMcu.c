@@ -46,12 +46,16 @@
 #include "lib_rtos/lib_rtos.h"
 #include "lib_fpga/DmaAlloc.h"
 #include "lib_common/Error.h"
+#include "lib_common/Reactor.h"
+#include "lib_perfs/StageStats.h"
+#include "lib_perfs/Trace.h"
 
 typedef struct al_t_SchedulerMcu
 {
   const TSchedulerVtable* vtable;
   AL_TAllocator* allocator;
   Driver* driver;
+  AL_TReactor* reactor;
 }AL_TSchedulerMcu;
 
 typedef struct
@@ -61,6 +65,8 @@ typedef struct
   Driver* driver;
   int fd;
   AL_THREAD thread;
+  AL_TReactor* reactor;
+  AL_HANDLE hWatch; /* the status are waited for by the reactor, or by a thread if the handle can't be polled */
   int32_t shouldContinue;
 }Channel;
 
@@ -83,6 +89,7 @@ static void setCallbacks(Channel* chan, AL_TISchedulerCallBacks* pCBs);
 static bool getStatusMsg(Channel* chan, struct al5_params* msg);
 static void processStatusMsg(Channel* chan, struct al5_params* msg);
 static void* WaitForStatus(void* p);
+static bool OnStatusReady(void* p);
 
 static AL_ERR createChannel(AL_HANDLE* hChannel, TScheduler* pScheduler, AL_TEncChanParam* pChParam, AL_PADDR pEP1, AL_TISchedulerCallBacks* pCBs)
 {
@@ -122,10 +129,16 @@ static AL_ERR createChannel(AL_HANDLE* hChannel, TScheduler* pScheduler, AL_TEnc
 
   chan->shouldContinue = 1;
 
-  chan->thread = Rtos_CreateThread(&WaitForStatus, chan);
+  chan->reactor = schedulerMcu->reactor;
+  chan->hWatch = AL_Reactor_Watch(chan->reactor, chan->fd, &OnStatusReady, chan);
 
-  if(!chan->thread)
-    goto fail;
+  if(!chan->hWatch)
+  {
+    chan->thread = Rtos_CreateThread(&WaitForStatus, chan);
+
+    if(!chan->thread)
+      goto fail;
+  }
 
   SetChannelInfo(&chan->info, pChParam);
 
@@ -173,9 +186,14 @@ static bool destroyChannel(TScheduler* pScheduler, AL_HANDLE hChannel)
 
   AL_Driver_PostMessage(schedulerMcu->driver, chan->fd, AL_MCU_DESTROY_CHANNEL, NULL);
 
-  if(!Rtos_JoinThread(chan->thread))
-    return false;
-  Rtos_DeleteThread(chan->thread);
+  if(chan->hWatch)
+    AL_Reactor_Unwatch(chan->reactor, chan->hWatch);
+  else
+  {
+    if(!Rtos_JoinThread(chan->thread))
+      return false;
+    Rtos_DeleteThread(chan->thread);
+  }
 
   AL_Driver_Close(schedulerMcu->driver, chan->fd);
 
@@ -261,7 +279,27 @@ static void processStatusMsg(Channel* chan, struct al5_params* msg)
     pStatus = &status;
   }
 
+  AL_TStageClock tCallback = AL_StageStats_Begin();
+  AL_Trace_Begin("end_encoding");
   chan->CBs.pfnEndEncodingCallBack(chan->CBs.pEndEncodingCBParam, pStatus, streamBufferPtr);
+  AL_Trace_End("end_encoding");
+  AL_StageStats_End(AL_STAGE_CALLBACK, tCallback);
+}
+
+static bool OnStatusReady(void* p)
+{
+  Channel* chan = p;
+  struct al5_params msg = { 0 };
+
+  if(Rtos_AtomicDecrement(&chan->shouldContinue) < 0)
+    return false;
+  Rtos_AtomicIncrement(&chan->shouldContinue);
+
+  if(!getStatusMsg(chan, &msg))
+    return false;
+
+  processStatusMsg(chan, &msg);
+  return true;
 }
 
 static void* WaitForStatus(void* p)
@@ -330,11 +368,13 @@ TScheduler* AL_SchedulerMcu_Create(Driver* driver, AL_TAllocator* pDmaAllocator)
   scheduler->vtable = &McuSchedulerVtable;
   scheduler->driver = driver;
   scheduler->allocator = pDmaAllocator;
+  scheduler->reactor = AL_Reactor_Acquire();
   return (TScheduler*)scheduler;
 }
 
 bool AL_SchedulerMcu_Destroy(AL_TSchedulerMcu* schedulerMcu)
 {
+  AL_Reactor_Release(schedulerMcu->reactor);
   free(schedulerMcu);
 
   return true;
@@ -70,17 +70,58 @@ static void GenerateNal(IRbspWriter* writer, AL_TBitStreamLite* bitstream, AL_Na
   AL_StreamMetaData_AddSection(pMeta, start, end - start, uFlags);
 }
 
-static void GenerateConfigNalUnits(IRbspWriter* writer, AL_NalUnit* nals, int nalsCount, AL_TBuffer* pStream)
+void ResetParamSetsCache(ParamSetsCache* cache)
+{
+  InvalidateCachedNal(&cache->vps);
+  InvalidateCachedNal(&cache->sps);
+  InvalidateCachedNal(&cache->pps);
+  ResetSeiTemplates(&cache->seiPrefix);
+}
+
+void InvalidateCachedNal(CachedNal* nal)
+{
+  nal->size = 0;
+}
+
+static void GenerateCachedNal(IRbspWriter* writer, AL_TBitStreamLite* bitstream, AL_NalUnit* nal, CachedNal* cached, AL_TStreamMetaData* pMeta, uint32_t uFlags)
+{
+  int start = getBytesOffset(bitstream);
+
+  if(cached->size)
+  {
+    Rtos_Memcpy(AL_BitStreamLite_GetData(bitstream) + start, cached->data, cached->size);
+    AL_BitStreamLite_SkipBits(bitstream, cached->size * 8);
+    AL_StreamMetaData_AddSection(pMeta, start, cached->size, uFlags);
+    return;
+  }
+
+  GenerateNal(writer, bitstream, nal, pMeta, uFlags);
+
+  int size = getBytesOffset(bitstream) - start;
+
+  if(size <= ENC_MAX_CACHED_NAL_SIZE)
+  {
+    Rtos_Memcpy(cached->data, AL_BitStreamLite_GetData(bitstream) + start, size);
+    cached->size = size;
+  }
+}
+
+static void GenerateConfigNalUnits(IRbspWriter* writer, AL_NalUnit* nals, CachedNal** cachedNals, int nalsCount, AL_TBuffer* pStream)
 {
   AL_TBitStreamLite bitstream;
   AL_BitStreamLite_Init(&bitstream, AL_Buffer_GetData(pStream));
   AL_TStreamMetaData* pMetaData = (AL_TStreamMetaData*)AL_Buffer_GetMetaData(pStream, AL_META_TYPE_STREAM);
 
   for(int i = 0; i < nalsCount; i++)
-    GenerateNal(writer, &bitstream, &nals[i], pMetaData, SECTION_CONFIG_FLAG);
+  {
+    if(cachedNals[i])
+      GenerateCachedNal(writer, &bitstream, &nals[i], cachedNals[i], pMetaData, SECTION_CONFIG_FLAG);
+    else
+      GenerateNal(writer, &bitstream, &nals[i], pMetaData, SECTION_CONFIG_FLAG);
+  }
 }
 
-static SeiPrefixCtx createSeiPrefixCtx(AL_TSps* sps, AL_TPps* pps, AL_THevcVps* vps, int initialCpbRemovalDelay, int cpbRemovalDelay, AL_TEncPicStatus const* pPicStatus)
+static SeiPrefixCtx createSeiPrefixCtx(AL_TSps* sps, AL_TPps* pps, AL_THevcVps* vps, int initialCpbRemovalDelay, int cpbRemovalDelay, AL_TEncPicStatus const* pPicStatus, SeiTemplates* templates)
 {
   uint32_t uFlags = SEI_PT;
 
@@ -91,7 +132,7 @@ static SeiPrefixCtx createSeiPrefixCtx(AL_TSps* sps, AL_TPps* pps, AL_THevcVps*
     if(!pPicStatus->bIsIDR)
       uFlags |= SEI_RP;
   }
-  SeiPrefixCtx ctx = { sps, pps, vps, initialCpbRemovalDelay, cpbRemovalDelay, uFlags, pPicStatus };
+  SeiPrefixCtx ctx = { sps, pps, vps, initialCpbRemovalDelay, cpbRemovalDelay, uFlags, pPicStatus, templates };
   return ctx;
 }
 
@@ -118,6 +159,8 @@ void GenerateSections(IRbspWriter* writer, Nuts nuts, const NalsData* nalsData,
   if(pPicStatus->bIsFirstSlice)
   {
     AL_NalUnit nals[5];
+    CachedNal* cachedNals[5] = { NULL };
+    ParamSetsCache* cache = nalsData->paramSetsCache;
     int nalsCount = 0;
 
     if(nalsData->shouldWriteAud)
@@ -126,26 +169,33 @@ void GenerateSections(IRbspWriter* writer, Nuts nuts, const NalsData* nalsData,
     if(pPicStatus->bIsIDR)
     {
       if(writer->WriteVPS)
+      {
+        cachedNals[nalsCount] = cache ? &cache->vps : NULL;
         nals[nalsCount++] = AL_CreateVps(nalsData->vps);
+      }
 
+      cachedNals[nalsCount] = cache ? &cache->sps : NULL;
       nals[nalsCount++] = AL_CreateSps(nuts.spsNut, nalsData->sps);
     }
 
     if(pPicStatus->eType == SLICE_I)
+    {
+      cachedNals[nalsCount] = cache ? &cache->pps : NULL;
       nals[nalsCount++] = AL_CreatePps(nuts.ppsNut, nalsData->pps);
+    }
 
     SeiPrefixCtx ctx;
 
     if(nalsData->seiData)
     {
-      ctx = createSeiPrefixCtx(nalsData->sps, nalsData->pps, nalsData->vps, nalsData->seiData->initialCpbRemovalDelay, nalsData->seiData->cpbRemovalDelay, pPicStatus);
+      ctx = createSeiPrefixCtx(nalsData->sps, nalsData->pps, nalsData->vps, nalsData->seiData->initialCpbRemovalDelay, nalsData->seiData->cpbRemovalDelay, pPicStatus, cache ? &cache->seiPrefix : NULL);
       nals[nalsCount++] = AL_CreateSeiPrefix(&ctx, nuts.seiPrefixNut);
     }
 
     for(int i = 0; i < nalsCount; i++)
       nals[i].header = nuts.GetNalHeader(nals[i].nut, nals[i].idc);
 
-    GenerateConfigNalUnits(writer, nals, nalsCount, pStream);
+    GenerateConfigNalUnits(writer, nals, cachedNals, nalsCount, pStream);
   }
 
   AL_TStreamPart* pStreamParts = (AL_TStreamPart*)(AL_Buffer_GetData(pStream) + pPicStatus->uStreamPartOffset);
@@ -39,10 +39,13 @@
 #include "lib_common/BufferStreamMeta.h"
 #include "IP_Stream.h"
 #include "lib_bitstream/IRbspWriter.h"
+#include "NalWriters.h"
 #include "lib_common_enc/EncPicInfo.h"
 #include "lib_common/BufferAPI.h"
 
 #define ENC_MAX_HEADER_SIZE (2 * 1024)
+/* start code, nal header and emulation prevention bytes included */
+#define ENC_MAX_CACHED_NAL_SIZE (ENC_MAX_HEADER_SIZE * 3 / 2 + 8)
 
 typedef struct t_nuts
 {
@@ -61,11 +64,31 @@ typedef struct
   int cpbRemovalDelay;
 }AL_SeiData;
 
+/* nal unit as written in the stream the last time, the cache is emptied
+ * when the parameter set it comes from changes */
+typedef struct
+{
+  int size; // 0 when the nal unit has to be written again
+  uint8_t data[ENC_MAX_CACHED_NAL_SIZE];
+}CachedNal;
+
+typedef struct
+{
+  CachedNal vps;
+  CachedNal sps;
+  CachedNal pps;
+  SeiTemplates seiPrefix;
+}ParamSetsCache;
+
+void ResetParamSetsCache(ParamSetsCache* cache);
+void InvalidateCachedNal(CachedNal* nal);
+
 typedef struct
 {
   AL_THevcVps* vps;
   AL_TSps* sps;
   AL_TPps* pps;
+  ParamSetsCache* paramSetsCache;
   bool shouldWriteAud;
   bool shouldWriteFillerData;
   AL_SeiData* seiData;
@@ -0,0 +1,162 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+extern "C"
+{
+#include "lib_encode/IP_Stream.h"
+#include "lib_common/SliceConsts.h"
+}
+
+using namespace std;
+
+/* one PutBits per byte with a 3-byte check, as AntiEmul did before the span copy */
+static void FlushNALByByte(AL_TBitStreamLite* pStream, uint8_t* pData, int iNumBytes)
+{
+  AL_BitStreamLite_PutBits(pStream, 24, 0x000001);
+  AL_BitStreamLite_PutBits(pStream, 8, GetNalHeaderAvc(AL_AVC_NUT_VCL_NON_IDR, 3).bytes[0]);
+
+  for(int i = 0; i < iNumBytes; ++i)
+  {
+    AL_BitStreamLite_PutBits(pStream, 8, pData[i]);
+
+    if(i + 2 < iNumBytes && !pData[i] && !pData[i + 1] && pData[i + 2] <= 3)
+    {
+      AL_BitStreamLite_PutBits(pStream, 8, pData[++i]);
+      AL_BitStreamLite_PutBits(pStream, 8, 0x03);
+    }
+  }
+}
+
+static void FlushNALBySpan(AL_TBitStreamLite* pStream, uint8_t* pData, int iNumBytes)
+{
+  FlushNAL(pStream, AL_AVC_NUT_VCL_NON_IDR, GetNalHeaderAvc(AL_AVC_NUT_VCL_NON_IDR, 3), pData, iNumBytes * 8);
+}
+
+/* 1 MiB payload with a zero byte every iZeroPeriod bytes on average, 0 for none */
+static vector<uint8_t> Payload(int iZeroPeriod)
+{
+  mt19937 gen(iZeroPeriod);
+  vector<uint8_t> payload(1024 * 1024);
+
+  for(auto& uByte : payload)
+    uByte = (iZeroPeriod && !(gen() % iZeroPeriod)) ? 0x00 : 1 + gen() % 255;
+
+  return payload;
+}
+
+template<void(*Flush)(AL_TBitStreamLite*, uint8_t*, int)>
+static void BM_FlushNAL(benchmark::State& state)
+{
+  auto payload = Payload(state.range(0));
+  vector<uint8_t> buf(2 * payload.size());
+  vector<uint8_t> ref(2 * payload.size());
+  AL_TBitStreamLite stream;
+
+  AL_BitStreamLite_Init(&stream, ref.data());
+  FlushNALByByte(&stream, payload.data(), payload.size());
+  int const iRefBits = AL_BitStreamLite_GetBitsCount(&stream);
+
+  AL_BitStreamLite_Init(&stream, buf.data());
+  Flush(&stream, payload.data(), payload.size());
+
+  if(AL_BitStreamLite_GetBitsCount(&stream) != iRefBits || buf != ref)
+    state.SkipWithError("span copy differs from the byte loop");
+
+  for(auto _ : state)
+  {
+    AL_BitStreamLite_Reset(&stream);
+    Flush(&stream, payload.data(), payload.size());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(int64_t(state.iterations()) * payload.size());
+}
+
+/* 0: no zero byte, 16: zero heavy residuals */
+BENCHMARK_TEMPLATE(BM_FlushNAL, FlushNALByByte)->Arg(0)->Arg(16);
+BENCHMARK_TEMPLATE(BM_FlushNAL, FlushNALBySpan)->Arg(0)->Arg(16);
+
+/* one bit per call, as the header writers did before the word writes */
+static void PutUEByBit(AL_TBitStreamLite* pStream, uint32_t uValue)
+{
+  uint64_t uCode = (uint64_t)uValue + 1;
+  int iNumBits = 1;
+
+  while(uCode >> iNumBits)
+    ++iNumBits;
+
+  for(int i = 1; i < iNumBits; ++i)
+    AL_BitStreamLite_PutBit(pStream, 0);
+
+  for(int i = iNumBits - 1; i >= 0; --i)
+    AL_BitStreamLite_PutBit(pStream, (uCode >> i) & 1);
+}
+
+template<void(*PutUE)(AL_TBitStreamLite*, uint32_t)>
+static void BM_PutUE(benchmark::State& state)
+{
+  mt19937 gen(6);
+  vector<uint32_t> values(100 * 1000);
+
+  /* mostly short codes, as in the slice and parameter set headers */
+  for(auto& uValue : values)
+    uValue = gen() >> (20 + gen() % 12);
+
+  vector<uint8_t> buf(values.size() * 8);
+  AL_TBitStreamLite stream;
+  AL_BitStreamLite_Init(&stream, buf.data());
+
+  for(auto _ : state)
+  {
+    AL_BitStreamLite_Reset(&stream);
+
+    for(auto uValue : values)
+      PutUE(&stream, uValue);
+
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations()) * values.size());
+}
+
+BENCHMARK_TEMPLATE(BM_PutUE, PutUEByBit);
+BENCHMARK_TEMPLATE(BM_PutUE, AL_BitStreamLite_PutUE);
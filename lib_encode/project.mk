@@ -61,4 +61,6 @@ UNITTEST+=$(LIB_COMMON_ENC_SRC)
 UNITTEST+=$(LIB_PREPROCESS_SRC)
 UNITTEST+=$(LIB_RATECTRL_SRC)
 
+BENCHMARK+=$(shell find lib_encode/benchmarks -name "*.cpp")
+
 .PHONY: liballegro_encode liballegro_encode_dll liballegro_encode_a
@@ -1,5 +1,6 @@
 LIB_ENCODE_SRC+=\
 		lib_encode/SchedulerMcu.c \
 		lib_encode/hardwareDriver.c \
+		lib_encode/simulatedDriver.c \
 		lib_encode/driverDataConversions.c \
 
@@ -0,0 +1,556 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include "lib_encode/simulatedDriver.h"
+#include "lib_encode/driverInterface.h"
+
+#if __linux__
+
+#include <assert.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+#include "allegro_ioctl_mcu_enc.h"
+#include "lib_fpga/DmaAllocSim.h"
+#include "lib_common_enc/EncChanParam.h"
+#include "lib_common_enc/EncPicInfo.h"
+#include "lib_common_enc/EncSize.h"
+#include "lib_common/Utils.h"
+
+#define SIM_MAX_CHANNELS 32
+#define SIM_MAX_QUEUED AL_MAX_STREAM_BUFFER
+#define SIM_SLICE_SIZE 256
+
+typedef struct
+{
+  AL_64U UserParam;
+  AL_64U SrcHandle;
+  int16_t iPpsQP;
+  bool bEndOfStream;
+}SimFrame;
+
+typedef struct
+{
+  AL_PTR64 StreamBufferPtr;
+  bool bHasPicStatus;
+  AL_TEncPicStatus PicStatus;
+}SimStatus;
+
+typedef struct SimDriver SimDriver;
+
+typedef struct
+{
+  SimDriver* pDriver;
+  int fd; /* counts the statuses ready to be read */
+  bool bIsAvc;
+  uint16_t uGopLength;
+  uint32_t uFreqIDR;
+  int iNumEncoded;
+
+  pthread_mutex_t Lock;
+  pthread_cond_t JobDone;
+  int iJobsInFlight;
+  bool bDestroyed;
+
+  /* frames encoded by the device, waiting for a stream buffer */
+  SimFrame Frames[SIM_MAX_QUEUED];
+  int iFrameHead;
+  int iNumFrames;
+
+  struct al5_buffer StreamBuffers[SIM_MAX_QUEUED];
+  int iStreamHead;
+  int iNumStreams;
+
+  SimStatus Statuses[SIM_MAX_QUEUED];
+  int iStatusHead;
+  int iNumStatuses;
+}SimChannel;
+
+typedef struct
+{
+  SimChannel* pChan;
+  SimFrame Frame;
+}SimJob;
+
+struct SimDriver
+{
+  Driver base;
+  AL_TAllocator* pAllocator;
+  AL_TSimDevice* pDevice;
+  pthread_mutex_t Lock;
+  SimChannel* pChannels[SIM_MAX_CHANNELS];
+};
+
+/****************************************************************************/
+static SimChannel* GetChannel(SimDriver* pDriver, int fd)
+{
+  SimChannel* pChan = NULL;
+  pthread_mutex_lock(&pDriver->Lock);
+
+  for(int i = 0; i < SIM_MAX_CHANNELS; ++i)
+  {
+    if(pDriver->pChannels[i] && pDriver->pChannels[i]->fd == fd)
+    {
+      pChan = pDriver->pChannels[i];
+      break;
+    }
+  }
+
+  pthread_mutex_unlock(&pDriver->Lock);
+  return pChan;
+}
+
+/****************************************************************************/
+static void Signal(SimChannel* pChan, uint64_t uCount)
+{
+  while(write(pChan->fd, &uCount, sizeof(uCount)) < 0 && errno == EINTR)
+    ;
+}
+
+/****************************************************************************/
+static uint32_t WriteSlice(SimChannel* pChan, uint8_t* pData, uint32_t uAvail, bool bIsIDR)
+{
+  uint32_t uSize = UnsignedMin(SIM_SLICE_SIZE, uAvail);
+  uint8_t const Header[] = { 0x00, 0x00, 0x00, 0x01 };
+
+  if(uSize < sizeof(Header) + 2)
+    return 0;
+
+  Rtos_Memcpy(pData, Header, sizeof(Header));
+  uint32_t uPos = sizeof(Header);
+
+  if(pChan->bIsAvc)
+    pData[uPos++] = 0x60 | (bIsIDR ? 5 : 1);
+  else
+  {
+    pData[uPos++] = (bIsIDR ? 19 : 1) << 1;
+    pData[uPos++] = 1;
+  }
+
+  /* no zero byte: nothing to protect against start code emulation */
+  Rtos_Memset(pData + uPos, 0x55, uSize - uPos);
+  return uSize;
+}
+
+/****************************************************************************/
+/* locked. Builds the status of a frame in the next stream buffer */
+static void FillStatus(SimChannel* pChan, SimFrame const* pFrame, struct al5_buffer const* pStream, SimStatus* pStatus)
+{
+  AL_TEncPicStatus* pPicStatus = &pStatus->PicStatus;
+  int iFrame = pChan->iNumEncoded++;
+  bool bIsIntra = pChan->uGopLength <= 1 || (iFrame % pChan->uGopLength) == 0;
+
+  Rtos_Memset(pPicStatus, 0, sizeof(*pPicStatus));
+  pStatus->StreamBufferPtr = pStream->stream_buffer_ptr;
+  pStatus->bHasPicStatus = true;
+
+  pPicStatus->UserParam = pFrame->UserParam;
+  pPicStatus->SrcHandle = pFrame->SrcHandle;
+  pPicStatus->bIsRef = true;
+  pPicStatus->uNumClmn = 1;
+  pPicStatus->uNumRow = 1;
+  pPicStatus->iQP = pFrame->iPpsQP;
+  pPicStatus->iPpsQP = pFrame->iPpsQP;
+  pPicStatus->eType = bIsIntra ? SLICE_I : SLICE_P;
+  pPicStatus->ePicStruct = PS_FRM;
+  pPicStatus->bIsIDR = iFrame == 0 || (pChan->uFreqIDR && (iFrame % pChan->uFreqIDR) == 0);
+  pPicStatus->bIsFirstSlice = true;
+  pPicStatus->bIsLastSlice = true;
+  pPicStatus->eErrorCode = AL_SUCCESS;
+
+  uint8_t* pData = AL_SimDmaAllocator_GetVirtualAddrFromFd(pChan->pDriver->pAllocator, pStream->handle);
+  uint32_t uPartOffset = (pStream->offset + SIM_SLICE_SIZE + 3) & ~3;
+
+  if(!pData || uPartOffset + sizeof(AL_TStreamPart) > pStream->size)
+  {
+    pPicStatus->eErrorCode = AL_ERR_NO_MEMORY;
+    pPicStatus->bSkip = true;
+    return;
+  }
+
+  AL_TStreamPart* pPart = (AL_TStreamPart*)(pData + uPartOffset);
+  pPart->uOffset = pStream->offset;
+  pPart->uSize = WriteSlice(pChan, pData + pStream->offset, uPartOffset - pStream->offset, pPicStatus->bIsIDR);
+
+  pPicStatus->uSize = pPart->uSize;
+  pPicStatus->uStreamPartOffset = uPartOffset;
+  pPicStatus->iNumParts = 1;
+}
+
+/****************************************************************************/
+/* locked. The statuses are sent in order, once the frame has a stream buffer */
+static int SendStatuses(SimChannel* pChan)
+{
+  int iNumSent = 0;
+
+  while(pChan->iNumFrames && pChan->iNumStatuses < SIM_MAX_QUEUED)
+  {
+    SimFrame* pFrame = &pChan->Frames[pChan->iFrameHead];
+    SimStatus* pStatus = &pChan->Statuses[(pChan->iStatusHead + pChan->iNumStatuses) % SIM_MAX_QUEUED];
+
+    if(pFrame->bEndOfStream)
+    {
+      pStatus->StreamBufferPtr = 0;
+      pStatus->bHasPicStatus = false;
+    }
+    else
+    {
+      if(!pChan->iNumStreams)
+        break;
+
+      FillStatus(pChan, pFrame, &pChan->StreamBuffers[pChan->iStreamHead], pStatus);
+      pChan->iStreamHead = (pChan->iStreamHead + 1) % SIM_MAX_QUEUED;
+      --pChan->iNumStreams;
+    }
+
+    pChan->iFrameHead = (pChan->iFrameHead + 1) % SIM_MAX_QUEUED;
+    --pChan->iNumFrames;
+    ++pChan->iNumStatuses;
+    ++iNumSent;
+  }
+
+  return iNumSent;
+}
+
+/****************************************************************************/
+static void EndEncoding(void* pPayload)
+{
+  SimJob* pJob = (SimJob*)pPayload;
+  SimChannel* pChan = pJob->pChan;
+
+  pthread_mutex_lock(&pChan->Lock);
+  pChan->Frames[(pChan->iFrameHead + pChan->iNumFrames) % SIM_MAX_QUEUED] = pJob->Frame;
+  ++pChan->iNumFrames;
+  int iNumSent = SendStatuses(pChan);
+  --pChan->iJobsInFlight;
+  pthread_cond_broadcast(&pChan->JobDone);
+  pthread_mutex_unlock(&pChan->Lock);
+
+  if(iNumSent)
+    Signal(pChan, iNumSent);
+}
+
+/****************************************************************************/
+static bool ConfigChannel(SimChannel* pChan, struct al5_channel_config* pMsg)
+{
+  AL_TEncChanParam ChParam;
+  static_assert(sizeof(ChParam) <= sizeof(pMsg->param.opaque_params), "Driver channel_param struct is too small");
+  Rtos_Memcpy(&ChParam, pMsg->param.opaque_params, sizeof(ChParam));
+
+  pChan->bIsAvc = AL_IS_AVC(ChParam.eProfile);
+  pChan->uGopLength = ChParam.tGopParam.uGopLength;
+  pChan->uFreqIDR = ChParam.tGopParam.uFreqIDR;
+
+  pMsg->status.options = ChParam.eOptions;
+  pMsg->status.num_core = ChParam.uNumCore ? ChParam.uNumCore : 1;
+  pMsg->status.pps_param = ChParam.uPpsParam;
+  pMsg->status.error_code = 0;
+  return true;
+}
+
+/****************************************************************************/
+static bool EncodeOneFrame(SimChannel* pChan, struct al5_encode_msg* pMsg)
+{
+  SimJob Job;
+  Job.pChan = pChan;
+  Rtos_Memset(&Job.Frame, 0, sizeof(Job.Frame));
+
+  /* an empty message flushes the channel */
+  if(pMsg->params.size == 0)
+    Job.Frame.bEndOfStream = true;
+  else
+  {
+    AL_TEncInfo EncInfo;
+    Rtos_Memcpy(&EncInfo, pMsg->params.opaque_params, sizeof(EncInfo));
+    Job.Frame.UserParam = EncInfo.UserParam;
+    Job.Frame.SrcHandle = EncInfo.SrcHandle;
+    Job.Frame.iPpsQP = EncInfo.iPpsQP;
+  }
+
+  pthread_mutex_lock(&pChan->Lock);
+  bool bFull = pChan->bDestroyed || pChan->iNumFrames + pChan->iJobsInFlight >= SIM_MAX_QUEUED;
+
+  if(!bFull)
+    ++pChan->iJobsInFlight;
+  pthread_mutex_unlock(&pChan->Lock);
+
+  if(bFull)
+  {
+    errno = EBUSY;
+    return false;
+  }
+
+  return AL_SimDevice_Post(pChan->pDriver->pDevice, &EndEncoding, &Job, sizeof(Job));
+}
+
+/****************************************************************************/
+static bool PutStreamBuffer(SimChannel* pChan, struct al5_buffer* pBuffer)
+{
+  pthread_mutex_lock(&pChan->Lock);
+  bool bFull = pChan->iNumStreams == SIM_MAX_QUEUED;
+  int iNumSent = 0;
+
+  if(!bFull)
+  {
+    pChan->StreamBuffers[(pChan->iStreamHead + pChan->iNumStreams) % SIM_MAX_QUEUED] = *pBuffer;
+    ++pChan->iNumStreams;
+    iNumSent = SendStatuses(pChan);
+  }
+  pthread_mutex_unlock(&pChan->Lock);
+
+  if(iNumSent)
+    Signal(pChan, iNumSent);
+
+  return !bFull;
+}
+
+/****************************************************************************/
+static bool WaitForStatus(SimChannel* pChan, struct al5_params* pMsg)
+{
+  uint64_t uCount;
+
+  if(read(pChan->fd, &uCount, sizeof(uCount)) < 0)
+    return false;
+
+  pthread_mutex_lock(&pChan->Lock);
+  bool bReady = !pChan->bDestroyed && pChan->iNumStatuses;
+
+  if(bReady)
+  {
+    SimStatus* pStatus = &pChan->Statuses[pChan->iStatusHead];
+    static_assert(sizeof(AL_PTR64) + sizeof(AL_TEncPicStatus) <= sizeof(pMsg->opaque_params), "Driver struct is too small for AL_TEncPicStatus");
+
+    Rtos_Memcpy(pMsg->opaque_params, &pStatus->StreamBufferPtr, sizeof(AL_PTR64));
+    pMsg->size = sizeof(AL_PTR64);
+
+    if(pStatus->bHasPicStatus)
+    {
+      Rtos_Memcpy((char*)pMsg->opaque_params + sizeof(AL_PTR64), &pStatus->PicStatus, sizeof(AL_TEncPicStatus));
+      pMsg->size += sizeof(AL_TEncPicStatus);
+    }
+
+    pChan->iStatusHead = (pChan->iStatusHead + 1) % SIM_MAX_QUEUED;
+    --pChan->iNumStatuses;
+  }
+  pthread_mutex_unlock(&pChan->Lock);
+
+  return bReady;
+}
+
+/****************************************************************************/
+static void DestroyChannel(SimChannel* pChan)
+{
+  pthread_mutex_lock(&pChan->Lock);
+  pChan->bDestroyed = true;
+  pthread_mutex_unlock(&pChan->Lock);
+
+  /* wake up the status waiters for good */
+  Signal(pChan, UINT32_MAX);
+}
+
+/****************************************************************************/
+static int SimulatedDriver_Open(Driver* driver, const char* device)
+{
+  (void)device;
+  SimDriver* pDriver = (SimDriver*)driver;
+  SimChannel* pChan = calloc(1, sizeof(*pChan));
+
+  if(!pChan)
+    return -1;
+
+  pChan->pDriver = pDriver;
+  pChan->fd = eventfd(0, EFD_SEMAPHORE | EFD_CLOEXEC);
+
+  if(pChan->fd < 0)
+    goto fail;
+
+  pthread_mutex_init(&pChan->Lock, NULL);
+  pthread_cond_init(&pChan->JobDone, NULL);
+
+  pthread_mutex_lock(&pDriver->Lock);
+  int iSlot = 0;
+
+  while(iSlot < SIM_MAX_CHANNELS && pDriver->pChannels[iSlot])
+    ++iSlot;
+
+  if(iSlot < SIM_MAX_CHANNELS)
+    pDriver->pChannels[iSlot] = pChan;
+  pthread_mutex_unlock(&pDriver->Lock);
+
+  if(iSlot == SIM_MAX_CHANNELS)
+  {
+    pthread_cond_destroy(&pChan->JobDone);
+    pthread_mutex_destroy(&pChan->Lock);
+    close(pChan->fd);
+    goto fail;
+  }
+
+  return pChan->fd;
+
+  fail:
+  free(pChan);
+  return -1;
+}
+
+/****************************************************************************/
+static void SimulatedDriver_Close(Driver* driver, int fd)
+{
+  SimDriver* pDriver = (SimDriver*)driver;
+  SimChannel* pChan = NULL;
+
+  pthread_mutex_lock(&pDriver->Lock);
+
+  for(int i = 0; i < SIM_MAX_CHANNELS; ++i)
+  {
+    if(pDriver->pChannels[i] && pDriver->pChannels[i]->fd == fd)
+    {
+      pChan = pDriver->pChannels[i];
+      pDriver->pChannels[i] = NULL;
+      break;
+    }
+  }
+
+  pthread_mutex_unlock(&pDriver->Lock);
+
+  if(!pChan)
+    return;
+
+  /* the jobs still on the device refer to the channel */
+  pthread_mutex_lock(&pChan->Lock);
+
+  while(pChan->iJobsInFlight)
+    pthread_cond_wait(&pChan->JobDone, &pChan->Lock);
+
+  pthread_mutex_unlock(&pChan->Lock);
+
+  pthread_cond_destroy(&pChan->JobDone);
+  pthread_mutex_destroy(&pChan->Lock);
+  close(pChan->fd);
+  free(pChan);
+}
+
+/****************************************************************************/
+static bool SimulatedDriver_PostMessage(Driver* driver, int fd, long unsigned int messageId, void* data)
+{
+  SimChannel* pChan = GetChannel((SimDriver*)driver, fd);
+
+  if(!pChan)
+  {
+    errno = EBADF;
+    return false;
+  }
+
+  switch(messageId)
+  {
+  case AL_MCU_CONFIG_CHANNEL:
+    return ConfigChannel(pChan, (struct al5_channel_config*)data);
+  case AL_MCU_ENCODE_ONE_FRM:
+    return EncodeOneFrame(pChan, (struct al5_encode_msg*)data);
+  case AL_MCU_PUT_STREAM_BUFFER:
+    return PutStreamBuffer(pChan, (struct al5_buffer*)data);
+  case AL_MCU_WAIT_FOR_STATUS:
+    return WaitForStatus(pChan, (struct al5_params*)data);
+  case AL_MCU_DESTROY_CHANNEL:
+    DestroyChannel(pChan);
+    return true;
+  case AL_MCU_RELEASE_REC_PICTURE:
+    return true;
+  default:
+    /* no reconstructed picture is produced */
+    errno = EINVAL;
+    return false;
+  }
+}
+
+/****************************************************************************/
+Driver* AL_SimulatedDriver_Create(AL_TAllocator* pDmaAllocator, AL_TSimDeviceSettings const* pSettings)
+{
+  SimDriver* pDriver = calloc(1, sizeof(*pDriver));
+
+  if(!pDriver)
+    return NULL;
+
+  pDriver->base.Open = &SimulatedDriver_Open;
+  pDriver->base.Close = &SimulatedDriver_Close;
+  pDriver->base.PostMessage = &SimulatedDriver_PostMessage;
+  pDriver->pAllocator = pDmaAllocator;
+  pthread_mutex_init(&pDriver->Lock, NULL);
+  pDriver->pDevice = AL_SimDevice_Create(pSettings);
+
+  if(!pDriver->pDevice)
+  {
+    pthread_mutex_destroy(&pDriver->Lock);
+    free(pDriver);
+    return NULL;
+  }
+
+  return &pDriver->base;
+}
+
+/****************************************************************************/
+void AL_SimulatedDriver_Destroy(Driver* driver)
+{
+  SimDriver* pDriver = (SimDriver*)driver;
+
+  if(!pDriver)
+    return;
+
+  AL_SimDevice_Destroy(pDriver->pDevice);
+  pthread_mutex_destroy(&pDriver->Lock);
+  free(pDriver);
+}
+
+#else
+
+Driver* AL_SimulatedDriver_Create(AL_TAllocator* pDmaAllocator, AL_TSimDeviceSettings const* pSettings)
+{
+  (void)pDmaAllocator;
+  (void)pSettings;
+  return NULL;
+}
+
+void AL_SimulatedDriver_Destroy(Driver* driver)
+{
+  (void)driver;
+}
+
+#endif
+
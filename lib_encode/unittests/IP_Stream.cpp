@@ -0,0 +1,154 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+extern "C"
+{
+#include "lib_encode/IP_Stream.h"
+#include "lib_common/SliceConsts.h"
+}
+
+using namespace std;
+
+/* an emulation prevention byte after each 00 00 followed by a byte <= 3, the
+ * last two bytes of the payload are not checked */
+static vector<uint8_t> RefAntiEmul(vector<uint8_t> const& payload)
+{
+  vector<uint8_t> out;
+  size_t i = 0;
+
+  while(i < payload.size())
+  {
+    if(i + 2 < payload.size() && !payload[i] && !payload[i + 1] && payload[i + 2] <= 3)
+    {
+      out.insert(out.end(), { 0x00, 0x00, 0x03 });
+      i += 2;
+    }
+    else
+      out.push_back(payload[i++]);
+  }
+
+  return out;
+}
+
+/* random bytes with dense runs of 00, 01, 02 and 03 */
+static vector<uint8_t> Payload(mt19937& gen, int iSize)
+{
+  vector<uint8_t> payload(iSize);
+
+  for(auto& uByte : payload)
+    uByte = (gen() % 3) ? gen() % 4 : gen() % 256;
+
+  return payload;
+}
+
+/* writes iNumBits bits and returns the bytes FlushNAL appends after them */
+static vector<uint8_t> Flush(vector<uint8_t> payload, int iNumBits)
+{
+  vector<uint8_t> buf(2 * payload.size() + 64);
+  AL_TBitStreamLite stream;
+  AL_BitStreamLite_Init(&stream, buf.data());
+  AL_BitStreamLite_PutBits(&stream, iNumBits, (1u << iNumBits) - 1);
+
+  FlushNAL(&stream, AL_AVC_NUT_VCL_NON_IDR, GetNalHeaderAvc(AL_AVC_NUT_VCL_NON_IDR, 3), payload.data(), payload.size() * 8);
+
+  int const iNumBytes = (AL_BitStreamLite_GetBitsCount(&stream) - iNumBits) / 8;
+  vector<uint8_t> written(buf.begin(), buf.begin() + iNumBytes + 1);
+
+  /* realign the written bytes on the first bit written by FlushNAL */
+  vector<uint8_t> out(iNumBytes);
+
+  for(int i = 0; i < iNumBytes; ++i)
+    out[i] = (uint8_t)(((written[i] << 8) | written[i + 1]) >> (8 - iNumBits));
+
+  return out;
+}
+
+static vector<uint8_t> Expected(vector<uint8_t> const& payload)
+{
+  vector<uint8_t> expected { 0x00, 0x00, 0x01, (3 << 5) | AL_AVC_NUT_VCL_NON_IDR };
+  auto const escaped = RefAntiEmul(payload);
+  expected.insert(expected.end(), escaped.begin(), escaped.end());
+  return expected;
+}
+
+TEST(IP_Stream, FlushNALEscapesLikeTheByteLoop)
+{
+  mt19937 gen(3);
+
+  for(int iSize = 1; iSize < 80; ++iSize)
+  {
+    for(int i = 0; i < 50; ++i)
+    {
+      auto const payload = Payload(gen, iSize);
+      ASSERT_EQ(Expected(payload), Flush(payload, 0));
+    }
+  }
+}
+
+TEST(IP_Stream, FlushNALEscapesLikeTheByteLoopOnUnalignedStreams)
+{
+  mt19937 gen(4);
+
+  for(int iNumBits = 1; iNumBits < 8; ++iNumBits)
+  {
+    for(int i = 0; i < 200; ++i)
+    {
+      auto const payload = Payload(gen, 1 + gen() % 100);
+      ASSERT_EQ(Expected(payload), Flush(payload, iNumBits));
+    }
+  }
+}
+
+TEST(IP_Stream, FlushNALEscapesLargePayloads)
+{
+  mt19937 gen(5);
+
+  for(int iZeroPeriod : { 2, 16, 1024 })
+  {
+    vector<uint8_t> payload(256 * 1024);
+
+    for(auto& uByte : payload)
+      uByte = (gen() % iZeroPeriod) ? 1 + gen() % 255 : 0x00;
+
+    ASSERT_EQ(Expected(payload), Flush(payload, 0));
+  }
+}
@@ -0,0 +1,230 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+extern "C"
+{
+#include "lib_encode/NalWriters.h"
+#include "lib_encode/IP_Utils.h"
+#include "lib_bitstream/AVC_RbspEncod.h"
+#include "lib_bitstream/HEVC_RbspEncod.h"
+#include "lib_common/FourCC.h"
+#include "lib_common_enc/Settings.h"
+}
+
+using namespace std;
+
+struct SeiConfig
+{
+  AL_EProfile eProfile;
+  AL_ERateCtrlMode eRCMode;
+  int iGopLength;
+  int iNumB;
+  int iNumSlices;
+};
+
+struct SeiChannel
+{
+  AL_TEncSettings settings;
+  AL_TSps sps;
+  AL_TPps pps;
+  AL_THevcVps vps;
+  IRbspWriter* writer;
+
+  explicit SeiChannel(SeiConfig const& config)
+  {
+    AL_Settings_SetDefaults(&settings);
+    settings.tChParam.uWidth = 1920;
+    settings.tChParam.uHeight = 1080;
+    settings.tChParam.eProfile = config.eProfile;
+    settings.tChParam.tRCParam.eRCMode = config.eRCMode;
+    settings.tChParam.tGopParam.uGopLength = config.iGopLength;
+    settings.tChParam.tGopParam.uNumB = config.iNumB;
+    settings.tChParam.uNumSlices = config.iNumSlices;
+    AL_Settings_CheckCoherency(&settings, FOURCC(I420), NULL);
+
+    int const iMaxRef = config.iNumB ? 2 : 1;
+    int const iCpbSize = settings.tChParam.tRCParam.uCPBSize;
+
+    if(AL_IS_AVC(config.eProfile))
+    {
+      AL_AVC_GenerateSPS(&sps, &settings, iMaxRef, iCpbSize);
+      AL_AVC_GeneratePPS(&pps, &settings, iMaxRef);
+      writer = AL_GetAvcRbspWriter();
+    }
+    else
+    {
+      AL_HEVC_GenerateSPS(&sps, &settings, iMaxRef, iCpbSize);
+      AL_HEVC_GeneratePPS(&pps, &settings, iMaxRef);
+      AL_HEVC_GenerateVPS(&vps, &settings, iMaxRef);
+      writer = AL_GetHevcRbspWriter();
+    }
+  }
+};
+
+/* the sei prefix rbsp written at iByteOffset of a buffer full of garbage */
+static vector<uint8_t> WriteSeiPrefix(SeiChannel& channel, SeiPrefixCtx ctx, SeiTemplates* templates, int iByteOffset)
+{
+  vector<uint8_t> buf(iByteOffset + 2 * ENC_MAX_SEI_TEMPLATE_SIZE, 0xC5);
+  AL_TBitStreamLite bitstream;
+  AL_BitStreamLite_Init(&bitstream, buf.data());
+  AL_BitStreamLite_SkipBits(&bitstream, iByteOffset * 8);
+
+  ctx.templates = templates;
+  AL_NalUnit nal = AL_CreateSeiPrefix(&ctx, 0);
+  nal.Write(channel.writer, &bitstream, nal.param);
+
+  int const iNumBits = AL_BitStreamLite_GetBitsCount(&bitstream) - iByteOffset * 8;
+  EXPECT_EQ(0, iNumBits % 8);
+  return vector<uint8_t>(buf.begin() + iByteOffset, buf.begin() + iByteOffset + iNumBits / 8);
+}
+
+/* the delays, with runs of zero bytes so that the patched values make and
+ * break emulation patterns */
+static uint32_t Delay(mt19937& gen)
+{
+  switch(gen() % 4)
+  {
+  case 0: return gen() % 4;
+  case 1: return gen() % 0x10000;
+  case 2: return (gen() % 4) << 24;
+  default: return gen();
+  }
+}
+
+/* encodes 3 gops: the template writes and patches must give the rbsp of the
+ * direct writers on each picture */
+static void ExpectTemplatesMatchWriters(SeiConfig const& config, int iByteOffset)
+{
+  SeiChannel channel(config);
+  SeiTemplates templates;
+  ResetSeiTemplates(&templates);
+  mt19937 gen(config.iGopLength * 100 + config.iNumB * 10 + config.eRCMode);
+
+  for(int iPic = 0; iPic < 3 * config.iGopLength; ++iPic)
+  {
+    int const iPos = iPic % config.iGopLength;
+    AL_TEncPicStatus status {};
+    status.bIsIDR = iPic == 0;
+    status.eType = iPos == 0 ? SLICE_I : (iPos - 1) % (config.iNumB + 1) ? SLICE_B : SLICE_P;
+    status.ePicStruct = iPic % 7 == 6 ? PS_FRM_x2 : PS_FRM;
+    status.uDpbOutputDelay = Delay(gen);
+
+    uint32_t uFlags = SEI_PT;
+
+    if(status.eType == SLICE_I)
+      uFlags |= status.bIsIDR ? SEI_BP : SEI_BP | SEI_RP;
+
+    SeiPrefixCtx ctx { &channel.sps, &channel.pps, &channel.vps, (int)Delay(gen), (int)Delay(gen), uFlags, &status, NULL };
+
+    /* the prefix is written once per picture, before its first slice */
+    auto const expected = WriteSeiPrefix(channel, ctx, NULL, iByteOffset);
+    ASSERT_EQ(expected, WriteSeiPrefix(channel, ctx, &templates, iByteOffset)) << "picture " << iPic;
+  }
+
+  /* each set of messages and pic_struct was written once then patched */
+  int iNumTemplates = 0;
+
+  for(auto const& t : templates.templates)
+    iNumTemplates += t.iNumBits != 0;
+
+  EXPECT_LE(2, iNumTemplates);
+}
+
+static SeiConfig const seiConfigs[] =
+{
+  { AL_PROFILE_AVC_HIGH, AL_RC_CONST_QP, 30, 0, 1 },
+  { AL_PROFILE_AVC_HIGH, AL_RC_CBR, 30, 0, 1 },
+  { AL_PROFILE_AVC_HIGH, AL_RC_VBR, 16, 2, 4 },
+  { AL_PROFILE_AVC_HIGH, AL_RC_CBR, 8, 3, 2 },
+  { AL_PROFILE_HEVC_MAIN, AL_RC_CONST_QP, 30, 0, 1 },
+  { AL_PROFILE_HEVC_MAIN, AL_RC_CBR, 30, 0, 1 },
+  { AL_PROFILE_HEVC_MAIN, AL_RC_VBR, 16, 2, 4 },
+  { AL_PROFILE_HEVC_MAIN, AL_RC_CBR, 8, 3, 2 },
+};
+
+TEST(SeiTemplate, MatchesTheWritersOnEveryPicture)
+{
+  for(auto const& config : seiConfigs)
+  {
+    SCOPED_TRACE(AL_IS_AVC(config.eProfile) ? "avc" : "hevc");
+    SCOPED_TRACE(config.eRCMode);
+    ExpectTemplatesMatchWriters(config, 0);
+  }
+}
+
+TEST(SeiTemplate, MatchesTheWritersAfterOtherNals)
+{
+  for(auto const& config : seiConfigs)
+    ExpectTemplatesMatchWriters(config, 37);
+}
+
+TEST(SeiTemplate, MatchesTheWritersWithNalAndVclHrd)
+{
+  /* the hevc buffering period repeats the initial delay per cpb and per hrd */
+  for(auto const& config : seiConfigs)
+  {
+    SeiChannel channel(config);
+    mt19937 gen(7);
+    SeiTemplates templates;
+    ResetSeiTemplates(&templates);
+
+    AL_TSps sps = channel.sps;
+    auto& hrd = AL_IS_AVC(config.eProfile) ? sps.m_AvcSPS.vui_param.hrd_param : sps.m_HevcSPS.vui_param.hrd_param;
+    hrd.nal_hrd_parameters_present_flag = 1;
+    hrd.vcl_hrd_parameters_present_flag = 1;
+    hrd.cpb_cnt_minus1[0] = 1;
+
+    for(int iPic = 0; iPic < 20; ++iPic)
+    {
+      AL_TEncPicStatus status {};
+      status.bIsIDR = iPic == 0;
+      status.eType = iPic % 5 ? SLICE_P : SLICE_I;
+      status.uDpbOutputDelay = Delay(gen);
+
+      uint32_t uFlags = status.eType == SLICE_I ? SEI_PT | SEI_BP : SEI_PT;
+      SeiPrefixCtx ctx { &sps, &channel.pps, &channel.vps, (int)Delay(gen), (int)Delay(gen), uFlags, &status, NULL };
+
+      auto const expected = WriteSeiPrefix(channel, ctx, NULL, 0);
+      ASSERT_EQ(expected, WriteSeiPrefix(channel, ctx, &templates, 0)) << "picture " << iPic;
+    }
+  }
+}
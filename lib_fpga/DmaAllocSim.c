@@ -0,0 +1,328 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include "lib_fpga/DmaAllocSim.h"
+#include "lib_rtos/lib_rtos.h"
+
+#define SIM_PAGE_SIZE 4096
+#define SIM_FIRST_PHYSICAL_ADDR SIM_PAGE_SIZE
+#define SIM_LAST_PHYSICAL_ADDR 0xFFFFF000
+
+typedef struct
+{
+  AL_PADDR uPhysicalAddr;
+  uint32_t uSize; /* rounded up to a page */
+  uint8_t* pData;
+  void* pAlloc;
+}SimDmaBuffer;
+
+struct SimDmaCtx
+{
+  AL_TLinuxDmaAllocator base;
+  AL_MUTEX hLock;
+  SimDmaBuffer** ppBuffers; /* sorted by physical address */
+  int iNumBuffers;
+  int iMaxBuffers;
+};
+
+/******************************************************************************/
+/* locked. Index of the first buffer whose range ends after uPhysicalAddr */
+static int FindBuffer(struct SimDmaCtx* pCtx, AL_PADDR uPhysicalAddr)
+{
+  int iLow = 0;
+  int iHigh = pCtx->iNumBuffers;
+
+  while(iLow < iHigh)
+  {
+    int iMid = (iLow + iHigh) / 2;
+    SimDmaBuffer* pBuf = pCtx->ppBuffers[iMid];
+
+    if((AL_64U)pBuf->uPhysicalAddr + pBuf->uSize <= uPhysicalAddr)
+      iLow = iMid + 1;
+    else
+      iHigh = iMid;
+  }
+
+  return iLow;
+}
+
+/******************************************************************************/
+/* locked. Takes the room after the last buffer, or the first hole large enough
+ * once the end of the address space has been reached */
+static bool PlaceBuffer(struct SimDmaCtx* pCtx, uint32_t uSize, AL_PADDR* pPhysicalAddr, int* pIndex)
+{
+  AL_64U uStart = SIM_FIRST_PHYSICAL_ADDR;
+
+  if(pCtx->iNumBuffers)
+  {
+    SimDmaBuffer* pLast = pCtx->ppBuffers[pCtx->iNumBuffers - 1];
+    uStart = (AL_64U)pLast->uPhysicalAddr + pLast->uSize;
+  }
+
+  if(uStart + uSize <= SIM_LAST_PHYSICAL_ADDR)
+  {
+    *pPhysicalAddr = (AL_PADDR)uStart;
+    *pIndex = pCtx->iNumBuffers;
+    return true;
+  }
+
+  uStart = SIM_FIRST_PHYSICAL_ADDR;
+
+  for(int i = 0; i < pCtx->iNumBuffers; ++i)
+  {
+    SimDmaBuffer* pBuf = pCtx->ppBuffers[i];
+
+    if(uStart + uSize <= pBuf->uPhysicalAddr)
+    {
+      *pPhysicalAddr = (AL_PADDR)uStart;
+      *pIndex = i;
+      return true;
+    }
+
+    uStart = (AL_64U)pBuf->uPhysicalAddr + pBuf->uSize;
+  }
+
+  return false;
+}
+
+/******************************************************************************/
+/* locked */
+static bool InsertBuffer(struct SimDmaCtx* pCtx, SimDmaBuffer* pBuf)
+{
+  if(pCtx->iNumBuffers == pCtx->iMaxBuffers)
+  {
+    int iMaxBuffers = pCtx->iMaxBuffers ? 2 * pCtx->iMaxBuffers : 64;
+    SimDmaBuffer** ppBuffers = (SimDmaBuffer**)Rtos_Malloc(iMaxBuffers * sizeof(*ppBuffers));
+
+    if(!ppBuffers)
+      return false;
+
+    if(pCtx->iNumBuffers)
+      Rtos_Memcpy(ppBuffers, pCtx->ppBuffers, pCtx->iNumBuffers * sizeof(*ppBuffers));
+    Rtos_Free(pCtx->ppBuffers);
+    pCtx->ppBuffers = ppBuffers;
+    pCtx->iMaxBuffers = iMaxBuffers;
+  }
+
+  int iIndex;
+
+  if(!PlaceBuffer(pCtx, pBuf->uSize, &pBuf->uPhysicalAddr, &iIndex))
+    return false;
+
+  Rtos_Memmove(&pCtx->ppBuffers[iIndex + 1], &pCtx->ppBuffers[iIndex], (pCtx->iNumBuffers - iIndex) * sizeof(*pCtx->ppBuffers));
+  pCtx->ppBuffers[iIndex] = pBuf;
+  ++pCtx->iNumBuffers;
+  return true;
+}
+
+/******************************************************************************/
+static AL_HANDLE SimDma_Alloc(AL_TAllocator* pAllocator, size_t zSize)
+{
+  struct SimDmaCtx* pCtx = (struct SimDmaCtx*)pAllocator;
+
+  if(zSize == 0 || zSize > SIM_LAST_PHYSICAL_ADDR - SIM_FIRST_PHYSICAL_ADDR)
+    return NULL;
+
+  SimDmaBuffer* pBuf = (SimDmaBuffer*)Rtos_Malloc(sizeof(*pBuf));
+
+  if(!pBuf)
+    return NULL;
+
+  pBuf->uSize = (uint32_t)((zSize + SIM_PAGE_SIZE - 1) & ~(size_t)(SIM_PAGE_SIZE - 1));
+  pBuf->pAlloc = Rtos_Malloc(pBuf->uSize + SIM_PAGE_SIZE);
+
+  if(!pBuf->pAlloc)
+    goto fail;
+
+  /* same alignment as the physical address */
+  pBuf->pData = (uint8_t*)(((uintptr_t)pBuf->pAlloc + SIM_PAGE_SIZE - 1) & ~(uintptr_t)(SIM_PAGE_SIZE - 1));
+
+  Rtos_GetMutex(pCtx->hLock);
+  bool bInserted = InsertBuffer(pCtx, pBuf);
+  Rtos_ReleaseMutex(pCtx->hLock);
+
+  if(!bInserted)
+    goto fail;
+
+  return (AL_HANDLE)pBuf;
+
+  fail:
+  Rtos_Free(pBuf->pAlloc);
+  Rtos_Free(pBuf);
+  return NULL;
+}
+
+/******************************************************************************/
+static bool SimDma_Free(AL_TAllocator* pAllocator, AL_HANDLE hBuf)
+{
+  struct SimDmaCtx* pCtx = (struct SimDmaCtx*)pAllocator;
+  SimDmaBuffer* pBuf = (SimDmaBuffer*)hBuf;
+
+  if(!pBuf)
+    return true;
+
+  Rtos_GetMutex(pCtx->hLock);
+  int iIndex = FindBuffer(pCtx, pBuf->uPhysicalAddr);
+  bool bFound = iIndex < pCtx->iNumBuffers && pCtx->ppBuffers[iIndex] == pBuf;
+
+  if(bFound)
+  {
+    --pCtx->iNumBuffers;
+    Rtos_Memmove(&pCtx->ppBuffers[iIndex], &pCtx->ppBuffers[iIndex + 1], (pCtx->iNumBuffers - iIndex) * sizeof(*pCtx->ppBuffers));
+  }
+  Rtos_ReleaseMutex(pCtx->hLock);
+
+  if(!bFound)
+    return false;
+
+  Rtos_Free(pBuf->pAlloc);
+  Rtos_Free(pBuf);
+  return true;
+}
+
+/******************************************************************************/
+static AL_VADDR SimDma_GetVirtualAddr(AL_TAllocator* pAllocator, AL_HANDLE hBuf)
+{
+  (void)pAllocator;
+  return ((SimDmaBuffer*)hBuf)->pData;
+}
+
+/******************************************************************************/
+static AL_PADDR SimDma_GetPhysicalAddr(AL_TAllocator* pAllocator, AL_HANDLE hBuf)
+{
+  (void)pAllocator;
+  return ((SimDmaBuffer*)hBuf)->uPhysicalAddr;
+}
+
+/******************************************************************************/
+static bool SimDma_Destroy(AL_TAllocator* pAllocator)
+{
+  struct SimDmaCtx* pCtx = (struct SimDmaCtx*)pAllocator;
+
+  for(int i = 0; i < pCtx->iNumBuffers; ++i)
+  {
+    Rtos_Free(pCtx->ppBuffers[i]->pAlloc);
+    Rtos_Free(pCtx->ppBuffers[i]);
+  }
+
+  Rtos_Free(pCtx->ppBuffers);
+  Rtos_DeleteMutex(pCtx->hLock);
+  Rtos_Free(pCtx);
+  return true;
+}
+
+/******************************************************************************/
+/* the physical addresses are page aligned: the page number is a unique handle */
+static int SimDma_GetFd(AL_TLinuxDmaAllocator* pAllocator, AL_HANDLE hBuf)
+{
+  (void)pAllocator;
+  return (int)(((SimDmaBuffer*)hBuf)->uPhysicalAddr / SIM_PAGE_SIZE);
+}
+
+/******************************************************************************/
+static AL_HANDLE SimDma_ImportFromFd(AL_TLinuxDmaAllocator* pAllocator, int fd)
+{
+  /* the simulated device has no buffer of its own to share */
+  (void)pAllocator;
+  (void)fd;
+  return NULL;
+}
+
+/******************************************************************************/
+static const AL_DmaAllocLinuxVtable DmaAllocSimVtable =
+{
+  {
+    &SimDma_Destroy,
+    &SimDma_Alloc,
+    &SimDma_Free,
+    &SimDma_GetVirtualAddr,
+    &SimDma_GetPhysicalAddr,
+    NULL,
+  },
+  &SimDma_GetFd,
+  &SimDma_ImportFromFd,
+  &SimDma_GetFd,
+};
+
+AL_TAllocator* DmaAllocSim_Create(void)
+{
+  struct SimDmaCtx* pCtx = (struct SimDmaCtx*)Rtos_Malloc(sizeof(*pCtx));
+
+  if(!pCtx)
+    return NULL;
+
+  Rtos_Memset(pCtx, 0, sizeof(*pCtx));
+  pCtx->base.vtable = &DmaAllocSimVtable;
+  pCtx->hLock = Rtos_CreateMutex();
+
+  if(!pCtx->hLock)
+  {
+    Rtos_Free(pCtx);
+    return NULL;
+  }
+
+  return (AL_TAllocator*)pCtx;
+}
+
+/******************************************************************************/
+AL_VADDR AL_SimDmaAllocator_GetVirtualAddrFromPhysical(AL_TAllocator* pAllocator, AL_PADDR uPhysicalAddr)
+{
+  struct SimDmaCtx* pCtx = (struct SimDmaCtx*)pAllocator;
+  AL_VADDR pVirtualAddr = NULL;
+
+  Rtos_GetMutex(pCtx->hLock);
+  int iIndex = FindBuffer(pCtx, uPhysicalAddr);
+
+  if(iIndex < pCtx->iNumBuffers && pCtx->ppBuffers[iIndex]->uPhysicalAddr <= uPhysicalAddr)
+  {
+    SimDmaBuffer* pBuf = pCtx->ppBuffers[iIndex];
+    pVirtualAddr = pBuf->pData + (uPhysicalAddr - pBuf->uPhysicalAddr);
+  }
+  Rtos_ReleaseMutex(pCtx->hLock);
+
+  return pVirtualAddr;
+}
+
+/******************************************************************************/
+AL_VADDR AL_SimDmaAllocator_GetVirtualAddrFromFd(AL_TAllocator* pAllocator, int fd)
+{
+  if(fd <= 0)
+    return NULL;
+
+  return AL_SimDmaAllocator_GetVirtualAddrFromPhysical(pAllocator, (AL_PADDR)fd * SIM_PAGE_SIZE);
+}
+
@@ -17,3 +17,5 @@ ifeq ($(LIB_FPGA_SRC),)
 	LIB_FPGA_SRC+=lib_fpga/BoardNone.c
 endif
 
+# host memory stand-in for the simulated device
+LIB_FPGA_SRC+=lib_fpga/DmaAllocSim.c
@@ -0,0 +1,723 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+extern "C"
+{
+#include "lib_parsing/AvcParser.h"
+#include "lib_parsing/HevcParser.h"
+#include "lib_parsing/SliceHdrParsing.h"
+#include "lib_encode/NalWriters.h"
+#include "lib_encode/IP_Utils.h"
+#include "lib_bitstream/AVC_RbspEncod.h"
+#include "lib_bitstream/HEVC_RbspEncod.h"
+#include "lib_common/FourCC.h"
+#include "lib_common/Utils.h"
+#include "lib_common_dec/DecBuffers.h"
+#include "lib_common_enc/Settings.h"
+}
+
+using namespace std;
+
+static int const NUM_GOPS = 3;
+static int const GOP_LENGTH = 30;
+static int const NUM_B = 2;
+static int const NUM_SLICES = 4;
+static int const SLICE_DATA_SIZE = 512;
+
+struct Picture
+{
+  AL_ESliceType eType;
+  int iPoc;
+  int iFrameNum;
+};
+
+/* the decoding order of the encoder default gop: an idr picture then
+ * P B B groups, the B pictures aren't used as reference */
+static vector<Picture> GetPictures()
+{
+  vector<Picture> pictures;
+
+  for(int iGop = 0; iGop < NUM_GOPS; ++iGop)
+  {
+    int iFrameNum = 0;
+    pictures.push_back({ SLICE_I, 0, iFrameNum++ });
+
+    for(int iPoc = NUM_B + 1; iPoc < GOP_LENGTH; iPoc += NUM_B + 1)
+    {
+      pictures.push_back({ SLICE_P, iPoc, iFrameNum++ });
+
+      for(int b = NUM_B; b > 0; --b)
+        pictures.push_back({ SLICE_B, iPoc - b, iFrameNum });
+    }
+  }
+
+  return pictures;
+}
+
+struct NalRef
+{
+  int iOffset;
+  int iNut;
+  bool bFirstSlice;
+  int iAddress;
+  AL_ESliceType eType;
+  int iQpDelta;
+};
+
+/* an elementary stream holding the parameter sets and the slices of
+ * NUM_GOPS gops, the parameter sets written by the encoder rbsp writers and
+ * the slice headers following the syntax the parsed parameter sets select */
+struct Corpus
+{
+  AL_TEncSettings settings;
+  AL_TSps sps;
+  AL_TPps pps;
+  AL_THevcVps vps;
+  vector<uint8_t> stream;
+  vector<NalRef> paramSets;
+  vector<NalRef> slices;
+
+  explicit Corpus(AL_EProfile eProfile)
+  {
+    AL_Settings_SetDefaults(&settings);
+    settings.tChParam.uWidth = 1920;
+    settings.tChParam.uHeight = 1080;
+    settings.tChParam.eProfile = eProfile;
+    settings.tChParam.tGopParam.uGopLength = GOP_LENGTH;
+    settings.tChParam.tGopParam.uNumB = NUM_B;
+    settings.tChParam.uNumSlices = NUM_SLICES;
+    AL_Settings_CheckCoherency(&settings, FOURCC(I420), NULL);
+
+    /* the high level syntax flags the encoder channels set */
+    if(AL_IS_AVC(eProfile))
+    {
+      settings.tChParam.uSpsParam = 0x4A | AL_SPS_TEMPORAL_MVP_EN_FLAG;
+      settings.tChParam.uPpsParam = AL_PPS_DBF_OVR_EN_FLAG;
+    }
+    else
+    {
+      settings.tChParam.uSpsParam = 0x0A | AL_SPS_TEMPORAL_MVP_EN_FLAG;
+      settings.tChParam.uSpsParam |= ceil_log2(AL_NUM_RPS) << 8;
+      settings.tChParam.uPpsParam |= AL_PPS_ENABLE_REORDERING;
+    }
+  }
+
+  void AppendNal(int iNut, NalHeader header, AL_TBitStreamLite* pRbsp, NalRef ref)
+  {
+    int const iNumBits = AL_BitStreamLite_GetBitsCount(pRbsp);
+    vector<uint8_t> nal(2 * iNumBits / 8 + 16);
+    AL_TBitStreamLite bitstream;
+    AL_BitStreamLite_Init(&bitstream, nal.data());
+    FlushNAL(&bitstream, iNut, header, AL_BitStreamLite_GetData(pRbsp), iNumBits);
+
+    ref.iOffset = stream.size();
+    ref.iNut = iNut;
+    stream.insert(stream.end(), nal.begin(), nal.begin() + AL_BitStreamLite_GetBitsCount(&bitstream) / 8);
+
+    if(ref.iAddress < 0)
+      paramSets.push_back(ref);
+    else
+      slices.push_back(ref);
+  }
+
+  void AppendParamSet(IRbspWriter* writer, AL_NalUnit nal, NalHeader header)
+  {
+    vector<uint8_t> rbsp(4096);
+    AL_TBitStreamLite bitstream;
+    AL_BitStreamLite_Init(&bitstream, rbsp.data());
+    nal.Write(writer, &bitstream, nal.param);
+    AppendNal(nal.nut, header, &bitstream, { 0, 0, false, -1, SLICE_I, 0 });
+  }
+
+  /* slice data of random bytes, ended by the rbsp slice trailing bits */
+  void AppendSlice(int iNut, NalHeader header, AL_TBitStreamLite* pRbsp, mt19937& gen, NalRef ref)
+  {
+    for(int i = 0; i < SLICE_DATA_SIZE; ++i)
+      AL_BitStreamLite_PutU(pRbsp, 8, gen() & 0xFF);
+
+    AL_BitStreamLite_PutBit(pRbsp, 1);
+    AL_BitStreamLite_AlignWithBits(pRbsp, 0);
+    AppendNal(iNut, header, pRbsp, ref);
+  }
+};
+
+/* the last nal ends on the start code of an access unit delimiter, with the
+ * zero_byte the encoder writes before it */
+static vector<uint8_t> EndStream(vector<uint8_t> stream)
+{
+  uint8_t const aud[] = { 0x00, 0x00, 0x00, 0x01, 0x09, 0x10 };
+  stream.insert(stream.end(), begin(aud), end(aud));
+  return stream;
+}
+
+static void InitParser(vector<uint8_t>& stream, NalRef const& ref, uint8_t* pBuffer, AL_TRbspParser* pRP)
+{
+  TCircBuffer tStream {};
+  tStream.tMD.pVirtualAddr = stream.data();
+  tStream.tMD.uSize = stream.size();
+  tStream.uOffset = ref.iOffset;
+  tStream.uAvailSize = stream.size() - ref.iOffset;
+  InitRbspParser(&tStream, pBuffer, pRP);
+}
+
+/* parses the parameter sets as the decoder does, concealment included */
+static bool ParseAvcParamSets(vector<uint8_t>& stream, vector<NalRef> const& paramSets, uint8_t* pBuffer, AL_TAup* pAup, AL_TConceal* pConceal)
+{
+  AL_AVC_InitAUP(&pAup->avcAup);
+  AL_Conceal_Init(pConceal);
+
+  for(auto const& ref : paramSets)
+  {
+    /* the decoder clears its buffer before each non vcl nal */
+    memset(pBuffer, 0, NON_VCL_NAL_SIZE);
+    AL_TRbspParser rp;
+    InitParser(stream, ref, pBuffer, &rp);
+
+    if(ref.iNut == AL_AVC_NUT_SPS)
+    {
+      if(AL_AVC_ParseSPS(pAup, &rp) != AL_OK)
+        return false;
+    }
+    else
+    {
+      if(AL_AVC_ParsePPS(pAup, &rp) != AL_OK)
+        return false;
+
+      pConceal->m_bHasPPS = !pAup->avcAup.m_pPPS[0].bConceal;
+    }
+  }
+
+  return pConceal->m_bHasPPS && !pAup->avcAup.m_pSPS[0].bConceal;
+}
+
+static bool ParseHevcParamSets(vector<uint8_t>& stream, vector<NalRef> const& paramSets, uint8_t* pBuffer, AL_TAup* pAup, AL_TConceal* pConceal)
+{
+  AL_HEVC_InitAUP(&pAup->hevcAup);
+  AL_Conceal_Init(pConceal);
+
+  for(auto const& ref : paramSets)
+  {
+    /* the decoder clears its buffer before each non vcl nal */
+    memset(pBuffer, 0, NON_VCL_NAL_SIZE);
+    AL_TRbspParser rp;
+    InitParser(stream, ref, pBuffer, &rp);
+
+    if(ref.iNut == AL_HEVC_NUT_VPS)
+      ParseVPS(pAup, &rp);
+    else if(ref.iNut == AL_HEVC_NUT_SPS)
+    {
+      if(AL_HEVC_ParseSPS(pAup, &rp) != AL_OK)
+        return false;
+    }
+    else
+    {
+      uint8_t uPpsId;
+      AL_HEVC_ParsePPS(pAup, &rp, &uPpsId);
+
+      if(!pAup->hevcAup.m_pPPS[uPpsId].bConceal && pConceal->m_iLastPPSId <= uPpsId)
+        pConceal->m_iLastPPSId = uPpsId;
+    }
+  }
+
+  return pConceal->m_iLastPPSId == 0 && !pAup->hevcAup.m_pSPS[0].bConceal;
+}
+
+static int GetAvcSliceType(AL_ESliceType eType)
+{
+  switch(eType)
+  {
+  case SLICE_P: return 0;
+  case SLICE_B: return 1;
+  default: return 2;
+  }
+}
+
+static void WriteAvcSliceHeader(AL_TBitStreamLite* pBS, AL_TAvcPps const& pps, Picture const& pic, int iFirstMb, int iQpDelta)
+{
+  AL_TAvcSps const& sps = *pps.m_pSPS;
+  bool const bIdr = pic.eType == SLICE_I;
+
+  AL_BitStreamLite_PutUE(pBS, iFirstMb);
+  AL_BitStreamLite_PutUE(pBS, GetAvcSliceType(pic.eType));
+  AL_BitStreamLite_PutUE(pBS, 0); // pic_parameter_set_id
+  AL_BitStreamLite_PutU(pBS, sps.log2_max_frame_num_minus4 + 4, pic.iFrameNum % (1 << (sps.log2_max_frame_num_minus4 + 4)));
+
+  if(!sps.frame_mbs_only_flag)
+    AL_BitStreamLite_PutU(pBS, 1, 0); // field_pic_flag
+
+  if(bIdr)
+    AL_BitStreamLite_PutUE(pBS, 0); // idr_pic_id
+
+  if(sps.pic_order_cnt_type == 0)
+  {
+    AL_BitStreamLite_PutU(pBS, sps.log2_max_pic_order_cnt_lsb_minus4 + 4, 2 * pic.iPoc % (1 << (sps.log2_max_pic_order_cnt_lsb_minus4 + 4)));
+
+    if(pps.bottom_field_pic_order_in_frame_present_flag)
+      AL_BitStreamLite_PutSE(pBS, 0);
+  }
+
+  if(sps.pic_order_cnt_type == 1 && !sps.delta_pic_order_always_zero_flag)
+  {
+    AL_BitStreamLite_PutSE(pBS, 0);
+
+    if(pps.bottom_field_pic_order_in_frame_present_flag)
+      AL_BitStreamLite_PutSE(pBS, 0);
+  }
+
+  if(pps.redundant_pic_cnt_present_flag)
+    AL_BitStreamLite_PutUE(pBS, 0);
+
+  if(pic.eType == SLICE_B)
+    AL_BitStreamLite_PutU(pBS, 1, 1); // direct_spatial_mv_pred_flag
+
+  if(pic.eType != SLICE_I)
+  {
+    AL_BitStreamLite_PutU(pBS, 1, 0); // num_ref_idx_active_override_flag
+    AL_BitStreamLite_PutU(pBS, 1, 0); // ref_pic_list_reordering_flag_l0
+  }
+
+  if(pic.eType == SLICE_B)
+    AL_BitStreamLite_PutU(pBS, 1, 0); // ref_pic_list_reordering_flag_l1
+
+  if(pic.eType != SLICE_B)
+  {
+    if(bIdr)
+    {
+      AL_BitStreamLite_PutU(pBS, 1, 0); // no_output_of_prior_pics_flag
+      AL_BitStreamLite_PutU(pBS, 1, 0); // long_term_reference_flag
+    }
+    else
+      AL_BitStreamLite_PutU(pBS, 1, 0); // adaptive_ref_pic_marking_mode_flag
+  }
+
+  if(pps.entropy_coding_mode_flag && pic.eType != SLICE_I)
+    AL_BitStreamLite_PutUE(pBS, 0); // cabac_init_idc
+
+  AL_BitStreamLite_PutSE(pBS, iQpDelta);
+
+  if(pps.deblocking_filter_control_present_flag)
+  {
+    AL_BitStreamLite_PutUE(pBS, 0); // disable_deblocking_filter_idc
+    AL_BitStreamLite_PutSE(pBS, 0);
+    AL_BitStreamLite_PutSE(pBS, 0);
+  }
+
+  if(pps.entropy_coding_mode_flag)
+    AL_BitStreamLite_AlignWithBits(pBS, 1); // cabac_alignment_one_bit
+}
+
+struct AvcCorpus : Corpus
+{
+  unique_ptr<AL_TAup> aup;
+
+  AvcCorpus() : Corpus(AL_PROFILE_AVC_HIGH), aup(new AL_TAup {})
+  {
+    AL_AVC_GenerateSPS(&sps, &settings, 2, settings.tChParam.tRCParam.uCPBSize);
+    AL_AVC_GeneratePPS(&pps, &settings, 2);
+    IRbspWriter* writer = AL_GetAvcRbspWriter();
+    AppendParamSet(writer, AL_CreateSps(AL_AVC_NUT_SPS, &sps), GetNalHeaderAvc(AL_AVC_NUT_SPS, 3));
+    AppendParamSet(writer, AL_CreatePps(AL_AVC_NUT_PPS, &pps), GetNalHeaderAvc(AL_AVC_NUT_PPS, 3));
+
+    /* the slice header syntax depends on the parameter sets as parsed */
+    vector<uint8_t> paramSetStream = EndStream(stream);
+    vector<uint8_t> buffer(paramSetStream.size() + NON_VCL_NAL_SIZE);
+    AL_TConceal conceal;
+
+    if(!ParseAvcParamSets(paramSetStream, paramSets, buffer.data(), aup.get(), &conceal))
+      return;
+
+    AL_TAvcPps const& parsedPps = aup->avcAup.m_pPPS[0];
+    int const iNumMbs = (parsedPps.m_pSPS->pic_width_in_mbs_minus1 + 1) * (parsedPps.m_pSPS->pic_height_in_map_units_minus1 + 1);
+    mt19937 gen(11);
+
+    for(auto const& pic : GetPictures())
+    {
+      int const iNut = pic.eType == SLICE_I ? AL_AVC_NUT_VCL_IDR : AL_AVC_NUT_VCL_NON_IDR;
+      int const iNalRefIdc = pic.eType == SLICE_B ? 0 : 2;
+
+      for(int iSlice = 0; iSlice < NUM_SLICES; ++iSlice)
+      {
+        int const iFirstMb = iSlice * iNumMbs / NUM_SLICES;
+        vector<uint8_t> rbsp(2 * SLICE_DATA_SIZE);
+        AL_TBitStreamLite bitstream;
+        AL_BitStreamLite_Init(&bitstream, rbsp.data());
+        int const iQpDelta = (int)(gen() % 11) - 5;
+        WriteAvcSliceHeader(&bitstream, parsedPps, pic, iFirstMb, iQpDelta);
+        AppendSlice(iNut, GetNalHeaderAvc(iNut, iNalRefIdc), &bitstream, gen, { 0, 0, iSlice == 0, iFirstMb, pic.eType, iQpDelta });
+      }
+    }
+
+    stream = EndStream(stream);
+  }
+};
+
+/* the number of pictures of the short term reference picture set used by
+ * the current picture */
+static int GetNumPocTotalCurr(AL_THevcSps const& sps, int iRpsIdx)
+{
+  int iNumPocTotalCurr = 0;
+
+  for(int i = 0; i < sps.NumNegativePics[iRpsIdx]; ++i)
+    iNumPocTotalCurr += sps.UsedByCurrPicS0[iRpsIdx][i] ? 1 : 0;
+
+  for(int i = 0; i < sps.NumPositivePics[iRpsIdx]; ++i)
+    iNumPocTotalCurr += sps.UsedByCurrPicS1[iRpsIdx][i] ? 1 : 0;
+
+  return iNumPocTotalCurr;
+}
+
+static void WriteHevcSliceHeader(AL_TBitStreamLite* pBS, AL_THevcPps const& pps, Picture const& pic, int iAddress, int iQpDelta)
+{
+  AL_THevcSps const& sps = *pps.m_pSPS;
+  bool const bIdr = pic.eType == SLICE_I;
+  int const iRpsIdx = pic.eType == SLICE_P || sps.num_short_term_ref_pic_sets < 2 ? 0 : 1;
+  bool bTemporalMvp = false;
+
+  AL_BitStreamLite_PutU(pBS, 1, iAddress == 0); // first_slice_segment_in_pic_flag
+
+  if(bIdr)
+    AL_BitStreamLite_PutU(pBS, 1, 0); // no_output_of_prior_pics_flag
+
+  AL_BitStreamLite_PutUE(pBS, 0); // slice_pic_parameter_set_id
+
+  if(iAddress)
+  {
+    if(pps.dependent_slice_segments_enabled_flag)
+      AL_BitStreamLite_PutU(pBS, 1, 0);
+
+    AL_BitStreamLite_PutU(pBS, ceil_log2(sps.PicWidthInCtbs * sps.PicHeightInCtbs), iAddress);
+  }
+
+  if(pps.num_extra_slice_header_bits)
+    AL_BitStreamLite_PutU(pBS, pps.num_extra_slice_header_bits, 0);
+
+  AL_BitStreamLite_PutUE(pBS, pic.eType);
+
+  if(pps.output_flag_present_flag)
+    AL_BitStreamLite_PutU(pBS, 1, 1);
+
+  if(sps.separate_colour_plane_flag)
+    AL_BitStreamLite_PutU(pBS, 2, 0);
+
+  if(!bIdr)
+  {
+    AL_BitStreamLite_PutU(pBS, sps.log2_max_slice_pic_order_cnt_lsb_minus4 + 4, pic.iPoc % (1 << (sps.log2_max_slice_pic_order_cnt_lsb_minus4 + 4)));
+    AL_BitStreamLite_PutU(pBS, 1, 1); // short_term_ref_pic_set_sps_flag
+
+    if(sps.num_short_term_ref_pic_sets > 1)
+      AL_BitStreamLite_PutU(pBS, ceil_log2(sps.num_short_term_ref_pic_sets), iRpsIdx);
+
+    if(sps.long_term_ref_pics_present_flag)
+    {
+      if(sps.num_long_term_ref_pics_sps > 0)
+        AL_BitStreamLite_PutUE(pBS, 0);
+      AL_BitStreamLite_PutUE(pBS, 0);
+    }
+
+    if(sps.sps_temporal_mvp_enabled_flag)
+    {
+      AL_BitStreamLite_PutU(pBS, 1, 1);
+      bTemporalMvp = true;
+    }
+  }
+
+  if(sps.sample_adaptive_offset_enabled_flag)
+  {
+    AL_BitStreamLite_PutU(pBS, 1, 1); // slice_sao_luma_flag
+
+    if(sps.ChromaArrayType)
+      AL_BitStreamLite_PutU(pBS, 1, 1); // slice_sao_chroma_flag
+  }
+
+  if(pic.eType != SLICE_I)
+  {
+    AL_BitStreamLite_PutU(pBS, 1, 0); // num_ref_idx_active_override_flag
+
+    if(pps.lists_modification_present_flag && GetNumPocTotalCurr(sps, iRpsIdx) > 1)
+    {
+      AL_BitStreamLite_PutU(pBS, 1, 0); // ref_pic_list_modification_flag_l0
+
+      if(pic.eType == SLICE_B)
+        AL_BitStreamLite_PutU(pBS, 1, 0); // ref_pic_list_modification_flag_l1
+    }
+
+    if(pic.eType == SLICE_B)
+      AL_BitStreamLite_PutU(pBS, 1, 0); // mvd_l1_zero_flag
+
+    if(pps.cabac_init_present_flag)
+      AL_BitStreamLite_PutU(pBS, 1, 0);
+
+    if(bTemporalMvp)
+    {
+      if(pic.eType == SLICE_B)
+        AL_BitStreamLite_PutU(pBS, 1, 1); // collocated_from_l0_flag
+
+      if(pps.num_ref_idx_l0_default_active_minus1 > 0)
+        AL_BitStreamLite_PutUE(pBS, 0); // collocated_ref_idx
+    }
+
+    AL_BitStreamLite_PutUE(pBS, 0); // five_minus_max_num_merge_cand
+  }
+
+  AL_BitStreamLite_PutSE(pBS, iQpDelta);
+
+  if(pps.pps_slice_chroma_qp_offsets_present_flag)
+  {
+    AL_BitStreamLite_PutSE(pBS, 0);
+    AL_BitStreamLite_PutSE(pBS, 0);
+  }
+
+  if(pps.chroma_qp_offset_list_enabled_flag)
+    AL_BitStreamLite_PutU(pBS, 1, 0);
+
+  if(pps.deblocking_filter_control_present_flag && pps.deblocking_filter_override_enabled_flag)
+    AL_BitStreamLite_PutU(pBS, 1, 0); // deblocking_filter_override_flag
+
+  if(pps.loop_filter_across_slices_enabled_flag && (sps.sample_adaptive_offset_enabled_flag || !pps.pps_deblocking_filter_disabled_flag))
+    AL_BitStreamLite_PutU(pBS, 1, 1);
+
+  if(pps.tiles_enabled_flag || pps.entropy_coding_sync_enabled_flag)
+    AL_BitStreamLite_PutUE(pBS, 0); // num_entry_point_offsets
+
+  if(pps.slice_segment_header_extension_present_flag)
+    AL_BitStreamLite_PutUE(pBS, 0);
+
+  /* byte_alignment */
+  AL_BitStreamLite_PutBit(pBS, 1);
+  AL_BitStreamLite_AlignWithBits(pBS, 0);
+}
+
+struct HevcCorpus : Corpus
+{
+  unique_ptr<AL_TAup> aup;
+
+  HevcCorpus() : Corpus(AL_PROFILE_HEVC_MAIN), aup(new AL_TAup {})
+  {
+    AL_HEVC_GenerateVPS(&vps, &settings, 2);
+    AL_HEVC_GenerateSPS(&sps, &settings, 2, settings.tChParam.tRCParam.uCPBSize);
+    AL_HEVC_GeneratePPS(&pps, &settings, 2);
+    IRbspWriter* writer = AL_GetHevcRbspWriter();
+    AppendParamSet(writer, AL_CreateVps(&vps), GetNalHeaderHevc(AL_HEVC_NUT_VPS, 0));
+    AppendParamSet(writer, AL_CreateSps(AL_HEVC_NUT_SPS, &sps), GetNalHeaderHevc(AL_HEVC_NUT_SPS, 0));
+    AppendParamSet(writer, AL_CreatePps(AL_HEVC_NUT_PPS, &pps), GetNalHeaderHevc(AL_HEVC_NUT_PPS, 0));
+
+    /* the slice header syntax depends on the parameter sets as parsed */
+    vector<uint8_t> paramSetStream = EndStream(stream);
+    vector<uint8_t> buffer(paramSetStream.size() + NON_VCL_NAL_SIZE);
+    AL_TConceal conceal;
+
+    if(!ParseHevcParamSets(paramSetStream, paramSets, buffer.data(), aup.get(), &conceal))
+      return;
+
+    AL_THevcPps const& parsedPps = aup->hevcAup.m_pPPS[0];
+    int const iNumCtbs = parsedPps.m_pSPS->PicWidthInCtbs * parsedPps.m_pSPS->PicHeightInCtbs;
+    mt19937 gen(13);
+
+    for(auto const& pic : GetPictures())
+    {
+      int iNut = AL_HEVC_NUT_TRAIL_N;
+
+      if(pic.eType == SLICE_I)
+        iNut = AL_HEVC_NUT_IDR_W_RADL;
+      else if(pic.eType == SLICE_P)
+        iNut = AL_HEVC_NUT_TRAIL_R;
+
+      for(int iSlice = 0; iSlice < NUM_SLICES; ++iSlice)
+      {
+        int const iAddress = iSlice * iNumCtbs / NUM_SLICES;
+        vector<uint8_t> rbsp(2 * SLICE_DATA_SIZE);
+        AL_TBitStreamLite bitstream;
+        AL_BitStreamLite_Init(&bitstream, rbsp.data());
+        int const iQpDelta = (int)(gen() % 11) - 5;
+        WriteHevcSliceHeader(&bitstream, parsedPps, pic, iAddress, iQpDelta);
+        AppendSlice(iNut, GetNalHeaderHevc(iNut, 0), &bitstream, gen, { 0, 0, iSlice == 0, iAddress, pic.eType, iQpDelta });
+      }
+    }
+
+    stream = EndStream(stream);
+  }
+};
+
+static AvcCorpus& GetAvcCorpus()
+{
+  static AvcCorpus corpus;
+  return corpus;
+}
+
+static HevcCorpus& GetHevcCorpus()
+{
+  static HevcCorpus corpus;
+  return corpus;
+}
+
+static void BM_ParseAvcParamSets(benchmark::State& state)
+{
+  auto& corpus = GetAvcCorpus();
+  vector<uint8_t> buffer(corpus.stream.size() + NON_VCL_NAL_SIZE);
+  unique_ptr<AL_TAup> aup(new AL_TAup {});
+  AL_TConceal conceal;
+
+  for(auto _ : state)
+  {
+    if(!ParseAvcParamSets(corpus.stream, corpus.paramSets, buffer.data(), aup.get(), &conceal))
+    {
+      state.SkipWithError("invalid parameter sets");
+      break;
+    }
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations()) * corpus.paramSets.size());
+}
+
+static void BM_ParseHevcParamSets(benchmark::State& state)
+{
+  auto& corpus = GetHevcCorpus();
+  vector<uint8_t> buffer(corpus.stream.size() + NON_VCL_NAL_SIZE);
+  unique_ptr<AL_TAup> aup(new AL_TAup {});
+  AL_TConceal conceal;
+
+  for(auto _ : state)
+  {
+    if(!ParseHevcParamSets(corpus.stream, corpus.paramSets, buffer.data(), aup.get(), &conceal))
+    {
+      state.SkipWithError("invalid parameter sets");
+      break;
+    }
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations()) * corpus.paramSets.size());
+}
+
+/* parses the slice headers as the decoder does: the concealment state
+ * restarts on the first slice of each picture */
+static void BM_ParseAvcSliceHeaders(benchmark::State& state)
+{
+  auto& corpus = GetAvcCorpus();
+  vector<uint8_t> buffer(corpus.stream.size() + NON_VCL_NAL_SIZE);
+  AL_TConceal conceal;
+
+  if(!ParseAvcParamSets(corpus.stream, corpus.paramSets, buffer.data(), corpus.aup.get(), &conceal) || corpus.slices.empty())
+  {
+    state.SkipWithError("invalid parameter sets");
+    return;
+  }
+
+  for(auto _ : state)
+  {
+    for(auto const& ref : corpus.slices)
+    {
+      if(ref.bFirstSlice)
+      {
+        conceal.m_iFirstLCU = -1;
+        conceal.m_bValidFrame = false;
+      }
+
+      AL_TRbspParser rp;
+      InitParser(corpus.stream, ref, buffer.data(), &rp);
+      AL_TAvcSliceHdr slice {};
+
+      if(!AL_AVC_ParseSliceHeader(&slice, &rp, &conceal, corpus.aup->avcAup.m_pPPS) ||
+         slice.first_mb_in_slice != ref.iAddress || slice.slice_type != ref.eType || slice.slice_qp_delta != ref.iQpDelta)
+      {
+        state.SkipWithError("wrong slice header");
+        return;
+      }
+
+      conceal.m_bValidFrame = true;
+    }
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations()) * corpus.slices.size());
+}
+
+static void BM_ParseHevcSliceHeaders(benchmark::State& state)
+{
+  auto& corpus = GetHevcCorpus();
+  vector<uint8_t> buffer(corpus.stream.size() + NON_VCL_NAL_SIZE);
+  AL_TConceal conceal;
+
+  if(!ParseHevcParamSets(corpus.stream, corpus.paramSets, buffer.data(), corpus.aup.get(), &conceal) || corpus.slices.empty())
+  {
+    state.SkipWithError("invalid parameter sets");
+    return;
+  }
+
+  /* the last independent slice is the previous one, there are no
+   * dependent slice segments in the corpus */
+  vector<AL_THevcSliceHdr> slices(2);
+  int iCur = 0;
+
+  for(auto _ : state)
+  {
+    for(auto const& ref : corpus.slices)
+    {
+      if(ref.bFirstSlice)
+      {
+        conceal.m_iFirstLCU = -1;
+        conceal.m_bValidFrame = false;
+      }
+
+      AL_TRbspParser rp;
+      InitParser(corpus.stream, ref, buffer.data(), &rp);
+      AL_THevcSliceHdr& slice = slices[iCur];
+
+      if(!AL_HEVC_ParseSliceHeader(&slice, &slices[1 - iCur], &rp, &conceal, corpus.aup->hevcAup.m_pPPS) ||
+         (int)slice.slice_segment_address != ref.iAddress || slice.slice_type != ref.eType || slice.slice_qp_delta != ref.iQpDelta)
+      {
+        state.SkipWithError("wrong slice header");
+        return;
+      }
+
+      conceal.m_bValidFrame = true;
+      iCur = 1 - iCur;
+    }
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations()) * corpus.slices.size());
+}
+
+BENCHMARK(BM_ParseAvcParamSets);
+BENCHMARK(BM_ParseHevcParamSets);
+BENCHMARK(BM_ParseAvcSliceHeaders);
+BENCHMARK(BM_ParseHevcSliceHeaders);
@@ -12,3 +12,5 @@ LIB_PARSING_SRC:=\
 
 UNITTEST+=$(shell find lib_parsing/unittests -name "*.cpp")
 UNITTEST+=$(LIB_PARSING_SRC)
+
+BENCHMARK+=$(shell find lib_parsing/benchmarks -name "*.cpp")
@@ -0,0 +1,207 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include "lib_perfs/StageStats.h"
+#include "lib_rtos/lib_rtos.h"
+
+/* log-linear histograms: 16 linear sub buckets per power of two keep the
+ * relative error of a percentile under 1/16 over the full 64 bits range */
+#define SUB_BUCKET_BITS 4
+#define SUB_BUCKETS (1 << SUB_BUCKET_BITS)
+#define BUCKETS_NUM ((64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS)
+
+typedef struct
+{
+  int32_t iCount;
+  int64_t iWallTotal;
+  int64_t iCpuTotal;
+  int32_t iWall[BUCKETS_NUM];
+  int32_t iCpu[BUCKETS_NUM];
+}TStage;
+
+static int32_t g_iEnabled;
+static TStage g_Stages[AL_STAGE_MAX_ENUM];
+
+static char const* const g_StageNames[AL_STAGE_MAX_ENUM] =
+{
+  "file_read",
+  "conversion",
+  "process",
+  "scd",
+  "slice_header",
+  "submit",
+  "callback",
+  "write_out",
+};
+
+/****************************************************************************/
+static int MostSignificantBit(AL_64U uVal)
+{
+  int iBit = 0;
+
+  while(uVal >>= 1)
+    ++iBit;
+
+  return iBit;
+}
+
+/****************************************************************************/
+static int GetBucket(AL_64U uVal)
+{
+  if(uVal < SUB_BUCKETS)
+    return (int)uVal;
+
+  int iExp = MostSignificantBit(uVal);
+  int iSub = (int)(uVal >> (iExp - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+  return (iExp - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + iSub;
+}
+
+/****************************************************************************/
+static AL_64U GetBucketValue(int iBucket)
+{
+  if(iBucket < SUB_BUCKETS)
+    return iBucket;
+
+  int iExp = iBucket / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+  AL_64U uWidth = (AL_64U)1 << (iExp - SUB_BUCKET_BITS);
+  AL_64U uLow = ((AL_64U)1 << iExp) + (iBucket % SUB_BUCKETS) * uWidth;
+
+  /* middle of the bucket */
+  return uLow + uWidth / 2;
+}
+
+/****************************************************************************/
+static AL_64U GetPercentile(int32_t* pBuckets, AL_64U uCount, int iPerThousand)
+{
+  AL_64U uRank = (uCount * iPerThousand + 999) / 1000;
+  AL_64U uSeen = 0;
+
+  if(uRank == 0)
+    return 0;
+
+  for(int i = 0; i < BUCKETS_NUM; ++i)
+  {
+    uSeen += Rtos_AtomicLoad(&pBuckets[i]);
+
+    if(uSeen >= uRank)
+      return GetBucketValue(i);
+  }
+
+  return 0;
+}
+
+/****************************************************************************/
+void AL_StageStats_Enable(bool bEnable)
+{
+  Rtos_AtomicStore(&g_iEnabled, bEnable);
+}
+
+/****************************************************************************/
+bool AL_StageStats_IsEnabled(void)
+{
+  return Rtos_AtomicLoad(&g_iEnabled);
+}
+
+/****************************************************************************/
+void AL_StageStats_Reset(void)
+{
+  Rtos_Memset(g_Stages, 0, sizeof(g_Stages));
+}
+
+/****************************************************************************/
+AL_TStageClock AL_StageStats_Begin(void)
+{
+  AL_TStageClock tClock = { 0, 0 };
+
+  if(!AL_StageStats_IsEnabled())
+    return tClock;
+
+  tClock.uWall = Rtos_GetTimeNs();
+  tClock.uCpu = Rtos_GetThreadCpuTimeNs();
+  return tClock;
+}
+
+/****************************************************************************/
+void AL_StageStats_End(AL_EStage eStage, AL_TStageClock tBegin)
+{
+  /* statistics enabled after the stage began */
+  if(!tBegin.uWall)
+    return;
+
+  AL_64U uCpu = Rtos_GetThreadCpuTimeNs() - tBegin.uCpu;
+  AL_64U uWall = Rtos_GetTimeNs() - tBegin.uWall;
+
+  TStage* pStage = &g_Stages[eStage];
+  Rtos_AtomicIncrement(&pStage->iCount);
+  Rtos_AtomicAdd64(&pStage->iWallTotal, (int64_t)uWall);
+  Rtos_AtomicAdd64(&pStage->iCpuTotal, (int64_t)uCpu);
+  Rtos_AtomicIncrement(&pStage->iWall[GetBucket(uWall)]);
+  Rtos_AtomicIncrement(&pStage->iCpu[GetBucket(uCpu)]);
+}
+
+/****************************************************************************/
+char const* AL_StageStats_GetName(AL_EStage eStage)
+{
+  return g_StageNames[eStage];
+}
+
+/****************************************************************************/
+void AL_StageStats_GetReport(AL_EStage eStage, AL_TStageReport* pReport)
+{
+  static int const PerThousand[3] = { 500, 990, 999 };
+  TStage* pStage = &g_Stages[eStage];
+
+  Rtos_Memset(pReport, 0, sizeof(*pReport));
+  pReport->uCount = Rtos_AtomicLoad(&pStage->iCount);
+  pReport->uWallTotal = Rtos_AtomicAdd64(&pStage->iWallTotal, 0);
+  pReport->uCpuTotal = Rtos_AtomicAdd64(&pStage->iCpuTotal, 0);
+
+  for(int i = 0; i < 3; ++i)
+  {
+    pReport->uWall[i] = GetPercentile(pStage->iWall, pReport->uCount, PerThousand[i]);
+    pReport->uCpu[i] = GetPercentile(pStage->iCpu, pReport->uCount, PerThousand[i]);
+  }
+
+  for(int i = BUCKETS_NUM - 1; i >= 0; --i)
+  {
+    if(Rtos_AtomicLoad(&pStage->iWall[i]))
+    {
+      pReport->uWallMax = GetBucketValue(i);
+      break;
+    }
+  }
+}
@@ -0,0 +1,281 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include "lib_perfs/Trace.h"
+#include "lib_rtos/lib_rtos.h"
+
+#define TRACE_MAX_THREADS 64
+#define TRACE_RING_SIZE (1 << 14)
+
+typedef struct
+{
+  uint64_t uHead; /* only written by the owner thread, or by AL_Trace_Reset when no thread records */
+  bool bOwned; /* protected by s_iLock */
+  AL_TTraceEvent events[TRACE_RING_SIZE];
+}TTraceRing;
+
+static int32_t s_iEnabled;
+static int32_t s_iLock;
+static int32_t s_iNumRings;
+static int64_t s_iNumDropped;
+static TTraceRing* s_pRings[TRACE_MAX_THREADS];
+static AL_TLS s_ThreadRing;
+/* thread local value of the threads which didn't get a ring */
+static char s_NoRing;
+
+/****************************************************************************/
+static void Lock(void)
+{
+  while(!Rtos_AtomicCompareAndSwap(&s_iLock, 0, 1))
+    Rtos_Yield();
+}
+
+/****************************************************************************/
+static void Unlock(void)
+{
+  Rtos_AtomicStore(&s_iLock, 0);
+}
+
+/****************************************************************************/
+static void ReleaseThreadRing(void* pValue)
+{
+  if(pValue == &s_NoRing)
+    return;
+
+  TTraceRing* pRing = (TTraceRing*)pValue;
+
+  /* the events are kept, the next new thread goes on recording in this ring */
+  Lock();
+  pRing->bOwned = false;
+  Unlock();
+}
+
+/****************************************************************************/
+static TTraceRing* TakeFreeRing(void)
+{
+  int iNumRings = Rtos_AtomicLoad(&s_iNumRings);
+
+  for(int iRing = 0; iRing < iNumRings; ++iRing)
+  {
+    TTraceRing* pRing = s_pRings[iRing];
+
+    if(!pRing->bOwned)
+    {
+      pRing->bOwned = true;
+      return pRing;
+    }
+  }
+
+  return NULL;
+}
+
+/****************************************************************************/
+static TTraceRing* AcquireRing(void)
+{
+  Lock();
+  TTraceRing* pRing = TakeFreeRing();
+  bool bFull = Rtos_AtomicLoad(&s_iNumRings) >= TRACE_MAX_THREADS;
+  Unlock();
+
+  if(pRing || bFull)
+    return pRing;
+
+  /* allocate out of the lock, so the other threads do not spin during it */
+  TTraceRing* pNewRing = (TTraceRing*)Rtos_Malloc(sizeof(*pNewRing));
+
+  if(!pNewRing)
+    return NULL;
+
+  pNewRing->uHead = 0;
+  pNewRing->bOwned = true;
+
+  Lock();
+
+  /* a ring may have been released or added while the lock was free */
+  pRing = TakeFreeRing();
+  int iNumRings = Rtos_AtomicLoad(&s_iNumRings);
+
+  if(!pRing && iNumRings < TRACE_MAX_THREADS)
+  {
+    pRing = pNewRing;
+    pNewRing = NULL;
+    s_pRings[iNumRings] = pRing;
+    Rtos_AtomicStore(&s_iNumRings, iNumRings + 1);
+  }
+
+  Unlock();
+
+  Rtos_Free(pNewRing);
+  return pRing;
+}
+
+/****************************************************************************/
+static TTraceRing* GetThreadRing(void)
+{
+  void* pValue = Rtos_GetTls(s_ThreadRing);
+
+  if(pValue)
+    return pValue == &s_NoRing ? NULL : (TTraceRing*)pValue;
+
+  TTraceRing* pRing = AcquireRing();
+  Rtos_SetTls(s_ThreadRing, pRing ? (void*)pRing : &s_NoRing);
+  return pRing;
+}
+
+/****************************************************************************/
+void AL_Trace_Enable(bool bEnable)
+{
+  if(bEnable)
+  {
+    Lock();
+
+    if(!s_ThreadRing)
+      s_ThreadRing = Rtos_CreateTls(&ReleaseThreadRing);
+
+    bEnable = s_ThreadRing != NULL;
+    Unlock();
+  }
+
+  Rtos_AtomicStore(&s_iEnabled, bEnable);
+}
+
+/****************************************************************************/
+bool AL_Trace_IsEnabled(void)
+{
+  return Rtos_AtomicLoad(&s_iEnabled);
+}
+
+/****************************************************************************/
+void AL_Trace_Record(AL_ETracePhase ePhase, char const* sName, AL_64U uId)
+{
+  if(!AL_Trace_IsEnabled())
+    return;
+
+  TTraceRing* pRing = GetThreadRing();
+
+  if(!pRing)
+  {
+    Rtos_AtomicAdd64(&s_iNumDropped, 1);
+    return;
+  }
+
+  uint64_t uHead = pRing->uHead;
+  AL_TTraceEvent* pEvent = &pRing->events[uHead & (TRACE_RING_SIZE - 1)];
+  pEvent->uTimestamp = Rtos_GetTimeNs();
+  pEvent->uId = uId;
+  pEvent->sName = sName;
+  pEvent->iPhase = ePhase;
+
+  /* publish the event */
+  Rtos_AtomicStore64((int64_t*)&pRing->uHead, (int64_t)(uHead + 1));
+}
+
+/****************************************************************************/
+static uint64_t GetHead(TTraceRing* pRing)
+{
+  return (uint64_t)Rtos_AtomicLoad64((int64_t*)&pRing->uHead);
+}
+
+/****************************************************************************/
+void AL_Trace_Visit(AL_FN_TraceVisitor pfnVisit, void* pParam)
+{
+  int iNumRings = Rtos_AtomicLoad(&s_iNumRings);
+
+  for(int iRing = 0; iRing < iNumRings; ++iRing)
+  {
+    TTraceRing* pRing = s_pRings[iRing];
+    uint64_t uHead = GetHead(pRing);
+    uint64_t uTail = uHead > TRACE_RING_SIZE ? uHead - TRACE_RING_SIZE : 0;
+
+    for(uint64_t u = uTail; u < uHead; ++u)
+      pfnVisit(pParam, iRing, &pRing->events[u & (TRACE_RING_SIZE - 1)]);
+  }
+}
+
+/****************************************************************************/
+AL_64U AL_Trace_GetNumLost(void)
+{
+  AL_64U uNumLost = (AL_64U)Rtos_AtomicLoad64(&s_iNumDropped);
+  int iNumRings = Rtos_AtomicLoad(&s_iNumRings);
+
+  for(int iRing = 0; iRing < iNumRings; ++iRing)
+  {
+    uint64_t uHead = GetHead(s_pRings[iRing]);
+
+    if(uHead > TRACE_RING_SIZE)
+      uNumLost += uHead - TRACE_RING_SIZE;
+  }
+
+  return uNumLost;
+}
+
+/****************************************************************************/
+/* the heads belong to the recording threads, see the declaration */
+void AL_Trace_Reset(void)
+{
+  int iNumRings = Rtos_AtomicLoad(&s_iNumRings);
+
+  for(int iRing = 0; iRing < iNumRings; ++iRing)
+    Rtos_AtomicStore64((int64_t*)&s_pRings[iRing]->uHead, 0);
+
+  Rtos_AtomicStore64(&s_iNumDropped, 0);
+}
+
+/****************************************************************************/
+void AL_Trace_Deinit(void)
+{
+  Rtos_AtomicStore(&s_iEnabled, false);
+  Lock();
+
+  /* deleting the storage doesn't call the destructors on the freed rings */
+  if(s_ThreadRing)
+    Rtos_DeleteTls(s_ThreadRing);
+
+  s_ThreadRing = NULL;
+
+  int iNumRings = Rtos_AtomicLoad(&s_iNumRings);
+
+  for(int iRing = 0; iRing < iNumRings; ++iRing)
+  {
+    Rtos_Free(s_pRings[iRing]);
+    s_pRings[iRing] = NULL;
+  }
+
+  Rtos_AtomicStore(&s_iNumRings, 0);
+  Rtos_AtomicStore64(&s_iNumDropped, 0);
+  Unlock();
+}
@@ -0,0 +1,5 @@
+LIB_PERFS_SRC+=\
+	lib_perfs/StageStats.c\
+	lib_perfs/Trace.c\
+
+UNITTEST+=$(shell find lib_perfs/unittests -name "*.cpp")
@@ -0,0 +1,127 @@
+/******************************************************************************
+*
+* Copyright (C) 2017 Allegro DVT2.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX OR ALLEGRO DVT2 BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of  Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+*
+* Except as contained in this notice, the name of Allegro DVT2 shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Allegro DVT2.
+*
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+extern "C"
+{
+#include "lib_perfs/Trace.h"
+}
+
+using namespace std;
+
+static void CountEvent(void* pParam, int iThread, AL_TTraceEvent const* pEvent)
+{
+  (void)pEvent;
+  auto pCounts = (vector<int>*)pParam;
+
+  if((int)pCounts->size() <= iThread)
+    pCounts->resize(iThread + 1);
+
+  ++(*pCounts)[iThread];
+}
+
+static vector<int> CountEvents()
+{
+  vector<int> counts;
+  AL_Trace_Visit(&CountEvent, &counts);
+  return counts;
+}
+
+static void RecordEvents(int iNum)
+{
+  for(int i = 0; i < iNum; ++i)
+    AL_Trace_Instant("event");
+}
+
+TEST(Trace, KeepsTheLastEventsWhenTheRingWraps)
+{
+  AL_Trace_Enable(true);
+  thread t([] { RecordEvents(3 << 14); });
+  t.join();
+
+  auto counts = CountEvents();
+  ASSERT_EQ(1u, counts.size());
+  EXPECT_EQ(1 << 14, counts[0]);
+  EXPECT_EQ((AL_64U)(2 << 14), AL_Trace_GetNumLost());
+
+  AL_Trace_Deinit();
+  EXPECT_EQ(0u, CountEvents().size());
+  EXPECT_EQ(0u, AL_Trace_GetNumLost());
+}
+
+TEST(Trace, ReusesTheRingOfAnExitedThread)
+{
+  AL_Trace_Enable(true);
+
+  for(int i = 0; i < 200; ++i)
+  {
+    thread t([] { RecordEvents(10); });
+    t.join();
+  }
+
+  auto counts = CountEvents();
+  ASSERT_EQ(1u, counts.size());
+  EXPECT_EQ(2000, counts[0]);
+  EXPECT_EQ(0u, AL_Trace_GetNumLost());
+
+  AL_Trace_Deinit();
+}
+
+TEST(Trace, RecordsNothingOnceDeinit)
+{
+  AL_Trace_Enable(true);
+  thread t([] { RecordEvents(10); });
+  t.join();
+  AL_Trace_Deinit();
+
+  EXPECT_FALSE(AL_Trace_IsEnabled());
+  thread t2([] { RecordEvents(10); });
+  t2.join();
+  EXPECT_EQ(0u, CountEvents().size());
+
+  AL_Trace_Enable(true);
+  RecordEvents(10);
+  auto counts = CountEvents();
+  ASSERT_EQ(1u, counts.size());
+  EXPECT_EQ(10, counts[0]);
+
+  AL_Trace_Deinit();
+}
@@ -132,12 +132,58 @@ AL_64U Rtos_GetTime()
   return (uCount * 1000) / uFreq;
 }
 
+/****************************************************************************/
+AL_64U Rtos_GetTimeUs()
+{
+  AL_64U uCount, uFreq;
+  QueryPerformanceCounter((LARGE_INTEGER*)&uCount);
+  QueryPerformanceFrequency((LARGE_INTEGER*)&uFreq);
+
+  return (uCount / uFreq) * 1000000 + ((uCount % uFreq) * 1000000) / uFreq;
+}
+
+/****************************************************************************/
+AL_64U Rtos_GetTimeNs()
+{
+  AL_64U uCount, uFreq;
+  QueryPerformanceCounter((LARGE_INTEGER*)&uCount);
+  QueryPerformanceFrequency((LARGE_INTEGER*)&uFreq);
+
+  return (uCount / uFreq) * 1000000000 + ((uCount % uFreq) * 1000000000) / uFreq;
+}
+
+/****************************************************************************/
+AL_64U Rtos_GetThreadCpuTimeNs()
+{
+  FILETIME tCreation, tExit, tKernel, tUser;
+
+  if(!GetThreadTimes(GetCurrentThread(), &tCreation, &tExit, &tKernel, &tUser))
+    return 0;
+
+  AL_64U uKernel = ((AL_64U)tKernel.dwHighDateTime << 32) | tKernel.dwLowDateTime;
+  AL_64U uUser = ((AL_64U)tUser.dwHighDateTime << 32) | tUser.dwLowDateTime;
+
+  return (uKernel + uUser) * 100;
+}
+
 /****************************************************************************/
 void Rtos_Sleep(uint32_t uMillisecond)
 {
   Sleep(uMillisecond);
 }
 
+/****************************************************************************/
+void Rtos_SleepUs(uint32_t uMicrosecond)
+{
+  Sleep((uMicrosecond + 999) / 1000);
+}
+
+/****************************************************************************/
+void Rtos_Yield()
+{
+  SwitchToThread();
+}
+
 /****************************************************************************/
 AL_MUTEX Rtos_CreateMutex()
 {
@@ -241,6 +287,36 @@ void Rtos_DeleteThread(AL_THREAD Thread)
   free(Thread);
 }
 
+/****************************************************************************/
+AL_TLS Rtos_CreateTls(void (* pfnDestructor)(void* pValue))
+{
+  DWORD uIndex = FlsAlloc((PFLS_CALLBACK_FUNCTION)pfnDestructor);
+
+  if(uIndex == FLS_OUT_OF_INDEXES)
+    return NULL;
+
+  /* index 0 is valid: store it plus one */
+  return (AL_TLS)(uintptr_t)(uIndex + 1);
+}
+
+/****************************************************************************/
+void Rtos_DeleteTls(AL_TLS Tls)
+{
+  FlsFree((DWORD)(uintptr_t)Tls - 1);
+}
+
+/****************************************************************************/
+void* Rtos_GetTls(AL_TLS Tls)
+{
+  return FlsGetValue((DWORD)(uintptr_t)Tls - 1);
+}
+
+/****************************************************************************/
+bool Rtos_SetTls(AL_TLS Tls, void* pValue)
+{
+  return FlsSetValue((DWORD)(uintptr_t)Tls - 1, pValue);
+}
+
 void* Rtos_DriverOpen(char const* name)
 {
   (void)name;
@@ -267,10 +343,12 @@ int Rtos_DriverIoctl(void* drv, int req, void* data)
 #elif defined __linux__
 
 #include <sys/time.h>
+#include <time.h>
 #include <errno.h>
 #include <unistd.h>
 
 #include <pthread.h>
+#include <sched.h>
 #include <semaphore.h>
 
 typedef struct
@@ -289,12 +367,56 @@ AL_64U Rtos_GetTime()
   return ((AL_64U)Tv.tv_sec) * 1000 + (Tv.tv_usec / 1000);
 }
 
+/****************************************************************************/
+AL_64U Rtos_GetTimeUs()
+{
+  struct timespec Ts;
+  clock_gettime(CLOCK_MONOTONIC, &Ts);
+
+  return ((AL_64U)Ts.tv_sec) * 1000000 + (Ts.tv_nsec / 1000);
+}
+
+/****************************************************************************/
+AL_64U Rtos_GetTimeNs()
+{
+  struct timespec Ts;
+  clock_gettime(CLOCK_MONOTONIC, &Ts);
+
+  return ((AL_64U)Ts.tv_sec) * 1000000000 + Ts.tv_nsec;
+}
+
+/****************************************************************************/
+AL_64U Rtos_GetThreadCpuTimeNs()
+{
+  struct timespec Ts;
+
+  if(clock_gettime(CLOCK_THREAD_CPUTIME_ID, &Ts) < 0)
+    return 0;
+
+  return ((AL_64U)Ts.tv_sec) * 1000000000 + Ts.tv_nsec;
+}
+
 /****************************************************************************/
 void Rtos_Sleep(uint32_t uMillisecond)
 {
   usleep(uMillisecond * 1000);
 }
 
+/****************************************************************************/
+void Rtos_SleepUs(uint32_t uMicrosecond)
+{
+  struct timespec Ts = { uMicrosecond / 1000000, (uMicrosecond % 1000000) * 1000 };
+
+  while(nanosleep(&Ts, &Ts) < 0 && errno == EINTR)
+    ;
+}
+
+/****************************************************************************/
+void Rtos_Yield()
+{
+  sched_yield();
+}
+
 /****************************************************************************/
 AL_MUTEX Rtos_CreateMutex()
 {
@@ -348,6 +470,25 @@ bool Rtos_ReleaseMutex(AL_MUTEX Mutex)
   return true;
 }
 
+/****************************************************************************/
+/* the timed waits take an absolute CLOCK_REALTIME deadline */
+static struct timespec GetDeadline(uint32_t Wait)
+{
+  struct timespec Ts;
+  clock_gettime(CLOCK_REALTIME, &Ts);
+
+  Ts.tv_sec += Wait / 1000;
+  Ts.tv_nsec += (Wait % 1000) * 1000000;
+
+  if(Ts.tv_nsec >= 1000000000)
+  {
+    Ts.tv_sec += 1;
+    Ts.tv_nsec -= 1000000000;
+  }
+
+  return Ts;
+}
+
 /****************************************************************************/
 AL_SEMAPHORE Rtos_CreateSemaphore(int iInitialCount)
 {
@@ -403,9 +544,7 @@ bool Rtos_GetSemaphore(AL_SEMAPHORE Semaphore, uint32_t Wait)
   }
   else
   {
-    struct timespec Ts;
-    Ts.tv_sec = Wait / 1000;
-    Ts.tv_nsec = (Wait % 1000) * 1000000;
+    struct timespec Ts = GetDeadline(Wait);
 
     do
     {
@@ -477,9 +616,7 @@ bool Rtos_WaitEvent(AL_EVENT Event, uint32_t Wait)
   }
   else
   {
-    struct timespec Ts;
-    Ts.tv_sec = Wait / 1000;
-    Ts.tv_nsec = (Wait % 1000) * 1000000;
+    struct timespec Ts = GetDeadline(Wait);
 
     while(bRet && !pEvt->bSignaled)
       bRet = (pthread_cond_timedwait(&pEvt->Cond, &pEvt->Mutex, &Ts) == 0);
@@ -532,6 +669,38 @@ void Rtos_DeleteThread(AL_THREAD Thread)
   free((pthread_t*)Thread);
 }
 
+/****************************************************************************/
+AL_TLS Rtos_CreateTls(void (* pfnDestructor)(void* pValue))
+{
+  pthread_key_t* pKey = (pthread_key_t*)Rtos_Malloc(sizeof(pthread_key_t));
+
+  if(pKey && pthread_key_create(pKey, pfnDestructor))
+  {
+    Rtos_Free(pKey);
+    return NULL;
+  }
+  return (AL_TLS)pKey;
+}
+
+/****************************************************************************/
+void Rtos_DeleteTls(AL_TLS Tls)
+{
+  pthread_key_delete(*(pthread_key_t*)Tls);
+  Rtos_Free(Tls);
+}
+
+/****************************************************************************/
+void* Rtos_GetTls(AL_TLS Tls)
+{
+  return pthread_getspecific(*(pthread_key_t*)Tls);
+}
+
+/****************************************************************************/
+bool Rtos_SetTls(AL_TLS Tls, void* pValue)
+{
+  return pthread_setspecific(*(pthread_key_t*)Tls, pValue) == 0;
+}
+
 #include <sys/ioctl.h>
 #include <fcntl.h>
 
@@ -564,6 +733,11 @@ int Rtos_DriverIoctl(void* drv, int req, void* data)
 /* big lock instead of mutexes */
 /* semaphore cases should be carefully solved case by case */
 
+/****************************************************************************/
+void Rtos_Yield()
+{
+}
+
 /****************************************************************************/
 AL_MUTEX Rtos_CreateMutex()
 {
@@ -618,12 +792,48 @@ bool Rtos_ReleaseSemaphore(AL_SEMAPHORE Semaphore)
   return true;
 }
 
+/****************************************************************************/
+/* single thread: the value is never destroyed */
+AL_TLS Rtos_CreateTls(void (* pfnDestructor)(void* pValue))
+{
+  (void)pfnDestructor;
+  void** ppValue = Rtos_Malloc(sizeof(void*));
+
+  if(ppValue)
+    *ppValue = NULL;
+  return (AL_TLS)ppValue;
+}
+
+/****************************************************************************/
+void Rtos_DeleteTls(AL_TLS Tls)
+{
+  Rtos_Free(Tls);
+}
+
+/****************************************************************************/
+void* Rtos_GetTls(AL_TLS Tls)
+{
+  return *(void**)Tls;
+}
+
+/****************************************************************************/
+bool Rtos_SetTls(AL_TLS Tls, void* pValue)
+{
+  *(void**)Tls = pValue;
+  return true;
+}
+
 #endif
 
 #else
 
 /* big lock instead of mutexes */
 
+/****************************************************************************/
+void Rtos_Yield()
+{
+}
+
 typedef struct
 {
   int m_iCount;
@@ -690,6 +900,37 @@ bool Rtos_ReleaseSemaphore(AL_SEMAPHORE Semaphore)
   return true;
 }
 
+/****************************************************************************/
+/* single thread: the value is never destroyed */
+AL_TLS Rtos_CreateTls(void (* pfnDestructor)(void* pValue))
+{
+  (void)pfnDestructor;
+  void** ppValue = Rtos_Malloc(sizeof(void*));
+
+  if(ppValue)
+    *ppValue = NULL;
+  return (AL_TLS)ppValue;
+}
+
+/****************************************************************************/
+void Rtos_DeleteTls(AL_TLS Tls)
+{
+  Rtos_Free(Tls);
+}
+
+/****************************************************************************/
+void* Rtos_GetTls(AL_TLS Tls)
+{
+  return *(void**)Tls;
+}
+
+/****************************************************************************/
+bool Rtos_SetTls(AL_TLS Tls, void* pValue)
+{
+  *(void**)Tls = pValue;
+  return true;
+}
+
 #endif
 
 #ifdef _MSC_VER
@@ -703,6 +944,46 @@ int32_t Rtos_AtomicDecrement(int32_t* iVal)
   return InterlockedDecrement(iVal);
 }
 
+int32_t Rtos_AtomicAdd(int32_t* iVal, int32_t iAdd)
+{
+  return InterlockedExchangeAdd(iVal, iAdd) + iAdd;
+}
+
+int64_t Rtos_AtomicAdd64(int64_t* iVal, int64_t iAdd)
+{
+  return InterlockedExchangeAdd64(iVal, iAdd) + iAdd;
+}
+
+bool Rtos_AtomicCompareAndSwap(int32_t* iVal, int32_t iOld, int32_t iNew)
+{
+  return InterlockedCompareExchange(iVal, iNew, iOld) == iOld;
+}
+
+int32_t Rtos_AtomicLoad(int32_t* iVal)
+{
+  return InterlockedCompareExchange(iVal, 0, 0);
+}
+
+void Rtos_AtomicStore(int32_t* iVal, int32_t iNew)
+{
+  InterlockedExchange(iVal, iNew);
+}
+
+int64_t Rtos_AtomicLoad64(int64_t* iVal)
+{
+  return InterlockedCompareExchange64(iVal, 0, 0);
+}
+
+void Rtos_AtomicStore64(int64_t* iVal, int64_t iNew)
+{
+  InterlockedExchange64(iVal, iNew);
+}
+
+void Rtos_AcquireFence()
+{
+  MemoryBarrier();
+}
+
 #else
 
 int32_t Rtos_AtomicIncrement(int32_t* iVal)
@@ -715,5 +996,45 @@ int32_t Rtos_AtomicDecrement(int32_t* iVal)
   return __sync_sub_and_fetch(iVal, 1);
 }
 
+int32_t Rtos_AtomicAdd(int32_t* iVal, int32_t iAdd)
+{
+  return __sync_add_and_fetch(iVal, iAdd);
+}
+
+int64_t Rtos_AtomicAdd64(int64_t* iVal, int64_t iAdd)
+{
+  return __sync_add_and_fetch(iVal, iAdd);
+}
+
+bool Rtos_AtomicCompareAndSwap(int32_t* iVal, int32_t iOld, int32_t iNew)
+{
+  return __sync_bool_compare_and_swap(iVal, iOld, iNew);
+}
+
+int32_t Rtos_AtomicLoad(int32_t* iVal)
+{
+  return __atomic_load_n(iVal, __ATOMIC_ACQUIRE);
+}
+
+void Rtos_AtomicStore(int32_t* iVal, int32_t iNew)
+{
+  __atomic_store_n(iVal, iNew, __ATOMIC_RELEASE);
+}
+
+int64_t Rtos_AtomicLoad64(int64_t* iVal)
+{
+  return __atomic_load_n(iVal, __ATOMIC_ACQUIRE);
+}
+
+void Rtos_AtomicStore64(int64_t* iVal, int64_t iNew)
+{
+  __atomic_store_n(iVal, iNew, __ATOMIC_RELEASE);
+}
+
+void Rtos_AcquireFence()
+{
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+}
+
 #endif
 
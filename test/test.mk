@@ -0,0 +1,91 @@
+# libraries the tested code depends on, without their own test list
+TEST_LIB_SRC:=\
+  $(LIB_RTOS_SRC)\
+  $(LIB_PERFS_SRC)\
+  $(LIB_FPGA_SRC)\
+  $(LIB_SCHEDULER_DEC_SRC)\
+  $(LIB_BUF_MNGT_SRC)\
+  $(LIB_CONV_SRC)\
+  $(LIB_CFG_SRC)\
+
+##############################################################
+# Unit tests (googletest)
+# make ENABLE_UNITTESTS=1 unittest
+##############################################################
+ifneq ($(ENABLE_UNITTESTS),0)
+
+UNITTEST_SRC:=$(sort $(UNITTEST) $(TEST_LIB_SRC))
+
+UNITTEST_OBJ:=$(UNITTEST_SRC:%=$(BIN)/%.o)
+
+$(BIN)/AL_UnitTests.exe: $(UNITTEST_OBJ)
+$(BIN)/AL_UnitTests.exe: LDFLAGS+=-lgtest_main -lgtest -lpthread
+
+unittest: $(BIN)/AL_UnitTests.exe
+	$(BIN)/AL_UnitTests.exe
+
+TARGETS+=$(BIN)/AL_UnitTests.exe
+
+.PHONY: unittest
+
+endif
+
+##############################################################
+# Micro benchmarks (google benchmark)
+# make ENABLE_BENCHMARKS=1 benchmark
+##############################################################
+ifneq ($(ENABLE_BENCHMARKS),0)
+
+# the tested libraries, without the test cases
+BENCHMARK_SRC:=$(sort $(BENCHMARK) $(TEST_LIB_SRC)\
+  $(foreach src,$(UNITTEST),$(if $(findstring /unittests/,$(src)),,$(src))))
+
+BENCHMARK_OBJ:=$(BENCHMARK_SRC:%=$(BIN)/%.o)
+
+$(BIN)/AL_Benchmarks.exe: $(BENCHMARK_OBJ)
+$(BIN)/AL_Benchmarks.exe: LDFLAGS+=-lbenchmark_main -lbenchmark -lpthread
+
+benchmark: $(BIN)/AL_Benchmarks.exe
+	$(BIN)/AL_Benchmarks.exe
+
+TARGETS+=$(BIN)/AL_Benchmarks.exe
+
+.PHONY: benchmark
+
+endif
+
+##############################################################
+# Encoder stage timings (--bench-json) of the test configs, on the
+# software stand-in for the MCU, collected in one report
+# make encoder_bench
+##############################################################
+ENC_BENCH_DIR:=$(BIN)/encoder_bench
+
+# encode_simple_avc.cfg and encode_simple_jpeg.cfg use settings this encoder
+# isn't built with. encode_overflow.cfg reads a random picture made below
+ENC_BENCH_CFG:=\
+  test/config/encode_simple.cfg\
+  test/config/encode_without_conversion.cfg\
+  test/config/encode_overflow.cfg\
+
+ENC_BENCH_JSON:=$(ENC_BENCH_CFG:test/config/%.cfg=$(ENC_BENCH_DIR)/%.json)
+
+# one 96x40 I420 picture
+$(ENC_BENCH_DIR)/random.yuv:
+	@mkdir -p $(@D)
+	head -c 5760 /dev/urandom > $@
+
+$(ENC_BENCH_DIR)/encode_overflow.json: ENC_BENCH_ARGS:=-i $(ENC_BENCH_DIR)/random.yuv
+$(ENC_BENCH_DIR)/encode_overflow.json: $(ENC_BENCH_DIR)/random.yuv
+
+# the timings are taken again on each run
+$(ENC_BENCH_JSON): $(ENC_BENCH_DIR)/%.json: test/config/%.cfg $(BIN)/AL_Encoder.exe
+	@mkdir -p $(@D)
+	$(BIN)/AL_Encoder.exe -cfg $< $(ENC_BENCH_ARGS) --sim-mcu --bench-json $@ -o $(ENC_BENCH_DIR)/$*.bin -r $(ENC_BENCH_DIR)/$*.rec.yuv
+
+# one report per config, keyed by the config name
+encoder_bench: $(ENC_BENCH_JSON)
+	@(echo "{"; sep=""; for f in $^; do printf '%s"%s": ' "$$sep" "$$(basename $$f .json)"; cat $$f; sep=","; done; echo "}") > $(ENC_BENCH_DIR)/reports.json
+	@echo "encoder bench reports: $(ENC_BENCH_DIR)/reports.json"
+
+.PHONY: encoder_bench $(ENC_BENCH_JSON)